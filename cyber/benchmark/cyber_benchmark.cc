@@ -0,0 +1,416 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Measures the latency and throughput of cyber messaging on one machine.
+//
+// With --role=all(default) the process publishes the messages itself and,
+// except for the intra transport, forks --reader_num reader processes of the
+// same binary. Every run appends one json line to --output.
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "cyber/benchmark/latency_stats.h"
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/cyber.h"
+#include "cyber/proto/unit_test.pb.h"
+#include "cyber/time/rate.h"
+#include "cyber/time/time.h"
+#include "cyber/transport/common/identity.h"
+#include "cyber/transport/transport.h"
+
+DEFINE_string(role, "all", "all, writer or reader");
+DEFINE_string(transport, "shm", "intra, shm, rtps or hybrid");
+DEFINE_uint64(message_size, 1024, "payload size in bytes");
+DEFINE_double(rate, 100.0, "publish rate in Hz, 0 for as fast as possible");
+DEFINE_uint64(message_num, 1000, "number of measured messages");
+DEFINE_uint64(warmup_num, 10, "number of messages sent before measuring");
+DEFINE_uint64(reader_num, 1, "number of readers");
+DEFINE_uint64(reader_id, 0, "index of this reader, for --role=reader");
+DEFINE_string(sched_name, "CYBER_DEFAULT",
+              "scheduler conf, only affects the hybrid transport which "
+              "dispatches messages through the scheduler");
+DEFINE_string(channel, "/apollo/cyber/benchmark", "benchmark channel");
+DEFINE_uint64(startup_ms, 2000, "time given to the readers to connect");
+DEFINE_uint64(idle_timeout_ms, 3000,
+              "a reader stops after receiving nothing for this long");
+DEFINE_string(result_file, "", "where a reader process writes its result");
+DEFINE_string(output, "", "file the json results are appended to, "
+                          "stdout if empty");
+
+namespace apollo {
+namespace cyber {
+namespace benchmark {
+
+using proto::Chatter;
+using proto::OptionalMode;
+using transport::Transport;
+
+namespace {
+
+bool GetMode(const std::string& name, OptionalMode* mode) {
+  if (name == "intra") {
+    *mode = OptionalMode::INTRA;
+  } else if (name == "shm") {
+    *mode = OptionalMode::SHM;
+  } else if (name == "rtps") {
+    *mode = OptionalMode::RTPS;
+  } else if (name == "hybrid") {
+    *mode = OptionalMode::HYBRID;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+proto::RoleAttributes ChannelAttr(const std::string& node_name) {
+  proto::RoleAttributes attr;
+  attr.set_host_name(common::GlobalData::Instance()->HostName());
+  attr.set_process_id(common::GlobalData::Instance()->ProcessId());
+  attr.set_node_name(node_name);
+  attr.set_node_id(common::GlobalData::RegisterNode(node_name));
+  attr.set_channel_name(FLAGS_channel);
+  attr.set_channel_id(common::GlobalData::RegisterChannel(FLAGS_channel));
+  transport::Identity id;
+  attr.set_id(id.HashValue());
+  return attr;
+}
+
+uint64_t NowNs() { return Time::Now().ToNanosecond(); }
+
+/**
+ * @class ReaderStats
+ * @brief Latency of one reader, counting only the measured messages
+ */
+class ReaderStats {
+ public:
+  explicit ReaderStats(uint64_t id)
+      : id_(id), stats_(FLAGS_message_num), last_recv_ns_(0) {}
+
+  void OnMessage(const std::shared_ptr<Chatter>& msg) {
+    uint64_t now = NowNs();
+    last_recv_ns_.store(now);
+    if (msg->seq() < FLAGS_warmup_num) {
+      return;
+    }
+    stats_.Add(now - msg->timestamp());
+  }
+
+  bool Done() { return stats_.Count() >= FLAGS_message_num; }
+
+  // waits for all the messages, or until nothing arrives for a while
+  void Wait(uint64_t started_ns) {
+    while (!Done() && !IsShutdown()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      uint64_t last = last_recv_ns_.load();
+      uint64_t since = last == 0 ? started_ns : last;
+      if (NowNs() - since > FLAGS_idle_timeout_ms * 1000000 +
+                                (last == 0 ? FLAGS_startup_ms * 1000000 : 0)) {
+        break;
+      }
+    }
+  }
+
+  std::string ToJson(uint64_t cpu_us) {
+    size_t received = stats_.Count();
+    std::ostringstream oss;
+    oss << "{\"reader_id\":" << id_ << ",\"lost\":"
+        << (FLAGS_message_num > received ? FLAGS_message_num - received : 0)
+        << "," << stats_.ToJson() << ",\"cpu_us_per_msg\":"
+        << (received > 0 ? static_cast<double>(cpu_us) /
+                               static_cast<double>(received)
+                         : 0.0)
+        << "}";
+    return oss.str();
+  }
+
+ private:
+  uint64_t id_;
+  LatencyStats stats_;
+  std::atomic<uint64_t> last_recv_ns_;
+};
+
+/**
+ * @class BenchmarkReader
+ * @brief Subscribes the channel through the transport under test
+ */
+class BenchmarkReader {
+ public:
+  BenchmarkReader(uint64_t id, OptionalMode mode)
+      : id_(id), stats_(id), mode_(mode) {}
+
+  bool Init() {
+    if (mode_ == OptionalMode::HYBRID) {
+      node_ = CreateNode("benchmark_reader_" + std::to_string(id_));
+      RETURN_VAL_IF_NULL(node_, false);
+      reader_ = node_->CreateReader<Chatter>(
+          FLAGS_channel,
+          [this](const std::shared_ptr<Chatter>& msg) { stats_.OnMessage(msg); });
+      return reader_ != nullptr;
+    }
+    receiver_ = Transport::Instance()->CreateReceiver<Chatter>(
+        ChannelAttr("benchmark_reader_" + std::to_string(id_)),
+        [this](const std::shared_ptr<Chatter>& msg,
+               const transport::MessageInfo&,
+               const proto::RoleAttributes&) { stats_.OnMessage(msg); },
+        mode_);
+    return receiver_ != nullptr;
+  }
+
+  ReaderStats* stats() { return &stats_; }
+
+ private:
+  uint64_t id_;
+  ReaderStats stats_;
+  OptionalMode mode_;
+  std::shared_ptr<Node> node_;
+  std::shared_ptr<Reader<Chatter>> reader_;
+  std::shared_ptr<transport::Receiver<Chatter>> receiver_;
+};
+
+/**
+ * @brief Publish the warmup and the measured messages, return the writer
+ * summary as json
+ */
+std::string RunWriter(OptionalMode mode) {
+  std::shared_ptr<Node> node = nullptr;
+  std::shared_ptr<Writer<Chatter>> writer = nullptr;
+  std::shared_ptr<transport::Transmitter<Chatter>> transmitter = nullptr;
+  if (mode == OptionalMode::HYBRID) {
+    node = CreateNode("benchmark_writer");
+    writer = node->CreateWriter<Chatter>(FLAGS_channel);
+  } else {
+    transmitter = Transport::Instance()->CreateTransmitter<Chatter>(
+        ChannelAttr("benchmark_writer"), mode);
+  }
+  if (writer == nullptr && transmitter == nullptr) {
+    AERROR << "failed to create writer.";
+    return "{}";
+  }
+
+  const std::string content(FLAGS_message_size, 'c');
+  const uint64_t total = FLAGS_warmup_num + FLAGS_message_num;
+  std::unique_ptr<Rate> rate = nullptr;
+  if (FLAGS_rate > 0.0) {
+    rate.reset(new Rate(FLAGS_rate));
+  }
+
+  uint64_t sent = 0;
+  uint64_t cpu_start = 0;
+  uint64_t begin_ns = 0;
+  for (uint64_t seq = 0; seq < total && OK(); ++seq) {
+    if (seq == FLAGS_warmup_num) {
+      cpu_start = ProcessCpuTimeUs();
+      begin_ns = NowNs();
+    }
+    auto msg = std::make_shared<Chatter>();
+    msg->set_seq(seq);
+    msg->set_content(content);
+    msg->set_timestamp(NowNs());
+    bool ok = writer != nullptr ? writer->Write(msg)
+                                : transmitter->Transmit(msg);
+    if (ok && seq >= FLAGS_warmup_num) {
+      ++sent;
+    }
+    if (rate != nullptr) {
+      rate->Sleep();
+    }
+  }
+  double duration_s = static_cast<double>(NowNs() - begin_ns) * 1e-9;
+  uint64_t cpu_us = ProcessCpuTimeUs() - cpu_start;
+
+  std::ostringstream oss;
+  oss << "{\"sent\":" << sent << ",\"duration_s\":" << duration_s
+      << ",\"throughput_msg_s\":"
+      << (duration_s > 0.0 ? static_cast<double>(sent) / duration_s : 0.0)
+      << ",\"throughput_mb_s\":"
+      << (duration_s > 0.0 ? static_cast<double>(sent * FLAGS_message_size) /
+                                 duration_s / 1e6
+                           : 0.0)
+      << ",\"cpu_us_per_msg\":"
+      << (sent > 0 ? static_cast<double>(cpu_us) / static_cast<double>(sent)
+                   : 0.0)
+      << "}";
+  return oss.str();
+}
+
+int RunReaderProcess(OptionalMode mode) {
+  BenchmarkReader reader(FLAGS_reader_id, mode);
+  if (!reader.Init()) {
+    AERROR << "failed to create reader.";
+    return -1;
+  }
+  uint64_t cpu_start = ProcessCpuTimeUs();
+  reader.stats()->Wait(NowNs());
+  std::string result =
+      reader.stats()->ToJson(ProcessCpuTimeUs() - cpu_start);
+  if (FLAGS_result_file.empty()) {
+    std::cout << result << std::endl;
+  } else {
+    std::ofstream fout(FLAGS_result_file);
+    fout << result << std::endl;
+  }
+  return 0;
+}
+
+pid_t SpawnReader(const std::string& binary, uint64_t id,
+                  const std::string& result_file) {
+  // the process is multithreaded, the child must not allocate before exec
+  std::vector<std::string> args = {
+      binary,
+      "--role=reader",
+      "--transport=" + FLAGS_transport,
+      "--message_num=" + std::to_string(FLAGS_message_num),
+      "--warmup_num=" + std::to_string(FLAGS_warmup_num),
+      "--reader_id=" + std::to_string(id),
+      "--sched_name=" + FLAGS_sched_name,
+      "--channel=" + FLAGS_channel,
+      "--startup_ms=" + std::to_string(FLAGS_startup_ms),
+      "--idle_timeout_ms=" + std::to_string(FLAGS_idle_timeout_ms),
+      "--result_file=" + result_file};
+  std::vector<char*> argv;
+  for (auto& arg : args) {
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  }
+  argv.push_back(nullptr);
+  pid_t pid = fork();
+  if (pid != 0) {
+    return pid;
+  }
+  execv(binary.c_str(), argv.data());
+  _exit(127);
+}
+
+int RunAll(OptionalMode mode) {
+  std::vector<std::string> reader_results;
+  std::string writer_result;
+
+  if (mode == OptionalMode::INTRA) {
+    std::vector<std::unique_ptr<BenchmarkReader>> readers;
+    for (uint64_t i = 0; i < FLAGS_reader_num; ++i) {
+      readers.emplace_back(new BenchmarkReader(i, mode));
+      if (!readers.back()->Init()) {
+        AERROR << "failed to create reader " << i;
+        return -1;
+      }
+    }
+    uint64_t cpu_start = ProcessCpuTimeUs();
+    writer_result = RunWriter(mode);
+    uint64_t started_ns = NowNs();
+    for (auto& reader : readers) {
+      reader->stats()->Wait(started_ns);
+    }
+    // readers share the process, report the cpu of the whole run
+    uint64_t cpu_us = ProcessCpuTimeUs() - cpu_start;
+    for (auto& reader : readers) {
+      reader_results.emplace_back(reader->stats()->ToJson(cpu_us));
+    }
+  } else {
+    char binary[4096] = {0};
+    ssize_t len = readlink("/proc/self/exe", binary, sizeof(binary) - 1);
+    if (len <= 0) {
+      AERROR << "cannot locate the benchmark binary.";
+      return -1;
+    }
+
+    const std::string prefix = "/tmp/cyber_benchmark_" +
+                               std::to_string(getpid()) + "_reader_";
+    std::vector<pid_t> pids;
+    for (uint64_t i = 0; i < FLAGS_reader_num; ++i) {
+      pids.push_back(SpawnReader(binary, i, prefix + std::to_string(i)));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(FLAGS_startup_ms));
+    writer_result = RunWriter(mode);
+
+    for (uint64_t i = 0; i < pids.size(); ++i) {
+      int status = 0;
+      waitpid(pids[i], &status, 0);
+      std::string file = prefix + std::to_string(i);
+      std::ifstream fin(file);
+      std::string line;
+      if (std::getline(fin, line) && !line.empty()) {
+        reader_results.emplace_back(line);
+      } else {
+        AERROR << "reader " << i << " reported nothing, status: " << status;
+      }
+      unlink(file.c_str());
+    }
+  }
+
+  std::ostringstream oss;
+  oss << "{\"transport\":\"" << FLAGS_transport
+      << "\",\"message_size\":" << FLAGS_message_size
+      << ",\"rate\":" << FLAGS_rate << ",\"reader_num\":" << FLAGS_reader_num
+      << ",\"sched_name\":\"" << FLAGS_sched_name
+      << "\",\"writer\":" << writer_result << ",\"readers\":[";
+  for (size_t i = 0; i < reader_results.size(); ++i) {
+    oss << (i == 0 ? "" : ",") << reader_results[i];
+  }
+  oss << "]}";
+
+  if (FLAGS_output.empty()) {
+    std::cout << oss.str() << std::endl;
+  } else {
+    std::ofstream fout(FLAGS_output, std::ios::app);
+    fout << oss.str() << std::endl;
+  }
+  return 0;
+}
+
+}  // namespace
+
+}  // namespace benchmark
+}  // namespace cyber
+}  // namespace apollo
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  apollo::cyber::proto::OptionalMode mode;
+  if (!apollo::cyber::benchmark::GetMode(FLAGS_transport, &mode)) {
+    std::cerr << "unknown transport: " << FLAGS_transport << std::endl;
+    return -1;
+  }
+
+  apollo::cyber::common::GlobalData::Instance()->SetSchedName(
+      FLAGS_sched_name);
+  apollo::cyber::Init(argv[0]);
+
+  int ret = 0;
+  if (FLAGS_role == "reader") {
+    ret = apollo::cyber::benchmark::RunReaderProcess(mode);
+  } else if (FLAGS_role == "writer") {
+    std::this_thread::sleep_for(std::chrono::milliseconds(FLAGS_startup_ms));
+    std::cout << apollo::cyber::benchmark::RunWriter(mode) << std::endl;
+  } else {
+    ret = apollo::cyber::benchmark::RunAll(mode);
+  }
+  apollo::cyber::Clear();
+  return ret;
+}
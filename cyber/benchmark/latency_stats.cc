@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/benchmark/latency_stats.h"
+
+#include <sys/resource.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+
+namespace apollo {
+namespace cyber {
+namespace benchmark {
+
+LatencyStats::LatencyStats(size_t expected_num) {
+  samples_.reserve(expected_num);
+}
+
+void LatencyStats::Add(uint64_t latency_ns) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  samples_.push_back(latency_ns);
+  sorted_ = false;
+}
+
+size_t LatencyStats::Count() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return samples_.size();
+}
+
+uint64_t LatencyStats::Percentile(double fraction) {
+  if (samples_.empty()) {
+    return 0;
+  }
+  Sort();
+  fraction = std::min(std::max(fraction, 0.0), 1.0);
+  size_t rank = static_cast<size_t>(
+      std::ceil(fraction * static_cast<double>(samples_.size())));
+  return samples_[rank == 0 ? 0 : rank - 1];
+}
+
+uint64_t LatencyStats::Max() {
+  if (samples_.empty()) {
+    return 0;
+  }
+  Sort();
+  return samples_.back();
+}
+
+double LatencyStats::Mean() const {
+  if (samples_.empty()) {
+    return 0.0;
+  }
+  double sum = std::accumulate(samples_.begin(), samples_.end(), 0.0);
+  return sum / static_cast<double>(samples_.size());
+}
+
+std::string LatencyStats::ToJson() {
+  std::ostringstream oss;
+  oss << "\"count\":" << Count() << ",\"mean_us\":" << Mean() * 1e-3
+      << ",\"p50_us\":" << static_cast<double>(Percentile(0.5)) * 1e-3
+      << ",\"p99_us\":" << static_cast<double>(Percentile(0.99)) * 1e-3
+      << ",\"p999_us\":" << static_cast<double>(Percentile(0.999)) * 1e-3
+      << ",\"max_us\":" << static_cast<double>(Max()) * 1e-3;
+  return oss.str();
+}
+
+void LatencyStats::Sort() {
+  if (!sorted_) {
+    std::sort(samples_.begin(), samples_.end());
+    sorted_ = true;
+  }
+}
+
+uint64_t ProcessCpuTimeUs() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  return static_cast<uint64_t>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) *
+             1000000 +
+         static_cast<uint64_t>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+}  // namespace benchmark
+}  // namespace cyber
+}  // namespace apollo
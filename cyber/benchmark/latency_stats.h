@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_BENCHMARK_LATENCY_STATS_H_
+#define CYBER_BENCHMARK_LATENCY_STATS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace benchmark {
+
+/**
+ * @class LatencyStats
+ * @brief Collects latency samples of a benchmark run and summarizes them.
+ * Add is thread safe, the summary methods should be called after the run.
+ */
+class LatencyStats {
+ public:
+  explicit LatencyStats(size_t expected_num = 0);
+
+  void Add(uint64_t latency_ns);
+
+  size_t Count();
+
+  /**
+   * @brief Get the latency below which the given fraction of the samples
+   * fall, e.g. 0.99 for p99. Returns 0 if there is no sample.
+   */
+  uint64_t Percentile(double fraction);
+  uint64_t Max();
+  double Mean() const;
+
+  /**
+   * @brief Format the summary in microseconds as json members, without the
+   * surrounding braces.
+   */
+  std::string ToJson();
+
+ private:
+  void Sort();
+
+  std::mutex mutex_;
+  std::vector<uint64_t> samples_;
+  bool sorted_ = false;
+};
+
+/**
+ * @brief CPU time(user + system) consumed by this process in microseconds
+ */
+uint64_t ProcessCpuTimeUs();
+
+}  // namespace benchmark
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_BENCHMARK_LATENCY_STATS_H_
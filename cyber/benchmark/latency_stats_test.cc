@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/benchmark/latency_stats.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace benchmark {
+
+TEST(LatencyStatsTest, empty) {
+  LatencyStats stats;
+  EXPECT_EQ(0, stats.Count());
+  EXPECT_EQ(0, stats.Percentile(0.5));
+  EXPECT_EQ(0, stats.Max());
+  EXPECT_DOUBLE_EQ(0.0, stats.Mean());
+}
+
+TEST(LatencyStatsTest, percentile) {
+  LatencyStats stats(1000);
+  // added in reverse order to make sure the samples get sorted
+  for (uint64_t i = 1000; i > 0; --i) {
+    stats.Add(i * 1000);
+  }
+  EXPECT_EQ(1000, stats.Count());
+  EXPECT_EQ(500000, stats.Percentile(0.5));
+  EXPECT_EQ(990000, stats.Percentile(0.99));
+  EXPECT_EQ(999000, stats.Percentile(0.999));
+  EXPECT_EQ(1000000, stats.Percentile(1.0));
+  EXPECT_EQ(1000, stats.Percentile(0.0));
+  EXPECT_EQ(1000000, stats.Max());
+  EXPECT_DOUBLE_EQ(500500.0, stats.Mean());
+
+  stats.Add(2000000);
+  EXPECT_EQ(2000000, stats.Max());
+}
+
+TEST(LatencyStatsTest, to_json) {
+  LatencyStats stats;
+  stats.Add(1000);
+  stats.Add(3000);
+  std::string json = stats.ToJson();
+  EXPECT_NE(std::string::npos, json.find("\"count\":2"));
+  EXPECT_NE(std::string::npos, json.find("\"mean_us\":2"));
+  EXPECT_NE(std::string::npos, json.find("\"p50_us\":1"));
+  EXPECT_NE(std::string::npos, json.find("\"max_us\":3"));
+}
+
+TEST(LatencyStatsTest, cpu_time) {
+  uint64_t start = ProcessCpuTimeUs();
+  volatile uint64_t sum = 0;
+  for (uint64_t i = 0; i < 10000000; ++i) {
+    sum += i;
+  }
+  EXPECT_GE(ProcessCpuTimeUs(), start);
+}
+
+}  // namespace benchmark
+}  // namespace cyber
+}  // namespace apollo
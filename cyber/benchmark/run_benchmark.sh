@@ -0,0 +1,65 @@
+#!/usr/bin/env bash
+
+###############################################################################
+# Copyright 2020 The Apollo Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+###############################################################################
+
+# Sweep the cyber benchmark over transports, message sizes, rates, reader
+# numbers and scheduler confs. Every run appends one json line to OUTPUT.
+#
+# Usage: run_benchmark.sh [output_file]
+
+APOLLO_ROOT="$(cd "$(dirname "$0")/../.." && pwd -P)"
+BENCHMARK="${BENCHMARK:-${APOLLO_ROOT}/bazel-bin/cyber/benchmark/cyber_benchmark}"
+OUTPUT="${1:-${APOLLO_ROOT}/data/cyber_benchmark_$(date +%Y%m%d_%H%M%S).json}"
+
+TRANSPORTS="${TRANSPORTS:-intra shm rtps hybrid}"
+# 100B, 1KB, 64KB, 1MB, 8MB
+MESSAGE_SIZES="${MESSAGE_SIZES:-100 1024 65536 1048576 8388608}"
+RATES="${RATES:-10 100 1000}"
+READER_NUMS="${READER_NUMS:-1 4}"
+SCHED_NAMES="${SCHED_NAMES:-CYBER_DEFAULT}"
+MESSAGE_NUM="${MESSAGE_NUM:-1000}"
+
+if [ ! -x "${BENCHMARK}" ]; then
+  echo "${BENCHMARK} not found, build it with:"
+  echo "  bazel build //cyber/benchmark:cyber_benchmark"
+  exit 1
+fi
+
+mkdir -p "$(dirname "${OUTPUT}")"
+
+for transport in ${TRANSPORTS}; do
+  for size in ${MESSAGE_SIZES}; do
+    for rate in ${RATES}; do
+      for reader_num in ${READER_NUMS}; do
+        for sched_name in ${SCHED_NAMES}; do
+          echo "transport: ${transport}, size: ${size}, rate: ${rate}," \
+            "readers: ${reader_num}, sched: ${sched_name}"
+          "${BENCHMARK}" \
+            --transport="${transport}" \
+            --message_size="${size}" \
+            --rate="${rate}" \
+            --reader_num="${reader_num}" \
+            --sched_name="${sched_name}" \
+            --message_num="${MESSAGE_NUM}" \
+            --output="${OUTPUT}"
+        done
+      done
+    done
+  done
+done
+
+echo "results are written to ${OUTPUT}"
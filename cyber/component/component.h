@@ -180,6 +180,7 @@ bool Component<M0, NullType, NullType, NullType>::Initialize(
   reader_cfg.channel_name = config.readers(0).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(0).qos_profile());
   reader_cfg.pending_queue_size = config.readers(0).pending_queue_size();
+  reader_cfg.arena_allocation = config.readers(0).arena_allocation();
 
   std::weak_ptr<Component<M0>> self =
       std::dynamic_pointer_cast<Component<M0>>(shared_from_this());
@@ -250,12 +251,14 @@ bool Component<M0, M1, NullType, NullType>::Initialize(
   reader_cfg.channel_name = config.readers(1).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(1).qos_profile());
   reader_cfg.pending_queue_size = config.readers(1).pending_queue_size();
+  reader_cfg.arena_allocation = config.readers(1).arena_allocation();
 
   auto reader1 = node_->template CreateReader<M1>(reader_cfg);
 
   reader_cfg.channel_name = config.readers(0).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(0).qos_profile());
   reader_cfg.pending_queue_size = config.readers(0).pending_queue_size();
+  reader_cfg.arena_allocation = config.readers(0).arena_allocation();
 
   std::shared_ptr<Reader<M0>> reader0 = nullptr;
   if (cyber_likely(is_reality_mode)) {
@@ -347,18 +350,21 @@ bool Component<M0, M1, M2, NullType>::Initialize(
   reader_cfg.channel_name = config.readers(1).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(1).qos_profile());
   reader_cfg.pending_queue_size = config.readers(1).pending_queue_size();
+  reader_cfg.arena_allocation = config.readers(1).arena_allocation();
 
   auto reader1 = node_->template CreateReader<M1>(reader_cfg);
 
   reader_cfg.channel_name = config.readers(2).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(2).qos_profile());
   reader_cfg.pending_queue_size = config.readers(2).pending_queue_size();
+  reader_cfg.arena_allocation = config.readers(2).arena_allocation();
 
   auto reader2 = node_->template CreateReader<M2>(reader_cfg);
 
   reader_cfg.channel_name = config.readers(0).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(0).qos_profile());
   reader_cfg.pending_queue_size = config.readers(0).pending_queue_size();
+  reader_cfg.arena_allocation = config.readers(0).arena_allocation();
   std::shared_ptr<Reader<M0>> reader0 = nullptr;
   if (cyber_likely(is_reality_mode)) {
     reader0 = node_->template CreateReader<M0>(reader_cfg);
@@ -457,24 +463,28 @@ bool Component<M0, M1, M2, M3>::Initialize(const ComponentConfig& config) {
   reader_cfg.channel_name = config.readers(1).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(1).qos_profile());
   reader_cfg.pending_queue_size = config.readers(1).pending_queue_size();
+  reader_cfg.arena_allocation = config.readers(1).arena_allocation();
 
   auto reader1 = node_->template CreateReader<M1>(reader_cfg);
 
   reader_cfg.channel_name = config.readers(2).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(2).qos_profile());
   reader_cfg.pending_queue_size = config.readers(2).pending_queue_size();
+  reader_cfg.arena_allocation = config.readers(2).arena_allocation();
 
   auto reader2 = node_->template CreateReader<M2>(reader_cfg);
 
   reader_cfg.channel_name = config.readers(3).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(3).qos_profile());
   reader_cfg.pending_queue_size = config.readers(3).pending_queue_size();
+  reader_cfg.arena_allocation = config.readers(3).arena_allocation();
 
   auto reader3 = node_->template CreateReader<M3>(reader_cfg);
 
   reader_cfg.channel_name = config.readers(0).channel();
   reader_cfg.qos_profile.CopyFrom(config.readers(0).qos_profile());
   reader_cfg.pending_queue_size = config.readers(0).pending_queue_size();
+  reader_cfg.arena_allocation = config.readers(0).arena_allocation();
 
   std::shared_ptr<Reader<M0>> reader0 = nullptr;
   if (cyber_likely(is_reality_mode)) {
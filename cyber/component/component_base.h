@@ -19,7 +19,9 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "gflags/gflags.h"
@@ -64,6 +66,19 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
     return common::GetProtoFromFile(config_file_path_, config);
   }
 
+  /**
+   * @brief Load a flag file ahead of Initialize, which then skips it. The
+   * mainboard loads the flag files of all the components in dag order
+   * before it initializes the components concurrently, as gflags is not
+   * thread safe.
+   */
+  static void PreloadFlagFile(const std::string& flag_file_path) {
+    std::string path = FlagFilePath(flag_file_path);
+    std::lock_guard<std::mutex> lock(FlagFileMutex());
+    google::SetCommandLineOption("flagfile", path.c_str());
+    PreloadedFlagFiles().insert(path);
+  }
+
  protected:
   virtual bool Init() = 0;
   virtual void Clear() { return; }
@@ -80,12 +95,7 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
     }
 
     if (!config.flag_file_path().empty()) {
-      std::string flag_file_path = config.flag_file_path();
-      if (flag_file_path[0] != '/') {
-        flag_file_path =
-            common::GetAbsolutePath(common::WorkRoot(), flag_file_path);
-      }
-      google::SetCommandLineOption("flagfile", flag_file_path.c_str());
+      LoadFlagFile(config.flag_file_path());
     }
   }
 
@@ -100,15 +110,35 @@ class ComponentBase : public std::enable_shared_from_this<ComponentBase> {
     }
 
     if (!config.flag_file_path().empty()) {
-      std::string flag_file_path = config.flag_file_path();
-      if (flag_file_path[0] != '/') {
-        flag_file_path =
-            common::GetAbsolutePath(common::WorkRoot(), flag_file_path);
-      }
-      google::SetCommandLineOption("flagfile", flag_file_path.c_str());
+      LoadFlagFile(config.flag_file_path());
+    }
+  }
+
+  void LoadFlagFile(const std::string& flag_file_path) {
+    std::string path = FlagFilePath(flag_file_path);
+    std::lock_guard<std::mutex> lock(FlagFileMutex());
+    if (PreloadedFlagFiles().count(path) == 0) {
+      google::SetCommandLineOption("flagfile", path.c_str());
     }
   }
 
+  static std::string FlagFilePath(const std::string& flag_file_path) {
+    if (flag_file_path[0] != '/') {
+      return common::GetAbsolutePath(common::WorkRoot(), flag_file_path);
+    }
+    return flag_file_path;
+  }
+
+  static std::mutex& FlagFileMutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  static std::unordered_set<std::string>& PreloadedFlagFiles() {
+    static std::unordered_set<std::string> flag_files;
+    return flag_files;
+  }
+
   std::atomic<bool> is_shutdown_ = {false};
   std::shared_ptr<Node> node_ = nullptr;
   std::string config_file_path_ = "";
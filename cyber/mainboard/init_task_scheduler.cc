@@ -0,0 +1,189 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/mainboard/init_task_scheduler.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+
+#include "cyber/base/thread_pool.h"
+#include "cyber/common/log.h"
+#include "cyber/time/time.h"
+
+namespace apollo {
+namespace cyber {
+namespace mainboard {
+
+bool InitTaskScheduler::Run(std::vector<InitTask>* tasks) const {
+  const size_t task_num = tasks->size();
+  std::unordered_map<std::string, size_t> name_to_index;
+  for (size_t i = 0; i < task_num; ++i) {
+    if (!tasks->at(i).name.empty()) {
+      name_to_index.emplace(tasks->at(i).name, i);
+    }
+  }
+
+  std::vector<int> pending_depends(task_num, 0);
+  std::vector<std::vector<size_t>> dependents(task_num);
+  for (size_t i = 0; i < task_num; ++i) {
+    for (auto& depend : tasks->at(i).depends) {
+      auto it = name_to_index.find(depend);
+      if (it == name_to_index.end()) {
+        AERROR << "component[" << tasks->at(i).name
+               << "] depends on unknown component[" << depend << "].";
+        return false;
+      }
+      dependents[it->second].push_back(i);
+      ++pending_depends[i];
+    }
+  }
+
+  // reject cyclic dependencies before running anything
+  {
+    std::vector<int> remains(pending_depends);
+    std::queue<size_t> ready;
+    for (size_t i = 0; i < task_num; ++i) {
+      if (remains[i] == 0) {
+        ready.push(i);
+      }
+    }
+    size_t visited = 0;
+    while (!ready.empty()) {
+      size_t i = ready.front();
+      ready.pop();
+      ++visited;
+      for (auto dependent : dependents[i]) {
+        if (--remains[dependent] == 0) {
+          ready.push(dependent);
+        }
+      }
+    }
+    if (visited != task_num) {
+      AERROR << "cyclic dependency found among components.";
+      return false;
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::queue<size_t> finished;
+  const double begin_ms = Time::MonoTime().ToSecond() * 1e3;
+  auto run = [tasks, &mutex, &cv, &finished, begin_ms](size_t i) {
+    auto& task = tasks->at(i);
+    const double start_ms = Time::MonoTime().ToSecond() * 1e3;
+    task.start_ms = start_ms - begin_ms;
+    task.success = task.run();
+    task.cost_ms = Time::MonoTime().ToSecond() * 1e3 - start_ms;
+    std::lock_guard<std::mutex> lock(mutex);
+    finished.push(i);
+    cv.notify_one();
+  };
+
+  const size_t thread_num = std::max<size_t>(
+      1, std::min(static_cast<size_t>(thread_num_), task_num));
+  std::unique_ptr<base::ThreadPool> pool = nullptr;
+  if (thread_num > 1) {
+    pool.reset(new base::ThreadPool(thread_num, task_num));
+  }
+
+  std::queue<size_t> ready;
+  for (size_t i = 0; i < task_num; ++i) {
+    if (pending_depends[i] == 0) {
+      ready.push(i);
+    }
+  }
+
+  size_t running = 0;
+  bool success = true;
+  while (true) {
+    // stop scheduling on failure, only wait for the running ones
+    while (success && !ready.empty() && running < thread_num) {
+      size_t i = ready.front();
+      ready.pop();
+      ++running;
+      tasks->at(i).started = true;
+      if (pool != nullptr) {
+        pool->Enqueue(run, i);
+      } else {
+        run(i);
+      }
+    }
+    if (running == 0) {
+      break;
+    }
+
+    size_t i = 0;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [&finished] { return !finished.empty(); });
+      i = finished.front();
+      finished.pop();
+    }
+    --running;
+    if (!tasks->at(i).success) {
+      AERROR << "Failed to initialize component[" << tasks->at(i).name
+             << "], class: " << tasks->at(i).class_name;
+      success = false;
+      continue;
+    }
+    for (auto dependent : dependents[i]) {
+      if (--pending_depends[dependent] == 0) {
+        ready.push(dependent);
+      }
+    }
+  }
+  pool = nullptr;
+
+  Report(*tasks, Time::MonoTime().ToSecond() * 1e3 - begin_ms);
+  return success;
+}
+
+void InitTaskScheduler::Report(const std::vector<InitTask>& tasks,
+                               double total_ms) const {
+  std::vector<const InitTask*> started_tasks;
+  for (auto& task : tasks) {
+    if (task.started) {
+      started_tasks.push_back(&task);
+    }
+  }
+  std::sort(started_tasks.begin(), started_tasks.end(),
+            [](const InitTask* lhs, const InitTask* rhs) {
+              return lhs->start_ms < rhs->start_ms;
+            });
+
+  double sum_ms = 0.0;
+  for (auto task : started_tasks) {
+    AINFO << "component[" << task->name << "] class[" << task->class_name
+          << "] start at " << task->start_ms << " ms, init cost "
+          << task->cost_ms << " ms" << (task->success ? "" : ", failed");
+    sum_ms += task->cost_ms;
+  }
+  AINFO << "Initialized " << started_tasks.size() << " components with "
+        << thread_num_ << " threads in " << total_ms
+        << " ms, sum of init cost " << sum_ms << " ms.";
+  if (started_tasks.size() < tasks.size()) {
+    AERROR << tasks.size() - started_tasks.size()
+           << " components are not initialized after a failure.";
+  }
+}
+
+}  // namespace mainboard
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#ifndef CYBER_MAINBOARD_INIT_TASK_SCHEDULER_H_
+#define CYBER_MAINBOARD_INIT_TASK_SCHEDULER_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace apollo {
+namespace cyber {
+namespace mainboard {
+
+struct InitTask {
+  std::string name;
+  std::string class_name;
+  std::vector<std::string> depends;
+  // creates and initializes the component
+  std::function<bool()> run;
+  bool started = false;
+  bool success = false;
+  double start_ms = 0.0;
+  double cost_ms = 0.0;
+};
+
+/**
+ * @class InitTaskScheduler
+ * @brief Runs the initialization tasks of the components on a thread pool.
+ * A task starts once all the tasks it depends on have succeeded, and no task
+ * starts after one has failed.
+ */
+class InitTaskScheduler {
+ public:
+  explicit InitTaskScheduler(int thread_num) : thread_num_(thread_num) {}
+
+  /**
+   * @brief Run the tasks and report their init time
+   *
+   * @return false if a task failed, or if a task depends on an unknown or
+   * cyclic one, in which case nothing is run
+   */
+  bool Run(std::vector<InitTask>* tasks) const;
+
+ private:
+  void Report(const std::vector<InitTask>& tasks, double total_ms) const;
+
+  int thread_num_ = 1;
+};
+
+}  // namespace mainboard
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_MAINBOARD_INIT_TASK_SCHEDULER_H_
@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/mainboard/init_task_scheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace cyber {
+namespace mainboard {
+
+namespace {
+
+// records the order in which the tasks start and finish
+class TaskRecorder {
+ public:
+  explicit TaskRecorder(size_t task_num)
+      : start_seq_(task_num, -1), finish_seq_(task_num, -1) {}
+
+  InitTask MakeTask(size_t index, const std::string& name,
+                    const std::vector<std::string>& depends,
+                    bool success = true) {
+    InitTask task;
+    task.name = name;
+    task.class_name = name + "Component";
+    task.depends = depends;
+    task.run = [this, index, success]() {
+      start_seq_[index] = seq_++;
+      finish_seq_[index] = seq_++;
+      return success;
+    };
+    return task;
+  }
+
+  int start_seq(size_t index) const { return start_seq_[index]; }
+  int finish_seq(size_t index) const { return finish_seq_[index]; }
+
+ private:
+  std::atomic<int> seq_ = {0};
+  std::vector<int> start_seq_;
+  std::vector<int> finish_seq_;
+};
+
+}  // namespace
+
+TEST(InitTaskSchedulerTest, RunInDependencyOrder) {
+  for (int thread_num : {1, 4}) {
+    TaskRecorder recorder(5);
+    std::vector<InitTask> tasks;
+    tasks.push_back(recorder.MakeTask(0, "d", {"b", "c"}));
+    tasks.push_back(recorder.MakeTask(1, "b", {"a"}));
+    tasks.push_back(recorder.MakeTask(2, "c", {"a"}));
+    tasks.push_back(recorder.MakeTask(3, "a", {}));
+    tasks.push_back(recorder.MakeTask(4, "e", {}));
+    EXPECT_TRUE(InitTaskScheduler(thread_num).Run(&tasks));
+
+    for (size_t i = 0; i < tasks.size(); ++i) {
+      EXPECT_TRUE(tasks[i].started);
+      EXPECT_TRUE(tasks[i].success);
+      EXPECT_GE(recorder.start_seq(i), 0);
+    }
+    EXPECT_GT(recorder.start_seq(1), recorder.finish_seq(3));
+    EXPECT_GT(recorder.start_seq(2), recorder.finish_seq(3));
+    EXPECT_GT(recorder.start_seq(0), recorder.finish_seq(1));
+    EXPECT_GT(recorder.start_seq(0), recorder.finish_seq(2));
+  }
+}
+
+TEST(InitTaskSchedulerTest, RunIndependentTasksConcurrently) {
+  // each task waits for the other to start
+  std::mutex mutex;
+  std::condition_variable cv;
+  int started = 0;
+  auto run = [&mutex, &cv, &started]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    ++started;
+    cv.notify_all();
+    return cv.wait_for(lock, std::chrono::seconds(5),
+                       [&started] { return started == 2; });
+  };
+  std::vector<InitTask> tasks(2);
+  tasks[0].name = "a";
+  tasks[0].run = run;
+  tasks[1].name = "b";
+  tasks[1].run = run;
+  EXPECT_TRUE(InitTaskScheduler(2).Run(&tasks));
+}
+
+TEST(InitTaskSchedulerTest, StopAfterFailure) {
+  TaskRecorder recorder(3);
+  std::vector<InitTask> tasks;
+  tasks.push_back(recorder.MakeTask(0, "a", {}, false));
+  tasks.push_back(recorder.MakeTask(1, "b", {"a"}));
+  tasks.push_back(recorder.MakeTask(2, "c", {}));
+  EXPECT_FALSE(InitTaskScheduler(1).Run(&tasks));
+
+  EXPECT_TRUE(tasks[0].started);
+  EXPECT_FALSE(tasks[0].success);
+  // neither the dependent nor the next ready task is started
+  EXPECT_FALSE(tasks[1].started);
+  EXPECT_FALSE(tasks[2].started);
+  EXPECT_EQ(-1, recorder.start_seq(1));
+  EXPECT_EQ(-1, recorder.start_seq(2));
+}
+
+TEST(InitTaskSchedulerTest, RejectUnknownDependency) {
+  TaskRecorder recorder(2);
+  std::vector<InitTask> tasks;
+  tasks.push_back(recorder.MakeTask(0, "a", {}));
+  tasks.push_back(recorder.MakeTask(1, "b", {"x"}));
+  EXPECT_FALSE(InitTaskScheduler(2).Run(&tasks));
+  EXPECT_FALSE(tasks[0].started);
+  EXPECT_FALSE(tasks[1].started);
+}
+
+TEST(InitTaskSchedulerTest, RejectCyclicDependency) {
+  TaskRecorder recorder(4);
+  std::vector<InitTask> tasks;
+  tasks.push_back(recorder.MakeTask(0, "a", {}));
+  tasks.push_back(recorder.MakeTask(1, "b", {"a", "d"}));
+  tasks.push_back(recorder.MakeTask(2, "c", {"b"}));
+  tasks.push_back(recorder.MakeTask(3, "d", {"c"}));
+  EXPECT_FALSE(InitTaskScheduler(2).Run(&tasks));
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    EXPECT_FALSE(tasks[i].started);
+    EXPECT_EQ(-1, recorder.start_seq(i));
+  }
+}
+
+}  // namespace mainboard
+}  // namespace cyber
+}  // namespace apollo
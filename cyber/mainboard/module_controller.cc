@@ -61,6 +61,8 @@ bool ModuleController::LoadAll() {
     total_component_nums += scheduler::Instance()->TaskPoolSize();
   }
   common::GlobalData::Instance()->SetComponentNums(total_component_nums);
+  init_tasks_.clear();
+  flag_file_paths_.clear();
   for (auto module_path : paths) {
     AINFO << "Start initialize dag: " << module_path;
     if (!LoadModule(module_path)) {
@@ -68,7 +70,7 @@ bool ModuleController::LoadAll() {
       return false;
     }
   }
-  return true;
+  return InitComponents();
 }
 
 bool ModuleController::LoadModule(const DagConfig& dag_config) {
@@ -90,29 +92,65 @@ bool ModuleController::LoadModule(const DagConfig& dag_config) {
 
     class_loader_manager_.LoadLibrary(load_path);
 
+    // the components are created and initialized later in InitComponents,
+    // which may run them concurrently
     for (auto& component : module_config.components()) {
-      const std::string& class_name = component.class_name();
-      std::shared_ptr<ComponentBase> base =
-          class_loader_manager_.CreateClassObj<ComponentBase>(class_name);
-      if (base == nullptr || !base->Initialize(component.config())) {
-        return false;
-      }
-      component_list_.emplace_back(std::move(base));
+      AddInitTask(component);
     }
 
     for (auto& component : module_config.timer_components()) {
-      const std::string& class_name = component.class_name();
-      std::shared_ptr<ComponentBase> base =
-          class_loader_manager_.CreateClassObj<ComponentBase>(class_name);
-      if (base == nullptr || !base->Initialize(component.config())) {
-        return false;
-      }
-      component_list_.emplace_back(std::move(base));
+      AddInitTask(component);
     }
   }
   return true;
 }
 
+template <typename ComponentInfo>
+void ModuleController::AddInitTask(const ComponentInfo& component) {
+  InitTask task;
+  task.name = component.config().name();
+  task.class_name = component.class_name();
+  task.depends.assign(component.depends().begin(), component.depends().end());
+  const size_t index = init_tasks_.size();
+  auto class_name = component.class_name();
+  auto config = component.config();
+  task.run = [this, index, class_name, config]() {
+    std::shared_ptr<ComponentBase> base =
+        class_loader_manager_.CreateClassObj<ComponentBase>(class_name);
+    if (base == nullptr) {
+      return false;
+    }
+    init_components_[index] = base;
+    return base->Initialize(config);
+  };
+  init_tasks_.emplace_back(std::move(task));
+  if (!config.flag_file_path().empty()) {
+    flag_file_paths_.push_back(config.flag_file_path());
+  }
+}
+
+bool ModuleController::InitComponents() {
+  // gflags is not thread safe, so the flag files are loaded here in dag
+  // order and skipped by the concurrent Initialize calls
+  for (auto& flag_file_path : flag_file_paths_) {
+    ComponentBase::PreloadFlagFile(flag_file_path);
+  }
+
+  init_components_.assign(init_tasks_.size(), nullptr);
+  InitTaskScheduler scheduler(args_.GetInitThreadNum());
+  bool success = scheduler.Run(&init_tasks_);
+
+  // keep the declaration order so that Clear shuts them down as before
+  for (auto& component : init_components_) {
+    if (component != nullptr) {
+      component_list_.emplace_back(component);
+    }
+  }
+  init_components_.clear();
+  init_tasks_.clear();
+  return success;
+}
+
 bool ModuleController::LoadModule(const std::string& path) {
   DagConfig dag_config;
   if (!common::GetProtoFromFile(path, &dag_config)) {
@@ -24,6 +24,7 @@
 
 #include "cyber/class_loader/class_loader_manager.h"
 #include "cyber/component/component.h"
+#include "cyber/mainboard/init_task_scheduler.h"
 #include "cyber/mainboard/module_argument.h"
 
 namespace apollo {
@@ -44,6 +45,9 @@ class ModuleController {
  private:
   bool LoadModule(const std::string& path);
   bool LoadModule(const DagConfig& dag_config);
+  template <typename ComponentInfo>
+  void AddInitTask(const ComponentInfo& component);
+  bool InitComponents();
   int GetComponentNum(const std::string& path);
   int total_component_nums = 0;
   bool has_timer_component = false;
@@ -51,6 +55,10 @@ class ModuleController {
   ModuleArgument args_;
   class_loader::ClassLoaderManager class_loader_manager_;
   std::vector<std::shared_ptr<ComponentBase>> component_list_;
+  std::vector<InitTask> init_tasks_;
+  // the components created by init_tasks_, at the same index
+  std::vector<std::shared_ptr<ComponentBase>> init_components_;
+  std::vector<std::string> flag_file_paths_;
 };
 
 inline ModuleController::ModuleController(const ModuleArgument& args)
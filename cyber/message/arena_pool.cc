@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/message/arena_pool.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+using google::protobuf::Arena;
+using google::protobuf::ArenaOptions;
+
+ArenaPool::ArenaPool() {}
+
+ArenaPool::~ArenaPool() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto entry : idle_entries_) {
+    delete entry;
+  }
+  idle_entries_.clear();
+}
+
+std::shared_ptr<Arena> ArenaPool::Acquire() {
+  Entry* entry = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!idle_entries_.empty()) {
+      entry = idle_entries_.back();
+      idle_entries_.pop_back();
+    }
+  }
+
+  if (entry == nullptr) {
+    entry = new Entry();
+    entry->initial_block.reset(new char[kInitialBlockSize]);
+    ArenaOptions options;
+    options.initial_block = entry->initial_block.get();
+    options.initial_block_size = kInitialBlockSize;
+    entry->arena.reset(new Arena(options));
+  }
+
+  return std::shared_ptr<Arena>(entry->arena.get(),
+                                [this, entry](Arena*) { Release(entry); });
+}
+
+size_t ArenaPool::IdleSize() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return idle_entries_.size();
+}
+
+void ArenaPool::Release(Entry* entry) {
+  // runs the destructors of the messages and keeps only the initial block
+  entry->arena->Reset();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (idle_entries_.size() < kMaxIdleArenaNum) {
+      idle_entries_.push_back(entry);
+      return;
+    }
+  }
+  delete entry;
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
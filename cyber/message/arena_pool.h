@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_MESSAGE_ARENA_POOL_H_
+#define CYBER_MESSAGE_ARENA_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "google/protobuf/arena.h"
+#include "google/protobuf/message.h"
+
+#include "cyber/common/macros.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+/**
+ * @class ArenaPool
+ * @brief Recycles protobuf arenas for received messages. Every arena owns an
+ * initial block which survives Reset(), so a recycled arena parses a message
+ * of similar size without touching malloc.
+ */
+class ArenaPool {
+ public:
+  static const size_t kInitialBlockSize = 128 * 1024;
+  static const size_t kMaxIdleArenaNum = 32;
+
+  ~ArenaPool();
+
+  /**
+   * @brief Get an empty arena. It is reset and given back to the pool when
+   * the last reference is dropped.
+   */
+  std::shared_ptr<google::protobuf::Arena> Acquire();
+
+  size_t IdleSize();
+
+ private:
+  struct Entry {
+    std::unique_ptr<char[]> initial_block;
+    std::unique_ptr<google::protobuf::Arena> arena;
+  };
+
+  void Release(Entry* entry);
+
+  std::mutex mutex_;
+  std::vector<Entry*> idle_entries_;
+
+  DECLARE_SINGLETON(ArenaPool)
+};
+
+template <typename T>
+struct IsArenaMessage
+    : std::integral_constant<
+          bool, std::is_base_of<google::protobuf::Message, T>::value &&
+                    google::protobuf::Arena::is_arena_constructable<T>::value> {
+};
+
+/**
+ * @brief Create a protobuf message on a pooled arena. The returned pointer
+ * shares the ownership of the arena, which is recycled together with the
+ * message. Messages whose proto file does not set cc_enable_arenas, and
+ * non-protobuf messages, are created on the heap.
+ */
+template <typename T>
+typename std::enable_if<IsArenaMessage<T>::value, std::shared_ptr<T>>::type
+CreateArenaMessage() {
+  auto arena = ArenaPool::Instance()->Acquire();
+  T* msg = google::protobuf::Arena::CreateMessage<T>(arena.get());
+  return std::shared_ptr<T>(arena, msg);
+}
+
+template <typename T>
+typename std::enable_if<!IsArenaMessage<T>::value, std::shared_ptr<T>>::type
+CreateArenaMessage() {
+  return std::make_shared<T>();
+}
+
+template <typename T>
+std::shared_ptr<T> CreateMessage(bool arena_allocation) {
+  if (arena_allocation) {
+    return CreateArenaMessage<T>();
+  }
+  return std::make_shared<T>();
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_MESSAGE_ARENA_POOL_H_
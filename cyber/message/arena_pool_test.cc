@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/message/arena_pool.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "cyber/message/message_traits.h"
+#include "cyber/message/raw_message.h"
+#include "cyber/proto/role_attributes.pb.h"
+#include "cyber/proto/unit_test.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace message {
+
+TEST(ArenaPoolTest, recycle) {
+  auto pool = ArenaPool::Instance();
+  {
+    auto arena = pool->Acquire();
+    EXPECT_NE(arena, nullptr);
+  }
+  size_t idle_size = pool->IdleSize();
+  EXPECT_GE(idle_size, 1);
+
+  {
+    auto msg = CreateArenaMessage<proto::Chatter>();
+    EXPECT_EQ(pool->IdleSize(), idle_size - 1);
+    msg->set_seq(1);
+    msg->set_content("arena");
+
+    auto copy = msg;
+    msg = nullptr;
+    EXPECT_EQ(pool->IdleSize(), idle_size - 1);
+    EXPECT_EQ(copy->content(), "arena");
+  }
+  EXPECT_EQ(pool->IdleSize(), idle_size);
+}
+
+TEST(ArenaPoolTest, parse) {
+  proto::Chatter chatter;
+  chatter.set_timestamp(123);
+  chatter.set_seq(456);
+  chatter.set_content(std::string(1024, 'a'));
+  std::string str;
+  EXPECT_TRUE(SerializeToString(chatter, &str));
+
+  auto msg = CreateMessage<proto::Chatter>(true);
+  EXPECT_TRUE(ParseFromString(str, msg.get()));
+  EXPECT_EQ(msg->timestamp(), 123);
+  EXPECT_EQ(msg->seq(), 456);
+  EXPECT_EQ(msg->content(), chatter.content());
+
+  EXPECT_NE(msg->GetArena(), nullptr);
+
+  // non-protobuf messages fall back to the heap
+  auto raw_msg = CreateMessage<RawMessage>(true);
+  EXPECT_TRUE(ParseFromString(str, raw_msg.get()));
+  EXPECT_EQ(raw_msg->message, str);
+}
+
+TEST(ArenaPoolTest, not_arena_constructable) {
+  // role_attributes.proto does not enable arenas
+  auto pool = ArenaPool::Instance();
+  size_t idle_size = pool->IdleSize();
+  auto msg = CreateMessage<proto::RoleAttributes>(true);
+  msg->set_channel_name("heap");
+  EXPECT_EQ(msg->channel_name(), "heap");
+  if (!google::protobuf::Arena::is_arena_constructable<
+          proto::RoleAttributes>::value) {
+    EXPECT_EQ(msg->GetArena(), nullptr);
+    EXPECT_EQ(pool->IdleSize(), idle_size);
+  }
+}
+
+}  // namespace message
+}  // namespace cyber
+}  // namespace apollo
@@ -30,6 +30,7 @@ ProtobufFactory::ProtobufFactory() {
 }
 
 ProtobufFactory::~ProtobufFactory() {
+  prototypes_.clear();
   factory_.reset();
   pool_.reset();
 }
@@ -156,26 +157,45 @@ void ProtobufFactory::GetDescriptorString(const std::string& type,
 // Internal method
 google::protobuf::Message* ProtobufFactory::GenerateMessageByType(
     const std::string& type) const {
-  google::protobuf::Message* message = GetMessageByGeneratedType(type);
-  if (message != nullptr) {
-    return message;
+  auto prototype = GetPrototype(type);
+  if (prototype == nullptr) {
+    return nullptr;
   }
+  return prototype->New();
+}
 
-  const google::protobuf::Descriptor* descriptor =
-      pool_->FindMessageTypeByName(type);
-  if (descriptor == nullptr) {
-    AERROR << "cannot find [" << type << "] descriptor";
-    return nullptr;
+const google::protobuf::Message* ProtobufFactory::GetPrototype(
+    const std::string& type) const {
+  {
+    std::lock_guard<std::mutex> lock(prototype_mutex_);
+    auto it = prototypes_.find(type);
+    if (it != prototypes_.end()) {
+      return it->second;
+    }
+  }
+
+  const google::protobuf::Message* prototype = nullptr;
+  auto descriptor =
+      DescriptorPool::generated_pool()->FindMessageTypeByName(type);
+  if (descriptor != nullptr) {
+    prototype = MessageFactory::generated_factory()->GetPrototype(descriptor);
+  } else {
+    descriptor = pool_->FindMessageTypeByName(type);
+    if (descriptor == nullptr) {
+      AERROR << "cannot find [" << type << "] descriptor";
+      return nullptr;
+    }
+    prototype = factory_->GetPrototype(descriptor);
   }
 
-  const google::protobuf::Message* prototype =
-      factory_->GetPrototype(descriptor);
   if (prototype == nullptr) {
     AERROR << "cannot find [" << type << "] prototype";
     return nullptr;
   }
 
-  return prototype->New();
+  std::lock_guard<std::mutex> lock(prototype_mutex_);
+  prototypes_[type] = prototype;
+  return prototype;
 }
 
 google::protobuf::Message* ProtobufFactory::GetMessageByGeneratedType(
@@ -21,6 +21,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "google/protobuf/compiler/parser.h"
 #include "google/protobuf/descriptor.h"
@@ -100,6 +101,7 @@ class ProtobufFactory {
   bool RegisterMessage(const ProtoDesc& proto_desc);
   google::protobuf::Message* GetMessageByGeneratedType(
       const std::string& type) const;
+  const google::protobuf::Message* GetPrototype(const std::string& type) const;
   static bool GetProtoDesc(const FileDescriptor* file_desc,
                            ProtoDesc* proto_desc);
 
@@ -107,6 +109,12 @@ class ProtobufFactory {
   std::unique_ptr<DescriptorPool> pool_ = nullptr;
   std::unique_ptr<DynamicMessageFactory> factory_ = nullptr;
 
+  // prototypes are immutable once created, cache them to skip the descriptor
+  // lookups on every conversion
+  mutable std::mutex prototype_mutex_;
+  mutable std::unordered_map<std::string, const google::protobuf::Message*>
+      prototypes_;
+
   DECLARE_SINGLETON(ProtobufFactory);
 };
 
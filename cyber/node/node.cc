@@ -46,5 +46,10 @@ void Node::ClearData() {
   }
 }
 
+bool Node::DeleteReader(const std::string& channel_name) {
+  std::lock_guard<std::mutex> lg(readers_mutex_);
+  return readers_.erase(channel_name) > 0;
+}
+
 }  // namespace cyber
 }  // namespace apollo
@@ -160,6 +160,15 @@ class Node {
    */
   void ClearData();
 
+  /**
+   * @brief Remove the Reader that subscribes `channel_name` from the node,
+   * so that the channel can be subscribed again
+   *
+   * @param channel_name channel name
+   * @return true if the reader existed
+   */
+  bool DeleteReader(const std::string& channel_name);
+
   /**
    * @brief Get the Reader object that subscribe `channel_name`
    *
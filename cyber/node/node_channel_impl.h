@@ -44,11 +44,13 @@ struct ReaderConfig {  ///< configurations for a Reader
     qos_profile.set_durability(proto::QosDurabilityPolicy::DURABILITY_VOLATILE);
 
     pending_queue_size = DEFAULT_PENDING_QUEUE_SIZE;
+    arena_allocation = false;
   }
   ReaderConfig(const ReaderConfig& other)
       : channel_name(other.channel_name),
         qos_profile(other.qos_profile),
-        pending_queue_size(other.pending_queue_size) {}
+        pending_queue_size(other.pending_queue_size),
+        arena_allocation(other.arena_allocation) {}
 
   std::string channel_name;       //< channel reads
   proto::QosProfile qos_profile;  //< the qos configuration
@@ -57,6 +59,12 @@ struct ReaderConfig {  ///< configurations for a Reader
    * Older messages will dropped if you have no time to handle
    */
   uint32_t pending_queue_size;
+  /**
+   * @brief parse received protobuf messages into pooled arenas, which saves
+   * the allocations of deep messages. The receiver of a channel is shared in
+   * a process, so the first reader of the channel decides.
+   */
+  bool arena_allocation;
 };
 
 /**
@@ -194,6 +202,9 @@ auto NodeChannelImpl::CreateReader(const ReaderConfig& config,
   proto::RoleAttributes role_attr;
   role_attr.set_channel_name(config.channel_name);
   role_attr.mutable_qos_profile()->CopyFrom(config.qos_profile);
+  if (config.arena_allocation) {
+    role_attr.set_arena_allocation(true);
+  }
   return this->template CreateReader<MessageT>(role_attr, reader_func,
                                                config.pending_queue_size);
 }
@@ -16,15 +16,103 @@
 
 #include "cyber/parameter/parameter_client.h"
 
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "cyber/common/macros.h"
 #include "cyber/node/node.h"
 #include "cyber/parameter/parameter_service_names.h"
 
 namespace apollo {
 namespace cyber {
 
+using base::AtomicRWLock;
+using base::ReadLockGuard;
+using base::WriteLockGuard;
+
+namespace {
+
+using ChangeCallback =
+    std::function<void(const std::shared_ptr<proto::Param>&)>;
+
+// A node creates at most one reader of a channel, so the caching clients of
+// a node share the reader of a change channel.
+class ParameterChangeReaders {
+ public:
+  std::shared_ptr<Reader<proto::Param>> Subscribe(
+      const std::shared_ptr<Node>& node, const std::string& channel_name,
+      const void* client, const ChangeCallback& callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& subscription =
+        subscriptions_[std::make_pair(node.get(), channel_name)];
+    if (subscription == nullptr) {
+      subscription.reset(new Subscription());
+      auto raw_subscription = subscription.get();
+      subscription->reader = node->CreateReader<proto::Param>(
+          channel_name,
+          [raw_subscription](const std::shared_ptr<proto::Param>& param) {
+            raw_subscription->Dispatch(param);
+          });
+      if (subscription->reader == nullptr) {
+        subscriptions_.erase(std::make_pair(node.get(), channel_name));
+        return nullptr;
+      }
+    }
+    std::lock_guard<std::mutex> callbacks_lock(subscription->mutex);
+    subscription->callbacks[client] = callback;
+    return subscription->reader;
+  }
+
+  void Unsubscribe(const std::shared_ptr<Node>& node,
+                   const std::string& channel_name, const void* client) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = subscriptions_.find(std::make_pair(node.get(), channel_name));
+    if (it == subscriptions_.end()) {
+      return;
+    }
+    auto& subscription = it->second;
+    {
+      std::lock_guard<std::mutex> callbacks_lock(subscription->mutex);
+      subscription->callbacks.erase(client);
+      if (!subscription->callbacks.empty()) {
+        return;
+      }
+    }
+    subscription->reader->Shutdown();
+    node->DeleteReader(channel_name);
+    subscriptions_.erase(it);
+  }
+
+ private:
+  struct Subscription {
+    void Dispatch(const std::shared_ptr<proto::Param>& param) {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (auto& item : callbacks) {
+        item.second(param);
+      }
+    }
+
+    std::shared_ptr<Reader<proto::Param>> reader;
+    std::mutex mutex;
+    std::unordered_map<const void*, ChangeCallback> callbacks;
+  };
+
+  std::mutex mutex_;
+  std::map<std::pair<const Node*, std::string>, std::unique_ptr<Subscription>>
+      subscriptions_;
+
+  DECLARE_SINGLETON(ParameterChangeReaders)
+};
+
+ParameterChangeReaders::ParameterChangeReaders() {}
+
+}  // namespace
+
 ParameterClient::ParameterClient(const std::shared_ptr<Node>& node,
-                                 const std::string& service_node_name)
-    : node_(node) {
+                                 const std::string& service_node_name,
+                                 bool enable_cache)
+    : node_(node), enable_cache_(enable_cache) {
   get_parameter_client_ = node_->CreateClient<ParamName, Param>(
       FixParameterServiceName(service_node_name, GET_PARAMETER_SERVICE_NAME));
 
@@ -33,10 +121,42 @@ ParameterClient::ParameterClient(const std::shared_ptr<Node>& node,
 
   list_parameters_client_ = node_->CreateClient<NodeName, Params>(
       FixParameterServiceName(service_node_name, LIST_PARAMETERS_SERVICE_NAME));
+
+  if (enable_cache_) {
+    parameter_change_reader_ = ParameterChangeReaders::Instance()->Subscribe(
+        node_,
+        FixParameterServiceName(service_node_name,
+                                PARAMETER_CHANGE_CHANNEL_NAME),
+        this, [this](const std::shared_ptr<Param>& param) {
+          OnParameterChange(param);
+        });
+    if (parameter_change_reader_ == nullptr) {
+      AERROR << "Failed to subscribe parameter changes of "
+             << service_node_name << ", cache disabled.";
+      enable_cache_ = false;
+    }
+  }
+}
+
+ParameterClient::~ParameterClient() {
+  if (parameter_change_reader_ != nullptr) {
+    ParameterChangeReaders::Instance()->Unsubscribe(
+        node_, parameter_change_reader_->GetChannelName(), this);
+    parameter_change_reader_ = nullptr;
+  }
 }
 
 bool ParameterClient::GetParameter(const std::string& param_name,
                                    Parameter* parameter) {
+  if (enable_cache_ && IsCacheSynced()) {
+    ReadLockGuard<AtomicRWLock> lock(cache_lock_);
+    auto it = cache_.find(param_name);
+    if (it != cache_.end()) {
+      parameter->FromProtoParam(it->second);
+      return true;
+    }
+  }
+
   auto request = std::make_shared<ParamName>();
   request->set_value(param_name);
   auto response = get_parameter_client_->SendRequest(request);
@@ -48,6 +168,15 @@ bool ParameterClient::GetParameter(const std::string& param_name,
     AWARN << "Parameter " << param_name << " not exists yet.";
     return false;
   }
+  if (enable_cache_) {
+    Param latest;
+    {
+      WriteLockGuard<AtomicRWLock> lock(cache_lock_);
+      UpdateCache(*response, &latest);
+    }
+    parameter->FromProtoParam(latest);
+    return true;
+  }
   parameter->FromProtoParam(*response);
   return true;
 }
@@ -59,6 +188,11 @@ bool ParameterClient::SetParameter(const Parameter& parameter) {
     AERROR << "Call " << set_parameter_client_->ServiceName() << " failed";
     return false;
   }
+  if (enable_cache_ && response->value()) {
+    // got from the server until the change arrives
+    WriteLockGuard<AtomicRWLock> lock(cache_lock_);
+    cache_.erase(parameter.Name());
+  }
   return response->value();
 }
 
@@ -78,5 +212,96 @@ bool ParameterClient::ListParameters(std::vector<Parameter>* parameters) {
   return true;
 }
 
+bool ParameterClient::RegisterCallback(const std::string& param_name,
+                                       const ParameterCallback& callback) {
+  if (!enable_cache_) {
+    AERROR << "Parameter cache is not enabled, cannot watch " << param_name;
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(callbacks_mutex_);
+  callbacks_[param_name].emplace_back(callback);
+  return true;
+}
+
+void ParameterClient::OnParameterChange(const std::shared_ptr<Param>& param) {
+  {
+    WriteLockGuard<AtomicRWLock> lock(cache_lock_);
+    if (param->seq() > last_seq_ + 1) {
+      // a change before this one is lost
+      is_synced_ = false;
+    }
+    last_seq_ = std::max(last_seq_, param->seq());
+    UpdateCache(*param);
+  }
+
+  std::vector<ParameterCallback> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(callbacks_mutex_);
+    auto it = callbacks_.find(param->name());
+    if (it == callbacks_.end()) {
+      return;
+    }
+    callbacks = it->second;
+  }
+  Parameter parameter;
+  parameter.FromProtoParam(*param);
+  for (auto& callback : callbacks) {
+    callback(parameter);
+  }
+}
+
+bool ParameterClient::IsCacheSynced() {
+  {
+    ReadLockGuard<AtomicRWLock> lock(cache_lock_);
+    if (is_synced_) {
+      return true;
+    }
+  }
+  if (!parameter_change_reader_->HasWriter()) {
+    return false;
+  }
+  return Resync();
+}
+
+bool ParameterClient::Resync() {
+  if (!list_parameters_client_->ServiceIsReady()) {
+    return false;
+  }
+  auto request = std::make_shared<NodeName>();
+  request->set_value(node_->Name());
+  auto response = list_parameters_client_->SendRequest(request);
+  if (response == nullptr) {
+    AERROR << "Call " << list_parameters_client_->ServiceName() << " failed";
+    return false;
+  }
+
+  WriteLockGuard<AtomicRWLock> lock(cache_lock_);
+  uint64_t seq = 0;
+  for (auto& param : response->param()) {
+    UpdateCache(param);
+    seq = std::max(seq, param.seq());
+  }
+  // the changes before one received during the list may be lost, check
+  // again on the next get
+  if (last_seq_ > seq) {
+    return false;
+  }
+  last_seq_ = seq;
+  is_synced_ = true;
+  return true;
+}
+
+void ParameterClient::UpdateCache(const Param& param, Param* latest) {
+  auto it = cache_.find(param.name());
+  if (it == cache_.end()) {
+    it = cache_.emplace(param.name(), param).first;
+  } else if (it->second.seq() < param.seq()) {
+    it->second = param;
+  }
+  if (latest != nullptr) {
+    *latest = it->second;
+  }
+}
+
 }  // namespace cyber
 }  // namespace apollo
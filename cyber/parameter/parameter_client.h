@@ -17,12 +17,17 @@
 #ifndef CYBER_PARAMETER_PARAMETER_CLIENT_H_
 #define CYBER_PARAMETER_PARAMETER_CLIENT_H_
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "cyber/proto/parameter.pb.h"
 
+#include "cyber/base/atomic_rw_lock.h"
+#include "cyber/node/reader.h"
 #include "cyber/parameter/parameter.h"
 #include "cyber/service/client.h"
 
@@ -34,7 +39,10 @@ class Node;
 /**
  * @class ParameterClient
  * @brief Parameter Client is used to set/get/list parameter(s)
- * by sending a request to ParameterServer
+ * by sending a request to ParameterServer. With cache enabled, the client
+ * subscribes the parameter changes of ParameterServer, and GetParameter is
+ * served from local memory while the cache has seen every change. The
+ * caching clients of a node share one reader of the change channel
  */
 class ParameterClient {
  public:
@@ -46,14 +54,23 @@ class ParameterClient {
   using GetParameterClient = Client<ParamName, Param>;
   using SetParameterClient = Client<Param, BoolResult>;
   using ListParametersClient = Client<NodeName, Params>;
+  using ParameterCallback = std::function<void(const Parameter&)>;
   /**
    * @brief Construct a new ParameterClient object
    *
    * @param node shared_ptr of the node handler
    * @param service_node_name node name which provide a param services
+   * @param enable_cache serve reads from a local cache kept up to date by
+   * the parameter change channel
    */
   ParameterClient(const std::shared_ptr<Node>& node,
-                  const std::string& service_node_name);
+                  const std::string& service_node_name,
+                  bool enable_cache = false);
+
+  /**
+   * @brief Destroy the ParameterClient object
+   */
+  virtual ~ParameterClient();
 
   /**
    * @brief Get the Parameter object
@@ -85,11 +102,42 @@ class ParameterClient {
    */
   bool ListParameters(std::vector<Parameter>* parameters);
 
+  /**
+   * @brief Register a callback called whenever the parameter changes
+   *
+   * @param param_name name of the parameter to watch
+   * @param callback called with the new value, in the reader's coroutine
+   * @return true
+   * @return false cache is not enabled
+   */
+  bool RegisterCallback(const std::string& param_name,
+                        const ParameterCallback& callback);
+
  private:
+  void OnParameterChange(const std::shared_ptr<Param>& param);
+  // true if every change is in the cache, changes published before the
+  // change reader connects or lost on the way are caught up by a resync
+  bool IsCacheSynced();
+  bool Resync();
+  // keeps the newer of the cached and the given parameter, a reply of the
+  // server may be older than a change received meanwhile. cache_lock_ must
+  // be held
+  void UpdateCache(const Param& param, Param* latest = nullptr);
+
   std::shared_ptr<Node> node_;
   std::shared_ptr<GetParameterClient> get_parameter_client_;
   std::shared_ptr<SetParameterClient> set_parameter_client_;
   std::shared_ptr<ListParametersClient> list_parameters_client_;
+
+  bool enable_cache_ = false;
+  std::shared_ptr<Reader<Param>> parameter_change_reader_;
+  base::AtomicRWLock cache_lock_;
+  std::unordered_map<std::string, Param> cache_;
+  // seq of the latest change received
+  uint64_t last_seq_ = 0;
+  bool is_synced_ = false;
+  std::mutex callbacks_mutex_;
+  std::unordered_map<std::string, std::vector<ParameterCallback>> callbacks_;
 };
 
 }  // namespace cyber
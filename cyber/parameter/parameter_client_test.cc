@@ -16,7 +16,10 @@
 
 #include "cyber/parameter/parameter_client.h"
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -26,6 +29,7 @@
 #include "cyber/init.h"
 #include "cyber/message/protobuf_factory.h"
 #include "cyber/parameter/parameter_server.h"
+#include "cyber/parameter/parameter_service_names.h"
 
 namespace apollo {
 namespace cyber {
@@ -88,5 +92,173 @@ TEST_F(ParameterClientTest, list_parameter) {
   EXPECT_FALSE(pc_->ListParameters(&parameters));
 }
 
+TEST_F(ParameterClientTest, cached_parameter) {
+  std::unique_ptr<ParameterClient> cached_pc(
+      new ParameterClient(node_, "parameter_server", true));
+  ps_->SetParameter(Parameter("int", 1));
+  Parameter parameter;
+  EXPECT_TRUE(cached_pc->GetParameter("int", &parameter));
+  EXPECT_EQ(1, parameter.AsInt64());
+
+  int64_t changed_value = 0;
+  EXPECT_TRUE(cached_pc->RegisterCallback(
+      "int", [&changed_value](const Parameter& changed) {
+        changed_value = changed.AsInt64();
+      }));
+  ps_->SetParameter(Parameter("int", 2));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(2, changed_value);
+
+  // served from the cache without the server
+  ps_.reset();
+  EXPECT_TRUE(cached_pc->GetParameter("int", &parameter));
+  EXPECT_EQ(2, parameter.AsInt64());
+  EXPECT_FALSE(cached_pc->GetParameter("double", &parameter));
+
+  EXPECT_FALSE(pc_->RegisterCallback("int", nullptr));
+}
+
+TEST_F(ParameterClientTest, cached_parameter_changed_during_get) {
+  // replies the value before a change it publishes while the reply is slow
+  auto slow_node = CreateNode("slow_parameter_server");
+  auto change_writer = slow_node->CreateWriter<proto::Param>(
+      FixParameterServiceName("slow_parameter_server",
+                              PARAMETER_CHANGE_CHANNEL_NAME));
+  auto get_service = slow_node->CreateService<proto::ParamName, proto::Param>(
+      FixParameterServiceName("slow_parameter_server",
+                              GET_PARAMETER_SERVICE_NAME),
+      [change_writer](const std::shared_ptr<proto::ParamName>& request,
+                      std::shared_ptr<proto::Param>& response) {
+        response->CopyFrom(Parameter(request->value(), 1).ToProtoParam());
+        response->set_seq(1);
+        auto change = Parameter(request->value(), 2).ToProtoParam();
+        change.set_seq(2);
+        change_writer->Write(change);
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      });
+  std::unique_ptr<ParameterClient> cached_pc(
+      new ParameterClient(node_, "slow_parameter_server", true));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  Parameter parameter;
+  EXPECT_TRUE(cached_pc->GetParameter("int", &parameter));
+  // the stale reply does not overwrite the change
+  EXPECT_TRUE(cached_pc->GetParameter("int", &parameter));
+  EXPECT_EQ(2, parameter.AsInt64());
+}
+
+TEST_F(ParameterClientTest, cached_parameter_shared_reader) {
+  std::unique_ptr<ParameterClient> cached_pc_0(
+      new ParameterClient(node_, "parameter_server", true));
+  std::unique_ptr<ParameterClient> cached_pc_1(
+      new ParameterClient(node_, "parameter_server", true));
+  int64_t changed_value_0 = 0;
+  int64_t changed_value_1 = 0;
+  EXPECT_TRUE(cached_pc_0->RegisterCallback(
+      "int", [&changed_value_0](const Parameter& changed) {
+        changed_value_0 = changed.AsInt64();
+      }));
+  EXPECT_TRUE(cached_pc_1->RegisterCallback(
+      "int", [&changed_value_1](const Parameter& changed) {
+        changed_value_1 = changed.AsInt64();
+      }));
+  ps_->SetParameter(Parameter("int", 1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(1, changed_value_0);
+  EXPECT_EQ(1, changed_value_1);
+
+  cached_pc_0.reset();
+  ps_->SetParameter(Parameter("int", 2));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(2, changed_value_1);
+
+  // the reader is created again once the last client is gone
+  cached_pc_1.reset();
+  cached_pc_0.reset(new ParameterClient(node_, "parameter_server", true));
+  EXPECT_TRUE(cached_pc_0->RegisterCallback(
+      "int", [&changed_value_0](const Parameter& changed) {
+        changed_value_0 = changed.AsInt64();
+      }));
+  ps_->SetParameter(Parameter("int", 3));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(3, changed_value_0);
+}
+
+TEST_F(ParameterClientTest, cached_parameter_resync) {
+  // a server whose changes are published or lost at will
+  const std::string server_name = "lossy_parameter_server";
+  auto server_node = CreateNode(server_name);
+  std::mutex params_mutex;
+  std::map<std::string, proto::Param> params;
+  uint64_t seq = 0;
+  std::shared_ptr<Writer<proto::Param>> change_writer;
+  auto set_parameter = [&](const Parameter& parameter, bool publish) {
+    std::lock_guard<std::mutex> lock(params_mutex);
+    auto param = parameter.ToProtoParam();
+    param.set_seq(++seq);
+    params[param.name()] = param;
+    if (publish) {
+      change_writer->Write(param);
+    }
+  };
+  auto get_service = server_node->CreateService<proto::ParamName,
+                                                proto::Param>(
+      FixParameterServiceName(server_name, GET_PARAMETER_SERVICE_NAME),
+      [&](const std::shared_ptr<proto::ParamName>& request,
+          std::shared_ptr<proto::Param>& response) {
+        std::lock_guard<std::mutex> lock(params_mutex);
+        auto it = params.find(request->value());
+        if (it != params.end()) {
+          response->CopyFrom(it->second);
+        }
+      });
+  auto list_service = server_node->CreateService<proto::NodeName,
+                                                 proto::Params>(
+      FixParameterServiceName(server_name, LIST_PARAMETERS_SERVICE_NAME),
+      [&](const std::shared_ptr<proto::NodeName>& request,
+          std::shared_ptr<proto::Params>& response) {
+        std::lock_guard<std::mutex> lock(params_mutex);
+        for (auto& item : params) {
+          response->add_param()->CopyFrom(item.second);
+        }
+      });
+  set_parameter(Parameter("int", 1), false);
+
+  std::unique_ptr<ParameterClient> cached_pc(
+      new ParameterClient(node_, server_name, true));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  Parameter parameter;
+  EXPECT_TRUE(cached_pc->GetParameter("int", &parameter));
+  EXPECT_EQ(1, parameter.AsInt64());
+
+  // the change reader is not connected, so the server is asked
+  set_parameter(Parameter("int", 2), false);
+  EXPECT_TRUE(cached_pc->GetParameter("int", &parameter));
+  EXPECT_EQ(2, parameter.AsInt64());
+
+  // connected, resynced and kept up to date
+  change_writer = server_node->CreateWriter<proto::Param>(
+      FixParameterServiceName(server_name, PARAMETER_CHANGE_CHANNEL_NAME));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_TRUE(cached_pc->GetParameter("int", &parameter));
+  EXPECT_EQ(2, parameter.AsInt64());
+  set_parameter(Parameter("int", 3), true);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_TRUE(cached_pc->GetParameter("int", &parameter));
+  EXPECT_EQ(3, parameter.AsInt64());
+
+  // a lost change is served from the cache until the next change shows the
+  // gap
+  set_parameter(Parameter("int", 4), false);
+  EXPECT_TRUE(cached_pc->GetParameter("int", &parameter));
+  EXPECT_EQ(3, parameter.AsInt64());
+  set_parameter(Parameter("double", 1.0), true);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_TRUE(cached_pc->GetParameter("int", &parameter));
+  EXPECT_EQ(4, parameter.AsInt64());
+  EXPECT_TRUE(cached_pc->GetParameter("double", &parameter));
+  EXPECT_DOUBLE_EQ(1.0, parameter.AsDouble());
+}
+
 }  // namespace cyber
 }  // namespace apollo
@@ -18,13 +18,19 @@
 #include "cyber/common/log.h"
 #include "cyber/node/node.h"
 #include "cyber/parameter/parameter_service_names.h"
+#include "cyber/time/time.h"
 
 namespace apollo {
 namespace cyber {
 
 ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
     : node_(node) {
+  // a restarted server continues above the changes of the previous one
+  change_seq_ = Time::Now().ToNanosecond();
   auto name = node_->Name();
+  parameter_change_writer_ = node_->CreateWriter<Param>(
+      FixParameterServiceName(name, PARAMETER_CHANGE_CHANNEL_NAME));
+
   get_parameter_service_ = node_->CreateService<ParamName, Param>(
       FixParameterServiceName(name, GET_PARAMETER_SERVICE_NAME),
       [this](const std::shared_ptr<ParamName>& request,
@@ -41,8 +47,7 @@ ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
       FixParameterServiceName(name, SET_PARAMETER_SERVICE_NAME),
       [this](const std::shared_ptr<Param>& request,
              std::shared_ptr<BoolResult>& response) {
-        std::lock_guard<std::mutex> lock(param_map_mutex_);
-        param_map_[request->name()] = *request;
+        UpdateParameter(*request);
         response->set_value(true);
       });
 
@@ -59,8 +64,7 @@ ParameterServer::ParameterServer(const std::shared_ptr<Node>& node)
 }
 
 void ParameterServer::SetParameter(const Parameter& parameter) {
-  std::lock_guard<std::mutex> lock(param_map_mutex_);
-  param_map_[parameter.Name()] = parameter.ToProtoParam();
+  UpdateParameter(parameter.ToProtoParam());
 }
 
 bool ParameterServer::GetParameter(const std::string& parameter_name,
@@ -83,5 +87,14 @@ void ParameterServer::ListParameters(std::vector<Parameter>* parameters) {
   }
 }
 
+void ParameterServer::UpdateParameter(Param param) {
+  std::lock_guard<std::mutex> lock(param_map_mutex_);
+  param.set_seq(++change_seq_);
+  param_map_[param.name()] = param;
+  if (parameter_change_writer_ != nullptr) {
+    parameter_change_writer_->Write(param);
+  }
+}
+
 }  // namespace cyber
 }  // namespace apollo
@@ -25,6 +25,7 @@
 #include "cyber/proto/parameter.pb.h"
 
 #include "cyber/parameter/parameter.h"
+#include "cyber/node/writer.h"
 #include "cyber/service/service.h"
 
 namespace apollo {
@@ -39,6 +40,8 @@ class Node;
  * Routing, sensor internal/external references are set by Parameter Service
  * ParameterServer can set a parameter, and then you can get/list
  * paramter(s) by start a ParameterClient to send responding request
+ * Every change is also published on the parameter change channel, which
+ * keeps the caches of ParameterClients up to date
  * @warning You should only have one ParameterServer works
  */
 class ParameterServer {
@@ -80,13 +83,19 @@ class ParameterServer {
   void ListParameters(std::vector<Parameter>* parameters);
 
  private:
+  // numbers the change and publishes it while param_map_mutex_ is held, so
+  // that the changes are published in the order they are applied
+  void UpdateParameter(Param param);
+
   std::shared_ptr<Node> node_;
   std::shared_ptr<Service<ParamName, Param>> get_parameter_service_;
   std::shared_ptr<Service<Param, BoolResult>> set_parameter_service_;
   std::shared_ptr<Service<NodeName, Params>> list_parameters_service_;
+  std::shared_ptr<Writer<Param>> parameter_change_writer_;
 
   std::mutex param_map_mutex_;
   std::unordered_map<std::string, Param> param_map_;
+  uint64_t change_seq_ = 0;
 };
 
 }  // namespace cyber
@@ -0,0 +1,214 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "cyber/service_discovery/communication/topology_cache.h"
+
+#include <signal.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "cyber/common/global_data.h"
+#include "cyber/common/log.h"
+#include "cyber/common/util.h"
+
+namespace apollo {
+namespace cyber {
+namespace service_discovery {
+
+using common::Hash;
+using proto::ChangeMsg;
+using proto::ChangeType;
+
+TopologyCache::TopologyCache(ChangeType change_type) {
+  key_ = static_cast<key_t>(
+      Hash("/apollo/cyber/service_discovery/topology_cache/" +
+           std::to_string(static_cast<int>(change_type))));
+  process_id_ = common::GlobalData::Instance()->ProcessId();
+}
+
+TopologyCache::~TopologyCache() { Shutdown(); }
+
+bool TopologyCache::Init() {
+  if (!is_shutdown_.load()) {
+    return true;
+  }
+  if (!OpenOrCreate()) {
+    AERROR << "fail to init topology cache.";
+    return false;
+  }
+  is_shutdown_.store(false);
+  return true;
+}
+
+void TopologyCache::Shutdown() {
+  if (is_shutdown_.exchange(true)) {
+    return;
+  }
+
+  // release the slots of this process so that they can be reused at once
+  for (uint32_t i = 0; i < kSlotNum; ++i) {
+    auto& slot = layout_->slots[i];
+    int32_t owner = process_id_;
+    slot.owner.compare_exchange_strong(owner, 0);
+  }
+
+  shmdt(managed_shm_);
+  managed_shm_ = nullptr;
+  layout_ = nullptr;
+}
+
+bool TopologyCache::Put(const ChangeMsg& msg) {
+  if (is_shutdown_.load()) {
+    return false;
+  }
+
+  ChangeMsg stripped(msg);
+  stripped.mutable_role_attr()->clear_proto_desc();
+  if (stripped.ByteSizeLong() > kSlotSize) {
+    ADEBUG << "change msg is too large for topology cache.";
+    return false;
+  }
+
+  for (uint32_t i = 0; i < kSlotNum; ++i) {
+    auto& slot = layout_->slots[i];
+    uint64_t version = slot.version.load(std::memory_order_acquire);
+    if (version & 1) {
+      continue;
+    }
+    int32_t owner = slot.owner.load(std::memory_order_acquire);
+    if (owner != 0 && IsAlive(owner)) {
+      continue;
+    }
+    // make the version odd before taking the owner, so that a reader never
+    // takes the data of the previous owner for the data of this process
+    if (!slot.version.compare_exchange_strong(version, version + 1,
+                                              std::memory_order_acq_rel)) {
+      continue;
+    }
+    if (!slot.owner.compare_exchange_strong(owner, process_id_,
+                                            std::memory_order_acq_rel)) {
+      slot.version.store(version + 2, std::memory_order_release);
+      continue;
+    }
+
+    slot.role_key = RoleKey(stripped);
+    slot.role_type = static_cast<int32_t>(stripped.role_type());
+    slot.size = static_cast<uint32_t>(stripped.ByteSizeLong());
+    stripped.SerializeToArray(slot.data, static_cast<int>(slot.size));
+    slot.version.store(version + 2, std::memory_order_release);
+    return true;
+  }
+
+  ADEBUG << "topology cache is full.";
+  return false;
+}
+
+void TopologyCache::Erase(const ChangeMsg& msg) {
+  if (is_shutdown_.load()) {
+    return;
+  }
+
+  uint64_t role_key = RoleKey(msg);
+  auto role_type = static_cast<int32_t>(msg.role_type());
+  for (uint32_t i = 0; i < kSlotNum; ++i) {
+    auto& slot = layout_->slots[i];
+    if (slot.owner.load(std::memory_order_acquire) != process_id_ ||
+        slot.role_key != role_key || slot.role_type != role_type) {
+      continue;
+    }
+    slot.version.fetch_add(2, std::memory_order_acq_rel);
+    slot.owner.store(0, std::memory_order_release);
+  }
+}
+
+void TopologyCache::GetAll(std::vector<ChangeMsg>* msgs) {
+  RETURN_IF_NULL(msgs);
+  if (is_shutdown_.load()) {
+    return;
+  }
+
+  std::string buf;
+  buf.reserve(kSlotSize);
+  for (uint32_t i = 0; i < kSlotNum; ++i) {
+    auto& slot = layout_->slots[i];
+    int32_t owner = slot.owner.load(std::memory_order_acquire);
+    if (owner == 0 || owner == process_id_ || !IsAlive(owner)) {
+      continue;
+    }
+
+    uint64_t version = slot.version.load(std::memory_order_acquire);
+    if (version & 1) {
+      continue;
+    }
+    uint32_t size = slot.size;
+    if (size > kSlotSize) {
+      continue;
+    }
+    buf.assign(slot.data, size);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.version.load(std::memory_order_relaxed) != version ||
+        slot.owner.load(std::memory_order_relaxed) != owner) {
+      continue;
+    }
+
+    ChangeMsg msg;
+    if (msg.ParseFromString(buf)) {
+      msgs->emplace_back(std::move(msg));
+    }
+  }
+}
+
+bool TopologyCache::OpenOrCreate() {
+  // a new segment is zero filled, which is a valid empty table
+  int shmid = shmget(key_, sizeof(Layout), 0644 | IPC_CREAT);
+  if (shmid == -1) {
+    AERROR << "create shm failed, error: " << strerror(errno);
+    return false;
+  }
+
+  managed_shm_ = shmat(shmid, nullptr, 0);
+  if (managed_shm_ == reinterpret_cast<void*>(-1)) {
+    AERROR << "attach shm failed, error: " << strerror(errno);
+    managed_shm_ = nullptr;
+    return false;
+  }
+
+  layout_ = reinterpret_cast<Layout*>(managed_shm_);
+  return true;
+}
+
+bool TopologyCache::IsAlive(int32_t pid) const {
+  return kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+uint64_t TopologyCache::RoleKey(const ChangeMsg& msg) {
+  auto& attr = msg.role_attr();
+  if (attr.has_id()) {
+    return attr.id();
+  }
+  if (attr.has_service_id()) {
+    return attr.service_id();
+  }
+  return attr.node_id();
+}
+
+}  // namespace service_discovery
+}  // namespace cyber
+}  // namespace apollo
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2018 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef CYBER_SERVICE_DISCOVERY_COMMUNICATION_TOPOLOGY_CACHE_H_
+#define CYBER_SERVICE_DISCOVERY_COMMUNICATION_TOPOLOGY_CACHE_H_
+
+#include <sys/types.h>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "cyber/proto/topology_change.pb.h"
+
+namespace apollo {
+namespace cyber {
+namespace service_discovery {
+
+/**
+ * @class TopologyCache
+ * @brief Same-host shared memory table of the roles joined by every local
+ * process. A process that starts up reads the table and learns the local
+ * topology at once, instead of waiting for rtps discovery to replay it.
+ * Each Manager owns one cache, keyed by its ChangeType.
+ */
+class TopologyCache {
+ public:
+  static const uint32_t kSlotNum = 1024;
+  static const uint32_t kSlotSize = 4096;
+
+  explicit TopologyCache(proto::ChangeType change_type);
+  virtual ~TopologyCache();
+
+  bool Init();
+  void Shutdown();
+
+  /**
+   * @brief Store a join message of a role owned by this process. proto_desc
+   * is stripped, messages that still do not fit are left to rtps.
+   */
+  bool Put(const proto::ChangeMsg& msg);
+
+  /**
+   * @brief Remove the role carried by a leave message of this process
+   */
+  void Erase(const proto::ChangeMsg& msg);
+
+  /**
+   * @brief Get the join messages of all the other alive local processes
+   */
+  void GetAll(std::vector<proto::ChangeMsg>* msgs);
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> version = {0};  // odd while being written
+    std::atomic<int32_t> owner = {0};     // 0 means free
+    uint64_t role_key = 0;
+    int32_t role_type = 0;
+    uint32_t size = 0;
+    char data[kSlotSize];
+  };
+
+  struct Layout {
+    Slot slots[kSlotNum];
+  };
+
+  bool OpenOrCreate();
+  bool IsAlive(int32_t pid) const;
+  static uint64_t RoleKey(const proto::ChangeMsg& msg);
+
+  key_t key_ = 0;
+  int32_t process_id_ = 0;
+  void* managed_shm_ = nullptr;
+  Layout* layout_ = nullptr;
+  std::atomic<bool> is_shutdown_ = {true};
+};
+
+}  // namespace service_discovery
+}  // namespace cyber
+}  // namespace apollo
+
+#endif  // CYBER_SERVICE_DISCOVERY_COMMUNICATION_TOPOLOGY_CACHE_H_
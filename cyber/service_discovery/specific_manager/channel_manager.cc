@@ -20,6 +20,8 @@
 #include <set>
 #include <utility>
 
+#include "google/protobuf/util/message_differencer.h"
+
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/message/message_traits.h"
@@ -32,6 +34,8 @@ namespace apollo {
 namespace cyber {
 namespace service_discovery {
 
+using google::protobuf::util::MessageDifferencer;
+
 ChannelManager::ChannelManager() {
   allowed_role_ |= 1 << RoleType::ROLE_WRITER;
   allowed_role_ |= 1 << RoleType::ROLE_READER;
@@ -229,9 +233,26 @@ bool ChannelManager::Check(const RoleAttributes& attr) {
   return true;
 }
 
+bool ChannelManager::GetTimeToConnected(const std::string& channel_name,
+                                        uint64_t* latency_ns) {
+  RETURN_VAL_IF_NULL(latency_ns, false);
+  uint64_t key = common::GlobalData::RegisterChannel(channel_name);
+  std::lock_guard<std::mutex> lg(connected_lock_);
+  auto it = connected_latencies_.find(key);
+  if (it == connected_latencies_.end()) {
+    return false;
+  }
+  *latency_ns = it->second;
+  return true;
+}
+
 void ChannelManager::Dispose(const ChangeMsg& msg) {
   if (msg.operate_type() == OperateType::OPT_JOIN) {
-    DisposeJoin(msg);
+    // the same role may arrive from both topology cache and rtps
+    if (!DisposeJoin(msg)) {
+      return;
+    }
+    UpdateConnectedTime(msg);
   } else {
     DisposeLeave(msg);
   }
@@ -241,6 +262,7 @@ void ChannelManager::Dispose(const ChangeMsg& msg) {
 void ChannelManager::OnTopoModuleLeave(const std::string& host_name,
                                        int process_id) {
   RETURN_IF(!is_discovery_started_.load());
+  ClearSeq(host_name, process_id);
 
   RoleAttributes attr;
   attr.set_host_name(host_name);
@@ -268,29 +290,55 @@ void ChannelManager::OnTopoModuleLeave(const std::string& host_name,
   }
 }
 
-void ChannelManager::DisposeJoin(const ChangeMsg& msg) {
-  ScanMessageType(msg);
+bool ChannelManager::DisposeJoin(const ChangeMsg& msg) {
+  RoleAttributes attr(msg.role_attr());
+  auto joined = FindJoined(msg);
+  if (joined != nullptr) {
+    // the topology cache strips proto_desc, keep the one already known
+    if (attr.proto_desc().empty()) {
+      if (joined->attributes().has_proto_desc()) {
+        attr.set_proto_desc(joined->attributes().proto_desc());
+      } else {
+        attr.clear_proto_desc();
+      }
+    }
+    if (MessageDifferencer::Equals(joined->attributes(), attr)) {
+      return false;
+    }
+  } else {
+    ScanMessageType(msg);
+  }
 
-  Vertice v(msg.role_attr().node_name());
+  Vertice v(attr.node_name());
   Edge e;
-  e.set_value(msg.role_attr().channel_name());
+  e.set_value(attr.channel_name());
   if (msg.role_type() == RoleType::ROLE_WRITER) {
-    if (msg.role_attr().has_proto_desc() &&
-        msg.role_attr().proto_desc() != "") {
-      message::ProtobufFactory::Instance()->RegisterMessage(
-          msg.role_attr().proto_desc());
+    if (attr.has_proto_desc() && attr.proto_desc() != "") {
+      message::ProtobufFactory::Instance()->RegisterMessage(attr.proto_desc());
+    }
+    // a later join with changed attributes replaces the joined role
+    if (joined != nullptr) {
+      node_writers_.Remove(joined->attributes().node_id(), joined);
+      channel_writers_.Remove(joined->attributes().channel_id(), joined);
     }
-    auto role = std::make_shared<RoleWriter>(msg.role_attr(), msg.timestamp());
+    auto role = std::make_shared<RoleWriter>(attr, msg.timestamp());
     node_writers_.Add(role->attributes().node_id(), role);
     channel_writers_.Add(role->attributes().channel_id(), role);
     e.set_src(v);
   } else {
-    auto role = std::make_shared<RoleReader>(msg.role_attr(), msg.timestamp());
+    if (joined != nullptr) {
+      node_readers_.Remove(joined->attributes().node_id(), joined);
+      channel_readers_.Remove(joined->attributes().channel_id(), joined);
+    }
+    auto role = std::make_shared<RoleReader>(attr, msg.timestamp());
     node_readers_.Add(role->attributes().node_id(), role);
     channel_readers_.Add(role->attributes().channel_id(), role);
     e.set_dst(v);
   }
-  node_graph_.Insert(e);
+  if (joined == nullptr) {
+    node_graph_.Insert(e);
+  }
+  return true;
 }
 
 void ChannelManager::DisposeLeave(const ChangeMsg& msg) {
@@ -311,6 +359,51 @@ void ChannelManager::DisposeLeave(const ChangeMsg& msg) {
   node_graph_.Delete(e);
 }
 
+RolePtr ChannelManager::FindJoined(const ChangeMsg& msg) {
+  std::vector<RolePtr> roles;
+  if (msg.role_type() == RoleType::ROLE_WRITER) {
+    channel_writers_.Search(msg.role_attr().channel_id(), &roles);
+  } else {
+    channel_readers_.Search(msg.role_attr().channel_id(), &roles);
+  }
+  for (auto& role : roles) {
+    if (role->attributes().id() == msg.role_attr().id()) {
+      return role;
+    }
+  }
+  return nullptr;
+}
+
+void ChannelManager::UpdateConnectedTime(const ChangeMsg& msg) {
+  uint64_t key = msg.role_attr().channel_id();
+  uint64_t now = cyber::Time::Now().ToNanosecond();
+  std::lock_guard<std::mutex> lg(connected_lock_);
+  if (connected_latencies_.count(key) > 0) {
+    return;
+  }
+
+  if (msg.role_type() == RoleType::ROLE_READER) {
+    if (!IsFromSameProcess(msg) || reader_join_times_.count(key) > 0) {
+      return;
+    }
+    if (channel_writers_.Search(key)) {
+      connected_latencies_[key] = 0;
+    } else {
+      reader_join_times_[key] = now;
+    }
+    return;
+  }
+
+  auto it = reader_join_times_.find(key);
+  if (it == reader_join_times_.end()) {
+    return;
+  }
+  connected_latencies_[key] = now - it->second;
+  ADEBUG << "channel[" << msg.role_attr().channel_name()
+         << "] connected after " << connected_latencies_[key] << " ns.";
+  reader_join_times_.erase(it);
+}
+
 void ChannelManager::ScanMessageType(const ChangeMsg& msg) {
   uint64_t key = msg.role_attr().channel_id();
   std::string role_type("reader");
@@ -18,6 +18,7 @@
 #define CYBER_SERVICE_DISCOVERY_SPECIFIC_MANAGER_CHANNEL_MANAGER_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -191,15 +192,29 @@ class ChannelManager : public Manager {
    */
   bool IsMessageTypeMatching(const std::string& lhs, const std::string& rhs);
 
+  /**
+   * @brief Get the time from the first reader of this process joining
+   * `channel_name` to a writer of it being discovered
+   *
+   * @param channel_name the channel we want to inquire
+   * @param latency_ns result time to connected in nanoseconds
+   * @return true if the channel has been connected
+   * @return false if no local reader or no writer yet
+   */
+  bool GetTimeToConnected(const std::string& channel_name,
+                          uint64_t* latency_ns);
+
  private:
   bool Check(const RoleAttributes& attr) override;
   void Dispose(const ChangeMsg& msg) override;
   void OnTopoModuleLeave(const std::string& host_name, int process_id) override;
 
-  void DisposeJoin(const ChangeMsg& msg);
+  bool DisposeJoin(const ChangeMsg& msg);
   void DisposeLeave(const ChangeMsg& msg);
 
+  RolePtr FindJoined(const ChangeMsg& msg);
   void ScanMessageType(const ChangeMsg& msg);
+  void UpdateConnectedTime(const ChangeMsg& msg);
 
   ExemptedMessageTypes exempted_msg_types_;
 
@@ -211,6 +226,12 @@ class ChannelManager : public Manager {
   // key: channel_id
   WriterWarehouse channel_writers_;
   ReaderWarehouse channel_readers_;
+
+  std::mutex connected_lock_;
+  // key: channel_id, join time of the first local reader
+  std::unordered_map<uint64_t, uint64_t> reader_join_times_;
+  // key: channel_id, time to connected in nanoseconds
+  std::unordered_map<uint64_t, uint64_t> connected_latencies_;
 };
 
 }  // namespace service_discovery
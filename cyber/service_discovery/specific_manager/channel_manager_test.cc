@@ -430,6 +430,113 @@ TEST_F(ChannelManagerTest, is_message_type_matching) {
       channel_manager_.IsMessageTypeMatching(raw_msg_type_1, py_msg_type));
 }
 
+TEST_F(ChannelManagerTest, duplicated_join) {
+  RoleAttributes role_attr;
+  role_attr.set_host_name(common::GlobalData::Instance()->HostName());
+  role_attr.set_process_id(common::GlobalData::Instance()->ProcessId());
+  role_attr.set_node_name("dup_node");
+  role_attr.set_node_id(common::GlobalData::RegisterNode("dup_node"));
+  role_attr.set_channel_name("dup_channel");
+  role_attr.set_channel_id(
+      common::GlobalData::Instance()->RegisterChannel("dup_channel"));
+  transport::Identity id;
+  role_attr.set_id(id.HashValue());
+
+  int notified = 0;
+  auto conn = channel_manager_.AddChangeListener(
+      [&notified](const ChangeMsg&) { ++notified; });
+  channel_manager_.Join(role_attr, RoleType::ROLE_WRITER);
+  channel_manager_.Join(role_attr, RoleType::ROLE_WRITER);
+  EXPECT_EQ(notified, 1);
+
+  std::vector<RoleAttributes> writers;
+  channel_manager_.GetWritersOfChannel("dup_channel", &writers);
+  EXPECT_EQ(writers.size(), 1);
+  channel_manager_.RemoveChangeListener(conn);
+}
+
+TEST_F(ChannelManagerTest, join_with_changed_attributes) {
+  RoleAttributes role_attr;
+  role_attr.set_host_name(common::GlobalData::Instance()->HostName());
+  role_attr.set_process_id(common::GlobalData::Instance()->ProcessId());
+  role_attr.set_node_name("cached_node");
+  role_attr.set_node_id(common::GlobalData::RegisterNode("cached_node"));
+  role_attr.set_channel_name("cached_channel");
+  role_attr.set_channel_id(
+      common::GlobalData::Instance()->RegisterChannel("cached_channel"));
+  transport::Identity id;
+  role_attr.set_id(id.HashValue());
+
+  int notified = 0;
+  auto conn = channel_manager_.AddChangeListener(
+      [&notified](const ChangeMsg&) { ++notified; });
+  // joined from the topology cache, which strips proto_desc
+  channel_manager_.Join(role_attr, RoleType::ROLE_WRITER);
+  EXPECT_EQ(notified, 1);
+  const std::string guard = "guard";
+  std::string proto_desc(guard);
+  channel_manager_.GetProtoDesc("cached_channel", &proto_desc);
+  EXPECT_EQ(proto_desc, guard);
+
+  // the rtps join of the same writer carries proto_desc
+  std::string desc;
+  message::GetDescriptorString<proto::Chatter>(
+      message::MessageType<proto::Chatter>(), &desc);
+  role_attr.set_proto_desc(desc);
+  channel_manager_.Join(role_attr, RoleType::ROLE_WRITER);
+  EXPECT_EQ(notified, 2);
+  channel_manager_.GetProtoDesc("cached_channel", &proto_desc);
+  EXPECT_EQ(proto_desc, desc);
+
+  // a join without proto_desc keeps the known one
+  role_attr.clear_proto_desc();
+  channel_manager_.Join(role_attr, RoleType::ROLE_WRITER);
+  EXPECT_EQ(notified, 2);
+  proto_desc = guard;
+  channel_manager_.GetProtoDesc("cached_channel", &proto_desc);
+  EXPECT_EQ(proto_desc, desc);
+
+  std::vector<RoleAttributes> writers;
+  channel_manager_.GetWritersOfChannel("cached_channel", &writers);
+  EXPECT_EQ(writers.size(), 1);
+  std::vector<RoleAttributes> node_writers;
+  channel_manager_.GetWritersOfNode("cached_node", &node_writers);
+  EXPECT_EQ(node_writers.size(), 1);
+  channel_manager_.RemoveChangeListener(conn);
+
+  channel_manager_.Leave(role_attr, RoleType::ROLE_WRITER);
+  EXPECT_FALSE(channel_manager_.HasWriter("cached_channel"));
+}
+
+TEST_F(ChannelManagerTest, get_time_to_connected) {
+  uint64_t latency_ns = 0;
+  EXPECT_FALSE(channel_manager_.GetTimeToConnected("wasd", &latency_ns));
+
+  RoleAttributes role_attr;
+  role_attr.set_host_name(common::GlobalData::Instance()->HostName());
+  role_attr.set_process_id(common::GlobalData::Instance()->ProcessId());
+  role_attr.set_node_name("connected_node");
+  role_attr.set_node_id(common::GlobalData::RegisterNode("connected_node"));
+  role_attr.set_channel_name("connected_channel");
+  role_attr.set_channel_id(
+      common::GlobalData::Instance()->RegisterChannel("connected_channel"));
+  transport::Identity reader_id;
+  role_attr.set_id(reader_id.HashValue());
+  channel_manager_.Join(role_attr, RoleType::ROLE_READER);
+  EXPECT_FALSE(
+      channel_manager_.GetTimeToConnected("connected_channel", &latency_ns));
+
+  transport::Identity writer_id;
+  role_attr.set_id(writer_id.HashValue());
+  channel_manager_.Join(role_attr, RoleType::ROLE_WRITER);
+  EXPECT_TRUE(
+      channel_manager_.GetTimeToConnected("connected_channel", &latency_ns));
+
+  // writer exists before the reader joins
+  EXPECT_TRUE(channel_manager_.GetTimeToConnected("channel_0", &latency_ns));
+  EXPECT_EQ(latency_ns, 0);
+}
+
 }  // namespace service_discovery
 }  // namespace cyber
 }  // namespace apollo
@@ -16,6 +16,8 @@
 
 #include "cyber/service_discovery/specific_manager/manager.h"
 
+#include <vector>
+
 #include "cyber/common/global_data.h"
 #include "cyber/common/log.h"
 #include "cyber/message/message_traits.h"
@@ -40,7 +42,9 @@ Manager::Manager()
       channel_name_(""),
       publisher_(nullptr),
       subscriber_(nullptr),
-      listener_(nullptr) {
+      listener_(nullptr),
+      cache_(nullptr),
+      seq_(0) {
   host_name_ = common::GlobalData::Instance()->HostName();
   process_id_ = common::GlobalData::Instance()->ProcessId();
 }
@@ -59,6 +63,18 @@ bool Manager::StartDiscovery(RtpsParticipant* participant) {
     StopDiscovery();
     return false;
   }
+
+  auto& global_conf = common::GlobalData::Instance()->Config();
+  if (global_conf.has_transport_conf() &&
+      global_conf.transport_conf().has_topology_conf() &&
+      global_conf.transport_conf().topology_conf().enable_shm_cache()) {
+    cache_.reset(new TopologyCache(change_type_));
+    if (cache_->Init()) {
+      LoadFromCache();
+    } else {
+      cache_ = nullptr;
+    }
+  }
   return true;
 }
 
@@ -84,6 +100,11 @@ void Manager::StopDiscovery() {
     delete listener_;
     listener_ = nullptr;
   }
+
+  if (cache_ != nullptr) {
+    cache_->Shutdown();
+    cache_ = nullptr;
+  }
 }
 
 void Manager::Shutdown() {
@@ -106,6 +127,9 @@ bool Manager::Join(const RoleAttributes& attr, RoleType role,
   ChangeMsg msg;
   Convert(attr, role, OperateType::OPT_JOIN, &msg);
   Dispose(msg);
+  if (cache_ != nullptr && IsFromSameProcess(msg)) {
+    cache_->Put(msg);
+  }
   if (need_publish) {
     return Publish(msg);
   }
@@ -122,6 +146,9 @@ bool Manager::Leave(const RoleAttributes& attr, RoleType role) {
   ChangeMsg msg;
   Convert(attr, role, OperateType::OPT_LEAVE, &msg);
   Dispose(msg);
+  if (cache_ != nullptr && IsFromSameProcess(msg)) {
+    cache_->Erase(msg);
+  }
   if (NeedPublish(msg)) {
     return Publish(msg);
   }
@@ -197,6 +224,7 @@ void Manager::OnRemoteChange(const std::string& msg_str) {
     return;
   }
   RETURN_IF(!Check(msg.role_attr()));
+  RETURN_IF(IsDuplicated(msg));
   Dispose(msg);
 }
 
@@ -206,15 +234,17 @@ bool Manager::Publish(const ChangeMsg& msg) {
     return false;
   }
 
-  apollo::cyber::transport::UnderlayMessage m;
-  RETURN_VAL_IF(!message::SerializeToString(msg, &m.data()), false);
-  {
-    std::lock_guard<std::mutex> lg(lock_);
-    if (publisher_ != nullptr) {
-      return publisher_->write(reinterpret_cast<void*>(&m));
-    }
+  std::lock_guard<std::mutex> lg(lock_);
+  if (publisher_ == nullptr) {
+    return true;
   }
-  return true;
+  // the seq is assigned in the order of writing, so the peers only see a seq
+  // not greater than the latest one when a change is re-delivered
+  ChangeMsg seq_msg(msg);
+  seq_msg.set_seq(++seq_);
+  apollo::cyber::transport::UnderlayMessage m;
+  RETURN_VAL_IF(!message::SerializeToString(seq_msg, &m.data()), false);
+  return publisher_->write(reinterpret_cast<void*>(&m));
 }
 
 bool Manager::IsFromSameProcess(const ChangeMsg& msg) {
@@ -227,6 +257,43 @@ bool Manager::IsFromSameProcess(const ChangeMsg& msg) {
   return true;
 }
 
+bool Manager::IsDuplicated(const ChangeMsg& msg) {
+  if (!msg.has_seq()) {
+    return false;
+  }
+  std::string origin = msg.role_attr().host_name() + '+' +
+                       std::to_string(msg.role_attr().process_id());
+  std::lock_guard<std::mutex> lg(seq_lock_);
+  auto& received_seq = received_seqs_[origin];
+  if (msg.seq() <= received_seq) {
+    ADEBUG << "drop re-delivered change, seq: " << msg.seq()
+           << ", latest: " << received_seq;
+    return true;
+  }
+  received_seq = msg.seq();
+  return false;
+}
+
+void Manager::ClearSeq(const std::string& host_name, int process_id) {
+  std::string origin = host_name + '+' + std::to_string(process_id);
+  std::lock_guard<std::mutex> lg(seq_lock_);
+  received_seqs_.erase(origin);
+}
+
+void Manager::LoadFromCache() {
+  std::vector<ChangeMsg> msgs;
+  cache_->GetAll(&msgs);
+  ADEBUG << "load " << msgs.size() << " roles from topology cache.";
+  for (auto& msg : msgs) {
+    if (msg.change_type() != change_type_ || !Check(msg.role_attr())) {
+      continue;
+    }
+    // the seq is not recorded, rtps will still deliver the complete
+    // attributes(e.g. proto_desc) and Dispose handles the duplicate join
+    Dispose(msg);
+  }
+}
+
 }  // namespace service_discovery
 }  // namespace cyber
 }  // namespace apollo
@@ -19,8 +19,10 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "fastrtps/Domain.h"
 #include "fastrtps/attributes/PublisherAttributes.h"
@@ -32,6 +34,7 @@
 #include "cyber/base/signal.h"
 #include "cyber/proto/topology_change.pb.h"
 #include "cyber/service_discovery/communication/subscriber_listener.h"
+#include "cyber/service_discovery/communication/topology_cache.h"
 
 namespace apollo {
 namespace cyber {
@@ -150,6 +153,9 @@ class Manager {
   bool Publish(const ChangeMsg& msg);
   void OnRemoteChange(const std::string& msg_str);
   bool IsFromSameProcess(const ChangeMsg& msg);
+  bool IsDuplicated(const ChangeMsg& msg);
+  void ClearSeq(const std::string& host_name, int process_id);
+  void LoadFromCache();
 
   std::atomic<bool> is_shutdown_;
   std::atomic<bool> is_discovery_started_;
@@ -162,6 +168,13 @@ class Manager {
   std::mutex lock_;
   eprosima::fastrtps::Subscriber* subscriber_;
   SubscriberListener* listener_;
+  std::unique_ptr<TopologyCache> cache_;
+
+  /// the seq of the latest published change, guarded by lock_
+  uint64_t seq_;
+  std::mutex seq_lock_;
+  /// the latest seq received from each process, keyed by host_name+pid
+  std::unordered_map<std::string, uint64_t> received_seqs_;
 
   ChangeSignal signal_;
 };
@@ -68,6 +68,7 @@ void ServiceManager::Dispose(const ChangeMsg& msg) {
 void ServiceManager::OnTopoModuleLeave(const std::string& host_name,
                                        int process_id) {
   RETURN_IF(!is_discovery_started_.load());
+  ClearSeq(host_name, process_id);
 
   RoleAttributes attr;
   attr.set_host_name(host_name);
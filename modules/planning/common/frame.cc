@@ -51,8 +51,69 @@ using apollo::prediction::PredictionObstacles;
 
 DrivingAction Frame::pad_msg_driving_action_ = DrivingAction::NONE;
 
+FrameSnapshot::FrameSnapshot(std::unique_ptr<Frame> frame)
+    : sequence_num_(frame->sequence_num_),
+      planning_start_point_(frame->planning_start_point_),
+      vehicle_state_(frame->vehicle_state_),
+      current_frame_planned_trajectory_(
+          std::move(frame->current_frame_planned_trajectory_)),
+      current_frame_planned_path_(
+          std::move(frame->current_frame_planned_path_)) {
+  current_frame_planned_trajectory_.clear_debug();
+
+  auto &frame_open_space_info = frame->open_space_info_;
+  open_space_info_.set_fallback_flag(frame_open_space_info.fallback_flag());
+  open_space_info_.set_open_space_provider_success(
+      frame_open_space_info.open_space_provider_success());
+  *open_space_info_.mutable_stitched_trajectory_result() =
+      frame_open_space_info.stitched_trajectory_result();
+  *open_space_info_.mutable_optimizer_trajectory_data() =
+      frame_open_space_info.optimizer_trajectory_data();
+  // the open space debug is reused while the optimizer thread is running
+  auto *frame_debug_instance = frame_open_space_info.mutable_debug_instance();
+  if (frame_debug_instance->planning_data().has_open_space()) {
+    open_space_info_.mutable_debug_instance()
+        ->mutable_planning_data()
+        ->mutable_open_space()
+        ->Swap(frame_debug_instance->mutable_planning_data()
+                   ->mutable_open_space());
+  }
+  *open_space_info_.mutable_gear_switch_states() =
+      frame_open_space_info.gear_switch_states();
+  *open_space_info_.mutable_target_parking_spot_id() =
+      frame_open_space_info.target_parking_spot_id();
+  open_space_info_.set_target_parking_lane(
+      frame_open_space_info.target_parking_lane());
+
+  if (!frame->reference_line_info_.empty()) {
+    trajectory_type_ = frame->reference_line_info_.front().trajectory_type();
+  }
+  // the drive reference line is only queried by the navi planner
+  for (auto &reference_line_info : frame->reference_line_info_) {
+    if (FLAGS_use_navigation_mode &&
+        &reference_line_info == frame->drive_reference_line_info_) {
+      has_drive_reference_line_ = true;
+      drive_reference_line_ = reference_line_info.reference_line();
+      drive_speed_data_ = std::move(*reference_line_info.mutable_speed_data());
+      break;
+    }
+  }
+
+  for (const auto *obstacle : frame->obstacles_.Items()) {
+    if (obstacle->IsVirtual()) {
+      continue;
+    }
+    obstacle_boxes_.push_back(
+        {obstacle->Id(), obstacle->PerceptionBoundingBox()});
+  }
+}
+
 FrameHistory::FrameHistory()
-    : IndexedQueue<uint32_t, Frame>(FLAGS_max_frame_history_num) {}
+    : IndexedQueue<uint32_t, FrameSnapshot>(FLAGS_max_frame_history_num) {}
+
+bool FrameHistory::Add(const uint32_t id, std::unique_ptr<Frame> frame) {
+  return Add(id, std::make_unique<FrameSnapshot>(std::move(frame)));
+}
 
 Frame::Frame(uint32_t sequence_num)
     : sequence_num_(sequence_num),
@@ -22,12 +22,14 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "modules/common/math/box2d.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/common/proto/geometry.pb.h"
@@ -183,6 +185,8 @@ class Frame {
   }
 
  private:
+  friend class FrameSnapshot;
+
   common::Status InitFrameData(
       const common::VehicleStateProvider *vehicle_state_provider,
       const EgoInfo *ego_info);
@@ -247,9 +251,103 @@ class Frame {
   common::monitor::MonitorLogBuffer monitor_logger_buffer_;
 };
 
-class FrameHistory : public IndexedQueue<uint32_t, Frame> {
+/**
+ * @class FrameSnapshot
+ *
+ * @brief FrameSnapshot keeps the part of a planned frame that the following
+ * planning cycles query, so that the frame itself can be released once its
+ * trajectory is published.
+ */
+class FrameSnapshot {
+ public:
+  struct ObstacleBox {
+    std::string id;
+    common::math::Box2d box;
+  };
+
+  /**
+   * @brief Take over the queried data of the frame and release the rest.
+   */
+  explicit FrameSnapshot(std::unique_ptr<Frame> frame);
+
+  uint32_t SequenceNum() const { return sequence_num_; }
+
+  const common::TrajectoryPoint &PlanningStartPoint() const {
+    return planning_start_point_;
+  }
+
+  const common::VehicleState &vehicle_state() const { return vehicle_state_; }
+
+  /**
+   * @brief The published trajectory, without its debug message.
+   */
+  const ADCTrajectory &current_frame_planned_trajectory() const {
+    return current_frame_planned_trajectory_;
+  }
+
+  const DiscretizedPath &current_frame_planned_path() const {
+    return current_frame_planned_path_;
+  }
+
+  /**
+   * @brief Only the open space states carried over to the next cycle: the
+   * fallback flag, the provider success flag, the stitched and optimizer
+   * trajectories, the open space part of the debug instance, the gear switch
+   * states and the target parking spot id and lane.
+   */
+  const OpenSpaceInfo &open_space_info() const { return open_space_info_; }
+
+  /**
+   * @brief The trajectory type of the first reference line info.
+   */
+  ADCTrajectory::TrajectoryType trajectory_type() const {
+    return trajectory_type_;
+  }
+
+  /**
+   * @brief The drive reference line and its speed data are only kept in
+   * navigation mode.
+   */
+  bool has_drive_reference_line() const { return has_drive_reference_line_; }
+
+  const ReferenceLine &drive_reference_line() const {
+    return drive_reference_line_;
+  }
+
+  const SpeedData &drive_speed_data() const { return drive_speed_data_; }
+
+  /**
+   * @brief The ids and perception bounding boxes of the non-virtual
+   * obstacles.
+   */
+  const std::vector<ObstacleBox> &obstacle_boxes() const {
+    return obstacle_boxes_;
+  }
+
+ private:
+  uint32_t sequence_num_ = 0;
+  common::TrajectoryPoint planning_start_point_;
+  common::VehicleState vehicle_state_;
+  ADCTrajectory current_frame_planned_trajectory_;
+  DiscretizedPath current_frame_planned_path_;
+  OpenSpaceInfo open_space_info_;
+  ADCTrajectory::TrajectoryType trajectory_type_ = ADCTrajectory::UNKNOWN;
+  bool has_drive_reference_line_ = false;
+  ReferenceLine drive_reference_line_;
+  SpeedData drive_speed_data_;
+  std::vector<ObstacleBox> obstacle_boxes_;
+};
+
+class FrameHistory : public IndexedQueue<uint32_t, FrameSnapshot> {
  public:
   FrameHistory();
+
+  using IndexedQueue<uint32_t, FrameSnapshot>::Add;
+
+  /**
+   * @brief Add the snapshot of the frame, and release the frame.
+   */
+  bool Add(const uint32_t id, std::unique_ptr<Frame> frame);
 };
 
 }  // namespace planning
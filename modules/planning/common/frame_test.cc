@@ -20,6 +20,10 @@
 
 #include "modules/planning/common/frame.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "cyber/common/file.h"
 #include "gtest/gtest.h"
 #include "modules/common/util/util.h"
@@ -63,5 +67,68 @@ TEST_F(FrameTest, AlignPredictionTime) {
                    .trajectory_point_size());
 }
 
+TEST_F(FrameTest, FrameHistory) {
+  auto frame = std::make_unique<Frame>(7);
+  ADCTrajectory trajectory;
+  trajectory.mutable_header()->set_timestamp_sec(12.0);
+  trajectory.add_trajectory_point()->set_v(3.0);
+  trajectory.mutable_debug()->mutable_planning_data()->add_path();
+  frame->set_current_frame_planned_trajectory(trajectory);
+  std::vector<common::PathPoint> path_points(2);
+  path_points[1].set_s(1.0);
+  frame->set_current_frame_planned_path(DiscretizedPath(path_points));
+  frame->mutable_open_space_info()->set_fallback_flag(false);
+  *frame->mutable_open_space_info()->mutable_target_parking_spot_id() = "spot";
+  frame->mutable_open_space_info()
+      ->mutable_gear_switch_states()
+      ->gear_switching_flag = true;
+  frame->mutable_open_space_info()->set_open_space_provider_success(true);
+  std::vector<common::TrajectoryPoint> trajectory_points(3);
+  trajectory_points[2].set_relative_time(0.2);
+  *frame->mutable_open_space_info()->mutable_stitched_trajectory_result() =
+      DiscretizedTrajectory(trajectory_points);
+  *frame->mutable_open_space_info()->mutable_optimizer_trajectory_data() =
+      DiscretizedTrajectory(trajectory_points);
+  frame->mutable_open_space_info()
+      ->mutable_debug_instance()
+      ->mutable_planning_data()
+      ->mutable_open_space()
+      ->add_obstacles();
+
+  FrameHistory frame_history;
+  EXPECT_EQ(nullptr, frame_history.Latest());
+  EXPECT_TRUE(frame_history.Add(7, std::move(frame)));
+  EXPECT_EQ(nullptr, frame);
+  const auto* snapshot = frame_history.Latest();
+  ASSERT_NE(nullptr, snapshot);
+  EXPECT_EQ(7, snapshot->SequenceNum());
+  const auto& planned_trajectory = snapshot->current_frame_planned_trajectory();
+  EXPECT_DOUBLE_EQ(12.0, planned_trajectory.header().timestamp_sec());
+  ASSERT_EQ(1, planned_trajectory.trajectory_point_size());
+  EXPECT_FALSE(planned_trajectory.has_debug());
+  ASSERT_EQ(2, snapshot->current_frame_planned_path().size());
+  EXPECT_DOUBLE_EQ(1.0, snapshot->current_frame_planned_path().back().s());
+  EXPECT_FALSE(snapshot->open_space_info().fallback_flag());
+  EXPECT_EQ("spot", snapshot->open_space_info().target_parking_spot_id());
+  EXPECT_TRUE(
+      snapshot->open_space_info().gear_switch_states().gear_switching_flag);
+  EXPECT_TRUE(snapshot->open_space_info().open_space_provider_success());
+  ASSERT_EQ(3,
+            snapshot->open_space_info().stitched_trajectory_result().size());
+  EXPECT_DOUBLE_EQ(0.2, snapshot->open_space_info()
+                            .stitched_trajectory_result()
+                            .back()
+                            .relative_time());
+  EXPECT_EQ(3, snapshot->open_space_info().optimizer_trajectory_data().size());
+  EXPECT_EQ(1, snapshot->open_space_info()
+                   .debug_instance()
+                   .planning_data()
+                   .open_space()
+                   .obstacles_size());
+  EXPECT_EQ(ADCTrajectory::UNKNOWN, snapshot->trajectory_type());
+  EXPECT_FALSE(snapshot->has_drive_reference_line());
+  EXPECT_TRUE(snapshot->obstacle_boxes().empty());
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -31,7 +31,13 @@ namespace planning {
 using apollo::common::PathPoint;
 
 DiscretizedPath::DiscretizedPath(std::vector<PathPoint> path_points)
-    : std::vector<PathPoint>(std::move(path_points)) {}
+    : std::vector<PathPoint>(std::move(path_points)) {
+  BuildLookupIndex();
+}
+
+void DiscretizedPath::BuildLookupIndex() {
+  s_index_.Build(*this, [](const PathPoint &point) { return point.s(); });
+}
 
 double DiscretizedPath::Length() const {
   if (empty()) {
@@ -53,12 +59,34 @@ PathPoint DiscretizedPath::Evaluate(const double path_s) const {
                                                            *it_lower, path_s);
 }
 
+std::vector<PathPoint> DiscretizedPath::Evaluate(
+    const std::vector<double> &sorted_path_s) const {
+  ACHECK(!empty());
+  std::vector<PathPoint> path_points;
+  path_points.reserve(sorted_path_s.size());
+  const auto path_point_s = [](const PathPoint &tp) { return tp.s(); };
+  size_t lower_index = 0;
+  for (const double path_s : sorted_path_s) {
+    lower_index =
+        s_index_.NextLowerBound(*this, path_point_s, path_s, lower_index);
+    const auto it_lower = begin() + lower_index;
+    if (it_lower == begin()) {
+      path_points.push_back(front());
+    } else if (it_lower == end()) {
+      path_points.push_back(back());
+    } else {
+      path_points.push_back(common::math::InterpolateUsingLinearApproximation(
+          *(it_lower - 1), *it_lower, path_s));
+    }
+  }
+  return path_points;
+}
+
 std::vector<PathPoint>::const_iterator DiscretizedPath::QueryLowerBound(
     const double path_s) const {
-  auto func = [](const PathPoint &tp, const double path_s) {
-    return tp.s() < path_s;
-  };
-  return std::lower_bound(begin(), end(), path_s, func);
+  return begin() +
+         s_index_.LowerBound(*this, [](const PathPoint &tp) { return tp.s(); },
+                             path_s);
 }
 
 PathPoint DiscretizedPath::EvaluateReverse(const double path_s) const {
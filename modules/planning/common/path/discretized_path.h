@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "modules/common/proto/pnc_point.pb.h"
+#include "modules/planning/math/uniform_lookup_index.h"
 
 namespace apollo {
 namespace planning {
@@ -32,19 +33,39 @@ class DiscretizedPath : public std::vector<common::PathPoint> {
  public:
   DiscretizedPath() = default;
 
+  /**
+   * @brief Also builds the lookup index of the path points by s. The index is
+   * only used while the number of the points is unchanged.
+   */
   explicit DiscretizedPath(std::vector<common::PathPoint> path_points);
 
   double Length() const;
 
   common::PathPoint Evaluate(const double path_s) const;
 
+  /**
+   * @brief Evaluate the path at each of the non-decreasing path_s, searching
+   * each path_s forward from the previous one.
+   */
+  std::vector<common::PathPoint> Evaluate(
+      const std::vector<double>& sorted_path_s) const;
+
   common::PathPoint EvaluateReverse(const double path_s) const;
 
+  /**
+   * @brief Build the lookup index of the path points by s, after the points
+   * are modified.
+   */
+  void BuildLookupIndex();
+
  protected:
   std::vector<common::PathPoint>::const_iterator QueryLowerBound(
       const double path_s) const;
   std::vector<common::PathPoint>::const_iterator QueryUpperBound(
       const double path_s) const;
+
+ private:
+  UniformLookupIndex s_index_;
 };
 
 }  // namespace planning
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ * @brief Benchmarks of the evaluation of a discretized path, by binary search,
+ * by the lookup index and in batch. Run it with -c opt.
+ */
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/common/util/point_factory.h"
+#include "modules/planning/common/path/discretized_path.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// a path of the given number of points, 0.1 m apart as the planned paths
+std::vector<common::PathPoint> MakePathPoints(const int64_t num_points) {
+  std::vector<common::PathPoint> path_points;
+  for (int64_t i = 0; i < num_points; ++i) {
+    const double s = 0.1 * static_cast<double>(i);
+    path_points.push_back(
+        common::util::PointFactory::ToPathPoint(s, 0.0, 0.0, s));
+  }
+  return path_points;
+}
+
+// the s of the st boundary and trajectory combination queries
+std::vector<double> MakeSortedS(const double length) {
+  std::vector<double> sorted_s;
+  for (double s = 0.0; s < length; s += 0.037) {
+    sorted_s.push_back(s);
+  }
+  return sorted_s;
+}
+
+}  // namespace
+
+void BM_EvaluateBinarySearch(benchmark::State& state) {  // NOLINT
+  const auto path_points = MakePathPoints(state.range(0));
+  // the index is only built by the constructor
+  DiscretizedPath path;
+  path.insert(path.end(), path_points.begin(), path_points.end());
+  const auto sorted_s = MakeSortedS(path.Length());
+  for (auto _ : state) {
+    for (const double s : sorted_s) {
+      benchmark::DoNotOptimize(path.Evaluate(s));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * sorted_s.size());
+}
+BENCHMARK(BM_EvaluateBinarySearch)->Arg(100)->Arg(1000)->Arg(10000);
+
+void BM_EvaluateIndexed(benchmark::State& state) {  // NOLINT
+  const DiscretizedPath path(MakePathPoints(state.range(0)));
+  const auto sorted_s = MakeSortedS(path.Length());
+  for (auto _ : state) {
+    for (const double s : sorted_s) {
+      benchmark::DoNotOptimize(path.Evaluate(s));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * sorted_s.size());
+}
+BENCHMARK(BM_EvaluateIndexed)->Arg(100)->Arg(1000)->Arg(10000);
+
+void BM_EvaluateBatch(benchmark::State& state) {  // NOLINT
+  const DiscretizedPath path(MakePathPoints(state.range(0)));
+  const auto sorted_s = MakeSortedS(path.Length());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(path.Evaluate(sorted_s));
+  }
+  state.SetItemsProcessed(state.iterations() * sorted_s.size());
+}
+BENCHMARK(BM_EvaluateBatch)->Arg(100)->Arg(1000)->Arg(10000);
+
+}  // namespace planning
+}  // namespace apollo
+
+BENCHMARK_MAIN();
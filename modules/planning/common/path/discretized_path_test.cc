@@ -16,6 +16,8 @@
 
 #include "modules/planning/common/path/discretized_path.h"
 
+#include <algorithm>
+
 #include "cyber/common/log.h"
 #include "gtest/gtest.h"
 #include "modules/common/util/point_factory.h"
@@ -108,5 +110,41 @@ TEST(DiscretizedPathTest, reverse_case) {
   EXPECT_EQ(discretized_path.size(), 0);
 }
 
+TEST(DiscretizedPathTest, indexed_and_batch_evaluate) {
+  std::vector<PathPoint> path_points;
+  double s = 0.0;
+  for (int i = 0; i < 100; ++i) {
+    // clustered points at the start
+    s += (i < 20 ? 0.01 : 1.0);
+    path_points.push_back(PointFactory::ToPathPoint(s, 2.0 * s, 0.0, s));
+  }
+  DiscretizedPath discretized_path(path_points);
+  DiscretizedPath unindexed_path;
+  unindexed_path.insert(unindexed_path.end(), path_points.begin(),
+                        path_points.end());
+
+  std::vector<double> sorted_s;
+  for (double path_s = -1.0; path_s < s + 1.0; path_s += 0.037) {
+    sorted_s.push_back(path_s);
+  }
+  sorted_s.push_back(path_points[50].s());
+  std::sort(sorted_s.begin(), sorted_s.end());
+  const auto batch_points = discretized_path.Evaluate(sorted_s);
+  ASSERT_EQ(sorted_s.size(), batch_points.size());
+  for (size_t i = 0; i < sorted_s.size(); ++i) {
+    const auto path_point = discretized_path.Evaluate(sorted_s[i]);
+    const auto expected = unindexed_path.Evaluate(sorted_s[i]);
+    EXPECT_DOUBLE_EQ(expected.s(), path_point.s());
+    EXPECT_DOUBLE_EQ(expected.y(), path_point.y());
+    EXPECT_DOUBLE_EQ(expected.s(), batch_points[i].s());
+    EXPECT_DOUBLE_EQ(expected.y(), batch_points[i].y());
+  }
+
+  // still right after the points are modified
+  discretized_path.pop_back();
+  EXPECT_DOUBLE_EQ(path_points[98].s(),
+                   discretized_path.Evaluate(s + 1.0).s());
+}
+
 }  // namespace planning
 }  // namespace apollo
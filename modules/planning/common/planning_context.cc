@@ -19,9 +19,24 @@
 namespace apollo {
 namespace planning {
 
+thread_local const PlanningContext* PlanningContext::local_context_ = nullptr;
+thread_local PlanningStatus* PlanningContext::local_status_ = nullptr;
+
+PlanningContext::ScopedStatus::ScopedStatus(const PlanningContext* context,
+                                            PlanningStatus* status)
+    : prev_context_(local_context_), prev_status_(local_status_) {
+  local_context_ = context;
+  local_status_ = status;
+}
+
+PlanningContext::ScopedStatus::~ScopedStatus() {
+  local_context_ = prev_context_;
+  local_status_ = prev_status_;
+}
+
 void PlanningContext::Init() {}
 
-void PlanningContext::Clear() { planning_status_.Clear(); }
+void PlanningContext::Clear() { mutable_planning_status()->Clear(); }
 
 }  // namespace planning
 }  // namespace apollo
@@ -32,6 +32,22 @@ namespace planning {
 
 class PlanningContext {
  public:
+  /**
+   * @class ScopedStatus
+   * @brief Redirects the planning status seen by the current thread to a
+   * private copy while in scope. Used when reference lines are planned in
+   * parallel, so that each line reads and writes its own status.
+   */
+  class ScopedStatus {
+   public:
+    ScopedStatus(const PlanningContext* context, PlanningStatus* status);
+    ~ScopedStatus();
+
+   private:
+    const PlanningContext* prev_context_ = nullptr;
+    PlanningStatus* prev_status_ = nullptr;
+  };
+
   PlanningContext() = default;
 
   void Clear();
@@ -41,11 +57,18 @@ class PlanningContext {
    * please put all status info inside PlanningStatus for easy maintenance.
    * do NOT create new struct at this level.
    * */
-  const PlanningStatus& planning_status() const { return planning_status_; }
-  PlanningStatus* mutable_planning_status() { return &planning_status_; }
+  const PlanningStatus& planning_status() const {
+    return local_context_ == this ? *local_status_ : planning_status_;
+  }
+  PlanningStatus* mutable_planning_status() {
+    return local_context_ == this ? local_status_ : &planning_status_;
+  }
 
  private:
   PlanningStatus planning_status_;
+
+  static thread_local const PlanningContext* local_context_;
+  static thread_local PlanningStatus* local_status_;
 };
 
 }  // namespace planning
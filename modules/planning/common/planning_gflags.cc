@@ -148,6 +148,9 @@ DEFINE_double(look_forward_extend_distance, 50,
 DEFINE_double(reference_line_stitch_overlap_distance, 20,
               "The overlap distance with the existing reference line when "
               "stitching the existing reference line");
+DEFINE_bool(enable_reference_line_smoothing_cache, false,
+            "True to reuse the smoothed reference lines of the same lane "
+            "segments, and only smooth the newly appended tail");
 
 DEFINE_bool(enable_smooth_reference_line, true,
             "enable smooth the map reference line");
@@ -320,6 +323,16 @@ DEFINE_bool(use_multi_thread_to_add_obstacles, false,
             "use multiple thread to add obstacles.");
 DEFINE_bool(enable_multi_thread_in_dp_st_graph, false,
             "Enable multiple thread to calculation curve cost in dp_st_graph.");
+DEFINE_int32(dp_st_graph_rows_per_task, 16,
+             "The number of rows of a dp_st_graph column calculated by each "
+             "task when multiple thread is enabled.");
+DEFINE_bool(enable_multi_thread_in_st_boundary_mapper, false,
+            "Enable multiple thread to map obstacles onto st graph in "
+            "st_boundary_mapper.");
+DEFINE_bool(enable_parallel_reference_line_planning, false,
+            "Plan the reference lines of lane follow stage in parallel. Each "
+            "line starts from the planning status of the beginning of the "
+            "cycle.");
 
 /// Lattice Planner
 DEFINE_double(numerical_epsilon, 1e-6, "Epsilon in lattice planner.");
@@ -379,6 +392,12 @@ DEFINE_double(polynomial_minimal_param, 0.01,
               "Minimal time parameter in polynomials.");
 DEFINE_double(lattice_stop_buffer, 0.02,
               "The buffer before the stop s to check trajectories.");
+DEFINE_bool(enable_parallel_lattice_evaluation, false,
+            "True to evaluate the longitudinal trajectories and check the "
+            "trajectory pairs of the lattice planner in parallel.");
+DEFINE_int32(lattice_num_speculative_candidates, 4,
+             "The number of the lowest cost trajectory pairs checked at a "
+             "time by the lattice planner in parallel.");
 
 DEFINE_bool(lateral_optimization, true,
             "whether using optimization for lateral trajectory generation");
@@ -472,6 +491,29 @@ DEFINE_bool(
 DEFINE_bool(enable_osqp_debug, false,
             "True to turn on OSQP verbose debug output in log.");
 
+DEFINE_bool(enable_piecewise_jerk_osqp_warm_start, false,
+            "True to keep the OSQP workspaces of the piecewise jerk path and "
+            "speed optimizers across planning cycles, and warm start them "
+            "from the shifted solutions of the previous cycle.");
+
+DEFINE_bool(enable_planning_profiler, false,
+            "True to record the scoped spans of each planning cycle, publish "
+            "their latency percentiles and dump the slowest cycles as a "
+            "Chrome trace.");
+DEFINE_int32(planning_profiler_max_spans, 2048,
+             "The maximum number of spans recorded in one planning cycle.");
+DEFINE_int32(planning_profiler_window_size, 200,
+             "The number of the recent durations of each span the latency "
+             "percentiles are computed over.");
+DEFINE_int32(planning_profiler_report_interval, 100,
+             "The number of planning cycles between two profile reports.");
+DEFINE_int32(planning_profiler_num_slowest_cycles, 5,
+             "The number of the slowest planning cycles kept for the trace.");
+DEFINE_string(planning_profiler_trace_file,
+              "/apollo/data/log/planning_trace.json",
+              "The Chrome trace file of the slowest planning cycles, "
+              "rewritten with each profile report.");
+
 DEFINE_bool(export_chart, false, "export chart in planning");
 DEFINE_bool(enable_record_debug, true,
             "True to enable record debug info in chart format");
@@ -540,6 +582,10 @@ DEFINE_string(planning_data_dir, "/apollo/modules/planning/data/",
 DEFINE_string(planning_offline_bags, "",
               "a list of source files or directories for offline mode. "
               "The items need to be separated by colon ':'. ");
+DEFINE_int32(planning_offline_num_workers, 1,
+             "number of worker processes generating the learning data of "
+             "planning_offline_bags in parallel. The records of a sequence "
+             "are processed in order by the same worker.");
 DEFINE_int32(learning_data_obstacle_history_time_sec, 3.0,
              "time sec (second) of history trajectory points for a obstacle");
 DEFINE_int32(learning_data_frame_num_per_file, 100,
@@ -61,6 +61,7 @@ DECLARE_double(rtk_trajectory_resolution);
 DECLARE_bool(enable_reference_line_stitching);
 DECLARE_double(look_forward_extend_distance);
 DECLARE_double(reference_line_stitch_overlap_distance);
+DECLARE_bool(enable_reference_line_smoothing_cache);
 
 DECLARE_bool(enable_smooth_reference_line);
 
@@ -154,6 +155,9 @@ DECLARE_bool(enable_sqp_solver);
 /// thread pool
 DECLARE_bool(use_multi_thread_to_add_obstacles);
 DECLARE_bool(enable_multi_thread_in_dp_st_graph);
+DECLARE_int32(dp_st_graph_rows_per_task);
+DECLARE_bool(enable_multi_thread_in_st_boundary_mapper);
+DECLARE_bool(enable_parallel_reference_line_planning);
 
 DECLARE_double(numerical_epsilon);
 DECLARE_double(default_cruise_speed);
@@ -200,6 +204,8 @@ DECLARE_double(time_min_density);
 DECLARE_double(comfort_acceleration_factor);
 DECLARE_double(polynomial_minimal_param);
 DECLARE_double(lattice_stop_buffer);
+DECLARE_bool(enable_parallel_lattice_evaluation);
+DECLARE_int32(lattice_num_speculative_candidates);
 DECLARE_double(max_s_lateral_optimization);
 DECLARE_double(default_delta_s_lateral_optimization);
 DECLARE_double(bound_buffer);
@@ -230,6 +236,13 @@ DECLARE_bool(use_iterative_anchoring_smoother);
 DECLARE_bool(enable_parallel_trajectory_smoothing);
 
 DECLARE_bool(enable_osqp_debug);
+DECLARE_bool(enable_piecewise_jerk_osqp_warm_start);
+DECLARE_bool(enable_planning_profiler);
+DECLARE_int32(planning_profiler_max_spans);
+DECLARE_int32(planning_profiler_window_size);
+DECLARE_int32(planning_profiler_report_interval);
+DECLARE_int32(planning_profiler_num_slowest_cycles);
+DECLARE_string(planning_profiler_trace_file);
 DECLARE_bool(export_chart);
 DECLARE_bool(enable_record_debug);
 
@@ -271,6 +284,7 @@ DECLARE_bool(use_road_boundary_from_map);
 DECLARE_bool(planning_offline_learning);
 DECLARE_string(planning_data_dir);
 DECLARE_string(planning_offline_bags);
+DECLARE_int32(planning_offline_num_workers);
 DECLARE_int32(learning_data_obstacle_history_time_sec);
 DECLARE_int32(learning_data_frame_num_per_file);
 DECLARE_string(planning_birdview_img_feature_renderer_config_file);
@@ -0,0 +1,352 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/planning_profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "cyber/common/log.h"
+#include "cyber/time/time.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+std::atomic<int> next_thread_index{0};
+
+// the innermost open span of the thread in the cycle of thread_cycle_id
+thread_local int thread_index = -1;
+thread_local uint64_t thread_cycle_id = 0;
+thread_local int thread_current_span = -1;
+
+// the paths and start times of the open spans of a thread with its own root
+thread_local std::string thread_root;
+thread_local std::vector<std::pair<std::string, int64_t>> thread_root_spans;
+
+int64_t NowInNanoseconds() {
+  return static_cast<int64_t>(cyber::Time::Now().ToNanosecond());
+}
+
+int ThreadIndex() {
+  if (thread_index < 0) {
+    thread_index = next_thread_index++;
+  }
+  return thread_index;
+}
+
+// nearest rank percentile of the sorted values
+double Percentile(const std::vector<double>& sorted_values,
+                  const double percent) {
+  const size_t rank = static_cast<size_t>(
+      std::ceil(percent / 100.0 * static_cast<double>(sorted_values.size())));
+  return sorted_values[std::max<size_t>(rank, 1) - 1];
+}
+
+std::string EscapeJson(const std::string& str) {
+  std::string escaped;
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+      escaped.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped += absl::StrFormat("\\u%04x", c);
+    } else {
+      escaped.push_back(c);
+    }
+  }
+  return escaped;
+}
+
+}  // namespace
+
+PlanningProfiler::PlanningProfiler()
+    : spans_(std::max(1, FLAGS_planning_profiler_max_spans)) {}
+
+PlanningProfiler::ScopedSpan::ScopedSpan(const char* name) {
+  if (FLAGS_enable_planning_profiler) {
+    index_ = PlanningProfiler::Instance()->BeginSpan(name, &cycle_id_);
+  }
+}
+
+PlanningProfiler::ScopedSpan::~ScopedSpan() {
+  if (index_ >= 0 || index_ == kThreadRootSpan) {
+    PlanningProfiler::Instance()->EndSpan(index_, cycle_id_);
+  }
+}
+
+PlanningProfiler::ScopedThreadRoot::ScopedThreadRoot(const char* name) {
+  thread_root = name;
+  thread_root_spans.clear();
+}
+
+PlanningProfiler::ScopedThreadRoot::~ScopedThreadRoot() {
+  thread_root.clear();
+  thread_root_spans.clear();
+}
+
+void PlanningProfiler::BeginCycle(const uint32_t sequence_num) {
+  if (!FLAGS_enable_planning_profiler) {
+    return;
+  }
+  const int64_t now = NowInNanoseconds();
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++cycle_id_;
+  is_in_cycle_ = true;
+  sequence_num_ = sequence_num;
+  auto& root = spans_.front();
+  std::strncpy(root.name, "PlanningCycle", kMaxNameLength);
+  root.name[kMaxNameLength] = '\0';
+  root.parent = -1;
+  root.thread_index = ThreadIndex();
+  root.start_ns = now;
+  root.end_ns = 0;
+  num_spans_ = 1;
+  thread_cycle_id = cycle_id_;
+  thread_current_span = 0;
+}
+
+int PlanningProfiler::BeginSpan(const char* name, uint64_t* cycle_id) {
+  const int64_t now = NowInNanoseconds();
+  // never attached to the cycle that happens to be open
+  if (!thread_root.empty()) {
+    const std::string& parent_path = thread_root_spans.empty()
+                                         ? thread_root
+                                         : thread_root_spans.back().first;
+    thread_root_spans.emplace_back(absl::StrCat(parent_path, "/", name), now);
+    return kThreadRootSpan;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!is_in_cycle_) {
+    return -1;
+  }
+  if (num_spans_ >= spans_.size()) {
+    ++num_dropped_spans_;
+    return -1;
+  }
+  const int index = static_cast<int>(num_spans_++);
+  auto& span = spans_[index];
+  std::strncpy(span.name, name, kMaxNameLength);
+  span.name[kMaxNameLength] = '\0';
+  // the spans of the threads without an open span, such as the threads
+  // planning the reference lines in parallel, are under the root span
+  span.parent = (thread_cycle_id == cycle_id_ && thread_current_span >= 0)
+                    ? thread_current_span
+                    : 0;
+  span.thread_index = ThreadIndex();
+  span.start_ns = now;
+  span.end_ns = 0;
+  thread_cycle_id = cycle_id_;
+  thread_current_span = index;
+  *cycle_id = cycle_id_;
+  return index;
+}
+
+void PlanningProfiler::EndSpan(const int index, const uint64_t cycle_id) {
+  const int64_t now = NowInNanoseconds();
+  if (index == kThreadRootSpan) {
+    if (thread_root_spans.empty()) {
+      return;
+    }
+    const auto span = std::move(thread_root_spans.back());
+    thread_root_spans.pop_back();
+    std::lock_guard<std::mutex> lock(mutex_);
+    AddDuration(span.first, static_cast<double>(now - span.second) * 1e-6);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  // the span is dropped if its cycle has ended
+  if (cycle_id != cycle_id_ || !is_in_cycle_) {
+    return;
+  }
+  spans_[index].end_ns = now;
+  if (thread_cycle_id == cycle_id_) {
+    thread_current_span = spans_[index].parent;
+  }
+}
+
+void PlanningProfiler::EndCycle() {
+  const int64_t now = NowInNanoseconds();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!is_in_cycle_) {
+    return;
+  }
+  is_in_cycle_ = false;
+  thread_current_span = -1;
+  spans_.front().end_ns = now;
+
+  // a parent span always comes before its children
+  std::vector<std::string> paths(num_spans_);
+  for (size_t i = 0; i < num_spans_; ++i) {
+    auto& span = spans_[i];
+    // the spans still open on the other threads end with the cycle
+    if (span.end_ns == 0) {
+      span.end_ns = now;
+    }
+    paths[i] = span.parent < 0
+                   ? span.name
+                   : absl::StrCat(paths[span.parent], "/", span.name);
+    AddDuration(paths[i],
+                static_cast<double>(span.end_ns - span.start_ns) * 1e-6);
+  }
+  ++num_cycles_;
+  KeepIfSlowest();
+}
+
+void PlanningProfiler::AddDuration(const std::string& path,
+                                   const double duration_ms) {
+  const size_t window_size =
+      static_cast<size_t>(std::max(1, FLAGS_planning_profiler_window_size));
+  auto& window = duration_windows_[path];
+  if (window.durations_ms.size() < window_size) {
+    window.durations_ms.push_back(duration_ms);
+  } else {
+    window.durations_ms[window.next] = duration_ms;
+    window.next = (window.next + 1) % window.durations_ms.size();
+  }
+}
+
+void PlanningProfiler::KeepIfSlowest() {
+  const size_t num_slowest_cycles = static_cast<size_t>(
+      std::max(0, FLAGS_planning_profiler_num_slowest_cycles));
+  if (num_slowest_cycles == 0) {
+    return;
+  }
+  const auto& root = spans_.front();
+  const int64_t duration_ns = root.end_ns - root.start_ns;
+  auto fastest = std::min_element(
+      slowest_cycles_.begin(), slowest_cycles_.end(),
+      [](const CycleTrace& a, const CycleTrace& b) {
+        return a.duration_ns < b.duration_ns;
+      });
+  CycleTrace* cycle_trace = nullptr;
+  if (slowest_cycles_.size() < num_slowest_cycles) {
+    slowest_cycles_.emplace_back();
+    cycle_trace = &slowest_cycles_.back();
+  } else if (fastest->duration_ns < duration_ns) {
+    cycle_trace = &(*fastest);
+  } else {
+    return;
+  }
+  cycle_trace->sequence_num = sequence_num_;
+  cycle_trace->duration_ns = duration_ns;
+  cycle_trace->events.clear();
+  cycle_trace->events.reserve(num_spans_);
+  for (size_t i = 0; i < num_spans_; ++i) {
+    const auto& span = spans_[i];
+    TraceEvent event;
+    event.name = span.name;
+    event.thread_index = span.thread_index;
+    event.start_ns = span.start_ns - root.start_ns;
+    event.duration_ns = span.end_ns - span.start_ns;
+    cycle_trace->events.push_back(std::move(event));
+  }
+}
+
+void PlanningProfiler::GetProfile(PlanningProfile* profile) const {
+  CHECK_NOTNULL(profile);
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile->set_num_cycles(num_cycles_);
+  profile->set_num_dropped_spans(num_dropped_spans_);
+  const std::map<std::string, DurationWindow> sorted_windows(
+      duration_windows_.begin(), duration_windows_.end());
+  for (const auto& path_window : sorted_windows) {
+    std::vector<double> durations_ms = path_window.second.durations_ms;
+    if (durations_ms.empty()) {
+      continue;
+    }
+    std::sort(durations_ms.begin(), durations_ms.end());
+    double sum_ms = 0.0;
+    for (const double duration_ms : durations_ms) {
+      sum_ms += duration_ms;
+    }
+    auto* span_stats = profile->add_span_stats();
+    span_stats->set_path(path_window.first);
+    span_stats->set_num(static_cast<int>(durations_ms.size()));
+    span_stats->set_avg_ms(sum_ms / static_cast<double>(durations_ms.size()));
+    span_stats->set_p50_ms(Percentile(durations_ms, 50.0));
+    span_stats->set_p90_ms(Percentile(durations_ms, 90.0));
+    span_stats->set_p99_ms(Percentile(durations_ms, 99.0));
+    span_stats->set_max_ms(durations_ms.back());
+  }
+}
+
+bool PlanningProfiler::DumpSlowestCycles(const std::string& file_name) const {
+  std::vector<CycleTrace> slowest_cycles;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slowest_cycles = slowest_cycles_;
+  }
+  std::sort(slowest_cycles.begin(), slowest_cycles.end(),
+            [](const CycleTrace& a, const CycleTrace& b) {
+              return a.duration_ns > b.duration_ns;
+            });
+
+  std::ofstream trace_file(file_name);
+  if (!trace_file.is_open()) {
+    AERROR << "Failed to open the planning trace file " << file_name;
+    return false;
+  }
+  trace_file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool is_first_event = true;
+  for (const auto& cycle_trace : slowest_cycles) {
+    trace_file << (is_first_event ? "" : ",")
+               << absl::StrFormat(
+                      "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,"
+                      "\"args\":{\"name\":\"cycle %u: %.3f ms\"}}",
+                      cycle_trace.sequence_num, cycle_trace.sequence_num,
+                      static_cast<double>(cycle_trace.duration_ns) * 1e-6);
+    is_first_event = false;
+    for (const auto& event : cycle_trace.events) {
+      trace_file << absl::StrFormat(
+          ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%u,\"tid\":%d,"
+          "\"ts\":%.3f,\"dur\":%.3f}",
+          EscapeJson(event.name), cycle_trace.sequence_num,
+          event.thread_index, static_cast<double>(event.start_ns) * 1e-3,
+          static_cast<double>(event.duration_ns) * 1e-3);
+    }
+  }
+  trace_file << "\n]}\n";
+  return trace_file.good();
+}
+
+void PlanningProfiler::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // the spans still open are dropped with their cycle
+  ++cycle_id_;
+  is_in_cycle_ = false;
+  num_spans_ = 0;
+  num_dropped_spans_ = 0;
+  num_cycles_ = 0;
+  duration_windows_.clear();
+  slowest_cycles_.clear();
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,168 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Scoped span profiler of the planning cycles.
+ *
+ * How to use:
+ *   void PathBoundsDecider::SomeStep() {
+ *     PLANNING_PROFILE_SPAN("SomeStep");
+ *     // do something
+ *   }
+ * The spans are only recorded between BeginCycle and EndCycle, and when
+ * --enable_planning_profiler is on. A thread running alongside the cycles,
+ * such as the reference line provider thread, holds a ScopedThreadRoot so
+ * that its spans are recorded under a root of their own instead.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cyber/common/macros.h"
+#include "modules/planning/proto/planning_stats.pb.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class PlanningProfiler
+ * @brief Records the nested spans of each planning cycle into a buffer
+ * preallocated for --planning_profiler_max_spans spans. At the end of a
+ * cycle, the recent durations of each path of the span names are kept for
+ * the latency percentiles, and the spans of the slowest cycles are kept for
+ * the Chrome trace export.
+ */
+class PlanningProfiler {
+ public:
+  class ScopedSpan {
+   public:
+    explicit ScopedSpan(const char* name);
+    explicit ScopedSpan(const std::string& name) : ScopedSpan(name.c_str()) {}
+    ~ScopedSpan();
+
+   private:
+    int index_ = -1;
+    uint64_t cycle_id_ = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedSpan);
+  };
+
+  /**
+   * @class ScopedThreadRoot
+   * @brief Records the spans of the calling thread apart from the planning
+   * cycles, under the path of the given root name. They are in the latency
+   * percentiles, but not in the trace of a cycle.
+   */
+  class ScopedThreadRoot {
+   public:
+    explicit ScopedThreadRoot(const char* name);
+    ~ScopedThreadRoot();
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(ScopedThreadRoot);
+  };
+
+  /**
+   * @brief Start recording the spans of a cycle, under a root span named
+   * "PlanningCycle".
+   */
+  void BeginCycle(const uint32_t sequence_num);
+
+  /**
+   * @brief Stop recording, and aggregate the spans of the cycle.
+   */
+  void EndCycle();
+
+  /**
+   * @brief The latency percentiles of the spans over their recent durations.
+   */
+  void GetProfile(PlanningProfile* profile) const;
+
+  /**
+   * @brief Write the spans of the slowest cycles in the Chrome trace event
+   * format, which is also read by Perfetto. Each cycle is a process named by
+   * its sequence number, with its time starting from 0.
+   */
+  bool DumpSlowestCycles(const std::string& file_name) const;
+
+  void Clear();
+
+ private:
+  static constexpr size_t kMaxNameLength = 63;
+  // the index of a span under a thread root
+  static constexpr int kThreadRootSpan = -2;
+
+  struct Span {
+    char name[kMaxNameLength + 1];
+    int parent = -1;
+    int thread_index = 0;
+    int64_t start_ns = 0;
+    int64_t end_ns = 0;
+  };
+
+  struct TraceEvent {
+    std::string name;
+    int thread_index = 0;
+    int64_t start_ns = 0;
+    int64_t duration_ns = 0;
+  };
+
+  struct CycleTrace {
+    uint32_t sequence_num = 0;
+    int64_t duration_ns = 0;
+    std::vector<TraceEvent> events;
+  };
+
+  // the recent durations of a span path
+  struct DurationWindow {
+    std::vector<double> durations_ms;
+    size_t next = 0;
+  };
+
+  int BeginSpan(const char* name, uint64_t* cycle_id);
+  void EndSpan(const int index, const uint64_t cycle_id);
+  void AddDuration(const std::string& path, const double duration_ms);
+  void KeepIfSlowest();
+
+ private:
+  mutable std::mutex mutex_;
+  bool is_in_cycle_ = false;
+  uint64_t cycle_id_ = 0;
+  uint32_t sequence_num_ = 0;
+  std::vector<Span> spans_;
+  size_t num_spans_ = 0;
+  int num_dropped_spans_ = 0;
+  int num_cycles_ = 0;
+  std::unordered_map<std::string, DurationWindow> duration_windows_;
+  std::vector<CycleTrace> slowest_cycles_;
+
+  DECLARE_SINGLETON(PlanningProfiler)
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#define PLANNING_PROFILE_CONCAT_INNER(a, b) a##b
+#define PLANNING_PROFILE_CONCAT(a, b) PLANNING_PROFILE_CONCAT_INNER(a, b)
+#define PLANNING_PROFILE_SPAN(name)                \
+  ::apollo::planning::PlanningProfiler::ScopedSpan \
+  PLANNING_PROFILE_CONCAT(_planning_profile_span_, __LINE__)(name)
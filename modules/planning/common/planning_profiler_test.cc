@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/planning_profiler.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+class PlanningProfilerTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    FLAGS_enable_planning_profiler = true;
+    FLAGS_planning_profiler_num_slowest_cycles = 2;
+    PlanningProfiler::Instance()->Clear();
+  }
+
+  virtual void TearDown() { FLAGS_enable_planning_profiler = false; }
+
+ protected:
+  const SpanLatencyStats* FindSpanStats(const PlanningProfile& profile,
+                                        const std::string& path) {
+    for (const auto& span_stats : profile.span_stats()) {
+      if (span_stats.path() == path) {
+        return &span_stats;
+      }
+    }
+    return nullptr;
+  }
+
+  void RunCycle(const uint32_t sequence_num, const int sleep_ms) {
+    auto* profiler = PlanningProfiler::Instance();
+    profiler->BeginCycle(sequence_num);
+    {
+      PLANNING_PROFILE_SPAN("Task");
+      PLANNING_PROFILE_SPAN("Step");
+      std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+    }
+    {
+      PLANNING_PROFILE_SPAN(std::string("Task"));
+    }
+    profiler->EndCycle();
+  }
+};
+
+TEST_F(PlanningProfilerTest, span_tree) {
+  for (uint32_t i = 0; i < 4; ++i) {
+    RunCycle(i, 1 + static_cast<int>(i));
+  }
+  // not recorded out of a cycle
+  { PLANNING_PROFILE_SPAN("Task"); }
+
+  PlanningProfile profile;
+  PlanningProfiler::Instance()->GetProfile(&profile);
+  EXPECT_EQ(4, profile.num_cycles());
+  EXPECT_EQ(0, profile.num_dropped_spans());
+  ASSERT_EQ(3, profile.span_stats_size());
+  const auto* cycle_stats = FindSpanStats(profile, "PlanningCycle");
+  const auto* task_stats = FindSpanStats(profile, "PlanningCycle/Task");
+  const auto* step_stats = FindSpanStats(profile, "PlanningCycle/Task/Step");
+  ASSERT_NE(nullptr, cycle_stats);
+  ASSERT_NE(nullptr, task_stats);
+  ASSERT_NE(nullptr, step_stats);
+  EXPECT_EQ(4, cycle_stats->num());
+  EXPECT_EQ(8, task_stats->num());
+  EXPECT_EQ(4, step_stats->num());
+  EXPECT_GE(step_stats->p50_ms(), 2.0);
+  EXPECT_GE(step_stats->max_ms(), 4.0);
+  EXPECT_LE(step_stats->p50_ms(), step_stats->p90_ms());
+  EXPECT_LE(step_stats->p90_ms(), step_stats->max_ms());
+  EXPECT_LE(step_stats->max_ms(), cycle_stats->max_ms());
+}
+
+TEST_F(PlanningProfilerTest, other_thread) {
+  auto* profiler = PlanningProfiler::Instance();
+  profiler->BeginCycle(0);
+  {
+    PLANNING_PROFILE_SPAN("Task");
+    std::thread thread([]() { PLANNING_PROFILE_SPAN("ReferenceLine"); });
+    thread.join();
+  }
+  profiler->EndCycle();
+
+  PlanningProfile profile;
+  profiler->GetProfile(&profile);
+  EXPECT_NE(nullptr, FindSpanStats(profile, "PlanningCycle/ReferenceLine"));
+}
+
+TEST_F(PlanningProfilerTest, thread_root) {
+  auto* profiler = PlanningProfiler::Instance();
+  auto provider = []() {
+    PlanningProfiler::ScopedThreadRoot thread_root("ReferenceLineProvider");
+    PLANNING_PROFILE_SPAN("CreateReferenceLine");
+    PLANNING_PROFILE_SPAN("SmoothReferenceLine");
+  };
+  // out of a cycle
+  std::thread thread(provider);
+  thread.join();
+  // while a cycle is open
+  profiler->BeginCycle(0);
+  {
+    PLANNING_PROFILE_SPAN("Task");
+    std::thread thread(provider);
+    thread.join();
+  }
+  profiler->EndCycle();
+
+  PlanningProfile profile;
+  profiler->GetProfile(&profile);
+  ASSERT_EQ(4, profile.span_stats_size());
+  const auto* create_stats =
+      FindSpanStats(profile, "ReferenceLineProvider/CreateReferenceLine");
+  const auto* smooth_stats = FindSpanStats(
+      profile, "ReferenceLineProvider/CreateReferenceLine/SmoothReferenceLine");
+  ASSERT_NE(nullptr, create_stats);
+  ASSERT_NE(nullptr, smooth_stats);
+  EXPECT_EQ(2, create_stats->num());
+  EXPECT_EQ(2, smooth_stats->num());
+  EXPECT_NE(nullptr, FindSpanStats(profile, "PlanningCycle/Task"));
+
+  // the spans of the cycle thread are recorded again once the root is gone
+  { PlanningProfiler::ScopedThreadRoot thread_root("Detached"); }
+  RunCycle(1, 1);
+  PlanningProfile next_profile;
+  profiler->GetProfile(&next_profile);
+  EXPECT_NE(nullptr, FindSpanStats(next_profile, "PlanningCycle/Task/Step"));
+}
+
+TEST_F(PlanningProfilerTest, dump_slowest_cycles) {
+  RunCycle(10, 5);
+  RunCycle(11, 1);
+  RunCycle(12, 10);
+
+  const std::string file_name =
+      ::testing::TempDir() + "/planning_profiler_test_trace.json";
+  ASSERT_TRUE(PlanningProfiler::Instance()->DumpSlowestCycles(file_name));
+  std::ifstream trace_file(file_name);
+  std::stringstream trace;
+  trace << trace_file.rdbuf();
+  const std::string trace_str = trace.str();
+  EXPECT_EQ(0, trace_str.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, trace_str.find("\"pid\":12"));
+  EXPECT_NE(std::string::npos, trace_str.find("\"pid\":10"));
+  EXPECT_EQ(std::string::npos, trace_str.find("\"pid\":11"));
+  EXPECT_NE(std::string::npos,
+            trace_str.find("\"name\":\"Step\",\"ph\":\"X\""));
+  // the slowest cycle first
+  EXPECT_LT(trace_str.find("\"pid\":12"), trace_str.find("\"pid\":10"));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -458,15 +458,18 @@ void ReferenceLineInfo::SetLatticeCruiseSpeed(double speed) {
 
 bool ReferenceLineInfo::IsStartFrom(
     const ReferenceLineInfo& previous_reference_line_info) const {
+  return IsStartFrom(previous_reference_line_info.reference_line());
+}
+
+bool ReferenceLineInfo::IsStartFrom(
+    const ReferenceLine& previous_reference_line) const {
   if (reference_line_.reference_points().empty()) {
     return false;
   }
   auto start_point = reference_line_.reference_points().front();
-  const auto& prev_reference_line =
-      previous_reference_line_info.reference_line();
   common::SLPoint sl_point;
-  prev_reference_line.XYToSL(start_point, &sl_point);
-  return previous_reference_line_info.reference_line_.IsOnLane(sl_point);
+  previous_reference_line.XYToSL(start_point, &sl_point);
+  return previous_reference_line.IsOnLane(sl_point);
 }
 
 const PathData& ReferenceLineInfo::path_data() const { return path_data_; }
@@ -509,29 +512,44 @@ bool ReferenceLineInfo::CombinePathAndSpeedProfile(
     return false;
   }
 
+  // the speed points and then the path points are evaluated in one pass each
+  std::vector<double> relative_times;
   for (double cur_rel_time = 0.0; cur_rel_time < speed_data_.TotalTime();
        cur_rel_time += (cur_rel_time < kDenseTimeSec ? kDenseTimeResoltuion
                                                      : kSparseTimeResolution)) {
-    common::SpeedPoint speed_point;
-    if (!speed_data_.EvaluateByTime(cur_rel_time, &speed_point)) {
-      AERROR << "Fail to get speed point with relative time " << cur_rel_time;
-      return false;
-    }
+    relative_times.push_back(cur_rel_time);
+  }
+  std::vector<common::SpeedPoint> speed_points;
+  const bool is_speed_evaluated =
+      speed_data_.EvaluateByTime(relative_times, &speed_points);
 
-    if (speed_point.s() > path_data_.discretized_path().Length()) {
+  const double path_length = path_data_.discretized_path().Length();
+  std::vector<double> path_s;
+  path_s.reserve(speed_points.size());
+  for (const auto& speed_point : speed_points) {
+    if (speed_point.s() > path_length) {
       break;
     }
-    common::PathPoint path_point =
-        path_data_.GetPathPointWithPathS(speed_point.s());
-    path_point.set_s(path_point.s() + start_s);
+    path_s.push_back(speed_point.s());
+  }
+  const std::vector<common::PathPoint> path_points =
+      path_data_.discretized_path().Evaluate(path_s);
 
+  for (size_t i = 0; i < path_points.size(); ++i) {
+    const auto& speed_point = speed_points[i];
     common::TrajectoryPoint trajectory_point;
-    trajectory_point.mutable_path_point()->CopyFrom(path_point);
+    trajectory_point.mutable_path_point()->CopyFrom(path_points[i]);
+    trajectory_point.mutable_path_point()->set_s(path_points[i].s() + start_s);
     trajectory_point.set_v(speed_point.v());
     trajectory_point.set_a(speed_point.a());
     trajectory_point.set_relative_time(speed_point.t() + relative_time);
     ptr_discretized_trajectory->AppendTrajectoryPoint(trajectory_point);
   }
+  if (!is_speed_evaluated && path_s.size() == speed_points.size()) {
+    AERROR << "Fail to get speed point with relative time "
+           << relative_times[speed_points.size()];
+    return false;
+  }
   return true;
 }
 
@@ -107,6 +107,7 @@ class ReferenceLineInfo {
    *line, otherwise false.
    **/
   bool IsStartFrom(const ReferenceLineInfo& previous_reference_line_info) const;
+  bool IsStartFrom(const ReferenceLine& previous_reference_line) const;
 
   planning_internal::Debug* mutable_debug() { return &debug_; }
   const planning_internal::Debug& debug() const { return debug_; }
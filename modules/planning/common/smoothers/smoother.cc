@@ -103,8 +103,13 @@ apollo::common::Status Smoother::Smooth(
   const auto& previous_planning =
       previous_frame->current_frame_planned_trajectory();
   auto header = current_trajectory_pb->header();
+  // the frame history keeps the previous trajectory without debug, so keep
+  // the debug of the current cycle
+  planning_internal::Debug debug;
+  debug.Swap(current_trajectory_pb->mutable_debug());
   *current_trajectory_pb = previous_planning;
   current_trajectory_pb->mutable_header()->CopyFrom(header);
+  current_trajectory_pb->mutable_debug()->Swap(&debug);
   auto smoother_debug = current_trajectory_pb->mutable_debug()
                             ->mutable_planning_data()
                             ->mutable_smoother();
@@ -37,46 +37,34 @@ namespace planning {
 
 using apollo::common::SpeedPoint;
 
-SpeedData::SpeedData(std::vector<SpeedPoint> speed_points)
-    : std::vector<SpeedPoint>(std::move(speed_points)) {
-  std::sort(begin(), end(), [](const SpeedPoint& p1, const SpeedPoint& p2) {
-    return p1.t() < p2.t();
-  });
-}
+namespace {
 
-void SpeedData::AppendSpeedPoint(const double s, const double time,
-                                 const double v, const double a,
-                                 const double da) {
-  static std::mutex mutex_speedpoint;
-  UNIQUE_LOCK_MULTITHREAD(mutex_speedpoint);
+double PointTime(const SpeedPoint& point) { return point.t(); }
 
-  if (!empty()) {
-    ACHECK(back().t() < time);
-  }
-  push_back(common::util::PointFactory::ToSpeedPoint(s, time, v, a, da));
-}
+double PointS(const SpeedPoint& point) { return point.s(); }
 
-bool SpeedData::EvaluateByTime(const double t,
-                               common::SpeedPoint* const speed_point) const {
-  if (size() < 2) {
-    return false;
-  }
-  if (!(front().t() < t + 1.0e-6 && t - 1.0e-6 < back().t())) {
-    return false;
-  }
+bool IsInTimeRange(const std::vector<SpeedPoint>& speed_points,
+                   const double t) {
+  return speed_points.front().t() < t + 1.0e-6 &&
+         t - 1.0e-6 < speed_points.back().t();
+}
 
-  auto comp = [](const common::SpeedPoint& sp, const double t) {
-    return sp.t() < t;
-  };
+bool IsInSRange(const std::vector<SpeedPoint>& speed_points, const double s) {
+  return speed_points.front().s() < s + 1.0e-6 &&
+         s - 1.0e-6 < speed_points.back().s();
+}
 
-  auto it_lower = std::lower_bound(begin(), end(), t, comp);
-  if (it_lower == end()) {
-    *speed_point = back();
-  } else if (it_lower == begin()) {
-    *speed_point = front();
+// the speed point at time t, with the lower bound of t in the speed points
+void InterpolateByTime(const std::vector<SpeedPoint>& speed_points,
+                       const size_t lower_index, const double t,
+                       SpeedPoint* const speed_point) {
+  if (lower_index == speed_points.size()) {
+    *speed_point = speed_points.back();
+  } else if (lower_index == 0) {
+    *speed_point = speed_points.front();
   } else {
-    const auto& p0 = *(it_lower - 1);
-    const auto& p1 = *it_lower;
+    const auto& p0 = speed_points[lower_index - 1];
+    const auto& p1 = speed_points[lower_index];
     double t0 = p0.t();
     double t1 = p1.t();
 
@@ -93,30 +81,19 @@ bool SpeedData::EvaluateByTime(const double t,
       speed_point->set_da(common::math::lerp(p0.da(), t0, p1.da(), t1, t));
     }
   }
-  return true;
 }
 
-bool SpeedData::EvaluateByS(const double s,
-                            common::SpeedPoint* const speed_point) const {
-  if (size() < 2) {
-    return false;
-  }
-  if (!(front().s() < s + 1.0e-6 && s - 1.0e-6 < back().s())) {
-    return false;
-  }
-
-  auto comp = [](const common::SpeedPoint& sp, const double s) {
-    return sp.s() < s;
-  };
-
-  auto it_lower = std::lower_bound(begin(), end(), s, comp);
-  if (it_lower == end()) {
-    *speed_point = back();
-  } else if (it_lower == begin()) {
-    *speed_point = front();
+// the speed point at s, with the lower bound of s in the speed points
+void InterpolateByS(const std::vector<SpeedPoint>& speed_points,
+                    const size_t lower_index, const double s,
+                    SpeedPoint* const speed_point) {
+  if (lower_index == speed_points.size()) {
+    *speed_point = speed_points.back();
+  } else if (lower_index == 0) {
+    *speed_point = speed_points.front();
   } else {
-    const auto& p0 = *(it_lower - 1);
-    const auto& p1 = *it_lower;
+    const auto& p0 = speed_points[lower_index - 1];
+    const auto& p1 = speed_points[lower_index];
     double s0 = p0.s();
     double s1 = p1.s();
 
@@ -133,9 +110,99 @@ bool SpeedData::EvaluateByS(const double s,
       speed_point->set_da(common::math::lerp(p0.da(), s0, p1.da(), s1, s));
     }
   }
+}
+
+}  // namespace
+
+SpeedData::SpeedData(std::vector<SpeedPoint> speed_points)
+    : std::vector<SpeedPoint>(std::move(speed_points)) {
+  std::sort(begin(), end(), [](const SpeedPoint& p1, const SpeedPoint& p2) {
+    return p1.t() < p2.t();
+  });
+  BuildLookupIndex();
+}
+
+void SpeedData::AppendSpeedPoint(const double s, const double time,
+                                 const double v, const double a,
+                                 const double da) {
+  static std::mutex mutex_speedpoint;
+  UNIQUE_LOCK_MULTITHREAD(mutex_speedpoint);
+
+  if (!empty()) {
+    ACHECK(back().t() < time);
+  }
+  push_back(common::util::PointFactory::ToSpeedPoint(s, time, v, a, da));
+}
+
+bool SpeedData::EvaluateByTime(const double t,
+                               common::SpeedPoint* const speed_point) const {
+  if (size() < 2) {
+    return false;
+  }
+  if (!IsInTimeRange(*this, t)) {
+    return false;
+  }
+  InterpolateByTime(*this, t_index_.LowerBound(*this, PointTime, t), t,
+                    speed_point);
+  return true;
+}
+
+bool SpeedData::EvaluateByS(const double s,
+                            common::SpeedPoint* const speed_point) const {
+  if (size() < 2) {
+    return false;
+  }
+  if (!IsInSRange(*this, s)) {
+    return false;
+  }
+  InterpolateByS(*this, s_index_.LowerBound(*this, PointS, s), s, speed_point);
+  return true;
+}
+
+bool SpeedData::EvaluateByTime(
+    const std::vector<double>& sorted_times,
+    std::vector<SpeedPoint>* const speed_points) const {
+  speed_points->clear();
+  if (size() < 2) {
+    return sorted_times.empty();
+  }
+  speed_points->reserve(sorted_times.size());
+  size_t index = 0;
+  for (const double t : sorted_times) {
+    if (!IsInTimeRange(*this, t)) {
+      return false;
+    }
+    index = t_index_.NextLowerBound(*this, PointTime, t, index);
+    speed_points->emplace_back();
+    InterpolateByTime(*this, index, t, &speed_points->back());
+  }
   return true;
 }
 
+bool SpeedData::EvaluateByS(const std::vector<double>& sorted_s,
+                            std::vector<SpeedPoint>* const speed_points) const {
+  speed_points->clear();
+  if (size() < 2) {
+    return sorted_s.empty();
+  }
+  speed_points->reserve(sorted_s.size());
+  size_t index = 0;
+  for (const double s : sorted_s) {
+    if (!IsInSRange(*this, s)) {
+      return false;
+    }
+    index = s_index_.NextLowerBound(*this, PointS, s, index);
+    speed_points->emplace_back();
+    InterpolateByS(*this, index, s, &speed_points->back());
+  }
+  return true;
+}
+
+void SpeedData::BuildLookupIndex() {
+  t_index_.Build(*this, PointTime);
+  s_index_.Build(*this, PointS);
+}
+
 double SpeedData::TotalTime() const {
   if (empty()) {
     return 0.0;
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "modules/common/proto/pnc_point.pb.h"
+#include "modules/planning/math/uniform_lookup_index.h"
 
 namespace apollo {
 namespace planning {
@@ -33,6 +34,9 @@ class SpeedData : public std::vector<common::SpeedPoint> {
 
   virtual ~SpeedData() = default;
 
+  /**
+   * @brief Also builds the lookup indices of the speed points by t and s.
+   */
   explicit SpeedData(std::vector<common::SpeedPoint> speed_points);
 
   void AppendSpeedPoint(const double s, const double time, const double v,
@@ -45,12 +49,36 @@ class SpeedData : public std::vector<common::SpeedPoint> {
   // current usage on city driving scenario
   bool EvaluateByS(const double s, common::SpeedPoint* const speed_point) const;
 
+  /**
+   * @brief Evaluate the speed points at each of the non-decreasing times,
+   * searching each time forward from the previous one.
+   * @return false if a time is out of the speed profile, with speed_points
+   * holding the speed points before it.
+   */
+  bool EvaluateByTime(
+      const std::vector<double>& sorted_times,
+      std::vector<common::SpeedPoint>* const speed_points) const;
+
+  bool EvaluateByS(const std::vector<double>& sorted_s,
+                   std::vector<common::SpeedPoint>* const speed_points) const;
+
+  /**
+   * @brief Build the lookup indices of the speed points, e.g. after they are
+   * appended. The indices are only used while the number of the speed points
+   * is unchanged.
+   */
+  void BuildLookupIndex();
+
   double TotalTime() const;
 
   // Assuming spatial traversed distance is monotonous
   double TotalLength() const;
 
   virtual std::string DebugString() const;
+
+ private:
+  UniformLookupIndex t_index_;
+  UniformLookupIndex s_index_;
 };
 
 }  // namespace planning
@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ * @brief Benchmarks of the evaluation of a speed profile by time, by binary
+ * search, by the lookup index and in batch. Run it with -c opt.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/planning/common/speed/speed_data.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// a speed profile of the given number of points, accelerating then cruising
+SpeedData MakeAppendedSpeedData(const int64_t num_points) {
+  SpeedData speed_data;
+  const double dt = 8.0 / static_cast<double>(num_points);
+  double s = 0.0;
+  for (int64_t i = 0; i < num_points; ++i) {
+    const double t = dt * static_cast<double>(i);
+    const double v = std::min(10.0, 2.0 * t);
+    speed_data.AppendSpeedPoint(s, t, v, 0.0, 0.0);
+    s += v * dt;
+  }
+  return speed_data;
+}
+
+// the times of the trajectory combination queries
+std::vector<double> MakeSortedTimes(const double total_time) {
+  std::vector<double> sorted_times;
+  for (double t = 0.0; t < total_time; t += 0.02) {
+    sorted_times.push_back(t);
+  }
+  return sorted_times;
+}
+
+}  // namespace
+
+void BM_EvaluateByTimeBinarySearch(benchmark::State& state) {  // NOLINT
+  // the index is not built for the appended speed points
+  const SpeedData speed_data = MakeAppendedSpeedData(state.range(0));
+  const auto sorted_times = MakeSortedTimes(speed_data.TotalTime());
+  common::SpeedPoint speed_point;
+  for (auto _ : state) {
+    for (const double t : sorted_times) {
+      benchmark::DoNotOptimize(speed_data.EvaluateByTime(t, &speed_point));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * sorted_times.size());
+}
+BENCHMARK(BM_EvaluateByTimeBinarySearch)->Arg(100)->Arg(1000)->Arg(10000);
+
+void BM_EvaluateByTimeIndexed(benchmark::State& state) {  // NOLINT
+  SpeedData speed_data = MakeAppendedSpeedData(state.range(0));
+  speed_data.BuildLookupIndex();
+  const auto sorted_times = MakeSortedTimes(speed_data.TotalTime());
+  common::SpeedPoint speed_point;
+  for (auto _ : state) {
+    for (const double t : sorted_times) {
+      benchmark::DoNotOptimize(speed_data.EvaluateByTime(t, &speed_point));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * sorted_times.size());
+}
+BENCHMARK(BM_EvaluateByTimeIndexed)->Arg(100)->Arg(1000)->Arg(10000);
+
+void BM_EvaluateByTimeBatch(benchmark::State& state) {  // NOLINT
+  SpeedData speed_data = MakeAppendedSpeedData(state.range(0));
+  speed_data.BuildLookupIndex();
+  const auto sorted_times = MakeSortedTimes(speed_data.TotalTime());
+  std::vector<common::SpeedPoint> speed_points;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        speed_data.EvaluateByTime(sorted_times, &speed_points));
+  }
+  state.SetItemsProcessed(state.iterations() * sorted_times.size());
+}
+BENCHMARK(BM_EvaluateByTimeBatch)->Arg(100)->Arg(1000)->Arg(10000);
+
+}  // namespace planning
+}  // namespace apollo
+
+BENCHMARK_MAIN();
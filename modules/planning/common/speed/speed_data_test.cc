@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/speed/speed_data.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::SpeedPoint;
+
+class SpeedDataTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    // stops for a while at s = 20
+    for (int i = 0; i <= 80; ++i) {
+      const double t = 0.1 * i;
+      const double s = std::min(20.0, 5.0 * t);
+      const double v = t < 4.0 ? 5.0 : 0.0;
+      appended_speed_data_.AppendSpeedPoint(s, t, v, 0.0, 0.0);
+    }
+  }
+
+ protected:
+  SpeedData appended_speed_data_;
+};
+
+TEST_F(SpeedDataTest, indexed_evaluate) {
+  SpeedData speed_data(std::vector<SpeedPoint>(appended_speed_data_.begin(),
+                                               appended_speed_data_.end()));
+  for (double t = -0.5; t < 8.5; t += 0.033) {
+    SpeedPoint expected;
+    SpeedPoint speed_point;
+    ASSERT_EQ(appended_speed_data_.EvaluateByTime(t, &expected),
+              speed_data.EvaluateByTime(t, &speed_point));
+    EXPECT_DOUBLE_EQ(expected.s(), speed_point.s());
+    EXPECT_DOUBLE_EQ(expected.v(), speed_point.v());
+  }
+  for (double s = -0.5; s < 20.5; s += 0.077) {
+    SpeedPoint expected;
+    SpeedPoint speed_point;
+    ASSERT_EQ(appended_speed_data_.EvaluateByS(s, &expected),
+              speed_data.EvaluateByS(s, &speed_point));
+    EXPECT_DOUBLE_EQ(expected.t(), speed_point.t());
+  }
+}
+
+TEST_F(SpeedDataTest, batch_evaluate) {
+  appended_speed_data_.BuildLookupIndex();
+  std::vector<double> sorted_times;
+  for (double t = 0.0; t < 8.0; t += 0.033) {
+    sorted_times.push_back(t);
+  }
+  std::vector<SpeedPoint> speed_points;
+  ASSERT_TRUE(appended_speed_data_.EvaluateByTime(sorted_times, &speed_points));
+  ASSERT_EQ(sorted_times.size(), speed_points.size());
+  for (size_t i = 0; i < sorted_times.size(); ++i) {
+    SpeedPoint expected;
+    ASSERT_TRUE(
+        appended_speed_data_.EvaluateByTime(sorted_times[i], &expected));
+    EXPECT_DOUBLE_EQ(expected.s(), speed_points[i].s());
+    EXPECT_DOUBLE_EQ(expected.v(), speed_points[i].v());
+  }
+
+  const std::vector<double> sorted_s = {0.0, 1.0, 1.0, 19.99, 20.0};
+  ASSERT_TRUE(appended_speed_data_.EvaluateByS(sorted_s, &speed_points));
+  ASSERT_EQ(sorted_s.size(), speed_points.size());
+  for (size_t i = 0; i < sorted_s.size(); ++i) {
+    SpeedPoint expected;
+    ASSERT_TRUE(appended_speed_data_.EvaluateByS(sorted_s[i], &expected));
+    EXPECT_DOUBLE_EQ(expected.t(), speed_points[i].t());
+  }
+
+  // out of the speed profile
+  EXPECT_FALSE(
+      appended_speed_data_.EvaluateByTime({1.0, 2.0, 9.0}, &speed_points));
+  EXPECT_EQ(2, speed_points.size());
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -20,6 +20,8 @@
 
 #include "modules/planning/constraint_checker/collision_checker.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "cyber/common/log.h"
@@ -83,9 +85,9 @@ bool CollisionChecker::InCollision(
 }
 
 bool CollisionChecker::InCollision(
-    const DiscretizedTrajectory& discretized_trajectory) {
+    const DiscretizedTrajectory& discretized_trajectory) const {
   CHECK_LE(discretized_trajectory.NumOfPoints(),
-           predicted_bounding_rectangles_.size());
+           predicted_environments_.size());
   const auto& vehicle_config =
       common::VehicleConfigHelper::Instance()->GetConfig();
   double ego_length = vehicle_config.vehicle_param().length();
@@ -104,10 +106,56 @@ bool CollisionChecker::InCollision(
                     shift_distance * std::sin(ego_theta)};
     ego_box.Shift(shift_vec);
 
-    for (const auto& obstacle_box : predicted_bounding_rectangles_[i]) {
-      if (ego_box.HasOverlap(obstacle_box)) {
-        return true;
-      }
+    if (HasOverlap(predicted_environments_[i], ego_box)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+CollisionChecker::PredictedEnvironment
+CollisionChecker::IndexPredictedBoxes(std::vector<Box2d> boxes) {
+  std::sort(boxes.begin(), boxes.end(),
+            [](const Box2d& box0, const Box2d& box1) {
+              return box0.min_x() < box1.min_x();
+            });
+  PredictedEnvironment predicted_environment;
+  predicted_environment.min_y = std::numeric_limits<double>::max();
+  predicted_environment.max_y = std::numeric_limits<double>::lowest();
+  for (const auto& box : boxes) {
+    predicted_environment.min_xs.push_back(box.min_x());
+    predicted_environment.max_length_x = std::max(
+        predicted_environment.max_length_x, box.max_x() - box.min_x());
+    predicted_environment.min_y =
+        std::min(predicted_environment.min_y, box.min_y());
+    predicted_environment.max_y =
+        std::max(predicted_environment.max_y, box.max_y());
+  }
+  // against the rounding of the extents of the boxes far from the origin
+  static constexpr double kExtentBuffer = 1.0e-6;
+  predicted_environment.max_length_x += kExtentBuffer;
+  predicted_environment.boxes = std::move(boxes);
+  return predicted_environment;
+}
+
+bool CollisionChecker::HasOverlap(
+    const PredictedEnvironment& predicted_environment, const Box2d& ego_box) {
+  if (predicted_environment.boxes.empty() ||
+      ego_box.max_y() < predicted_environment.min_y ||
+      ego_box.min_y() > predicted_environment.max_y) {
+    return false;
+  }
+  // only the boxes starting in
+  // [ego_box.min_x() - max_length_x, ego_box.max_x()] overlap it in x
+  const auto& min_xs = predicted_environment.min_xs;
+  const auto begin =
+      std::lower_bound(min_xs.begin(), min_xs.end(),
+                       ego_box.min_x() - predicted_environment.max_length_x);
+  const auto end = std::upper_bound(begin, min_xs.end(), ego_box.max_x());
+  for (auto it = begin; it != end; ++it) {
+    if (ego_box.HasOverlap(
+            predicted_environment.boxes[std::distance(min_xs.begin(), it)])) {
+      return true;
     }
   }
   return false;
@@ -117,7 +165,7 @@ void CollisionChecker::BuildPredictedEnvironment(
     const std::vector<const Obstacle*>& obstacles, const double ego_vehicle_s,
     const double ego_vehicle_d,
     const std::vector<PathPoint>& discretized_reference_line) {
-  ACHECK(predicted_bounding_rectangles_.empty());
+  ACHECK(predicted_environments_.empty());
 
   // If the ego vehicle is in lane,
   // then, ignore all obstacles from the same lane.
@@ -149,7 +197,8 @@ void CollisionChecker::BuildPredictedEnvironment(
       box.LateralExtend(2.0 * FLAGS_lat_collision_buffer);
       predicted_env.push_back(std::move(box));
     }
-    predicted_bounding_rectangles_.push_back(std::move(predicted_env));
+    predicted_environments_.push_back(
+        IndexPredictedBoxes(std::move(predicted_env)));
     relative_time += FLAGS_trajectory_time_resolution;
   }
 }
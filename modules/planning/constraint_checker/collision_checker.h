@@ -23,6 +23,7 @@
 #include <memory>
 #include <vector>
 
+#include "gtest/gtest_prod.h"
 #include "modules/common/math/box2d.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/reference_line_info.h"
@@ -32,6 +33,13 @@
 namespace apollo {
 namespace planning {
 
+/**
+ * @class CollisionChecker
+ * @brief Checks the collision of the trajectories with the boxes of the
+ * obstacles predicted at each time step. The boxes of a time step are sorted
+ * by min x, so that a trajectory point is only checked against the few boxes
+ * overlapping it in x, found by a binary search.
+ */
 class CollisionChecker {
  public:
   CollisionChecker(
@@ -41,7 +49,7 @@ class CollisionChecker {
       const ReferenceLineInfo* ptr_reference_line_info,
       const std::shared_ptr<PathTimeGraph>& ptr_path_time_graph);
 
-  bool InCollision(const DiscretizedTrajectory& discretized_trajectory);
+  bool InCollision(const DiscretizedTrajectory& discretized_trajectory) const;
 
   static bool InCollision(const std::vector<const Obstacle*>& obstacles,
                           const DiscretizedTrajectory& ego_trajectory,
@@ -61,10 +69,28 @@ class CollisionChecker {
       const Obstacle* obstacle, const double ego_vehicle_s,
       const std::vector<apollo::common::PathPoint>& discretized_reference_line);
 
+  // the predicted obstacle boxes at a time step
+  struct PredictedEnvironment {
+    // sorted by min x
+    std::vector<common::math::Box2d> boxes;
+    std::vector<double> min_xs;
+    // the largest extent of the boxes in x
+    double max_length_x = 0.0;
+    double min_y = 0.0;
+    double max_y = 0.0;
+  };
+
+  static PredictedEnvironment IndexPredictedBoxes(
+      std::vector<common::math::Box2d> boxes);
+
+  static bool HasOverlap(const PredictedEnvironment& predicted_environment,
+                         const common::math::Box2d& ego_box);
+  FRIEND_TEST(CollisionCheckerTest, has_overlap);
+
  private:
   const ReferenceLineInfo* ptr_reference_line_info_;
   std::shared_ptr<PathTimeGraph> ptr_path_time_graph_;
-  std::vector<std::vector<common::math::Box2d>> predicted_bounding_rectangles_;
+  std::vector<PredictedEnvironment> predicted_environments_;
 };
 
 }  // namespace planning
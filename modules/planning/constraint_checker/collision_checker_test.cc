@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/constraint_checker/collision_checker.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+
+TEST(CollisionCheckerTest, has_overlap) {
+  std::mt19937 random_engine(20200101);
+  std::uniform_real_distribution<double> offset_dist(-30.0, 30.0);
+  std::uniform_real_distribution<double> length_dist(0.5, 15.0);
+  std::uniform_real_distribution<double> width_dist(0.5, 3.0);
+  std::uniform_real_distribution<double> heading_dist(-M_PI, M_PI);
+  std::uniform_int_distribution<int> num_boxes_dist(0, 30);
+
+  int num_overlaps = 0;
+  int num_checks = 0;
+  // around the origin and far from it, where the extents of the boxes are
+  // rounded
+  for (const double origin_x : {0.0, 587000.0}) {
+    const double origin_y = origin_x == 0.0 ? 0.0 : 4141000.0;
+    auto random_box = [&]() {
+      return Box2d({origin_x + offset_dist(random_engine),
+                    origin_y + offset_dist(random_engine)},
+                   heading_dist(random_engine), length_dist(random_engine),
+                   width_dist(random_engine));
+    };
+    for (int i = 0; i < 200; ++i) {
+      std::vector<Box2d> boxes;
+      const int num_boxes = num_boxes_dist(random_engine);
+      for (int j = 0; j < num_boxes; ++j) {
+        boxes.push_back(random_box());
+      }
+      const auto predicted_environment =
+          CollisionChecker::IndexPredictedBoxes(boxes);
+      ASSERT_EQ(boxes.size(), predicted_environment.boxes.size());
+
+      for (int j = 0; j < 50; ++j) {
+        const Box2d ego_box = random_box();
+        bool expected_overlap = false;
+        for (const auto& box : boxes) {
+          if (ego_box.HasOverlap(box)) {
+            expected_overlap = true;
+            break;
+          }
+        }
+        EXPECT_EQ(expected_overlap,
+                  CollisionChecker::HasOverlap(predicted_environment, ego_box));
+        num_overlaps += expected_overlap ? 1 : 0;
+        ++num_checks;
+      }
+    }
+  }
+  // both results are covered
+  EXPECT_GT(num_overlaps, 0);
+  EXPECT_LT(num_overlaps, num_checks);
+}
+
+}  // namespace planning
+}  // namespace apollo
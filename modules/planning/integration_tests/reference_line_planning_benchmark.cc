@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/integration_tests/planning_test_base.h"
+
+DEFINE_int32(benchmark_cycle_num, 20,
+             "number of planning cycles of each benchmark run");
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class ReferenceLinePlanningBenchmark
+ * @brief Compares the cycle time of sequential and parallel reference line
+ * planning on the change lane case of the sunnyvale_big_loop map, grouped by
+ * the number of reference lines of each cycle.
+ */
+class ReferenceLinePlanningBenchmark : public PlanningTestBase {
+ public:
+  virtual void SetUp() {
+    FLAGS_use_navigation_mode = false;
+    FLAGS_map_dir = "modules/map/data/sunnyvale_big_loop";
+    FLAGS_test_base_map_filename = "base_map.bin";
+    FLAGS_test_data_dir = "modules/planning/testdata/sunnyvale_big_loop_test";
+    FLAGS_planning_upper_speed_limit = 20.0;
+
+    FLAGS_enable_scenario_pull_over = false;
+    FLAGS_enable_scenario_stop_sign = false;
+    FLAGS_enable_scenario_traffic_light = false;
+    FLAGS_enable_rss_info = false;
+
+    ENABLE_RULE(TrafficRuleConfig::CROSSWALK, false);
+    ENABLE_RULE(TrafficRuleConfig::DESTINATION, false);
+    ENABLE_RULE(TrafficRuleConfig::KEEP_CLEAR, false);
+    ENABLE_RULE(TrafficRuleConfig::TRAFFIC_LIGHT, false);
+
+    std::string seq_num = "400";
+    FLAGS_test_routing_response_file = seq_num + "_routing.pb.txt";
+    FLAGS_test_localization_file = seq_num + "_localization.pb.txt";
+    FLAGS_test_chassis_file = seq_num + "_chassis.pb.txt";
+    FLAGS_test_prediction_file = seq_num + "_prediction.pb.txt";
+    FLAGS_test_traffic_light_file = "300_traffic_light.pb.txt";
+  }
+
+ protected:
+  struct BenchmarkResult {
+    // reference line number -> cycle time in ms
+    std::map<size_t, std::vector<double>> cycle_time_ms;
+    std::vector<std::string> trajectories;
+  };
+
+  void RunCycles(bool parallel, BenchmarkResult* result) {
+    FLAGS_enable_parallel_reference_line_planning = parallel;
+    PlanningTestBase::SetUp();
+    for (int i = 0; i < FLAGS_benchmark_cycle_num; ++i) {
+      ADCTrajectory trajectory;
+      const auto start = std::chrono::steady_clock::now();
+      planning_->RunOnce(local_view_, &trajectory);
+      const auto end = std::chrono::steady_clock::now();
+
+      const size_t reference_line_num =
+          planning_->frame_->reference_line_info().size();
+      result->cycle_time_ms[reference_line_num].push_back(
+          std::chrono::duration<double, std::milli>(end - start).count());
+
+      TrimPlanning(&trajectory, false);
+      trajectory.clear_header();
+      result->trajectories.push_back(trajectory.ShortDebugString());
+    }
+    FLAGS_enable_parallel_reference_line_planning = false;
+  }
+
+  static double Mean(const std::vector<double>& values) {
+    if (values.empty()) {
+      return 0.0;
+    }
+    return std::accumulate(values.begin(), values.end(), 0.0) /
+           static_cast<double>(values.size());
+  }
+
+  static void Report(const BenchmarkResult& sequential,
+                     const BenchmarkResult& parallel) {
+    std::cout << std::setw(16) << "reference_lines" << std::setw(10)
+              << "cycles" << std::setw(18) << "sequential_ms"
+              << std::setw(16) << "parallel_ms" << std::endl;
+    for (const auto& entry : sequential.cycle_time_ms) {
+      auto iter = parallel.cycle_time_ms.find(entry.first);
+      std::cout << std::setw(16) << entry.first << std::setw(10)
+                << entry.second.size() << std::setw(18) << std::fixed
+                << std::setprecision(3) << Mean(entry.second)
+                << std::setw(16)
+                << (iter == parallel.cycle_time_ms.end() ? 0.0
+                                                         : Mean(iter->second))
+                << std::endl;
+    }
+  }
+};
+
+TEST_F(ReferenceLinePlanningBenchmark, change_lane) {
+  BenchmarkResult sequential;
+  RunCycles(false, &sequential);
+
+  BenchmarkResult parallel;
+  RunCycles(true, &parallel);
+
+  BenchmarkResult parallel_again;
+  RunCycles(true, &parallel_again);
+
+  Report(sequential, parallel);
+
+  // the picked trajectory must not depend on the thread timing
+  ASSERT_EQ(parallel.trajectories.size(), parallel_again.trajectories.size());
+  for (size_t i = 0; i < parallel.trajectories.size(); ++i) {
+    EXPECT_EQ(parallel.trajectories[i], parallel_again.trajectories[i])
+        << "cycle " << i;
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+TMAIN;
@@ -21,9 +21,11 @@
 #include "modules/planning/lattice/trajectory_generation/trajectory_evaluator.h"
 
 #include <algorithm>
+#include <future>
 #include <limits>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/trajectory1d/piecewise_acceleration_trajectory1d.h"
@@ -42,6 +44,21 @@ using PtrTrajectory1d = std::shared_ptr<Trajectory1d>;
 using Trajectory1dPair =
     std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>>;
 
+namespace {
+
+// the number of longitudinal trajectories evaluated by a task
+constexpr size_t kNumLonTrajectoriesPerTask = 16;
+
+// the lateral costs are not negative, so that the cost of a longitudinal
+// trajectory is a lower bound of the costs of its pairs
+bool IsLatCostNonNegative() {
+  return FLAGS_weight_lat_offset >= 0.0 && FLAGS_weight_lat_comfort >= 0.0 &&
+         FLAGS_weight_same_side_offset >= 0.0 &&
+         FLAGS_weight_opposite_side_offset >= 0.0;
+}
+
+}  // namespace
+
 TrajectoryEvaluator::TrajectoryEvaluator(
     const std::array<double, 3>& init_s, const PlanningTarget& planning_target,
     const std::vector<PtrTrajectory1d>& lon_trajectories,
@@ -58,15 +75,66 @@ TrajectoryEvaluator::TrajectoryEvaluator(
 
   reference_s_dot_ = ComputeLongitudinalGuideVelocity(planning_target);
 
+  lat_trajectories_ = lat_trajectories;
+  lon_costs_.resize(lon_trajectories.size());
+  if (FLAGS_enable_parallel_lattice_evaluation) {
+    std::vector<std::future<void>> futures;
+    for (size_t begin = kNumLonTrajectoriesPerTask;
+         begin < lon_trajectories.size();
+         begin += kNumLonTrajectoriesPerTask) {
+      const size_t end = std::min(lon_trajectories.size(),
+                                  begin + kNumLonTrajectoriesPerTask);
+      futures.push_back(
+          cyber::Async(&TrajectoryEvaluator::EvaluateLonTrajectories, this,
+                       std::cref(planning_target), std::cref(lon_trajectories),
+                       begin, end));
+    }
+    EvaluateLonTrajectories(
+        planning_target, lon_trajectories, 0,
+        std::min(lon_trajectories.size(), kNumLonTrajectoriesPerTask));
+    for (auto& future : futures) {
+      future.get();
+    }
+  } else {
+    EvaluateLonTrajectories(planning_target, lon_trajectories, 0,
+                            lon_trajectories.size());
+  }
+
+  const bool is_lazy = IsLatCostNonNegative();
+  for (size_t i = 0; i < lon_trajectories.size(); ++i) {
+    if (!lon_costs_[i].is_valid || lat_trajectories_.empty()) {
+      continue;
+    }
+    num_of_trajectory_pairs_ += lat_trajectories_.size();
+    PairCost lon_pair_cost;
+    lon_pair_cost.lon_trajectory = lon_trajectories[i];
+    lon_pair_cost.lon_index = i;
+    lon_pair_cost.cost = lon_costs_[i].cost;
+    if (is_lazy) {
+      cost_queue_.push(lon_pair_cost);
+    } else {
+      ExpandLonTrajectory(lon_pair_cost);
+    }
+  }
+  ExpandTopTrajectoryPairs();
+  ADEBUG << "Number of valid 1d trajectory pairs: " << num_of_trajectory_pairs_;
+}
+
+void TrajectoryEvaluator::EvaluateLonTrajectories(
+    const PlanningTarget& planning_target,
+    const std::vector<PtrTrajectory1d>& lon_trajectories, const size_t begin,
+    const size_t end) {
   // if we have a stop point along the reference line,
   // filter out the lon. trajectories that pass the stop point.
   double stop_point = std::numeric_limits<double>::max();
   if (planning_target.has_stop_point()) {
     stop_point = planning_target.stop_point().s();
   }
-  for (const auto& lon_trajectory : lon_trajectories) {
-    double lon_end_s = lon_trajectory->Evaluate(0, end_time);
-    if (init_s[0] < stop_point &&
+  for (size_t i = begin; i < end; ++i) {
+    const auto& lon_trajectory = lon_trajectories[i];
+    double lon_end_s =
+        lon_trajectory->Evaluate(0, FLAGS_trajectory_time_length);
+    if (init_s_[0] < stop_point &&
         lon_end_s + FLAGS_lattice_stop_buffer > stop_point) {
       continue;
     }
@@ -74,20 +142,35 @@ TrajectoryEvaluator::TrajectoryEvaluator(
     if (!ConstraintChecker1d::IsValidLongitudinalTrajectory(*lon_trajectory)) {
       continue;
     }
-    for (const auto& lat_trajectory : lat_trajectories) {
-      /**
-       * The validity of the code needs to be verified.
-      if (!ConstraintChecker1d::IsValidLateralTrajectory(*lat_trajectory,
-                                                         *lon_trajectory)) {
-        continue;
-      }
-      */
-      double cost = Evaluate(planning_target, lon_trajectory, lat_trajectory);
-      cost_queue_.emplace(Trajectory1dPair(lon_trajectory, lat_trajectory),
-                          cost);
+    lon_costs_[i] = EvaluateLon(planning_target, lon_trajectory);
+  }
+}
+
+void TrajectoryEvaluator::ExpandTopTrajectoryPairs() {
+  while (!cost_queue_.empty() &&
+         cost_queue_.top().lat_trajectory == nullptr) {
+    const PairCost lon_pair_cost = cost_queue_.top();
+    cost_queue_.pop();
+    ExpandLonTrajectory(lon_pair_cost);
+  }
+}
+
+void TrajectoryEvaluator::ExpandLonTrajectory(const PairCost& lon_pair_cost) {
+  const LonCost& lon_cost = lon_costs_[lon_pair_cost.lon_index];
+  for (const auto& lat_trajectory : lat_trajectories_) {
+    /**
+     * The validity of the code needs to be verified.
+    if (!ConstraintChecker1d::IsValidLateralTrajectory(*lat_trajectory,
+                                                       *lon_trajectory)) {
+      continue;
     }
+    */
+    PairCost pair_cost = lon_pair_cost;
+    pair_cost.lat_trajectory = lat_trajectory;
+    pair_cost.cost = EvaluatePair(lon_cost, lon_pair_cost.lon_trajectory,
+                                  lat_trajectory);
+    cost_queue_.push(pair_cost);
   }
-  ADEBUG << "Number of valid 1d trajectory pairs: " << cost_queue_.size();
 }
 
 bool TrajectoryEvaluator::has_more_trajectory_pairs() const {
@@ -95,7 +178,7 @@ bool TrajectoryEvaluator::has_more_trajectory_pairs() const {
 }
 
 size_t TrajectoryEvaluator::num_of_trajectory_pairs() const {
-  return cost_queue_.size();
+  return num_of_trajectory_pairs_;
 }
 
 std::pair<PtrTrajectory1d, PtrTrajectory1d>
@@ -103,11 +186,13 @@ TrajectoryEvaluator::next_top_trajectory_pair() {
   ACHECK(has_more_trajectory_pairs());
   auto top = cost_queue_.top();
   cost_queue_.pop();
-  return top.first;
+  --num_of_trajectory_pairs_;
+  ExpandTopTrajectoryPairs();
+  return Trajectory1dPair(top.lon_trajectory, top.lat_trajectory);
 }
 
 double TrajectoryEvaluator::top_trajectory_pair_cost() const {
-  return cost_queue_.top().second;
+  return cost_queue_.top().cost;
 }
 
 double TrajectoryEvaluator::Evaluate(
@@ -115,6 +200,16 @@ double TrajectoryEvaluator::Evaluate(
     const PtrTrajectory1d& lon_trajectory,
     const PtrTrajectory1d& lat_trajectory,
     std::vector<double>* cost_components) const {
+  const LonCost lon_cost =
+      EvaluateLon(planning_target, lon_trajectory, cost_components);
+  return EvaluatePair(lon_cost, lon_trajectory, lat_trajectory,
+                      cost_components);
+}
+
+TrajectoryEvaluator::LonCost TrajectoryEvaluator::EvaluateLon(
+    const PlanningTarget& planning_target,
+    const PtrTrajectory1d& lon_trajectory,
+    std::vector<double>* cost_components) const {
   // Costs:
   // 1. Cost of missing the objective, e.g., cruise, stop, etc.
   // 2. Cost of longitudinal jerk
@@ -132,12 +227,33 @@ double TrajectoryEvaluator::Evaluate(
 
   double centripetal_acc_cost = CentripetalAccelerationCost(lon_trajectory);
 
+  if (cost_components != nullptr) {
+    cost_components->emplace_back(lon_objective_cost);
+    cost_components->emplace_back(lon_jerk_cost);
+    cost_components->emplace_back(lon_collision_cost);
+  }
+
+  LonCost lon_cost;
+  lon_cost.is_valid = true;
+  lon_cost.cost =
+      lon_objective_cost * FLAGS_weight_lon_objective +
+      lon_jerk_cost * FLAGS_weight_lon_jerk +
+      lon_collision_cost * FLAGS_weight_lon_collision +
+      centripetal_acc_cost * FLAGS_weight_centripetal_acceleration;
+
   // decides the longitudinal evaluation horizon for lateral trajectories.
-  double evaluation_horizon =
+  lon_cost.evaluation_horizon =
       std::min(FLAGS_speed_lon_decision_horizon,
                lon_trajectory->Evaluate(0, lon_trajectory->ParamLength()));
+  return lon_cost;
+}
+
+double TrajectoryEvaluator::EvaluatePair(
+    const LonCost& lon_cost, const PtrTrajectory1d& lon_trajectory,
+    const PtrTrajectory1d& lat_trajectory,
+    std::vector<double>* cost_components) const {
   std::vector<double> s_values;
-  for (double s = 0.0; s < evaluation_horizon;
+  for (double s = 0.0; s < lon_cost.evaluation_horizon;
        s += FLAGS_trajectory_space_resolution) {
     s_values.emplace_back(s);
   }
@@ -148,17 +264,11 @@ double TrajectoryEvaluator::Evaluate(
   double lat_comfort_cost = LatComfortCost(lon_trajectory, lat_trajectory);
 
   if (cost_components != nullptr) {
-    cost_components->emplace_back(lon_objective_cost);
-    cost_components->emplace_back(lon_jerk_cost);
-    cost_components->emplace_back(lon_collision_cost);
     cost_components->emplace_back(lat_offset_cost);
   }
 
-  return lon_objective_cost * FLAGS_weight_lon_objective +
-         lon_jerk_cost * FLAGS_weight_lon_jerk +
-         lon_collision_cost * FLAGS_weight_lon_collision +
-         centripetal_acc_cost * FLAGS_weight_centripetal_acceleration +
-         lat_offset_cost * FLAGS_weight_lat_offset +
+  // added in the same order as a sum of all the costs
+  return lon_cost.cost + lat_offset_cost * FLAGS_weight_lat_offset +
          lat_comfort_cost * FLAGS_weight_lat_comfort;
 }
 
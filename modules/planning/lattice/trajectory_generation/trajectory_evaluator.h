@@ -26,6 +26,7 @@
 #include <utility>
 #include <vector>
 
+#include "gtest/gtest_prod.h"
 #include "modules/planning/lattice/behavior/path_time_graph.h"
 #include "modules/planning/math/curve1d/curve1d.h"
 #include "modules/planning/proto/lattice_structure.pb.h"
@@ -34,12 +35,17 @@
 namespace apollo {
 namespace planning {
 
+/**
+ * @class TrajectoryEvaluator
+ * @brief Sorts the longitudinal and lateral trajectory pairs by cost. The
+ * costs only depending on the longitudinal trajectory are evaluated once for
+ * all its pairs, and are a lower bound of the costs of its pairs. The lateral
+ * costs of the pairs of a longitudinal trajectory are only evaluated when this
+ * lower bound is the lowest of the remaining costs, so the pairs of the
+ * expensive longitudinal trajectories behind the chosen pair are never
+ * evaluated.
+ */
 class TrajectoryEvaluator {
-  // normal use
-  typedef std::pair<
-      std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>>, double>
-      PairCost;
-
   // auto tuning
   typedef std::pair<
       std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>>,
@@ -69,10 +75,49 @@ class TrajectoryEvaluator {
   std::vector<double> top_trajectory_pair_component_cost() const;
 
  private:
+  // the part of the cost of the pairs of a longitudinal trajectory only
+  // depending on it
+  struct LonCost {
+    bool is_valid = false;
+    double cost = 0.0;
+    // the longitudinal evaluation horizon of the lateral trajectories
+    double evaluation_horizon = 0.0;
+  };
+
+  // a trajectory pair, or a longitudinal trajectory whose pairs are not
+  // evaluated yet, with a null lat_trajectory and the lower bound cost
+  struct PairCost {
+    std::shared_ptr<Curve1d> lon_trajectory;
+    std::shared_ptr<Curve1d> lat_trajectory;
+    size_t lon_index = 0;
+    double cost = 0.0;
+  };
+
   double Evaluate(const PlanningTarget& planning_target,
                   const std::shared_ptr<Curve1d>& lon_trajectory,
                   const std::shared_ptr<Curve1d>& lat_trajectory,
                   std::vector<double>* cost_components = nullptr) const;
+  FRIEND_TEST(TrajectoryEvaluatorTest, lazy_evaluation);
+
+  LonCost EvaluateLon(const PlanningTarget& planning_target,
+                      const std::shared_ptr<Curve1d>& lon_trajectory,
+                      std::vector<double>* cost_components = nullptr) const;
+
+  double EvaluatePair(const LonCost& lon_cost,
+                      const std::shared_ptr<Curve1d>& lon_trajectory,
+                      const std::shared_ptr<Curve1d>& lat_trajectory,
+                      std::vector<double>* cost_components = nullptr) const;
+
+  void EvaluateLonTrajectories(
+      const PlanningTarget& planning_target,
+      const std::vector<std::shared_ptr<Curve1d>>& lon_trajectories,
+      const size_t begin, const size_t end);
+
+  // evaluates the pairs of the longitudinal trajectories on the top of the
+  // queue, until a trajectory pair is on the top
+  void ExpandTopTrajectoryPairs();
+
+  void ExpandLonTrajectory(const PairCost& lon_pair_cost);
 
   double LatOffsetCost(const std::shared_ptr<Curve1d>& lat_trajectory,
                        const std::vector<double>& s_values) const;
@@ -101,13 +146,26 @@ class TrajectoryEvaluator {
   struct CostComparator
       : public std::binary_function<const PairCost&, const PairCost&, bool> {
     bool operator()(const PairCost& left, const PairCost& right) const {
-      return left.second > right.second;
+      if (left.cost != right.cost) {
+        return left.cost > right.cost;
+      }
+      // a longitudinal trajectory is expanded before the pairs of the same
+      // cost are taken
+      return left.lat_trajectory != nullptr &&
+             right.lat_trajectory == nullptr;
     }
   };
 
   std::priority_queue<PairCost, std::vector<PairCost>, CostComparator>
       cost_queue_;
 
+  std::vector<std::shared_ptr<Curve1d>> lat_trajectories_;
+
+  std::vector<LonCost> lon_costs_;
+
+  // including the pairs of the longitudinal trajectories not expanded yet
+  size_t num_of_trajectory_pairs_ = 0;
+
   std::shared_ptr<PathTimeGraph> path_time_graph_;
 
   std::shared_ptr<std::vector<apollo::common::PathPoint>> reference_line_;
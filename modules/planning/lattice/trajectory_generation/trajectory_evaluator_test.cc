@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/lattice/trajectory_generation/trajectory_evaluator.h"
+
+#include <algorithm>
+#include <set>
+#include <tuple>
+
+#include "gtest/gtest.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/lattice/trajectory_generation/lattice_trajectory1d.h"
+#include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
+#include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::PathPoint;
+
+class TrajectoryEvaluatorTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    // a gentle curve
+    auto reference_line = std::make_shared<std::vector<PathPoint>>();
+    for (int i = 0; i <= 400; ++i) {
+      PathPoint path_point;
+      path_point.set_x(static_cast<double>(i) * 0.5);
+      path_point.set_s(static_cast<double>(i) * 0.5);
+      path_point.set_kappa(0.01);
+      reference_line->push_back(path_point);
+    }
+    reference_line_ = reference_line;
+    path_time_graph_ = std::make_shared<PathTimeGraph>(
+        std::vector<const Obstacle*>(), *reference_line_, nullptr, init_s_[0],
+        init_s_[0] + FLAGS_speed_lon_decision_horizon, 0.0,
+        FLAGS_trajectory_time_length, init_d_);
+    planning_target_.set_cruise_speed(10.0);
+
+    // some of them exceed the acceleration bounds
+    for (const double end_v : {0.0, 4.0, 8.0, 12.0, 16.0}) {
+      for (const double end_t : {1.0, 2.0, 4.0, 6.0, 8.0}) {
+        lon_trajectories_.push_back(std::make_shared<LatticeTrajectory1d>(
+            std::make_shared<QuarticPolynomialCurve1d>(
+                init_s_, std::array<double, 2>{{end_v, 0.0}}, end_t)));
+      }
+    }
+    for (const double end_d : {-1.0, -0.5, 0.0, 0.5, 1.0}) {
+      for (const double end_s : {10.0, 20.0, 40.0, 80.0}) {
+        lat_trajectories_.push_back(std::make_shared<LatticeTrajectory1d>(
+            std::make_shared<QuinticPolynomialCurve1d>(
+                init_d_, std::array<double, 3>{{end_d, 0.0, 0.0}}, end_s)));
+      }
+    }
+  }
+
+  std::unique_ptr<TrajectoryEvaluator> MakeEvaluator() const {
+    return std::make_unique<TrajectoryEvaluator>(
+        init_s_, planning_target_, lon_trajectories_, lat_trajectories_,
+        path_time_graph_, reference_line_);
+  }
+
+ protected:
+  const std::array<double, 3> init_s_ = {{0.0, 8.0, 0.0}};
+  const std::array<double, 3> init_d_ = {{0.3, 0.0, 0.0}};
+  std::shared_ptr<std::vector<PathPoint>> reference_line_;
+  std::shared_ptr<PathTimeGraph> path_time_graph_;
+  PlanningTarget planning_target_;
+  std::vector<std::shared_ptr<Curve1d>> lon_trajectories_;
+  std::vector<std::shared_ptr<Curve1d>> lat_trajectories_;
+};
+
+TEST_F(TrajectoryEvaluatorTest, lazy_evaluation) {
+  const bool enable_parallel_lattice_evaluation =
+      FLAGS_enable_parallel_lattice_evaluation;
+  const double weight_lat_offset = FLAGS_weight_lat_offset;
+  // lazy, lazy with the longitudinal trajectories evaluated in parallel,
+  // and eager for a negative lateral cost
+  for (const auto& flags : {std::make_pair(false, weight_lat_offset),
+                            std::make_pair(true, weight_lat_offset),
+                            std::make_pair(false, -weight_lat_offset)}) {
+    FLAGS_enable_parallel_lattice_evaluation = flags.first;
+    FLAGS_weight_lat_offset = flags.second;
+    auto trajectory_evaluator = MakeEvaluator();
+
+    // all the pairs of the valid longitudinal trajectories, by cost
+    std::vector<std::tuple<double, Curve1d*, Curve1d*>> expected_pairs;
+    size_t num_valid_lon_trajectories = 0;
+    for (size_t i = 0; i < lon_trajectories_.size(); ++i) {
+      if (!trajectory_evaluator->lon_costs_[i].is_valid) {
+        continue;
+      }
+      ++num_valid_lon_trajectories;
+      for (const auto& lat_trajectory : lat_trajectories_) {
+        expected_pairs.emplace_back(
+            trajectory_evaluator->Evaluate(planning_target_,
+                                           lon_trajectories_[i],
+                                           lat_trajectory),
+            lon_trajectories_[i].get(), lat_trajectory.get());
+      }
+    }
+    EXPECT_GT(num_valid_lon_trajectories, 0);
+    EXPECT_LT(num_valid_lon_trajectories, lon_trajectories_.size());
+    std::sort(expected_pairs.begin(), expected_pairs.end());
+    ASSERT_EQ(expected_pairs.size(),
+              trajectory_evaluator->num_of_trajectory_pairs());
+
+    std::vector<std::tuple<double, Curve1d*, Curve1d*>> pairs;
+    while (trajectory_evaluator->has_more_trajectory_pairs()) {
+      const double cost = trajectory_evaluator->top_trajectory_pair_cost();
+      const auto trajectory_pair =
+          trajectory_evaluator->next_top_trajectory_pair();
+      pairs.emplace_back(cost, trajectory_pair.first.get(),
+                         trajectory_pair.second.get());
+      EXPECT_EQ(expected_pairs.size() - pairs.size(),
+                trajectory_evaluator->num_of_trajectory_pairs());
+    }
+    ASSERT_EQ(expected_pairs.size(), pairs.size());
+    // the same costs in the same order, only the pairs of the same cost may
+    // be taken in another order
+    for (size_t i = 0; i < pairs.size(); ++i) {
+      EXPECT_EQ(std::get<0>(expected_pairs[i]), std::get<0>(pairs[i]));
+    }
+    std::sort(pairs.begin(), pairs.end());
+    EXPECT_EQ(expected_pairs, pairs);
+  }
+  FLAGS_enable_parallel_lattice_evaluation = enable_parallel_lattice_evaluation;
+  FLAGS_weight_lat_offset = weight_lat_offset;
+}
+
+}  // namespace planning
+}  // namespace apollo
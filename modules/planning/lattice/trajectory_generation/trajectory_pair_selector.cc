@@ -0,0 +1,99 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/lattice/trajectory_generation/trajectory_pair_selector.h"
+
+#include <algorithm>
+#include <future>
+
+#include "cyber/common/log.h"
+#include "cyber/task/task.h"
+#include "modules/planning/common/planning_profiler.h"
+
+namespace apollo {
+namespace planning {
+
+TrajectoryPairSelector::TrajectoryPairSelector(const size_t num_checked_pairs,
+                                               const CheckFunc& check)
+    : num_checked_pairs_(std::max<size_t>(1, num_checked_pairs)),
+      check_(check) {}
+
+bool TrajectoryPairSelector::Select(TrajectoryEvaluator* trajectory_evaluator,
+                                    CheckedTrajectoryPair* selected_pair) {
+  CHECK_NOTNULL(trajectory_evaluator);
+  CHECK_NOTNULL(selected_pair);
+  std::vector<CheckedTrajectoryPair> checked_pairs;
+  size_t checked_pair_index = 0;
+  while (checked_pair_index < checked_pairs.size() ||
+         trajectory_evaluator->has_more_trajectory_pairs()) {
+    if (checked_pair_index == checked_pairs.size()) {
+      checked_pairs = CheckTopTrajectoryPairs(trajectory_evaluator);
+      checked_pair_index = 0;
+    }
+    auto& checked_pair = checked_pairs[checked_pair_index++];
+    if (checked_pair.result != ConstraintChecker::Result::VALID) {
+      ++combined_constraint_failure_count_;
+      ++constraint_failure_counts_[checked_pair.result];
+      continue;
+    }
+    if (checked_pair.in_collision) {
+      ++collision_failure_count_;
+      continue;
+    }
+    *selected_pair = std::move(checked_pair);
+    return true;
+  }
+  return false;
+}
+
+size_t TrajectoryPairSelector::constraint_failure_count(
+    const ConstraintChecker::Result result) const {
+  const auto it = constraint_failure_counts_.find(result);
+  return it == constraint_failure_counts_.end() ? 0 : it->second;
+}
+
+std::vector<CheckedTrajectoryPair>
+TrajectoryPairSelector::CheckTopTrajectoryPairs(
+    TrajectoryEvaluator* trajectory_evaluator) const {
+  PLANNING_PROFILE_SPAN("CheckTrajectoryPairs");
+  std::vector<CheckedTrajectoryPair> checked_pairs;
+  while (checked_pairs.size() < num_checked_pairs_ &&
+         trajectory_evaluator->has_more_trajectory_pairs()) {
+    CheckedTrajectoryPair checked_pair;
+    checked_pair.cost = trajectory_evaluator->top_trajectory_pair_cost();
+    checked_pair.trajectory_pair =
+        trajectory_evaluator->next_top_trajectory_pair();
+    checked_pairs.push_back(std::move(checked_pair));
+  }
+  std::vector<std::future<void>> futures;
+  for (size_t i = 1; i < checked_pairs.size(); ++i) {
+    futures.push_back(cyber::Async(check_, &checked_pairs[i]));
+  }
+  if (!checked_pairs.empty()) {
+    check_(&checked_pairs.front());
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+  return checked_pairs;
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "modules/planning/common/trajectory/discretized_trajectory.h"
+#include "modules/planning/constraint_checker/constraint_checker.h"
+#include "modules/planning/lattice/trajectory_generation/trajectory_evaluator.h"
+#include "modules/planning/math/curve1d/curve1d.h"
+
+namespace apollo {
+namespace planning {
+
+// a trajectory pair with its combined trajectory and the results of its checks
+struct CheckedTrajectoryPair {
+  double cost = 0.0;
+  std::pair<std::shared_ptr<Curve1d>, std::shared_ptr<Curve1d>>
+      trajectory_pair;
+  DiscretizedTrajectory combined_trajectory;
+  ConstraintChecker::Result result = ConstraintChecker::Result::VALID;
+  bool in_collision = false;
+};
+
+/**
+ * @class TrajectoryPairSelector
+ * @brief Selects the trajectory pair of the lowest cost passing the checks.
+ * The num_checked_pairs pairs of the lowest costs are checked concurrently,
+ * so the pairs after the first valid one are checked for nothing, but the
+ * selected pair and the failure counts are those of checking the pairs one by
+ * one.
+ */
+class TrajectoryPairSelector {
+ public:
+  // combines the trajectory pair and sets the results of its checks
+  using CheckFunc = std::function<void(CheckedTrajectoryPair*)>;
+
+  TrajectoryPairSelector(const size_t num_checked_pairs,
+                         const CheckFunc& check);
+
+  /**
+   * @brief Select the first valid trajectory pair in cost order
+   * @return false if no trajectory pair is valid
+   */
+  bool Select(TrajectoryEvaluator* trajectory_evaluator,
+              CheckedTrajectoryPair* selected_pair);
+
+  size_t constraint_failure_count(
+      const ConstraintChecker::Result result) const;
+
+  size_t combined_constraint_failure_count() const {
+    return combined_constraint_failure_count_;
+  }
+
+  size_t collision_failure_count() const { return collision_failure_count_; }
+
+ private:
+  // takes the num_checked_pairs_ trajectory pairs of the lowest costs, and
+  // checks them concurrently
+  std::vector<CheckedTrajectoryPair> CheckTopTrajectoryPairs(
+      TrajectoryEvaluator* trajectory_evaluator) const;
+
+  size_t num_checked_pairs_ = 1;
+  CheckFunc check_;
+
+  std::map<ConstraintChecker::Result, size_t> constraint_failure_counts_;
+  size_t combined_constraint_failure_count_ = 0;
+  size_t collision_failure_count_ = 0;
+};
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,218 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/lattice/trajectory_generation/trajectory_pair_selector.h"
+
+#include <atomic>
+#include <unordered_map>
+
+#include "gtest/gtest.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/lattice/trajectory_generation/lattice_trajectory1d.h"
+#include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
+#include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::PathPoint;
+using Result = ConstraintChecker::Result;
+
+class TrajectoryPairSelectorTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    auto reference_line = std::make_shared<std::vector<PathPoint>>();
+    for (int i = 0; i <= 400; ++i) {
+      PathPoint path_point;
+      path_point.set_x(static_cast<double>(i) * 0.5);
+      path_point.set_s(static_cast<double>(i) * 0.5);
+      path_point.set_kappa(0.0);
+      reference_line->push_back(path_point);
+    }
+    reference_line_ = reference_line;
+    path_time_graph_ = std::make_shared<PathTimeGraph>(
+        std::vector<const Obstacle*>(), *reference_line_, nullptr, init_s_[0],
+        init_s_[0] + FLAGS_speed_lon_decision_horizon, 0.0,
+        FLAGS_trajectory_time_length, init_d_);
+    planning_target_.set_cruise_speed(10.0);
+
+    for (const double end_v : {4.0, 6.0, 8.0, 10.0, 12.0}) {
+      for (const double end_t : {4.0, 6.0, 8.0}) {
+        lon_trajectories_.push_back(std::make_shared<LatticeTrajectory1d>(
+            std::make_shared<QuarticPolynomialCurve1d>(
+                init_s_, std::array<double, 2>{{end_v, 0.0}}, end_t)));
+      }
+    }
+    for (const double end_d : {-1.0, -0.5, 0.0, 0.5, 1.0}) {
+      for (const double end_s : {20.0, 40.0, 80.0}) {
+        lat_trajectories_.push_back(std::make_shared<LatticeTrajectory1d>(
+            std::make_shared<QuinticPolynomialCurve1d>(
+                init_d_, std::array<double, 3>{{end_d, 0.0, 0.0}}, end_s)));
+      }
+    }
+    for (size_t i = 0; i < lon_trajectories_.size(); ++i) {
+      indices_[lon_trajectories_[i].get()] = i;
+    }
+    for (size_t i = 0; i < lat_trajectories_.size(); ++i) {
+      indices_[lat_trajectories_[i].get()] = i;
+    }
+  }
+
+  std::unique_ptr<TrajectoryEvaluator> MakeEvaluator() const {
+    return std::make_unique<TrajectoryEvaluator>(
+        init_s_, planning_target_, lon_trajectories_, lat_trajectories_,
+        path_time_graph_, reference_line_);
+  }
+
+  // fails the pairs cheaper than min_valid_cost, and half of the others, in
+  // all the ways by their trajectories
+  TrajectoryPairSelector::CheckFunc MakeCheck(const double min_valid_cost) {
+    return [this, min_valid_cost](CheckedTrajectoryPair* checked_pair) {
+      ++num_checks_;
+      const size_t lon_index =
+          indices_.at(checked_pair->trajectory_pair.first.get());
+      const size_t lat_index =
+          indices_.at(checked_pair->trajectory_pair.second.get());
+      const size_t key = lon_index * 7 + lat_index * 3;
+      if (checked_pair->cost >= min_valid_cost && key % 2 == 0) {
+        return;
+      }
+      switch (key % 3) {
+        case 0:
+          checked_pair->result = Result::LON_JERK_OUT_OF_BOUND;
+          break;
+        case 1:
+          checked_pair->result = Result::LAT_ACCELERATION_OUT_OF_BOUND;
+          break;
+        default:
+          checked_pair->in_collision = true;
+          break;
+      }
+    };
+  }
+
+ protected:
+  const std::array<double, 3> init_s_ = {{0.0, 8.0, 0.0}};
+  const std::array<double, 3> init_d_ = {{0.3, 0.0, 0.0}};
+  std::shared_ptr<std::vector<PathPoint>> reference_line_;
+  std::shared_ptr<PathTimeGraph> path_time_graph_;
+  PlanningTarget planning_target_;
+  std::vector<std::shared_ptr<Curve1d>> lon_trajectories_;
+  std::vector<std::shared_ptr<Curve1d>> lat_trajectories_;
+  std::unordered_map<const Curve1d*, size_t> indices_;
+  std::atomic<size_t> num_checks_ = {0};
+};
+
+TEST_F(TrajectoryPairSelectorTest, select_first_valid_pair) {
+  std::vector<double> costs;
+  auto trajectory_evaluator = MakeEvaluator();
+  while (trajectory_evaluator->has_more_trajectory_pairs()) {
+    costs.push_back(trajectory_evaluator->top_trajectory_pair_cost());
+    trajectory_evaluator->next_top_trajectory_pair();
+  }
+  ASSERT_GT(costs.size(), 100);
+
+  // the valid pair is in the first batch, or after a few batches
+  for (const size_t num_invalid_pairs : {0, 5, 20, 100}) {
+    // the serial loop over the pairs in cost order
+    auto check = MakeCheck(costs[num_invalid_pairs]);
+    trajectory_evaluator = MakeEvaluator();
+    CheckedTrajectoryPair expected_pair;
+    size_t expected_lon_jerk_failure_count = 0;
+    size_t expected_lat_acc_failure_count = 0;
+    size_t expected_collision_failure_count = 0;
+    bool expected_found = false;
+    while (trajectory_evaluator->has_more_trajectory_pairs()) {
+      CheckedTrajectoryPair checked_pair;
+      checked_pair.cost = trajectory_evaluator->top_trajectory_pair_cost();
+      checked_pair.trajectory_pair =
+          trajectory_evaluator->next_top_trajectory_pair();
+      check(&checked_pair);
+      if (checked_pair.result == Result::LON_JERK_OUT_OF_BOUND) {
+        ++expected_lon_jerk_failure_count;
+      } else if (checked_pair.result == Result::LAT_ACCELERATION_OUT_OF_BOUND) {
+        ++expected_lat_acc_failure_count;
+      } else if (checked_pair.in_collision) {
+        ++expected_collision_failure_count;
+      } else {
+        expected_pair = checked_pair;
+        expected_found = true;
+        break;
+      }
+    }
+    ASSERT_TRUE(expected_found);
+    EXPECT_GE(expected_lon_jerk_failure_count +
+                  expected_lat_acc_failure_count +
+                  expected_collision_failure_count,
+              num_invalid_pairs);
+
+    for (const size_t num_checked_pairs : {1, 2, 8, 1000}) {
+      num_checks_ = 0;
+      TrajectoryPairSelector selector(num_checked_pairs, check);
+      trajectory_evaluator = MakeEvaluator();
+      CheckedTrajectoryPair selected_pair;
+      ASSERT_TRUE(selector.Select(trajectory_evaluator.get(), &selected_pair));
+      EXPECT_EQ(expected_pair.cost, selected_pair.cost);
+      EXPECT_EQ(expected_pair.trajectory_pair.first,
+                selected_pair.trajectory_pair.first);
+      EXPECT_EQ(expected_pair.trajectory_pair.second,
+                selected_pair.trajectory_pair.second);
+      EXPECT_EQ(Result::VALID, selected_pair.result);
+      EXPECT_FALSE(selected_pair.in_collision);
+      EXPECT_EQ(expected_lon_jerk_failure_count,
+                selector.constraint_failure_count(
+                    Result::LON_JERK_OUT_OF_BOUND));
+      EXPECT_EQ(expected_lat_acc_failure_count,
+                selector.constraint_failure_count(
+                    Result::LAT_ACCELERATION_OUT_OF_BOUND));
+      EXPECT_EQ(0, selector.constraint_failure_count(
+                       Result::CURVATURE_OUT_OF_BOUND));
+      EXPECT_EQ(
+          expected_lon_jerk_failure_count + expected_lat_acc_failure_count,
+          selector.combined_constraint_failure_count());
+      EXPECT_EQ(expected_collision_failure_count,
+                selector.collision_failure_count());
+      // the pairs after the selected one in the last batch are checked too
+      EXPECT_GE(num_checks_, expected_lon_jerk_failure_count +
+                                 expected_lat_acc_failure_count +
+                                 expected_collision_failure_count);
+    }
+  }
+}
+
+TEST_F(TrajectoryPairSelectorTest, select_no_pair) {
+  auto fail = [](CheckedTrajectoryPair* checked_pair) {
+    checked_pair->in_collision = true;
+  };
+  for (const size_t num_checked_pairs : {1, 8}) {
+    auto trajectory_evaluator = MakeEvaluator();
+    const size_t num_pairs = trajectory_evaluator->num_of_trajectory_pairs();
+    EXPECT_GT(num_pairs, 0);
+    TrajectoryPairSelector selector(num_checked_pairs, fail);
+    CheckedTrajectoryPair selected_pair;
+    EXPECT_FALSE(selector.Select(trajectory_evaluator.get(), &selected_pair));
+    EXPECT_FALSE(trajectory_evaluator->has_more_trajectory_pairs());
+    EXPECT_EQ(num_pairs, selector.collision_failure_count());
+    EXPECT_EQ(0, selector.combined_constraint_failure_count());
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
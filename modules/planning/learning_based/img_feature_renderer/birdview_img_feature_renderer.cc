@@ -623,15 +623,13 @@ bool BirdviewImgFeatureRenderer::CropByPose(const double ego_x,
   cv::Mat rotation_matrix =
       cv::getRotationMatrix2D(cv::Point2i(rough_radius, rough_radius),
                               90.0 - ego_heading * 180.0 / M_PI, 1.0);
-  cv::Mat rotated_mat;
-  cv::warpAffine(base_map(rough_rect), rotated_mat, rotation_matrix,
-                 base_map(rough_rect).size());
 
-  cv::Rect fine_rect(rough_radius - config_.ego_idx_x(),
-                     rough_radius - config_.ego_idx_y(), config_.height(),
-                     config_.width());
-
-  rotated_mat(fine_rect).copyTo(*img_feature);
+  // shift the rotated rough rect to the fine rect around ego, so that only
+  // the pixels of img_feature are warped instead of the whole rough rect
+  rotation_matrix.at<double>(0, 2) -= rough_radius - config_.ego_idx_x();
+  rotation_matrix.at<double>(1, 2) -= rough_radius - config_.ego_idx_y();
+  cv::warpAffine(base_map(rough_rect), *img_feature, rotation_matrix,
+                 cv::Size(config_.height(), config_.width()));
   return true;
 }
 
@@ -16,16 +16,98 @@
 
 #include "modules/planning/math/piecewise_jerk/piecewise_jerk_problem.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
 #include "cyber/common/log.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 
 namespace apollo {
 namespace planning {
 
 namespace {
 constexpr double kMaxVariableRange = 1.0e10;
+
+// Samples a block of the previous solution, whose k-th value sits at
+// start + k * delta, at the knots of the new problem, holding the end value
+// beyond the previous horizon. With keep_last, the last value stays at the
+// last knot and the others are sampled from the previous ones before it,
+// which suits the duals of the terminal knot.
+void ShiftBlock(const c_float* prev, const size_t size, const double offset,
+                const double ratio, const bool keep_last, c_float* curr) {
+  const size_t num_sampled = keep_last && size > 1 ? size - 1 : size;
+  const double max_k = static_cast<double>(num_sampled - 1);
+  for (size_t i = 0; i < num_sampled; ++i) {
+    const double k =
+        std::min(std::max(offset + static_cast<double>(i) * ratio, 0.0),
+                 max_k);
+    const size_t k0 = static_cast<size_t>(k);
+    const size_t k1 = std::min(k0 + 1, num_sampled - 1);
+    const double w = k - static_cast<double>(k0);
+    curr[i] = (1.0 - w) * prev[k0] + w * prev[k1];
+  }
+  if (num_sampled < size) {
+    curr[size - 1] = prev[size - 1];
+  }
+}
+
+// The values of the kernel in the layout kept by the OSQP workspace, which
+// drops the entries below the diagonal in some versions.
+bool GetKeptKernelValues(const std::vector<c_float>& P_data,
+                         const std::vector<c_int>& P_indices,
+                         const std::vector<c_int>& P_indptr,
+                         const size_t num_kept, std::vector<c_float>* values) {
+  if (P_data.size() == num_kept) {
+    *values = P_data;
+    return true;
+  }
+  values->clear();
+  for (size_t col = 0; col + 1 < P_indptr.size(); ++col) {
+    for (c_int k = P_indptr[col]; k < P_indptr[col + 1]; ++k) {
+      if (P_indices[k] <= static_cast<c_int>(col)) {
+        values->push_back(P_data[k]);
+      }
+    }
+  }
+  return values->size() == num_kept;
+}
 }  // namespace
 
+void PiecewiseJerkOsqpWorkspace::Reset() {
+  if (work_ != nullptr) {
+    osqp_cleanup(work_);
+    work_ = nullptr;
+  }
+  P_indices_.clear();
+  P_indptr_.clear();
+  A_indices_.clear();
+  A_indptr_.clear();
+  primal_.clear();
+  dual_.clear();
+}
+
+PiecewiseJerkOsqpWorkspace* PiecewiseJerkOsqpWorkspacePool::Get(
+    const std::string& key, const uint32_t sequence_num) {
+  if (sequence_num != sequence_num_) {
+    for (auto iter = workspaces_.begin(); iter != workspaces_.end();) {
+      if (iter->second.sequence_num != sequence_num_) {
+        iter = workspaces_.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+    sequence_num_ = sequence_num;
+  }
+  auto& entry = workspaces_[key];
+  if (entry.workspace == nullptr) {
+    entry.workspace = std::make_unique<PiecewiseJerkOsqpWorkspace>();
+  }
+  entry.sequence_num = sequence_num;
+  return entry.workspace.get();
+}
+
 PiecewiseJerkProblem::PiecewiseJerkProblem(
     const size_t num_of_knots, const double delta_s,
     const std::array<double, 3>& x_init) {
@@ -97,7 +179,10 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   osqp_work = osqp_setup(data, settings);
   // osqp_setup(&osqp_work, data, settings);
 
-  osqp_solve(osqp_work);
+  {
+    PLANNING_PROFILE_SPAN("OsqpSolve");
+    osqp_solve(osqp_work);
+  }
 
   auto status = osqp_work->info->status_val;
 
@@ -116,15 +201,7 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   }
 
   // extract primal results
-  x_.resize(num_of_knots_);
-  dx_.resize(num_of_knots_);
-  ddx_.resize(num_of_knots_);
-  for (size_t i = 0; i < num_of_knots_; ++i) {
-    x_.at(i) = osqp_work->solution->x[i] / scale_factor_[0];
-    dx_.at(i) = osqp_work->solution->x[i + num_of_knots_] / scale_factor_[1];
-    ddx_.at(i) =
-        osqp_work->solution->x[i + 2 * num_of_knots_] / scale_factor_[2];
-  }
+  ExtractSolution(*osqp_work->solution);
 
   // Cleanup
   osqp_cleanup(osqp_work);
@@ -133,6 +210,212 @@ bool PiecewiseJerkProblem::Optimize(const int max_iter) {
   return true;
 }
 
+bool PiecewiseJerkProblem::Optimize(const int max_iter, const double start_s,
+                                    PiecewiseJerkOsqpWorkspace* workspace) {
+  CHECK_NOTNULL(workspace);
+  const auto start_time = std::chrono::system_clock::now();
+
+  std::vector<c_float> P_data;
+  std::vector<c_int> P_indices;
+  std::vector<c_int> P_indptr;
+  CalculateKernel(&P_data, &P_indices, &P_indptr);
+
+  std::vector<c_float> A_data;
+  std::vector<c_int> A_indices;
+  std::vector<c_int> A_indptr;
+  std::vector<c_float> lower_bounds;
+  std::vector<c_float> upper_bounds;
+  CalculateAffineConstraint(&A_data, &A_indices, &A_indptr, &lower_bounds,
+                            &upper_bounds);
+
+  std::vector<c_float> q;
+  CalculateOffset(&q);
+  CHECK_EQ(lower_bounds.size(), upper_bounds.size());
+
+  const size_t kernel_dim = 3 * num_of_knots_;
+  const size_t num_affine_constraint = lower_bounds.size();
+
+  OSQPWorkspace*& osqp_work = workspace->work_;
+  workspace->is_reused_ =
+      osqp_work != nullptr &&
+      osqp_work->data->n == static_cast<c_int>(kernel_dim) &&
+      osqp_work->data->m == static_cast<c_int>(num_affine_constraint) &&
+      workspace->P_indices_ == P_indices && workspace->P_indptr_ == P_indptr &&
+      workspace->A_indices_ == A_indices && workspace->A_indptr_ == A_indptr;
+  if (workspace->is_reused_) {
+    // the sparsity is unchanged, only the values are updated
+    std::vector<c_float> P_values;
+    c_int exitflag = -1;
+    if (GetKeptKernelValues(P_data, P_indices, P_indptr,
+                            osqp_work->data->P->p[kernel_dim], &P_values)) {
+      exitflag = osqp_update_P_A(
+          osqp_work, P_values.data(), OSQP_NULL,
+          static_cast<c_int>(P_values.size()), A_data.data(), OSQP_NULL,
+          static_cast<c_int>(A_data.size()));
+    }
+    if (exitflag == 0) {
+      exitflag = osqp_update_lin_cost(osqp_work, q.data());
+    }
+    if (exitflag == 0) {
+      exitflag = osqp_update_bounds(osqp_work, lower_bounds.data(),
+                                    upper_bounds.data());
+    }
+    if (exitflag == 0) {
+      exitflag = osqp_update_max_iter(osqp_work, max_iter);
+    }
+    if (exitflag != 0) {
+      AERROR << "Fail to update the OSQP workspace, exitflag: " << exitflag;
+      workspace->is_reused_ = false;
+    }
+  }
+
+  if (!workspace->is_reused_) {
+    workspace->Reset();
+    OSQPData data;
+    data.n = kernel_dim;
+    data.m = num_affine_constraint;
+    data.P = csc_matrix(kernel_dim, kernel_dim, P_data.size(), P_data.data(),
+                        P_indices.data(), P_indptr.data());
+    data.q = q.data();
+    data.A = csc_matrix(num_affine_constraint, kernel_dim, A_data.size(),
+                        A_data.data(), A_indices.data(), A_indptr.data());
+    data.l = lower_bounds.data();
+    data.u = upper_bounds.data();
+
+    OSQPSettings* settings = SolverDefaultSettings();
+    settings->max_iter = max_iter;
+    // osqp_setup copies the data
+    osqp_work = osqp_setup(&data, settings);
+    c_free(data.P);
+    c_free(data.A);
+    c_free(settings);
+    if (osqp_work == nullptr) {
+      AERROR << "Fail to set up the OSQP workspace";
+      return false;
+    }
+    workspace->P_indices_ = std::move(P_indices);
+    workspace->P_indptr_ = std::move(P_indptr);
+    workspace->A_indices_ = std::move(A_indices);
+    workspace->A_indptr_ = std::move(A_indptr);
+  }
+
+  workspace->is_warm_started_ =
+      workspace->is_reused_ && workspace->primal_.size() == kernel_dim &&
+      workspace->dual_.size() == num_affine_constraint &&
+      workspace->delta_s_ > 0.0 && delta_s_ > 0.0 &&
+      workspace->scale_factor_ == scale_factor_;
+  if (workspace->is_reused_) {
+    // a reused workspace otherwise starts from the unshifted last solution
+    std::vector<c_float> primal(kernel_dim, 0.0);
+    std::vector<c_float> dual(num_affine_constraint, 0.0);
+    if (workspace->is_warm_started_) {
+      ShiftPreviousSolution(*workspace, start_s, &primal, &dual);
+    }
+    osqp_warm_start(osqp_work, primal.data(), dual.data());
+  }
+
+  {
+    PLANNING_PROFILE_SPAN("OsqpSolve");
+    osqp_solve(osqp_work);
+  }
+
+  const auto end_time = std::chrono::system_clock::now();
+  const std::chrono::duration<double> diff = end_time - start_time;
+  workspace->num_iterations_ = static_cast<int>(osqp_work->info->iter);
+  workspace->solve_time_ = diff.count();
+  ADEBUG << "OSQP workspace reused: " << workspace->is_reused_
+         << ", warm started: " << workspace->is_warm_started_
+         << ", iterations: " << workspace->num_iterations_
+         << ", time: " << workspace->solve_time_ * 1000.0 << " ms.";
+
+  auto status = osqp_work->info->status_val;
+  if (status < 0 || (status != 1 && status != 2)) {
+    AERROR << "failed optimization status:\t" << osqp_work->info->status;
+    workspace->Reset();
+    return false;
+  } else if (osqp_work->solution == nullptr) {
+    AERROR << "The solution from OSQP is nullptr";
+    workspace->Reset();
+    return false;
+  }
+
+  ExtractSolution(*osqp_work->solution);
+
+  workspace->primal_.assign(osqp_work->solution->x,
+                            osqp_work->solution->x + kernel_dim);
+  workspace->dual_.assign(osqp_work->solution->y,
+                          osqp_work->solution->y + num_affine_constraint);
+  workspace->start_s_ = start_s;
+  workspace->delta_s_ = delta_s_;
+  workspace->scale_factor_ = scale_factor_;
+  return true;
+}
+
+void PiecewiseJerkProblem::ExtractSolution(const OSQPSolution& solution) {
+  x_.resize(num_of_knots_);
+  dx_.resize(num_of_knots_);
+  ddx_.resize(num_of_knots_);
+  for (size_t i = 0; i < num_of_knots_; ++i) {
+    x_.at(i) = solution.x[i] / scale_factor_[0];
+    dx_.at(i) = solution.x[i + num_of_knots_] / scale_factor_[1];
+    ddx_.at(i) = solution.x[i + 2 * num_of_knots_] / scale_factor_[2];
+  }
+}
+
+void PiecewiseJerkProblem::ShiftPreviousSolution(
+    const PiecewiseJerkOsqpWorkspace& workspace, const double start_s,
+    std::vector<c_float>* primal, std::vector<c_float>* dual) const {
+  const size_t n = num_of_knots_;
+  const double offset = (start_s - workspace.start_s_) / workspace.delta_s_;
+  const double ratio = delta_s_ / workspace.delta_s_;
+
+  // x, x', x''
+  for (size_t i = 0; i < 3; ++i) {
+    ShiftBlock(workspace.primal_.data() + i * n, n, offset, ratio, false,
+               primal->data() + i * n);
+  }
+  // beyond the previous horizon, roll out the last knot with constant x''
+  // to keep the start consistent with the dynamics
+  const double last_x = workspace.primal_[n - 1] / scale_factor_[0];
+  const double last_dx = workspace.primal_[2 * n - 1] / scale_factor_[1];
+  const double last_ddx = workspace.primal_[3 * n - 1] / scale_factor_[2];
+  for (size_t i = 0; i < n; ++i) {
+    const double ds = (offset + static_cast<double>(i) * ratio -
+                       static_cast<double>(n - 1)) *
+                      workspace.delta_s_;
+    if (ds <= 0.0) {
+      continue;
+    }
+    primal->at(i) =
+        (last_x + last_dx * ds + 0.5 * last_ddx * ds * ds) * scale_factor_[0];
+    primal->at(n + i) = (last_dx + last_ddx * ds) * scale_factor_[1];
+  }
+  if (is_x_relative_to_start()) {
+    const double x_offset = x_init_[0] * scale_factor_[0] - primal->front();
+    for (size_t i = 0; i < n; ++i) {
+      primal->at(i) += x_offset;
+    }
+  }
+
+  // the bounds on x, x', x'' and the 3 (n - 1) constraints between the
+  // knots, in the order of CalculateAffineConstraint, while the duals of the
+  // constraints on x_init stay
+  size_t index = 0;
+  for (size_t i = 0; i < 3; ++i) {
+    ShiftBlock(workspace.dual_.data() + index, n, offset, ratio, true,
+               dual->data() + index);
+    index += n;
+  }
+  for (size_t i = 0; i < 3; ++i) {
+    ShiftBlock(workspace.dual_.data() + index, n - 1, offset, ratio, true,
+               dual->data() + index);
+    index += n - 1;
+  }
+  CHECK_EQ(index + 3, dual->size());
+  std::copy(workspace.dual_.begin() + index, workspace.dual_.end(),
+            dual->begin() + index);
+}
+
 void PiecewiseJerkProblem::CalculateAffineConstraint(
     std::vector<c_float>* A_data, std::vector<c_int>* A_indices,
     std::vector<c_int>* A_indptr, std::vector<c_float>* lower_bounds,
@@ -20,7 +20,11 @@
 
 #pragma once
 
+#include <array>
+#include <memory>
+#include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -29,6 +33,80 @@
 namespace apollo {
 namespace planning {
 
+/*
+ * @brief:
+ * The OSQP workspace of a PiecewiseJerkProblem kept across solves. When the
+ * next problem has the same sparsity, its kernel, offset and bounds are
+ * updated in the workspace instead of setting up and factorizing the KKT
+ * system again, and the solver is warm started from the previous solution
+ * shifted to the new start.
+ */
+class PiecewiseJerkOsqpWorkspace {
+ public:
+  PiecewiseJerkOsqpWorkspace() = default;
+
+  PiecewiseJerkOsqpWorkspace(const PiecewiseJerkOsqpWorkspace&) = delete;
+  PiecewiseJerkOsqpWorkspace& operator=(const PiecewiseJerkOsqpWorkspace&) =
+      delete;
+
+  ~PiecewiseJerkOsqpWorkspace() { Reset(); }
+
+  void Reset();
+
+  // whether the last solve updated the workspace of the previous one
+  bool is_reused() const { return is_reused_; }
+
+  // whether the last solve started from the shifted previous solution
+  bool is_warm_started() const { return is_warm_started_; }
+
+  int num_iterations() const { return num_iterations_; }
+
+  // time of the last solve including the setup or update, in seconds
+  double solve_time() const { return solve_time_; }
+
+ private:
+  friend class PiecewiseJerkProblem;
+
+  OSQPWorkspace* work_ = nullptr;
+
+  std::vector<c_int> P_indices_;
+  std::vector<c_int> P_indptr_;
+  std::vector<c_int> A_indices_;
+  std::vector<c_int> A_indptr_;
+
+  // previous solution in the scaled variables of the solver
+  std::vector<c_float> primal_;
+  std::vector<c_float> dual_;
+  double start_s_ = 0.0;
+  double delta_s_ = 0.0;
+  std::array<double, 3> scale_factor_ = {{1.0, 1.0, 1.0}};
+
+  bool is_reused_ = false;
+  bool is_warm_started_ = false;
+  int num_iterations_ = 0;
+  double solve_time_ = 0.0;
+};
+
+/*
+ * @brief:
+ * The workspaces of the problems a task solves in each planning cycle, by a
+ * key naming the problem, e.g. the reference line and the path boundary.
+ * The workspaces not used in the previous cycle are released.
+ */
+class PiecewiseJerkOsqpWorkspacePool {
+ public:
+  PiecewiseJerkOsqpWorkspace* Get(const std::string& key,
+                                  const uint32_t sequence_num);
+
+ private:
+  struct Entry {
+    std::unique_ptr<PiecewiseJerkOsqpWorkspace> workspace;
+    uint32_t sequence_num = 0;
+  };
+  std::unordered_map<std::string, Entry> workspaces_;
+  uint32_t sequence_num_ = 0;
+};
+
 /*
  * @brief:
  * This class solve an optimization problem:
@@ -110,6 +188,16 @@ class PiecewiseJerkProblem {
 
   virtual bool Optimize(const int max_iter = 4000);
 
+  /**
+   * @brief Optimize in the workspace kept from the previous solve
+   *
+   * @param max_iter: max iterations of OSQP
+   * @param start_s: s of the first knot, to shift the previous solution
+   * @param workspace: the workspace, set up again when the sparsity changes
+   */
+  bool Optimize(const int max_iter, const double start_s,
+                PiecewiseJerkOsqpWorkspace* workspace);
+
   const std::vector<double>& opt_x() const { return x_; }
 
   const std::vector<double>& opt_dx() const { return dx_; }
@@ -132,8 +220,19 @@ class PiecewiseJerkProblem {
 
   virtual OSQPSettings* SolverDefaultSettings();
 
+  // Whether x is measured from the first knot, so the shifted previous
+  // solution is offset to x_init as well, e.g. s in the speed problem.
+  virtual bool is_x_relative_to_start() const { return false; }
+
   OSQPData* FormulateProblem();
 
+  void ExtractSolution(const OSQPSolution& solution);
+
+  void ShiftPreviousSolution(const PiecewiseJerkOsqpWorkspace& workspace,
+                             const double start_s,
+                             std::vector<c_float>* primal,
+                             std::vector<c_float>* dual) const;
+
   void FreeData(OSQPData* data);
 
   template <typename T>
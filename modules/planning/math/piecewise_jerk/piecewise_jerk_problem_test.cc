@@ -0,0 +1,228 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/math/piecewise_jerk/piecewise_jerk_problem.h"
+
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/planning/math/piecewise_jerk/piecewise_jerk_path_problem.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+constexpr double kDeltaS = 1.0;
+constexpr int kMaxIter = 4000;
+
+// a path problem with the x'' coupling terms optionally dropped from the
+// kernel, which changes its sparsity but not its size
+class TestPathProblem : public PiecewiseJerkPathProblem {
+ public:
+  using PiecewiseJerkPathProblem::PiecewiseJerkPathProblem;
+
+  void set_drop_coupling(const bool drop_coupling) {
+    drop_coupling_ = drop_coupling;
+  }
+
+  void ShiftSolution(const PiecewiseJerkOsqpWorkspace& workspace,
+                     const double start_s, std::vector<c_float>* primal,
+                     std::vector<c_float>* dual) const {
+    ShiftPreviousSolution(workspace, start_s, primal, dual);
+  }
+
+ protected:
+  void CalculateKernel(std::vector<c_float>* P_data,
+                       std::vector<c_int>* P_indices,
+                       std::vector<c_int>* P_indptr) override {
+    PiecewiseJerkPathProblem::CalculateKernel(P_data, P_indices, P_indptr);
+    if (!drop_coupling_) {
+      return;
+    }
+    std::vector<c_float> data;
+    std::vector<c_int> indices;
+    std::vector<c_int> indptr;
+    for (size_t col = 0; col + 1 < P_indptr->size(); ++col) {
+      indptr.push_back(static_cast<c_int>(data.size()));
+      for (c_int k = P_indptr->at(col); k < P_indptr->at(col + 1); ++k) {
+        if (P_indices->at(k) == static_cast<c_int>(col)) {
+          data.push_back(P_data->at(k));
+          indices.push_back(P_indices->at(k));
+        }
+      }
+    }
+    indptr.push_back(static_cast<c_int>(data.size()));
+    *P_data = std::move(data);
+    *P_indices = std::move(indices);
+    *P_indptr = std::move(indptr);
+  }
+
+ private:
+  bool drop_coupling_ = false;
+};
+
+// a lane narrowed by an obstacle around s = 30, with the bounds given in s
+// so that the problem of a later start covers the same road
+std::unique_ptr<TestPathProblem> MakePathProblem(const size_t num_of_knots,
+                                                 const double start_s) {
+  auto problem = std::make_unique<TestPathProblem>(
+      num_of_knots, kDeltaS, std::array<double, 3>{{0.5, 0.0, 0.0}});
+  std::vector<std::pair<double, double>> x_bounds;
+  for (size_t i = 0; i < num_of_knots; ++i) {
+    const double s = start_s + static_cast<double>(i) * kDeltaS;
+    const double lower_bound = std::abs(s - 30.0) < 5.0 ? 1.0 : -2.0;
+    x_bounds.emplace_back(lower_bound, 2.0);
+  }
+  problem->set_x_bounds(std::move(x_bounds));
+  problem->set_dx_bounds(-2.0, 2.0);
+  problem->set_ddx_bounds(-1.0, 1.0);
+  problem->set_dddx_bound(1.0);
+  problem->set_weight_x(1.0);
+  problem->set_weight_dx(10.0);
+  problem->set_weight_ddx(100.0);
+  problem->set_weight_dddx(1000.0);
+  return problem;
+}
+
+void ExpectSameSolution(const PiecewiseJerkProblem& expected,
+                        const PiecewiseJerkProblem& actual,
+                        const double tolerance) {
+  ASSERT_EQ(expected.opt_x().size(), actual.opt_x().size());
+  for (size_t i = 0; i < expected.opt_x().size(); ++i) {
+    EXPECT_NEAR(expected.opt_x()[i], actual.opt_x()[i], tolerance);
+    EXPECT_NEAR(expected.opt_dx()[i], actual.opt_dx()[i], tolerance);
+    EXPECT_NEAR(expected.opt_ddx()[i], actual.opt_ddx()[i], tolerance);
+  }
+}
+
+}  // namespace
+
+TEST(PiecewiseJerkProblemTest, WarmSolveMatchesColdSolve) {
+  PiecewiseJerkOsqpWorkspace workspace;
+  auto first = MakePathProblem(50, 0.0);
+  EXPECT_TRUE(first->Optimize(kMaxIter, 0.0, &workspace));
+  EXPECT_FALSE(workspace.is_reused());
+  EXPECT_FALSE(workspace.is_warm_started());
+
+  for (const double start_s : {2.0, 4.5, 7.0}) {
+    auto warm = MakePathProblem(50, start_s);
+    EXPECT_TRUE(warm->Optimize(kMaxIter, start_s, &workspace));
+    EXPECT_TRUE(workspace.is_reused());
+    EXPECT_TRUE(workspace.is_warm_started());
+    EXPECT_GT(workspace.num_iterations(), 0);
+
+    auto cold = MakePathProblem(50, start_s);
+    EXPECT_TRUE(cold->Optimize(kMaxIter));
+    ExpectSameSolution(*cold, *warm, 1e-2);
+  }
+}
+
+TEST(PiecewiseJerkProblemTest, ResetWorkspaceOnChangedProblem) {
+  PiecewiseJerkOsqpWorkspace workspace;
+  auto first = MakePathProblem(50, 0.0);
+  EXPECT_TRUE(first->Optimize(kMaxIter, 0.0, &workspace));
+
+  // more knots
+  auto longer = MakePathProblem(60, 1.0);
+  EXPECT_TRUE(longer->Optimize(kMaxIter, 1.0, &workspace));
+  EXPECT_FALSE(workspace.is_reused());
+  EXPECT_FALSE(workspace.is_warm_started());
+  auto cold_longer = MakePathProblem(60, 1.0);
+  EXPECT_TRUE(cold_longer->Optimize(kMaxIter));
+  ExpectSameSolution(*cold_longer, *longer, 1e-2);
+
+  // same size, other sparsity
+  auto decoupled = MakePathProblem(60, 2.0);
+  decoupled->set_drop_coupling(true);
+  EXPECT_TRUE(decoupled->Optimize(kMaxIter, 2.0, &workspace));
+  EXPECT_FALSE(workspace.is_reused());
+  EXPECT_FALSE(workspace.is_warm_started());
+  auto cold_decoupled = MakePathProblem(60, 2.0);
+  cold_decoupled->set_drop_coupling(true);
+  EXPECT_TRUE(cold_decoupled->Optimize(kMaxIter));
+  ExpectSameSolution(*cold_decoupled, *decoupled, 1e-2);
+
+  // the workspace is kept again for the next problem of the same sparsity
+  auto next = MakePathProblem(60, 3.0);
+  next->set_drop_coupling(true);
+  EXPECT_TRUE(next->Optimize(kMaxIter, 3.0, &workspace));
+  EXPECT_TRUE(workspace.is_reused());
+  EXPECT_TRUE(workspace.is_warm_started());
+}
+
+TEST(PiecewiseJerkProblemTest, ShiftPreviousSolution) {
+  const size_t n = 50;
+  PiecewiseJerkOsqpWorkspace workspace;
+  auto first = MakePathProblem(n, 0.0);
+  EXPECT_TRUE(first->Optimize(kMaxIter, 0.0, &workspace));
+
+  const size_t shift = 3;
+  auto next = MakePathProblem(n, static_cast<double>(shift) * kDeltaS);
+  std::vector<c_float> primal(3 * n, 0.0);
+  std::vector<c_float> dual(3 * n + 3 * (n - 1) + 3, 0.0);
+  next->ShiftSolution(workspace, static_cast<double>(shift) * kDeltaS,
+                      &primal, &dual);
+  for (size_t i = 0; i + shift < n; ++i) {
+    EXPECT_NEAR(first->opt_x()[i + shift], primal[i], 1e-9);
+    EXPECT_NEAR(first->opt_dx()[i + shift], primal[n + i], 1e-9);
+    EXPECT_NEAR(first->opt_ddx()[i + shift], primal[2 * n + i], 1e-9);
+  }
+  // beyond the previous horizon the last knot is rolled out
+  const double last_x = first->opt_x().back();
+  const double last_dx = first->opt_dx().back();
+  const double last_ddx = first->opt_ddx().back();
+  for (size_t i = n - shift; i < n; ++i) {
+    const double ds = static_cast<double>(i + shift - (n - 1)) * kDeltaS;
+    EXPECT_NEAR(last_x + last_dx * ds + 0.5 * last_ddx * ds * ds, primal[i],
+                1e-9);
+    EXPECT_NEAR(last_dx + last_ddx * ds, primal[n + i], 1e-9);
+  }
+}
+
+TEST(PiecewiseJerkProblemTest, WorkspacePool) {
+  PiecewiseJerkOsqpWorkspacePool pool;
+  auto* workspace_a = pool.Get("a", 1);
+  auto* workspace_b = pool.Get("b", 1);
+  EXPECT_NE(workspace_a, workspace_b);
+  EXPECT_EQ(workspace_a, pool.Get("a", 1));
+
+  auto problem = MakePathProblem(50, 0.0);
+  EXPECT_TRUE(problem->Optimize(kMaxIter, 0.0, workspace_b));
+  EXPECT_GT(workspace_b->num_iterations(), 0);
+
+  // both were used in the previous cycle and are reused
+  EXPECT_EQ(workspace_a, pool.Get("a", 2));
+  EXPECT_EQ(workspace_b, pool.Get("b", 2));
+  EXPECT_GT(workspace_b->num_iterations(), 0);
+
+  // b is not used in cycle 3, so it is released in cycle 4
+  EXPECT_EQ(workspace_a, pool.Get("a", 3));
+  EXPECT_EQ(workspace_a, pool.Get("a", 4));
+  auto* new_workspace_b = pool.Get("b", 4);
+  EXPECT_EQ(0, new_workspace_b->num_iterations());
+  EXPECT_FALSE(new_workspace_b->is_reused());
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -66,6 +66,8 @@ class PiecewiseJerkSpeedProblem : public PiecewiseJerkProblem {
 
   OSQPSettings* SolverDefaultSettings() override;
 
+  bool is_x_relative_to_start() const override { return true; }
+
   bool has_dx_ref_ = false;
   double weight_dx_ref_ = 0.0;
   double dx_ref_ = 0.0;
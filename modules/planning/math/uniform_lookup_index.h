@@ -0,0 +1,164 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Lower bound queries in O(1) on the points sorted by a key, such as
+ * the s of a discretized path or the t of a speed profile.
+ **/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class UniformLookupIndex
+ * @brief Splits the key range of the points into as many buckets of the same
+ * size as the points, and keeps the lower bound of the start of each bucket.
+ * A query only searches the points of its bucket, which are very few unless
+ * the keys are strongly clustered.
+ *
+ * The index does not refer to the points. Each result is checked against its
+ * neighbor points, so the queries on points modified after Build, e.g. by a
+ * push_back, are still right and fall back to the binary search over all the
+ * points.
+ */
+class UniformLookupIndex {
+ public:
+  // below this size, std::lower_bound is as fast as the index
+  static constexpr size_t kMinIndexedSize = 16;
+
+  /**
+   * @brief Build the index of the points, whose keys must be non-decreasing.
+   * @param key The key of a point, e.g. its s.
+   */
+  template <typename Points, typename KeyFunc>
+  void Build(const Points& points, const KeyFunc& key) {
+    Clear();
+    if (points.size() < kMinIndexedSize) {
+      return;
+    }
+    const double min_key = key(points.front());
+    const double max_key = key(points.back());
+    if (!(max_key > min_key)) {
+      return;
+    }
+    const size_t num_buckets = points.size();
+    const double resolution =
+        (max_key - min_key) / static_cast<double>(num_buckets);
+    min_key_ = min_key;
+    inv_resolution_ = 1.0 / resolution;
+    bucket_begins_.resize(num_buckets + 1);
+    size_t index = 0;
+    for (size_t i = 0; i < num_buckets; ++i) {
+      const double bucket_start =
+          min_key + static_cast<double>(i) * resolution;
+      while (index < points.size() && key(points[index]) < bucket_start) {
+        ++index;
+      }
+      bucket_begins_[i] = index;
+    }
+    bucket_begins_[num_buckets] = points.size();
+    indexed_size_ = points.size();
+  }
+
+  void Clear() {
+    bucket_begins_.clear();
+    indexed_size_ = 0;
+  }
+
+  /**
+   * @brief The index of the first point whose key is not less than value, as
+   * std::lower_bound.
+   */
+  template <typename Points, typename KeyFunc>
+  size_t LowerBound(const Points& points, const KeyFunc& key,
+                    const double value) const {
+    const auto less = [&key](const typename Points::value_type& point,
+                             const double target) {
+      return key(point) < target;
+    };
+    size_t first = 0;
+    size_t last = 0;
+    if (BucketRange(points.size(), value, &first, &last)) {
+      const size_t index = static_cast<size_t>(
+          std::lower_bound(points.begin() + first, points.begin() + last,
+                           value, less) -
+          points.begin());
+      if ((index == 0 || key(points[index - 1]) < value) &&
+          (index == points.size() || !(key(points[index]) < value))) {
+        return index;
+      }
+    }
+    return static_cast<size_t>(
+        std::lower_bound(points.begin(), points.end(), value, less) -
+        points.begin());
+  }
+
+  /**
+   * @brief LowerBound of the values queried in non-decreasing order.
+   * @param hint The lower bound of the previous value. Unless value is a few
+   * points after it, it is found through the index.
+   */
+  template <typename Points, typename KeyFunc>
+  size_t NextLowerBound(const Points& points, const KeyFunc& key,
+                        const double value, const size_t hint) const {
+    static constexpr size_t kMaxForwardSteps = 4;
+    if (hint <= points.size() &&
+        (hint == 0 || key(points[hint - 1]) < value)) {
+      const size_t last = std::min(points.size(), hint + kMaxForwardSteps);
+      for (size_t index = hint; index <= last; ++index) {
+        if (index == points.size() || !(key(points[index]) < value)) {
+          return index;
+        }
+      }
+    }
+    return LowerBound(points, key, value);
+  }
+
+ private:
+  // the range of the points holding the lower bounds of the values in a
+  // bucket
+  bool BucketRange(const size_t num_points, const double value,
+                   size_t* const first, size_t* const last) const {
+    if (indexed_size_ == 0 || indexed_size_ != num_points) {
+      return false;
+    }
+    const size_t num_buckets = bucket_begins_.size() - 1;
+    // nan goes to the first bucket, and fails the check of the result
+    const double bucket = std::min(
+        std::max(0.0, (value - min_key_) * inv_resolution_),
+        static_cast<double>(num_buckets - 1));
+    const size_t bucket_index = static_cast<size_t>(bucket);
+    *first = bucket_begins_[bucket_index];
+    *last = bucket_begins_[bucket_index + 1];
+    return true;
+  }
+
+ private:
+  double min_key_ = 0.0;
+  double inv_resolution_ = 0.0;
+  size_t indexed_size_ = 0;
+  std::vector<size_t> bucket_begins_;
+};
+
+}  // namespace planning
+}  // namespace apollo
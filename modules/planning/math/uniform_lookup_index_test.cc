@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/math/uniform_lookup_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+double Key(const double value) { return value; }
+
+size_t ExpectedLowerBound(const std::vector<double>& keys,
+                          const double value) {
+  return static_cast<size_t>(
+      std::lower_bound(keys.begin(), keys.end(), value) - keys.begin());
+}
+
+}  // namespace
+
+TEST(UniformLookupIndexTest, lower_bound) {
+  std::mt19937 random_engine(7);
+  std::uniform_real_distribution<double> distribution(0.0, 10.0);
+  std::vector<double> keys;
+  for (int i = 0; i < 200; ++i) {
+    keys.push_back(distribution(random_engine));
+  }
+  // duplicated and clustered keys
+  keys.insert(keys.end(), 20, 5.0);
+  for (int i = 0; i < 50; ++i) {
+    keys.push_back(3.0 + 1.0e-4 * i);
+  }
+  std::sort(keys.begin(), keys.end());
+
+  UniformLookupIndex index;
+  index.Build(keys, Key);
+  for (double value = -1.0; value < 11.0; value += 0.0113) {
+    EXPECT_EQ(ExpectedLowerBound(keys, value),
+              index.LowerBound(keys, Key, value));
+  }
+  for (const double key : keys) {
+    EXPECT_EQ(ExpectedLowerBound(keys, key), index.LowerBound(keys, Key, key));
+  }
+  EXPECT_EQ(keys.size(), index.LowerBound(keys, Key,
+                                          std::numeric_limits<double>::max()));
+  EXPECT_EQ(0, index.LowerBound(keys, Key, std::nan("")));
+}
+
+TEST(UniformLookupIndexTest, next_lower_bound) {
+  std::vector<double> keys;
+  for (int i = 0; i < 100; ++i) {
+    keys.push_back(0.1 * i * i);
+  }
+  UniformLookupIndex index;
+  index.Build(keys, Key);
+  size_t lower_index = 0;
+  for (double value = -1.0; value < 1000.0; value += 0.31) {
+    lower_index = index.NextLowerBound(keys, Key, value, lower_index);
+    EXPECT_EQ(ExpectedLowerBound(keys, value), lower_index);
+  }
+  // not in order
+  EXPECT_EQ(ExpectedLowerBound(keys, 5.0),
+            index.NextLowerBound(keys, Key, 5.0, lower_index));
+}
+
+TEST(UniformLookupIndexTest, modified_points) {
+  std::vector<double> keys;
+  for (int i = 0; i < 100; ++i) {
+    keys.push_back(0.1 * i);
+  }
+  UniformLookupIndex index;
+  index.Build(keys, Key);
+
+  // same size, shifted keys
+  for (auto& key : keys) {
+    key += 3.05;
+  }
+  for (double value = 0.0; value < 15.0; value += 0.07) {
+    EXPECT_EQ(ExpectedLowerBound(keys, value),
+              index.LowerBound(keys, Key, value));
+  }
+
+  keys.resize(50);
+  for (double value = 0.0; value < 15.0; value += 0.07) {
+    EXPECT_EQ(ExpectedLowerBound(keys, value),
+              index.LowerBound(keys, Key, value));
+  }
+}
+
+TEST(UniformLookupIndexTest, few_points) {
+  const std::vector<double> keys = {1.0, 2.0, 3.0};
+  UniformLookupIndex index;
+  index.Build(keys, Key);
+  EXPECT_EQ(0, index.LowerBound(keys, Key, 0.5));
+  EXPECT_EQ(1, index.LowerBound(keys, Key, 2.0));
+  EXPECT_EQ(3, index.LowerBound(keys, Key, 3.5));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -396,6 +396,13 @@ void OnLanePlanning::RunOnce(const LocalView& local_view,
     ref_line_task->set_time_ms(reference_line_provider_->LastTimeDelay() *
                                1000.0);
     ref_line_task->set_name("ReferenceLineProvider");
+    auto* smoother_task =
+        ptr_trajectory_pb->mutable_latency_stats()->add_task_stats();
+    smoother_task->set_time_ms(reference_line_provider_->LastSmoothingTime() *
+                               1000.0);
+    smoother_task->set_name("ReferenceLineSmoother");
+    ADEBUG << "Reference line smoothing cache hit rate: "
+           << reference_line_provider_->SmoothingCacheHitRate();
     // TODO(all): integrate reverse gear
     ptr_trajectory_pb->set_gear(canbus::Chassis::GEAR_DRIVE);
     FillPlanningPb(start_timestamp, ptr_trajectory_pb);
@@ -0,0 +1,182 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/distance_map.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cyber/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+// stands for infinity in the distance transform, where inf - inf is avoided
+constexpr double kFarAway = 1e20;
+}  // namespace
+
+void DistanceMap::Build(
+    const std::vector<double>& XYbounds, const double margin,
+    const double resolution,
+    const std::vector<std::vector<common::math::LineSegment2d>>&
+        obstacles_linesegments_vec) {
+  CHECK_EQ(XYbounds.size(), 4U);
+  CHECK_GT(resolution, 0.0);
+  resolution_ = resolution;
+  // XYbounds in xmin, xmax, ymin, ymax
+  min_x_ = XYbounds[0] - margin;
+  min_y_ = XYbounds[2] - margin;
+  size_x_ = std::max(
+      1, static_cast<int>(std::ceil((XYbounds[1] + margin - min_x_) /
+                                    resolution_)));
+  size_y_ = std::max(
+      1, static_cast<int>(std::ceil((XYbounds[3] + margin - min_y_) /
+                                    resolution_)));
+  max_x_ = min_x_ + size_x_ * resolution_;
+  max_y_ = min_y_ + size_y_ * resolution_;
+
+  distance_.assign(static_cast<size_t>(size_x_) * size_y_, kFarAway);
+  for (const auto& obstacle_linesegments : obstacles_linesegments_vec) {
+    for (const auto& linesegment : obstacle_linesegments) {
+      Rasterize(linesegment);
+    }
+  }
+  DistanceTransform();
+
+  // A point and an obstacle point are each at most half a cell diagonal away
+  // from the centers of their cells, so the distance between the centers
+  // overestimates theirs by at most one cell diagonal.
+  const double cell_diagonal = resolution_ * M_SQRT2;
+  for (double& distance : distance_) {
+    distance = std::sqrt(distance) * resolution_ - cell_diagonal;
+  }
+}
+
+double DistanceMap::DistanceLowerBound(const double x, const double y) const {
+  if (distance_.empty()) {
+    return 0.0;
+  }
+  // obstacles out of the map are at least as far as the map border
+  const double border_distance = std::min(std::min(x - min_x_, max_x_ - x),
+                                          std::min(y - min_y_, max_y_ - y));
+  if (border_distance <= 0.0) {
+    return 0.0;
+  }
+  const int grid_x =
+      std::min(static_cast<int>((x - min_x_) / resolution_), size_x_ - 1);
+  const int grid_y =
+      std::min(static_cast<int>((y - min_y_) / resolution_), size_y_ - 1);
+  return std::max(0.0,
+                  std::min(distance_[Index(grid_x, grid_y)], border_distance));
+}
+
+void DistanceMap::Rasterize(const common::math::LineSegment2d& linesegment) {
+  // every cell the segment passes through has its center within half a cell
+  // diagonal of the segment
+  const double half_cell_diagonal = resolution_ * M_SQRT1_2;
+  const auto cell_range = [this](const double min_value,
+                                 const double max_value, const double origin,
+                                 const int size) {
+    const int low =
+        static_cast<int>(std::floor((min_value - origin) / resolution_)) - 1;
+    const int high =
+        static_cast<int>(std::floor((max_value - origin) / resolution_)) + 1;
+    return std::make_pair(std::max(low, 0), std::min(high, size - 1));
+  };
+  const auto x_range = cell_range(
+      std::min(linesegment.start().x(), linesegment.end().x()),
+      std::max(linesegment.start().x(), linesegment.end().x()), min_x_,
+      size_x_);
+  const auto y_range = cell_range(
+      std::min(linesegment.start().y(), linesegment.end().y()),
+      std::max(linesegment.start().y(), linesegment.end().y()), min_y_,
+      size_y_);
+  for (int grid_y = y_range.first; grid_y <= y_range.second; ++grid_y) {
+    for (int grid_x = x_range.first; grid_x <= x_range.second; ++grid_x) {
+      const common::math::Vec2d center(min_x_ + (grid_x + 0.5) * resolution_,
+                                       min_y_ + (grid_y + 0.5) * resolution_);
+      if (linesegment.DistanceTo(center) <= half_cell_diagonal) {
+        distance_[Index(grid_x, grid_y)] = 0.0;
+      }
+    }
+  }
+}
+
+void DistanceMap::DistanceTransform() {
+  // Squared Euclidean distance transform in two passes, see "Distance
+  // Transforms of Sampled Functions", P. Felzenszwalb and D. Huttenlocher.
+  // The column pass on the binary grid is a forward and a backward scan, so
+  // both passes walk the rows in memory order.
+  for (int grid_y = 1; grid_y < size_y_; ++grid_y) {
+    for (int grid_x = 0; grid_x < size_x_; ++grid_x) {
+      double& distance = distance_[Index(grid_x, grid_y)];
+      distance = std::min(distance, distance_[Index(grid_x, grid_y - 1)] + 1.0);
+    }
+  }
+  for (int grid_y = size_y_ - 2; grid_y >= 0; --grid_y) {
+    for (int grid_x = 0; grid_x < size_x_; ++grid_x) {
+      double& distance = distance_[Index(grid_x, grid_y)];
+      distance = std::min(distance, distance_[Index(grid_x, grid_y + 1)] + 1.0);
+    }
+  }
+
+  buffer_d_.resize(size_x_);
+  buffer_z_.resize(size_x_ + 1);
+  buffer_v_.resize(size_x_);
+  auto& z = buffer_z_;
+  auto& v = buffer_v_;
+  for (int grid_y = 0; grid_y < size_y_; ++grid_y) {
+    double* f = &distance_[Index(0, grid_y)];
+    for (int grid_x = 0; grid_x < size_x_; ++grid_x) {
+      f[grid_x] = f[grid_x] < kFarAway ? f[grid_x] * f[grid_x] : kFarAway;
+    }
+    // lower envelope of the parabolas rooted at each cell of the row
+    int k = 0;
+    v[0] = 0;
+    z[0] = -kFarAway;
+    z[1] = kFarAway;
+    for (int q = 1; q < size_x_; ++q) {
+      double s = 0.0;
+      while (true) {
+        s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0 * (q - v[k]));
+        if (s > z[k] || k == 0) {
+          break;
+        }
+        --k;
+      }
+      ++k;
+      v[k] = q;
+      z[k] = s;
+      z[k + 1] = kFarAway;
+    }
+    k = 0;
+    for (int q = 0; q < size_x_; ++q) {
+      while (z[k + 1] < q) {
+        ++k;
+      }
+      buffer_d_[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+    std::copy(buffer_d_.begin(), buffer_d_.begin() + size_x_, f);
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "modules/common/math/line_segment2d.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class DistanceMap
+ * @brief Occupancy grid of the obstacle line segments with its Euclidean
+ * distance transform. It answers a lower bound of the distance from a point
+ * to the nearest obstacle, so a footprint far enough from all obstacles is
+ * cleared without testing every line segment.
+ */
+class DistanceMap {
+ public:
+  DistanceMap() = default;
+
+  /**
+   * @brief Rasterize the obstacles over XYbounds extended by margin and
+   * compute the distance transform.
+   * @param XYbounds xmin, xmax, ymin, ymax
+   */
+  void Build(const std::vector<double>& XYbounds, const double margin,
+             const double resolution,
+             const std::vector<std::vector<common::math::LineSegment2d>>&
+                 obstacles_linesegments_vec);
+
+  /**
+   * @brief A lower bound of the distance from (x, y) to the nearest obstacle
+   * line segment. It is 0 before the map is built.
+   */
+  double DistanceLowerBound(const double x, const double y) const;
+
+ private:
+  void Rasterize(const common::math::LineSegment2d& linesegment);
+  void DistanceTransform();
+  size_t Index(const int grid_x, const int grid_y) const {
+    return static_cast<size_t>(grid_y) * size_x_ + grid_x;
+  }
+
+ private:
+  double resolution_ = 0.0;
+  double min_x_ = 0.0;
+  double min_y_ = 0.0;
+  double max_x_ = 0.0;
+  double max_y_ = 0.0;
+  int size_x_ = 0;
+  int size_y_ = 0;
+  // squared distance to the nearest occupied cell in cells while building,
+  // and then the lower bound of the distance to the obstacles in meters
+  std::vector<double> distance_;
+  std::vector<double> buffer_d_;
+  std::vector<double> buffer_z_;
+  std::vector<int> buffer_v_;
+};
+
+}  // namespace planning
+}  // namespace apollo
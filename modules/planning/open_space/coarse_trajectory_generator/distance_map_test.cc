@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/distance_map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "modules/common/math/vec2d.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+class DistanceMapTest : public ::testing::Test {
+ protected:
+  double ExactDistance(const double x, const double y) const {
+    double distance = std::numeric_limits<double>::infinity();
+    for (const auto& obstacle : obstacles_) {
+      for (const auto& linesegment : obstacle) {
+        distance = std::min(distance, linesegment.DistanceTo(Vec2d(x, y)));
+      }
+    }
+    return distance;
+  }
+
+  std::vector<double> XYbounds_ = {-10.0, 10.0, -10.0, 10.0};
+  std::vector<std::vector<LineSegment2d>> obstacles_ = {
+      {LineSegment2d(Vec2d(-6.0, 2.0), Vec2d(6.0, 2.0)),
+       LineSegment2d(Vec2d(6.0, 2.0), Vec2d(6.0, -4.0))},
+      {LineSegment2d(Vec2d(-3.1, -3.3), Vec2d(-2.2, -6.7))},
+      // partly out of the map
+      {LineSegment2d(Vec2d(8.0, 8.0), Vec2d(30.0, 8.0))}};
+};
+
+TEST_F(DistanceMapTest, not_built) {
+  DistanceMap distance_map;
+  EXPECT_DOUBLE_EQ(0.0, distance_map.DistanceLowerBound(0.0, 0.0));
+}
+
+TEST_F(DistanceMapTest, lower_bound) {
+  for (const double resolution : {0.1, 0.25, 0.5}) {
+    DistanceMap distance_map;
+    distance_map.Build(XYbounds_, 1.0, resolution, obstacles_);
+    for (double x = -12.0; x <= 12.0; x += 0.37) {
+      for (double y = -12.0; y <= 12.0; y += 0.29) {
+        const double lower_bound = distance_map.DistanceLowerBound(x, y);
+        EXPECT_GE(lower_bound, 0.0);
+        EXPECT_LE(lower_bound, ExactDistance(x, y))
+            << x << ", " << y << " at resolution " << resolution;
+        // tight up to a few cells where the nearest obstacle is closer than
+        // the map border
+        const double border_distance =
+            1.0 + std::min(10.0 - std::abs(x), 10.0 - std::abs(y));
+        if (ExactDistance(x, y) < border_distance) {
+          EXPECT_GE(lower_bound, ExactDistance(x, y) - 3.0 * resolution)
+              << x << ", " << y << " at resolution " << resolution;
+        }
+      }
+    }
+    // on the obstacles
+    EXPECT_DOUBLE_EQ(0.0, distance_map.DistanceLowerBound(0.0, 2.0));
+    EXPECT_DOUBLE_EQ(0.0, distance_map.DistanceLowerBound(6.0, -1.0));
+    // out of the map
+    EXPECT_DOUBLE_EQ(0.0, distance_map.DistanceLowerBound(20.0, 0.0));
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
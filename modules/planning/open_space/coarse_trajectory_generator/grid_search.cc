@@ -20,13 +20,41 @@
 
 #include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <tuple>
+
 namespace apollo {
 namespace planning {
 
+namespace {
+
+// up, up_right, right, down_right, down, down_left, left, up_left
+constexpr int kNeighborDx[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+constexpr int kNeighborDy[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+
+double NeighborDistance(const size_t i) {
+  static const double kDiagonalDistance = std::sqrt(2.0);
+  return kNeighborDx[i] != 0 && kNeighborDy[i] != 0 ? kDiagonalDistance : 1.0;
+}
+
+bool SegmentLess(const common::math::LineSegment2d& left,
+                 const common::math::LineSegment2d& right) {
+  return std::make_tuple(left.start().x(), left.start().y(), left.end().x(),
+                         left.end().y()) <
+         std::make_tuple(right.start().x(), right.start().y(),
+                         right.end().x(), right.end().y());
+}
+
+}  // namespace
+
 GridSearch::GridSearch(const PlannerOpenSpaceConfig& open_space_conf) {
   xy_grid_resolution_ =
       open_space_conf.warm_start_config().grid_a_star_xy_resolution();
   node_radius_ = open_space_conf.warm_start_config().node_radius();
+  enable_incremental_dp_map_ =
+      open_space_conf.warm_start_config().enable_incremental_dp_map();
 }
 
 double GridSearch::EuclidDistance(const double x1, const double y1,
@@ -34,9 +62,9 @@ double GridSearch::EuclidDistance(const double x1, const double y1,
   return std::sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
 }
 
-bool GridSearch::CheckConstraints(std::shared_ptr<Node2d> node) {
-  const double node_grid_x = node->GetGridX();
-  const double node_grid_y = node->GetGridY();
+bool GridSearch::CheckConstraints(const Node2d& node) {
+  const int node_grid_x = node.GetGridX();
+  const int node_grid_y = node.GetGridY();
   if (node_grid_x > max_grid_x_ || node_grid_x < 0 ||
       node_grid_y > max_grid_y_ || node_grid_y < 0) {
     return false;
@@ -47,7 +75,7 @@ bool GridSearch::CheckConstraints(std::shared_ptr<Node2d> node) {
   for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
     for (const common::math::LineSegment2d& linesegment :
          obstacle_linesegments) {
-      if (linesegment.DistanceTo({node->GetX(), node->GetY()}) < node_radius_) {
+      if (linesegment.DistanceTo({node.GetX(), node.GetY()}) < node_radius_) {
         return false;
       }
     }
@@ -55,55 +83,46 @@ bool GridSearch::CheckConstraints(std::shared_ptr<Node2d> node) {
   return true;
 }
 
-std::vector<std::shared_ptr<Node2d>> GridSearch::GenerateNextNodes(
-    std::shared_ptr<Node2d> current_node) {
-  double current_node_x = current_node->GetX();
-  double current_node_y = current_node->GetY();
-  double current_node_path_cost = current_node->GetPathCost();
-  double diagonal_distance = std::sqrt(2.0);
-  std::vector<std::shared_ptr<Node2d>> next_nodes;
-  std::shared_ptr<Node2d> up = std::make_shared<Node2d>(
-      current_node_x, current_node_y + xy_grid_resolution_, xy_grid_resolution_,
-      XYbounds_);
-  up->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> up_right = std::make_shared<Node2d>(
-      current_node_x + xy_grid_resolution_,
-      current_node_y + xy_grid_resolution_, xy_grid_resolution_, XYbounds_);
-  up_right->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> right =
-      std::make_shared<Node2d>(current_node_x + xy_grid_resolution_,
-                               current_node_y, xy_grid_resolution_, XYbounds_);
-  right->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> down_right = std::make_shared<Node2d>(
-      current_node_x + xy_grid_resolution_,
-      current_node_y - xy_grid_resolution_, xy_grid_resolution_, XYbounds_);
-  down_right->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> down = std::make_shared<Node2d>(
-      current_node_x, current_node_y - xy_grid_resolution_, xy_grid_resolution_,
-      XYbounds_);
-  down->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> down_left = std::make_shared<Node2d>(
-      current_node_x - xy_grid_resolution_,
-      current_node_y - xy_grid_resolution_, xy_grid_resolution_, XYbounds_);
-  down_left->SetPathCost(current_node_path_cost + diagonal_distance);
-  std::shared_ptr<Node2d> left =
-      std::make_shared<Node2d>(current_node_x - xy_grid_resolution_,
-                               current_node_y, xy_grid_resolution_, XYbounds_);
-  left->SetPathCost(current_node_path_cost + 1.0);
-  std::shared_ptr<Node2d> up_left = std::make_shared<Node2d>(
-      current_node_x - xy_grid_resolution_,
-      current_node_y + xy_grid_resolution_, xy_grid_resolution_, XYbounds_);
-  up_left->SetPathCost(current_node_path_cost + diagonal_distance);
-
-  next_nodes.emplace_back(up);
-  next_nodes.emplace_back(up_right);
-  next_nodes.emplace_back(right);
-  next_nodes.emplace_back(down_right);
-  next_nodes.emplace_back(down);
-  next_nodes.emplace_back(down_left);
-  next_nodes.emplace_back(left);
-  next_nodes.emplace_back(up_left);
-  return next_nodes;
+void GridSearch::GenerateNextNodes(const Node2d& current_node,
+                                   std::array<Node2d, 8>* next_nodes) {
+  const double current_node_x = current_node.GetX();
+  const double current_node_y = current_node.GetY();
+  const double current_node_path_cost = current_node.GetPathCost();
+  for (size_t i = 0; i < next_nodes->size(); ++i) {
+    const double next_x =
+        kNeighborDx[i] == 0
+            ? current_node_x
+            : current_node_x + kNeighborDx[i] * xy_grid_resolution_;
+    const double next_y =
+        kNeighborDy[i] == 0
+            ? current_node_y
+            : current_node_y + kNeighborDy[i] * xy_grid_resolution_;
+    Node2d& next_node = (*next_nodes)[i];
+    next_node = Node2d(next_x, next_y, xy_grid_resolution_, XYbounds_);
+    next_node.SetPathCost(current_node_path_cost + NeighborDistance(i));
+  }
+}
+
+void GridSearch::SetBounds(const std::vector<double>& XYbounds,
+                           NodeGrid* grid) {
+  XYbounds_ = XYbounds;
+  // XYbounds with xmin, xmax, ymin, ymax
+  max_grid_y_ = static_cast<int>(
+      std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_));
+  max_grid_x_ = static_cast<int>(
+      std::round((XYbounds_[1] - XYbounds_[0]) / xy_grid_resolution_));
+  grid->max_grid_x = max_grid_x_;
+  grid->max_grid_y = max_grid_y_;
+}
+
+void GridSearch::ResetGrid(const std::vector<double>& XYbounds,
+                           NodeGrid* grid) {
+  SetBounds(XYbounds, grid);
+  const size_t grid_size = static_cast<size_t>(max_grid_x_ + 1) *
+                           static_cast<size_t>(max_grid_y_ + 1);
+  // only the states are cleared, a node is written when it is first visited
+  grid->nodes.resize(grid_size);
+  grid->states.assign(grid_size, NodeState::UNVISITED);
 }
 
 bool GridSearch::GenerateAStarPath(
@@ -112,50 +131,54 @@ bool GridSearch::GenerateAStarPath(
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec,
     GridAStartResult* result) {
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
+  std::priority_queue<std::pair<size_t, double>,
+                      std::vector<std::pair<size_t, double>>, cmp>
       open_pq;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> close_set;
-  XYbounds_ = XYbounds;
-  std::shared_ptr<Node2d> start_node =
-      std::make_shared<Node2d>(sx, sy, xy_grid_resolution_, XYbounds_);
-  std::shared_ptr<Node2d> end_node =
-      std::make_shared<Node2d>(ex, ey, xy_grid_resolution_, XYbounds_);
-  std::shared_ptr<Node2d> final_node_ = nullptr;
+  ResetGrid(XYbounds, &astar_grid_);
+  Node2d start_node(sx, sy, xy_grid_resolution_, XYbounds_);
+  Node2d end_node(ex, ey, xy_grid_resolution_, XYbounds_);
+  if (!astar_grid_.Contains(start_node.GetGridX(), start_node.GetGridY()) ||
+      !astar_grid_.Contains(end_node.GetGridX(), end_node.GetGridY())) {
+    AERROR << "Grid A star start or end node is out of XYbounds";
+    return false;
+  }
+  final_node_ = nullptr;
   obstacles_linesegments_vec_ = obstacles_linesegments_vec;
-  open_set.emplace(start_node->GetIndex(), start_node);
-  open_pq.emplace(start_node->GetIndex(), start_node->GetCost());
+  const size_t start_index =
+      astar_grid_.Index(start_node.GetGridX(), start_node.GetGridY());
+  astar_grid_.nodes[start_index] = start_node;
+  astar_grid_.states[start_index] = NodeState::OPEN;
+  open_pq.emplace(start_index, start_node.GetCost());
 
   // Grid a star begins
   size_t explored_node_num = 0;
+  std::array<Node2d, 8> next_nodes;
   while (!open_pq.empty()) {
-    std::string current_id = open_pq.top().first;
+    const size_t current_index = open_pq.top().first;
     open_pq.pop();
-    std::shared_ptr<Node2d> current_node = open_set[current_id];
+    const Node2d& current_node = astar_grid_.nodes[current_index];
     // Check destination
-    if (*(current_node) == *(end_node)) {
-      final_node_ = current_node;
+    if (current_node == end_node) {
+      final_node_ = &current_node;
       break;
     }
-    close_set.emplace(current_node->GetIndex(), current_node);
-    std::vector<std::shared_ptr<Node2d>> next_nodes =
-        std::move(GenerateNextNodes(current_node));
+    astar_grid_.states[current_index] = NodeState::CLOSED;
+    GenerateNextNodes(current_node, &next_nodes);
     for (auto& next_node : next_nodes) {
       if (!CheckConstraints(next_node)) {
         continue;
       }
-      if (close_set.find(next_node->GetIndex()) != close_set.end()) {
-        continue;
-      }
-      if (open_set.find(next_node->GetIndex()) == open_set.end()) {
+      const size_t next_index =
+          astar_grid_.Index(next_node.GetGridX(), next_node.GetGridY());
+      if (astar_grid_.states[next_index] == NodeState::UNVISITED) {
         ++explored_node_num;
-        next_node->SetHeuristic(
-            EuclidDistance(next_node->GetGridX(), next_node->GetGridY(),
-                           end_node->GetGridX(), end_node->GetGridY()));
-        next_node->SetPreNode(current_node);
-        open_set.emplace(next_node->GetIndex(), next_node);
-        open_pq.emplace(next_node->GetIndex(), next_node->GetCost());
+        next_node.SetHeuristic(
+            EuclidDistance(next_node.GetGridX(), next_node.GetGridY(),
+                           end_node.GetGridX(), end_node.GetGridY()));
+        next_node.SetPreNode(&current_node);
+        astar_grid_.nodes[next_index] = next_node;
+        astar_grid_.states[next_index] = NodeState::OPEN;
+        open_pq.emplace(next_index, next_node.GetCost());
       }
     }
   }
@@ -173,47 +196,54 @@ bool GridSearch::GenerateDpMap(
     const double ex, const double ey, const std::vector<double>& XYbounds,
     const std::vector<std::vector<common::math::LineSegment2d>>&
         obstacles_linesegments_vec) {
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
+  if (enable_incremental_dp_map_) {
+    return GenerateIncrementalDpMap(ex, ey, XYbounds,
+                                    obstacles_linesegments_vec);
+  }
+  std::priority_queue<std::pair<size_t, double>,
+                      std::vector<std::pair<size_t, double>>, cmp>
       open_pq;
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> open_set;
-  dp_map_ = decltype(dp_map_)();
-  XYbounds_ = XYbounds;
-  // XYbounds with xmin, xmax, ymin, ymax
-  max_grid_y_ = std::round((XYbounds_[3] - XYbounds_[2]) / xy_grid_resolution_);
-  max_grid_x_ = std::round((XYbounds_[1] - XYbounds_[0]) / xy_grid_resolution_);
-  std::shared_ptr<Node2d> end_node =
-      std::make_shared<Node2d>(ex, ey, xy_grid_resolution_, XYbounds_);
+  ResetGrid(XYbounds, &dp_grid_);
+  Node2d end_node(ex, ey, xy_grid_resolution_, XYbounds_);
+  if (!dp_grid_.Contains(end_node.GetGridX(), end_node.GetGridY())) {
+    AERROR << "Dp map end node is out of XYbounds";
+    return false;
+  }
   obstacles_linesegments_vec_ = obstacles_linesegments_vec;
-  open_set.emplace(end_node->GetIndex(), end_node);
-  open_pq.emplace(end_node->GetIndex(), end_node->GetCost());
+  const size_t end_index =
+      dp_grid_.Index(end_node.GetGridX(), end_node.GetGridY());
+  dp_grid_.nodes[end_index] = end_node;
+  dp_grid_.states[end_index] = NodeState::OPEN;
+  open_pq.emplace(end_index, end_node.GetCost());
 
   // Grid a star begins
   size_t explored_node_num = 0;
+  std::array<Node2d, 8> next_nodes;
   while (!open_pq.empty()) {
-    const std::string current_id = open_pq.top().first;
+    const size_t current_index = open_pq.top().first;
     open_pq.pop();
-    std::shared_ptr<Node2d> current_node = open_set[current_id];
-    dp_map_.emplace(current_node->GetIndex(), current_node);
-    std::vector<std::shared_ptr<Node2d>> next_nodes =
-        std::move(GenerateNextNodes(current_node));
+    const Node2d& current_node = dp_grid_.nodes[current_index];
+    dp_grid_.states[current_index] = NodeState::CLOSED;
+    GenerateNextNodes(current_node, &next_nodes);
     for (auto& next_node : next_nodes) {
       if (!CheckConstraints(next_node)) {
         continue;
       }
-      if (dp_map_.find(next_node->GetIndex()) != dp_map_.end()) {
+      const size_t next_index =
+          dp_grid_.Index(next_node.GetGridX(), next_node.GetGridY());
+      const NodeState next_state = dp_grid_.states[next_index];
+      if (next_state == NodeState::CLOSED) {
         continue;
       }
-      if (open_set.find(next_node->GetIndex()) == open_set.end()) {
+      if (next_state == NodeState::UNVISITED) {
         ++explored_node_num;
-        next_node->SetPreNode(current_node);
-        open_set.emplace(next_node->GetIndex(), next_node);
-        open_pq.emplace(next_node->GetIndex(), next_node->GetCost());
-      } else {
-        if (open_set[next_node->GetIndex()]->GetCost() > next_node->GetCost()) {
-          open_set[next_node->GetIndex()]->SetCost(next_node->GetCost());
-          open_set[next_node->GetIndex()]->SetPreNode(current_node);
-        }
+        next_node.SetPreNode(&current_node);
+        dp_grid_.nodes[next_index] = next_node;
+        dp_grid_.states[next_index] = NodeState::OPEN;
+        open_pq.emplace(next_index, next_node.GetCost());
+      } else if (dp_grid_.nodes[next_index].GetCost() > next_node.GetCost()) {
+        dp_grid_.nodes[next_index].SetCost(next_node.GetCost());
+        dp_grid_.nodes[next_index].SetPreNode(&current_node);
       }
     }
   }
@@ -221,18 +251,234 @@ bool GridSearch::GenerateDpMap(
   return true;
 }
 
+bool GridSearch::GenerateIncrementalDpMap(
+    const double ex, const double ey, const std::vector<double>& XYbounds,
+    const std::vector<std::vector<common::math::LineSegment2d>>&
+        obstacles_linesegments_vec) {
+  std::vector<common::math::LineSegment2d> segments;
+  for (const auto& obstacle_linesegments : obstacles_linesegments_vec) {
+    segments.insert(segments.end(), obstacle_linesegments.begin(),
+                    obstacle_linesegments.end());
+  }
+  std::sort(segments.begin(), segments.end(), SegmentLess);
+  obstacles_linesegments_vec_ = obstacles_linesegments_vec;
+  SetBounds(XYbounds, &dp_grid_);
+
+  if (!dp_g_.empty() && ex == dp_end_x_ && ey == dp_end_y_ &&
+      XYbounds == dp_XYbounds_) {
+    std::vector<common::math::LineSegment2d> changed_segments;
+    std::set_symmetric_difference(segments.begin(), segments.end(),
+                                  dp_segments_.begin(), dp_segments_.end(),
+                                  std::back_inserter(changed_segments),
+                                  SegmentLess);
+    // repairing is only cheaper when most of the obstacles stay
+    if (2 * changed_segments.size() <= segments.size() + dp_segments_.size()) {
+      dp_segments_ = std::move(segments);
+      const size_t changed_cell_num = UpdateChangedCells(changed_segments);
+      ComputeIncrementalDpMap();
+      ADEBUG << "dp map repaired from " << changed_segments.size()
+             << " changed segments and " << changed_cell_num
+             << " changed cells";
+      return true;
+    }
+  }
+
+  Node2d end_node(ex, ey, xy_grid_resolution_, XYbounds_);
+  if (!dp_grid_.Contains(end_node.GetGridX(), end_node.GetGridY())) {
+    AERROR << "Dp map end node is out of XYbounds";
+    dp_g_.clear();
+    return false;
+  }
+  dp_segments_ = std::move(segments);
+  dp_end_x_ = ex;
+  dp_end_y_ = ey;
+  dp_end_grid_x_ = end_node.GetGridX();
+  dp_end_grid_y_ = end_node.GetGridY();
+  dp_XYbounds_ = XYbounds;
+  ResetIncrementalDpMap();
+  ComputeIncrementalDpMap();
+  return true;
+}
+
+void GridSearch::ResetIncrementalDpMap() {
+  const size_t grid_size = static_cast<size_t>(max_grid_x_ + 1) *
+                           static_cast<size_t>(max_grid_y_ + 1);
+  dp_g_.assign(grid_size, std::numeric_limits<double>::infinity());
+  dp_rhs_.assign(grid_size, std::numeric_limits<double>::infinity());
+  dp_blocked_.resize(grid_size);
+  for (int grid_y = 0; grid_y <= max_grid_y_; ++grid_y) {
+    for (int grid_x = 0; grid_x <= max_grid_x_; ++grid_x) {
+      dp_blocked_[dp_grid_.Index(grid_x, grid_y)] =
+          IsCellBlocked(grid_x, grid_y);
+    }
+  }
+  dp_open_pq_ = decltype(dp_open_pq_)();
+  dp_end_index_ = dp_grid_.Index(dp_end_grid_x_, dp_end_grid_y_);
+  dp_rhs_[dp_end_index_] = 0.0;
+  dp_open_pq_.emplace(0.0, dp_end_index_);
+}
+
+std::pair<int, int> GridSearch::AffectedCellRange(const double min_value,
+                                                  const double max_value,
+                                                  const double end_value,
+                                                  const int end_grid,
+                                                  const int max_grid) const {
+  const int low = end_grid + static_cast<int>(std::floor(
+                                 (min_value - node_radius_ - end_value) /
+                                 xy_grid_resolution_));
+  const int high = end_grid + static_cast<int>(std::ceil(
+                                  (max_value + node_radius_ - end_value) /
+                                  xy_grid_resolution_));
+  return {std::max(low, 0), std::min(high, max_grid)};
+}
+
+size_t GridSearch::UpdateChangedCells(
+    const std::vector<common::math::LineSegment2d>& changed_segments) {
+  size_t changed_cell_num = 0;
+  for (const auto& segment : changed_segments) {
+    // cells farther than node_radius_ from the segment are not affected
+    const auto x_range = AffectedCellRange(
+        std::min(segment.start().x(), segment.end().x()),
+        std::max(segment.start().x(), segment.end().x()), dp_end_x_,
+        dp_end_grid_x_, max_grid_x_);
+    const auto y_range = AffectedCellRange(
+        std::min(segment.start().y(), segment.end().y()),
+        std::max(segment.start().y(), segment.end().y()), dp_end_y_,
+        dp_end_grid_y_, max_grid_y_);
+    for (int grid_y = y_range.first; grid_y <= y_range.second; ++grid_y) {
+      for (int grid_x = x_range.first; grid_x <= x_range.second; ++grid_x) {
+        const size_t index = dp_grid_.Index(grid_x, grid_y);
+        const uint8_t blocked = IsCellBlocked(grid_x, grid_y);
+        if (blocked != dp_blocked_[index]) {
+          dp_blocked_[index] = blocked;
+          UpdateCell(index);
+          ++changed_cell_num;
+        }
+      }
+    }
+  }
+  return changed_cell_num;
+}
+
+bool GridSearch::IsCellBlocked(const int grid_x, const int grid_y) const {
+  // cells are placed on the lattice through the goal
+  const common::math::Vec2d position(
+      dp_end_x_ + (grid_x - dp_end_grid_x_) * xy_grid_resolution_,
+      dp_end_y_ + (grid_y - dp_end_grid_y_) * xy_grid_resolution_);
+  for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
+    for (const common::math::LineSegment2d& linesegment :
+         obstacle_linesegments) {
+      if (linesegment.DistanceTo(position) < node_radius_) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void GridSearch::UpdateCell(const size_t index) {
+  if (index == dp_end_index_) {
+    return;
+  }
+  double rhs = std::numeric_limits<double>::infinity();
+  if (!dp_blocked_[index]) {
+    const int grid_x = static_cast<int>(index % (max_grid_x_ + 1));
+    const int grid_y = static_cast<int>(index / (max_grid_x_ + 1));
+    for (size_t i = 0; i < 8; ++i) {
+      const int next_grid_x = grid_x + kNeighborDx[i];
+      const int next_grid_y = grid_y + kNeighborDy[i];
+      if (!dp_grid_.Contains(next_grid_x, next_grid_y)) {
+        continue;
+      }
+      rhs = std::min(rhs, dp_g_[dp_grid_.Index(next_grid_x, next_grid_y)] +
+                              NeighborDistance(i));
+    }
+  }
+  dp_rhs_[index] = rhs;
+  if (dp_g_[index] != rhs) {
+    dp_open_pq_.emplace(std::min(dp_g_[index], rhs), index);
+  }
+}
+
+void GridSearch::ComputeIncrementalDpMap() {
+  size_t expanded_cell_num = 0;
+  while (!dp_open_pq_.empty()) {
+    const auto top = dp_open_pq_.top();
+    dp_open_pq_.pop();
+    const size_t index = top.second;
+    const double g = dp_g_[index];
+    const double rhs = dp_rhs_[index];
+    // skip the outdated entries
+    if (g == rhs || top.first != std::min(g, rhs)) {
+      continue;
+    }
+    ++expanded_cell_num;
+    const int grid_x = static_cast<int>(index % (max_grid_x_ + 1));
+    const int grid_y = static_cast<int>(index / (max_grid_x_ + 1));
+    if (g > rhs) {
+      // the distance dropped, which can only lower the neighbors
+      dp_g_[index] = rhs;
+      for (size_t i = 0; i < 8; ++i) {
+        const int next_grid_x = grid_x + kNeighborDx[i];
+        const int next_grid_y = grid_y + kNeighborDy[i];
+        if (!dp_grid_.Contains(next_grid_x, next_grid_y)) {
+          continue;
+        }
+        const size_t next_index = dp_grid_.Index(next_grid_x, next_grid_y);
+        const double next_rhs = rhs + NeighborDistance(i);
+        if (next_index == dp_end_index_ || dp_blocked_[next_index] ||
+            next_rhs >= dp_rhs_[next_index]) {
+          continue;
+        }
+        dp_rhs_[next_index] = next_rhs;
+        dp_open_pq_.emplace(std::min(dp_g_[next_index], next_rhs),
+                            next_index);
+      }
+    } else {
+      // the distance rose, the cell and its neighbors are looked up again
+      dp_g_[index] = std::numeric_limits<double>::infinity();
+      UpdateCell(index);
+      for (size_t i = 0; i < 8; ++i) {
+        const int next_grid_x = grid_x + kNeighborDx[i];
+        const int next_grid_y = grid_y + kNeighborDy[i];
+        if (dp_grid_.Contains(next_grid_x, next_grid_y)) {
+          UpdateCell(dp_grid_.Index(next_grid_x, next_grid_y));
+        }
+      }
+    }
+  }
+  ADEBUG << "dp map expanded cell num is " << expanded_cell_num;
+}
+
 double GridSearch::CheckDpMap(const double sx, const double sy) {
-  std::string index = Node2d::CalcIndex(sx, sy, xy_grid_resolution_, XYbounds_);
-  if (dp_map_.find(index) != dp_map_.end()) {
-    return dp_map_[index]->GetCost() * xy_grid_resolution_;
-  } else {
+  if (XYbounds_.size() < 4) {
+    return std::numeric_limits<double>::infinity();
+  }
+  // XYbounds with xmin, xmax, ymin, ymax
+  const int grid_x =
+      static_cast<int>((sx - XYbounds_[0]) / xy_grid_resolution_);
+  const int grid_y =
+      static_cast<int>((sy - XYbounds_[2]) / xy_grid_resolution_);
+  if (!dp_grid_.Contains(grid_x, grid_y)) {
+    return std::numeric_limits<double>::infinity();
+  }
+  const size_t index = dp_grid_.Index(grid_x, grid_y);
+  if (enable_incremental_dp_map_) {
+    if (dp_g_.size() <= index) {
+      return std::numeric_limits<double>::infinity();
+    }
+    return dp_g_[index] * xy_grid_resolution_;
+  }
+  if (dp_grid_.states.size() <= index ||
+      dp_grid_.states[index] != NodeState::CLOSED) {
     return std::numeric_limits<double>::infinity();
   }
+  return dp_grid_.nodes[index].GetCost() * xy_grid_resolution_;
 }
 
 void GridSearch::LoadGridAStarResult(GridAStartResult* result) {
   (*result).path_cost = final_node_->GetPathCost() * xy_grid_resolution_;
-  std::shared_ptr<Node2d> current_node = final_node_;
+  const Node2d* current_node = final_node_;
   std::vector<double> grid_a_x;
   std::vector<double> grid_a_y;
   while (current_node->GetPreNode() != nullptr) {
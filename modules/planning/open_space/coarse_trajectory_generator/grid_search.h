@@ -20,15 +20,14 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <limits>
-#include <memory>
 #include <queue>
-#include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "absl/strings/str_cat.h"
 #include "cyber/common/log.h"
 #include "modules/common/math/line_segment2d.h"
 #include "modules/planning/proto/planner_open_space_config.pb.h"
@@ -38,6 +37,7 @@ namespace planning {
 
 class Node2d {
  public:
+  Node2d() = default;
   Node2d(const double x, const double y, const double xy_resolution,
          const std::vector<double>& XYbounds) {
     // XYbounds with xmin, xmax, ymin, ymax
@@ -45,7 +45,7 @@ class Node2d {
     y_ = y;
     grid_x_ = static_cast<int>((x - XYbounds[0]) / xy_resolution);
     grid_y_ = static_cast<int>((y - XYbounds[2]) / xy_resolution);
-    index_ = ComputeStringIndex(grid_x_, grid_y_);
+    index_ = ComputeIndex(grid_x_, grid_y_);
   }
   void SetPathCost(const double path_cost) {
     path_cost_ = path_cost;
@@ -56,31 +56,32 @@ class Node2d {
     cost_ = path_cost_ + heuristic_;
   }
   void SetCost(const double cost) { cost_ = cost; }
-  void SetPreNode(std::shared_ptr<Node2d> pre_node) { pre_node_ = pre_node; }
+  void SetPreNode(const Node2d* pre_node) { pre_node_ = pre_node; }
   double GetX() const { return x_; }
   double GetY() const { return y_; }
-  double GetGridX() const { return grid_x_; }
-  double GetGridY() const { return grid_y_; }
+  int GetGridX() const { return grid_x_; }
+  int GetGridY() const { return grid_y_; }
   double GetPathCost() const { return path_cost_; }
   double GetHeuCost() const { return heuristic_; }
   double GetCost() const { return cost_; }
-  const std::string& GetIndex() const { return index_; }
-  std::shared_ptr<Node2d> GetPreNode() const { return pre_node_; }
-  static std::string CalcIndex(const double x, const double y,
-                               const double xy_resolution,
-                               const std::vector<double>& XYbounds) {
+  uint64_t GetIndex() const { return index_; }
+  const Node2d* GetPreNode() const { return pre_node_; }
+  static uint64_t CalcIndex(const double x, const double y,
+                            const double xy_resolution,
+                            const std::vector<double>& XYbounds) {
     // XYbounds with xmin, xmax, ymin, ymax
     int grid_x = static_cast<int>((x - XYbounds[0]) / xy_resolution);
     int grid_y = static_cast<int>((y - XYbounds[2]) / xy_resolution);
-    return ComputeStringIndex(grid_x, grid_y);
+    return ComputeIndex(grid_x, grid_y);
   }
   bool operator==(const Node2d& right) const {
     return right.GetIndex() == index_;
   }
 
  private:
-  static std::string ComputeStringIndex(int x_grid, int y_grid) {
-    return absl::StrCat(x_grid, "_", y_grid);
+  static uint64_t ComputeIndex(int x_grid, int y_grid) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x_grid)) << 32) |
+           static_cast<uint32_t>(y_grid);
   }
 
  private:
@@ -91,8 +92,8 @@ class Node2d {
   double path_cost_ = 0.0;
   double heuristic_ = 0.0;
   double cost_ = 0.0;
-  std::string index_;
-  std::shared_ptr<Node2d> pre_node_ = nullptr;
+  uint64_t index_ = 0;
+  const Node2d* pre_node_ = nullptr;
 };
 
 struct GridAStartResult {
@@ -118,32 +119,92 @@ class GridSearch {
   double CheckDpMap(const double sx, const double sy);
 
  private:
+  // The incremental dp map keeps the exact 8-connected distances to the goal.
+  // When the goal and XYbounds are unchanged, only the cells around the
+  // obstacle line segments that were added or removed are checked again, and
+  // the distances are repaired from them in the way of Lifelong Planning A*.
+  bool GenerateIncrementalDpMap(
+      const double ex, const double ey, const std::vector<double>& XYbounds,
+      const std::vector<std::vector<common::math::LineSegment2d>>&
+          obstacles_linesegments_vec);
+  void ResetIncrementalDpMap();
+  // range of the cells along one axis which may be blocked by a segment
+  std::pair<int, int> AffectedCellRange(const double min_value,
+                                        const double max_value,
+                                        const double end_value,
+                                        const int end_grid,
+                                        const int max_grid) const;
+  size_t UpdateChangedCells(
+      const std::vector<common::math::LineSegment2d>& changed_segments);
+  bool IsCellBlocked(const int grid_x, const int grid_y) const;
+  void UpdateCell(const size_t index);
+  void ComputeIncrementalDpMap();
+
+  enum class NodeState : uint8_t { UNVISITED, OPEN, CLOSED };
+
+  // the nodes of a search are kept in a dense grid over XYbounds, which is
+  // reused by the following searches without reallocation
+  struct NodeGrid {
+    int max_grid_x = 0;
+    int max_grid_y = 0;
+    std::vector<Node2d> nodes;
+    std::vector<NodeState> states;
+
+    bool Contains(const int grid_x, const int grid_y) const {
+      return grid_x >= 0 && grid_x <= max_grid_x && grid_y >= 0 &&
+             grid_y <= max_grid_y;
+    }
+    size_t Index(const int grid_x, const int grid_y) const {
+      return static_cast<size_t>(grid_y) * (max_grid_x + 1) + grid_x;
+    }
+  };
+
   double EuclidDistance(const double x1, const double y1, const double x2,
                         const double y2);
-  std::vector<std::shared_ptr<Node2d>> GenerateNextNodes(
-      std::shared_ptr<Node2d> node);
-  bool CheckConstraints(std::shared_ptr<Node2d> node);
+  void GenerateNextNodes(const Node2d& node,
+                         std::array<Node2d, 8>* next_nodes);
+  bool CheckConstraints(const Node2d& node);
+  void SetBounds(const std::vector<double>& XYbounds, NodeGrid* grid);
+  void ResetGrid(const std::vector<double>& XYbounds, NodeGrid* grid);
   void LoadGridAStarResult(GridAStartResult* result);
 
  private:
   double xy_grid_resolution_ = 0.0;
   double node_radius_ = 0.0;
   std::vector<double> XYbounds_;
-  double max_grid_x_ = 0.0;
-  double max_grid_y_ = 0.0;
-  std::shared_ptr<Node2d> start_node_;
-  std::shared_ptr<Node2d> end_node_;
-  std::shared_ptr<Node2d> final_node_;
+  int max_grid_x_ = 0;
+  int max_grid_y_ = 0;
+  const Node2d* final_node_ = nullptr;
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec_;
 
   struct cmp {
-    bool operator()(const std::pair<std::string, double>& left,
-                    const std::pair<std::string, double>& right) const {
+    bool operator()(const std::pair<size_t, double>& left,
+                    const std::pair<size_t, double>& right) const {
       return left.second >= right.second;
     }
   };
-  std::unordered_map<std::string, std::shared_ptr<Node2d>> dp_map_;
+  NodeGrid astar_grid_;
+  // closed nodes of the grid make up the dp map
+  NodeGrid dp_grid_;
+
+  bool enable_incremental_dp_map_ = false;
+  // cache key of the incremental dp map
+  double dp_end_x_ = 0.0;
+  double dp_end_y_ = 0.0;
+  int dp_end_grid_x_ = 0;
+  int dp_end_grid_y_ = 0;
+  size_t dp_end_index_ = 0;
+  std::vector<double> dp_XYbounds_;
+  std::vector<common::math::LineSegment2d> dp_segments_;
+  // distance to the goal in grid steps, and its one step lookahead
+  std::vector<double> dp_g_;
+  std::vector<double> dp_rhs_;
+  std::vector<uint8_t> dp_blocked_;
+  std::priority_queue<std::pair<double, size_t>,
+                      std::vector<std::pair<double, size_t>>,
+                      std::greater<std::pair<double, size_t>>>
+      dp_open_pq_;
 };
 }  // namespace planning
 }  // namespace apollo
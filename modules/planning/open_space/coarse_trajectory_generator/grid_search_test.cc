@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ */
+
+#include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "modules/common/math/vec2d.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+class GridSearchTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    auto* warm_start_config =
+        planner_open_space_config_.mutable_warm_start_config();
+    warm_start_config->set_grid_a_star_xy_resolution(0.5);
+    warm_start_config->set_node_radius(0.5);
+    warm_start_config->set_enable_incremental_dp_map(true);
+  }
+
+ protected:
+  // compares the heuristic on every cell of XYbounds_
+  void ExpectSameDpMap(GridSearch* expected, GridSearch* actual) {
+    for (double x = XYbounds_[0]; x <= XYbounds_[1]; x += 0.5) {
+      for (double y = XYbounds_[2]; y <= XYbounds_[3]; y += 0.5) {
+        const double expected_cost = expected->CheckDpMap(x, y);
+        const double actual_cost = actual->CheckDpMap(x, y);
+        if (std::isinf(expected_cost)) {
+          EXPECT_TRUE(std::isinf(actual_cost)) << x << ", " << y;
+        } else {
+          EXPECT_NEAR(expected_cost, actual_cost, 1e-9) << x << ", " << y;
+        }
+      }
+    }
+  }
+
+  PlannerOpenSpaceConfig planner_open_space_config_;
+  std::vector<double> XYbounds_ = {-10.0, 10.0, -10.0, 10.0};
+  std::vector<LineSegment2d> wall_ = {
+      LineSegment2d(Vec2d(-6.0, 2.0), Vec2d(6.0, 2.0)),
+      LineSegment2d(Vec2d(6.0, 2.0), Vec2d(6.0, -4.0))};
+  std::vector<LineSegment2d> post_ = {
+      LineSegment2d(Vec2d(-3.0, -3.0), Vec2d(-3.0, -6.0))};
+};
+
+TEST_F(GridSearchTest, incremental_dp_map) {
+  GridSearch grid_search(planner_open_space_config_);
+  ASSERT_TRUE(grid_search.GenerateDpMap(0.0, 5.0, XYbounds_, {wall_}));
+  EXPECT_DOUBLE_EQ(0.0, grid_search.CheckDpMap(0.0, 5.0));
+  EXPECT_DOUBLE_EQ(2.5, grid_search.CheckDpMap(2.5, 5.0));
+  // on the wall
+  EXPECT_TRUE(std::isinf(grid_search.CheckDpMap(0.0, 2.0)));
+  // out of XYbounds
+  EXPECT_TRUE(std::isinf(grid_search.CheckDpMap(20.0, 5.0)));
+  // around the wall
+  EXPECT_GT(grid_search.CheckDpMap(0.0, 0.0), 5.0);
+}
+
+TEST_F(GridSearchTest, repair_dp_map) {
+  GridSearch repaired(planner_open_space_config_);
+  ASSERT_TRUE(repaired.GenerateDpMap(0.0, 5.0, XYbounds_, {wall_}));
+
+  // an obstacle shows up
+  ASSERT_TRUE(repaired.GenerateDpMap(0.0, 5.0, XYbounds_, {wall_, post_}));
+  GridSearch rebuilt(planner_open_space_config_);
+  ASSERT_TRUE(rebuilt.GenerateDpMap(0.0, 5.0, XYbounds_, {wall_, post_}));
+  ExpectSameDpMap(&rebuilt, &repaired);
+
+  // and part of the wall goes away
+  std::vector<LineSegment2d> short_wall = {wall_.front()};
+  ASSERT_TRUE(
+      repaired.GenerateDpMap(0.0, 5.0, XYbounds_, {short_wall, post_}));
+  GridSearch rebuilt_again(planner_open_space_config_);
+  ASSERT_TRUE(
+      rebuilt_again.GenerateDpMap(0.0, 5.0, XYbounds_, {short_wall, post_}));
+  ExpectSameDpMap(&rebuilt_again, &repaired);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -53,13 +53,31 @@ HybridAStar::HybridAStar(const PlannerOpenSpaceConfig& open_space_conf) {
       planner_open_space_config_.warm_start_config().traj_steer_penalty();
   traj_steer_change_penalty_ = planner_open_space_config_.warm_start_config()
                                    .traj_steer_change_penalty();
+  distance_map_resolution_ =
+      planner_open_space_config_.warm_start_config().distance_map_resolution();
+
+  // cover the box of Node3d::GetBoundingBox with circles along the heading
+  const double half_length = vehicle_param_.length() / 2.0;
+  const double half_width = vehicle_param_.width() / 2.0;
+  const int circle_num = std::max(
+      1, static_cast<int>(std::ceil(half_length / std::max(half_width, 0.1))));
+  const double circle_half_length = half_length / circle_num;
+  const double shift_distance =
+      half_length - vehicle_param_.back_edge_to_center();
+  footprint_circle_radius_ = std::hypot(circle_half_length, half_width);
+  for (int i = 0; i < circle_num; ++i) {
+    footprint_circle_offsets_.push_back(shift_distance - half_length +
+                                        (2 * i + 1) * circle_half_length);
+  }
 }
 
-bool HybridAStar::AnalyticExpansion(std::shared_ptr<Node3d> current_node) {
+bool HybridAStar::AnalyticExpansion(Node3d* current_node) {
   std::shared_ptr<ReedSheppPath> reeds_shepp_to_check =
       std::make_shared<ReedSheppPath>();
-  if (!reed_shepp_generator_->ShortestRSP(current_node, end_node_,
-                                          reeds_shepp_to_check)) {
+  // the pool owns the node, so it is only aliased without ownership here
+  if (!reed_shepp_generator_->ShortestRSP(
+          std::shared_ptr<Node3d>(std::shared_ptr<Node3d>(), current_node),
+          end_node_, reeds_shepp_to_check)) {
     ADEBUG << "ShortestRSP failed";
     return false;
   }
@@ -76,24 +94,26 @@ bool HybridAStar::AnalyticExpansion(std::shared_ptr<Node3d> current_node) {
 
 bool HybridAStar::RSPCheck(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end) {
-  std::shared_ptr<Node3d> node = std::shared_ptr<Node3d>(new Node3d(
-      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
-  return ValidityCheck(node);
+  CHECK_EQ(reeds_shepp_to_end->x.size(), reeds_shepp_to_end->y.size());
+  CHECK_EQ(reeds_shepp_to_end->x.size(), reeds_shepp_to_end->phi.size());
+  return ValidityCheck(reeds_shepp_to_end->x, reeds_shepp_to_end->y,
+                       reeds_shepp_to_end->phi);
+}
+
+bool HybridAStar::ValidityCheck(const Node3d& node) {
+  return ValidityCheck(node.GetXs(), node.GetYs(), node.GetPhis());
 }
 
-bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
-  CHECK_NOTNULL(node);
-  CHECK_GT(node->GetStepSize(), 0);
+bool HybridAStar::ValidityCheck(const std::vector<double>& traversed_x,
+                                const std::vector<double>& traversed_y,
+                                const std::vector<double>& traversed_phi) {
+  CHECK_GT(traversed_x.size(), 0);
 
   if (obstacles_linesegments_vec_.empty()) {
     return true;
   }
 
-  size_t node_step_size = node->GetStepSize();
-  const auto& traversed_x = node->GetXs();
-  const auto& traversed_y = node->GetYs();
-  const auto& traversed_phi = node->GetPhis();
+  size_t node_step_size = traversed_x.size();
 
   // The first {x, y, phi} is collision free unless they are start and end
   // configuration of search problem
@@ -109,6 +129,10 @@ bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
         traversed_y[i] > XYbounds_[3] || traversed_y[i] < XYbounds_[2]) {
       return false;
     }
+    // only the poses close to the obstacles go through the exact check
+    if (IsFarFromObstacles(traversed_x[i], traversed_y[i], traversed_phi[i])) {
+      continue;
+    }
     Box2d bounding_box = Node3d::GetBoundingBox(
         vehicle_param_, traversed_x[i], traversed_y[i], traversed_phi[i]);
     for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
@@ -127,19 +151,39 @@ bool HybridAStar::ValidityCheck(std::shared_ptr<Node3d> node) {
   return true;
 }
 
-std::shared_ptr<Node3d> HybridAStar::LoadRSPinCS(
+bool HybridAStar::IsFarFromObstacles(const double x, const double y,
+                                     const double phi) const {
+  if (distance_map_resolution_ <= 0.0) {
+    return false;
+  }
+  // keep clear of the tolerance of Box2d::HasOverlap
+  static constexpr double kClearance = 1e-6;
+  const double cos_phi = std::cos(phi);
+  const double sin_phi = std::sin(phi);
+  for (const double offset : footprint_circle_offsets_) {
+    if (distance_map_.DistanceLowerBound(x + offset * cos_phi,
+                                         y + offset * sin_phi) <=
+        footprint_circle_radius_ + kClearance) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Node3d* HybridAStar::LoadRSPinCS(
     const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
-    std::shared_ptr<Node3d> current_node) {
-  std::shared_ptr<Node3d> end_node = std::shared_ptr<Node3d>(new Node3d(
-      reeds_shepp_to_end->x, reeds_shepp_to_end->y, reeds_shepp_to_end->phi,
-      XYbounds_, planner_open_space_config_));
+    Node3d* current_node) {
+  Node3d* end_node = CreateNode();
+  end_node->Reset(reeds_shepp_to_end->x, reeds_shepp_to_end->y,
+                  reeds_shepp_to_end->phi, XYbounds_,
+                  planner_open_space_config_);
   end_node->SetPre(current_node);
   close_set_.emplace(end_node->GetIndex(), end_node);
   return end_node;
 }
 
-std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
-    std::shared_ptr<Node3d> current_node, size_t next_node_index) {
+Node3d* HybridAStar::Next_node_generator(Node3d* current_node,
+                                         size_t next_node_index) {
   double steering = 0.0;
   double traveled_distance = 0.0;
   if (next_node_index < static_cast<double>(next_node_num_) / 2) {
@@ -159,46 +203,45 @@ std::shared_ptr<Node3d> HybridAStar::Next_node_generator(
   // take above motion primitive to generate a curve driving the car to a
   // different grid
   double arc = std::sqrt(2) * xy_grid_resolution_;
-  std::vector<double> intermediate_x;
-  std::vector<double> intermediate_y;
-  std::vector<double> intermediate_phi;
+  intermediate_x_.clear();
+  intermediate_y_.clear();
+  intermediate_phi_.clear();
   double last_x = current_node->GetX();
   double last_y = current_node->GetY();
   double last_phi = current_node->GetPhi();
-  intermediate_x.push_back(last_x);
-  intermediate_y.push_back(last_y);
-  intermediate_phi.push_back(last_phi);
+  intermediate_x_.push_back(last_x);
+  intermediate_y_.push_back(last_y);
+  intermediate_phi_.push_back(last_phi);
   for (size_t i = 0; i < arc / step_size_; ++i) {
     const double next_x = last_x + traveled_distance * std::cos(last_phi);
     const double next_y = last_y + traveled_distance * std::sin(last_phi);
     const double next_phi = common::math::NormalizeAngle(
         last_phi +
         traveled_distance / vehicle_param_.wheel_base() * std::tan(steering));
-    intermediate_x.push_back(next_x);
-    intermediate_y.push_back(next_y);
-    intermediate_phi.push_back(next_phi);
+    intermediate_x_.push_back(next_x);
+    intermediate_y_.push_back(next_y);
+    intermediate_phi_.push_back(next_phi);
     last_x = next_x;
     last_y = next_y;
     last_phi = next_phi;
   }
   // check if the vehicle runs outside of XY boundary
-  if (intermediate_x.back() > XYbounds_[1] ||
-      intermediate_x.back() < XYbounds_[0] ||
-      intermediate_y.back() > XYbounds_[3] ||
-      intermediate_y.back() < XYbounds_[2]) {
+  if (intermediate_x_.back() > XYbounds_[1] ||
+      intermediate_x_.back() < XYbounds_[0] ||
+      intermediate_y_.back() > XYbounds_[3] ||
+      intermediate_y_.back() < XYbounds_[2]) {
     return nullptr;
   }
-  std::shared_ptr<Node3d> next_node = std::shared_ptr<Node3d>(
-      new Node3d(intermediate_x, intermediate_y, intermediate_phi, XYbounds_,
-                 planner_open_space_config_));
+  Node3d* next_node = CreateNode();
+  next_node->Reset(intermediate_x_, intermediate_y_, intermediate_phi_,
+                   XYbounds_, planner_open_space_config_);
   next_node->SetPre(current_node);
   next_node->SetDirec(traveled_distance > 0.0);
   next_node->SetSteer(steering);
   return next_node;
 }
 
-void HybridAStar::CalculateNodeCost(std::shared_ptr<Node3d> current_node,
-                                    std::shared_ptr<Node3d> next_node) {
+void HybridAStar::CalculateNodeCost(Node3d* current_node, Node3d* next_node) {
   next_node->SetTrajCost(current_node->GetTrajCost() +
                          TrajCost(current_node, next_node));
   // evaluate heuristic cost
@@ -207,8 +250,7 @@ void HybridAStar::CalculateNodeCost(std::shared_ptr<Node3d> current_node,
   next_node->SetHeuCost(optimal_path_cost);
 }
 
-double HybridAStar::TrajCost(std::shared_ptr<Node3d> current_node,
-                             std::shared_ptr<Node3d> next_node) {
+double HybridAStar::TrajCost(Node3d* current_node, Node3d* next_node) {
   // evaluate cost on the trajectory and add current cost
   double piecewise_cost = 0.0;
   if (next_node->GetDirec()) {
@@ -227,13 +269,20 @@ double HybridAStar::TrajCost(std::shared_ptr<Node3d> current_node,
   return piecewise_cost;
 }
 
-double HybridAStar::HoloObstacleHeuristic(std::shared_ptr<Node3d> next_node) {
+double HybridAStar::HoloObstacleHeuristic(Node3d* next_node) {
   return grid_a_star_heuristic_generator_->CheckDpMap(next_node->GetX(),
                                                       next_node->GetY());
 }
 
+Node3d* HybridAStar::CreateNode() {
+  if (node_pool_used_ == node_pool_.size()) {
+    node_pool_.emplace_back(new Node3d());
+  }
+  return node_pool_[node_pool_used_++].get();
+}
+
 bool HybridAStar::GetResult(HybridAStartResult* result) {
-  std::shared_ptr<Node3d> current_node = final_node_;
+  const Node3d* current_node = final_node_;
   std::vector<double> hybrid_a_x;
   std::vector<double> hybrid_a_y;
   std::vector<double> hybrid_a_phi;
@@ -642,6 +691,7 @@ bool HybridAStar::Plan(
   close_set_.clear();
   open_pq_ = decltype(open_pq_)();
   final_node_ = nullptr;
+  node_pool_used_ = 0;
 
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec;
@@ -659,16 +709,28 @@ bool HybridAStar::Plan(
 
   // load XYbounds
   XYbounds_ = XYbounds;
+  if (distance_map_resolution_ > 0.0 && !obstacles_linesegments_vec_.empty()) {
+    // the footprint circles of a pose in XYbounds stay in the map
+    double reach = 0.0;
+    for (const double offset : footprint_circle_offsets_) {
+      reach = std::max(reach, std::abs(offset));
+    }
+    const double distance_map_time = Clock::NowInSeconds();
+    distance_map_.Build(XYbounds_, reach + footprint_circle_radius_,
+                        distance_map_resolution_, obstacles_linesegments_vec_);
+    ADEBUG << "distance map time "
+           << Clock::NowInSeconds() - distance_map_time;
+  }
   // load nodes and obstacles
   start_node_.reset(
       new Node3d({sx}, {sy}, {sphi}, XYbounds_, planner_open_space_config_));
   end_node_.reset(
       new Node3d({ex}, {ey}, {ephi}, XYbounds_, planner_open_space_config_));
-  if (!ValidityCheck(start_node_)) {
+  if (!ValidityCheck(*start_node_)) {
     ADEBUG << "start_node in collision with obstacles";
     return false;
   }
-  if (!ValidityCheck(end_node_)) {
+  if (!ValidityCheck(*end_node_)) {
     ADEBUG << "end_node in collision with obstacles";
     return false;
   }
@@ -677,7 +739,7 @@ bool HybridAStar::Plan(
                                                   obstacles_linesegments_vec_);
   ADEBUG << "map time " << Clock::NowInSeconds() - map_time;
   // load open set, pq
-  open_set_.emplace(start_node_->GetIndex(), start_node_);
+  open_set_.emplace(start_node_->GetIndex(), start_node_.get());
   open_pq_.emplace(start_node_->GetIndex(), start_node_->GetCost());
 
   // Hybrid A* begins
@@ -687,9 +749,9 @@ bool HybridAStar::Plan(
   double rs_time = 0.0;
   while (!open_pq_.empty()) {
     // take out the lowest cost neighboring node
-    const std::string current_id = open_pq_.top().first;
+    const uint64_t current_id = open_pq_.top().first;
     open_pq_.pop();
-    std::shared_ptr<Node3d> current_node = open_set_[current_id];
+    Node3d* current_node = open_set_[current_id];
     // check if an analystic curve could be connected from current
     // configuration to the end configuration without collision. if so, search
     // ends.
@@ -701,17 +763,19 @@ bool HybridAStar::Plan(
     rs_time += rs_end_time - rs_start_time;
     close_set_.emplace(current_node->GetIndex(), current_node);
     for (size_t i = 0; i < next_node_num_; ++i) {
-      std::shared_ptr<Node3d> next_node = Next_node_generator(current_node, i);
+      Node3d* next_node = Next_node_generator(current_node, i);
       // boundary check failure handle
       if (next_node == nullptr) {
         continue;
       }
       // check if the node is already in the close set
       if (close_set_.find(next_node->GetIndex()) != close_set_.end()) {
+        ReleaseLastNode();
         continue;
       }
       // collision check
-      if (!ValidityCheck(next_node)) {
+      if (!ValidityCheck(*next_node)) {
+        ReleaseLastNode();
         continue;
       }
       if (open_set_.find(next_node->GetIndex()) == open_set_.end()) {
@@ -722,6 +786,8 @@ bool HybridAStar::Plan(
         heuristic_time += end_time - start_time;
         open_set_.emplace(next_node->GetIndex(), next_node);
         open_pq_.emplace(next_node->GetIndex(), next_node->GetCost());
+      } else {
+        ReleaseLastNode();
       }
     }
   }
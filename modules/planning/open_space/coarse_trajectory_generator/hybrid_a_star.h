@@ -21,9 +21,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <queue>
-#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -36,6 +36,7 @@
 #include "modules/common/math/math_utils.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/distance_map.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/grid_search.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/node3d.h"
 #include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_path.h"
@@ -67,22 +68,29 @@ class HybridAStar {
                            std::vector<HybridAStartResult>* partitioned_result);
 
  private:
-  bool AnalyticExpansion(std::shared_ptr<Node3d> current_node);
+  bool AnalyticExpansion(Node3d* current_node);
   // check collision and validity
-  bool ValidityCheck(std::shared_ptr<Node3d> node);
+  bool ValidityCheck(const Node3d& node);
+  bool ValidityCheck(const std::vector<double>& traversed_x,
+                     const std::vector<double>& traversed_y,
+                     const std::vector<double>& traversed_phi);
+  // whether the circles covering the vehicle box are clear of the obstacles
+  // according to the distance map, false when it can't tell
+  bool IsFarFromObstacles(const double x, const double y,
+                          const double phi) const;
   // check Reeds Shepp path collision and validity
   bool RSPCheck(const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end);
   // load the whole RSP as nodes and add to the close set
-  std::shared_ptr<Node3d> LoadRSPinCS(
-      const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
-      std::shared_ptr<Node3d> current_node);
-  std::shared_ptr<Node3d> Next_node_generator(
-      std::shared_ptr<Node3d> current_node, size_t next_node_index);
-  void CalculateNodeCost(std::shared_ptr<Node3d> current_node,
-                         std::shared_ptr<Node3d> next_node);
-  double TrajCost(std::shared_ptr<Node3d> current_node,
-                  std::shared_ptr<Node3d> next_node);
-  double HoloObstacleHeuristic(std::shared_ptr<Node3d> next_node);
+  Node3d* LoadRSPinCS(const std::shared_ptr<ReedSheppPath> reeds_shepp_to_end,
+                      Node3d* current_node);
+  Node3d* Next_node_generator(Node3d* current_node, size_t next_node_index);
+  void CalculateNodeCost(Node3d* current_node, Node3d* next_node);
+  double TrajCost(Node3d* current_node, Node3d* next_node);
+  double HoloObstacleHeuristic(Node3d* next_node);
+  // take a node from the pool, which is reused by the following Plan() calls
+  Node3d* CreateNode();
+  // give back the last created node when it is not added to the search
+  void ReleaseLastNode() { --node_pool_used_; }
   bool GetResult(HybridAStartResult* result);
   bool GetTemporalProfile(HybridAStartResult* result);
   bool GenerateSpeedAcceleration(HybridAStartResult* result);
@@ -110,21 +118,33 @@ class HybridAStar {
   std::vector<double> XYbounds_;
   std::shared_ptr<Node3d> start_node_;
   std::shared_ptr<Node3d> end_node_;
-  std::shared_ptr<Node3d> final_node_;
+  Node3d* final_node_ = nullptr;
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec_;
 
   struct cmp {
-    bool operator()(const std::pair<std::string, double>& left,
-                    const std::pair<std::string, double>& right) const {
+    bool operator()(const std::pair<uint64_t, double>& left,
+                    const std::pair<uint64_t, double>& right) const {
       return left.second >= right.second;
     }
   };
-  std::priority_queue<std::pair<std::string, double>,
-                      std::vector<std::pair<std::string, double>>, cmp>
+  std::priority_queue<std::pair<uint64_t, double>,
+                      std::vector<std::pair<uint64_t, double>>, cmp>
       open_pq_;
-  std::unordered_map<std::string, std::shared_ptr<Node3d>> open_set_;
-  std::unordered_map<std::string, std::shared_ptr<Node3d>> close_set_;
+  std::unordered_map<uint64_t, Node3d*> open_set_;
+  std::unordered_map<uint64_t, Node3d*> close_set_;
+  double distance_map_resolution_ = 0.0;
+  DistanceMap distance_map_;
+  // offsets of the footprint circle centers from the vehicle position along
+  // the heading
+  std::vector<double> footprint_circle_offsets_;
+  double footprint_circle_radius_ = 0.0;
+  std::vector<std::unique_ptr<Node3d>> node_pool_;
+  size_t node_pool_used_ = 0;
+  // states of the motion primitive being expanded
+  std::vector<double> intermediate_x_;
+  std::vector<double> intermediate_y_;
+  std::vector<double> intermediate_phi_;
   std::unique_ptr<ReedShepp> reed_shepp_generator_;
   std::unique_ptr<GridSearch> grid_a_star_heuristic_generator_;
 };
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/*
+ * @file
+ * @brief Benchmarks of the hybrid a star search. Run it with -c opt on two
+ * revisions to compare them.
+ */
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "cyber/common/file.h"
+#include "modules/common/math/vec2d.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/open_space/coarse_trajectory_generator/hybrid_a_star.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Vec2d;
+
+namespace {
+
+struct Scenario {
+  double sx;
+  double sy;
+  double sphi;
+  double ex;
+  double ey;
+  double ephi;
+  std::vector<double> XYbounds;
+  std::vector<std::vector<Vec2d>> obstacles;
+};
+
+Scenario GetScenario(int64_t id) {
+  if (id == 0) {
+    // the scenario of hybrid_a_star_test
+    return {-15.0, 0.0, 0.0, 15.0, 0.0, 0.0,
+            {-50.0, 50.0, -50.0, 50.0},
+            {{Vec2d(1.0, 0.0), Vec2d(-1.0, 0.0)}}};
+  }
+  // backing into a parking spot between two walls
+  return {-8.0, 4.0, 0.0, 0.0, -4.0, M_PI_2,
+          {-15.0, 15.0, -7.0, 9.0},
+          {{Vec2d(-15.0, 0.0), Vec2d(-1.5, 0.0), Vec2d(-1.5, -6.0),
+            Vec2d(1.5, -6.0), Vec2d(1.5, 0.0), Vec2d(15.0, 0.0)},
+           {Vec2d(-15.0, 8.0), Vec2d(15.0, 8.0)}}};
+}
+
+PlannerOpenSpaceConfig LoadConfig() {
+  PlannerOpenSpaceConfig config;
+  ACHECK(cyber::common::GetProtoFromFile(
+      "/apollo/modules/planning/testdata/conf/"
+      "open_space_standard_parking_lot.pb.txt",
+      &config));
+  return config;
+}
+
+}  // namespace
+
+void BM_HybridAStarPlan(benchmark::State& state) {  // NOLINT
+  const Scenario scenario = GetScenario(state.range(0));
+  HybridAStar hybrid_a_star(LoadConfig());
+  for (auto _ : state) {
+    HybridAStartResult result;
+    const bool planned = hybrid_a_star.Plan(
+        scenario.sx, scenario.sy, scenario.sphi, scenario.ex, scenario.ey,
+        scenario.ephi, scenario.XYbounds, scenario.obstacles, &result);
+    benchmark::DoNotOptimize(planned);
+  }
+}
+BENCHMARK(BM_HybridAStarPlan)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+void BM_GridSearchDpMap(benchmark::State& state) {  // NOLINT
+  const Scenario scenario = GetScenario(state.range(0));
+  std::vector<std::vector<common::math::LineSegment2d>> obstacles;
+  for (const auto& vertices : scenario.obstacles) {
+    obstacles.emplace_back();
+    for (size_t i = 0; i + 1 < vertices.size(); ++i) {
+      obstacles.back().emplace_back(vertices[i], vertices[i + 1]);
+    }
+  }
+  GridSearch grid_search(LoadConfig());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(grid_search.GenerateDpMap(
+        scenario.ex, scenario.ey, scenario.XYbounds, obstacles));
+  }
+}
+BENCHMARK(BM_GridSearchDpMap)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+}  // namespace planning
+}  // namespace apollo
+
+BENCHMARK_MAIN();
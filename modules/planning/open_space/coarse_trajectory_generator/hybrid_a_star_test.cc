@@ -76,5 +76,26 @@ TEST_F(HybridATest, test1) {
   ASSERT_TRUE(hybrid_test->Plan(sx, sy, sphi, ex, ey, ephi, XYbounds_,
                                 obstacles_list, &result));
 }
+
+TEST_F(HybridATest, replan_reuses_nodes) {
+  std::vector<std::vector<Vec2d>> obstacles_list = {
+      {Vec2d(1.0, 0.0), Vec2d(-1.0, 0.0)}};
+  std::vector<double> XYbounds = {-50.0, 50.0, -50.0, 50.0};
+  HybridAStartResult first_result;
+  ASSERT_TRUE(hybrid_test->Plan(-15.0, 0.0, 0.0, 15.0, 0.0, 0.0, XYbounds,
+                                obstacles_list, &first_result));
+
+  // a different search in between leaves the pooled nodes dirty
+  HybridAStartResult other_result;
+  ASSERT_TRUE(hybrid_test->Plan(0.0, -10.0, M_PI_2, 10.0, 10.0, 0.0,
+                                XYbounds, obstacles_list, &other_result));
+
+  HybridAStartResult second_result;
+  ASSERT_TRUE(hybrid_test->Plan(-15.0, 0.0, 0.0, 15.0, 0.0, 0.0, XYbounds,
+                                obstacles_list, &second_result));
+  EXPECT_EQ(first_result.x, second_result.x);
+  EXPECT_EQ(first_result.y, second_result.y);
+  EXPECT_EQ(first_result.phi, second_result.phi);
+}
 }  // namespace planning
 }  // namespace apollo
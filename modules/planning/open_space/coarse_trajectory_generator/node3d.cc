@@ -20,8 +20,6 @@
 
 #include "modules/planning/open_space/coarse_trajectory_generator/node3d.h"
 
-#include "absl/strings/str_cat.h"
-
 namespace apollo {
 namespace planning {
 
@@ -57,7 +55,7 @@ Node3d::Node3d(double x, double y, double phi,
   traversed_y_.push_back(y);
   traversed_phi_.push_back(phi);
 
-  index_ = ComputeStringIndex(x_grid_, y_grid_, phi_grid_);
+  index_ = ComputeIndex(x_grid_, y_grid_, phi_grid_);
 }
 
 Node3d::Node3d(const std::vector<double>& traversed_x,
@@ -65,6 +63,14 @@ Node3d::Node3d(const std::vector<double>& traversed_x,
                const std::vector<double>& traversed_phi,
                const std::vector<double>& XYbounds,
                const PlannerOpenSpaceConfig& open_space_conf) {
+  Reset(traversed_x, traversed_y, traversed_phi, XYbounds, open_space_conf);
+}
+
+void Node3d::Reset(const std::vector<double>& traversed_x,
+                   const std::vector<double>& traversed_y,
+                   const std::vector<double>& traversed_phi,
+                   const std::vector<double>& XYbounds,
+                   const PlannerOpenSpaceConfig& open_space_conf) {
   CHECK_EQ(XYbounds.size(), 4)
       << "XYbounds size is not 4, but" << XYbounds.size();
   CHECK_EQ(traversed_x.size(), traversed_y.size());
@@ -89,8 +95,15 @@ Node3d::Node3d(const std::vector<double>& traversed_x,
   traversed_y_ = traversed_y;
   traversed_phi_ = traversed_phi;
 
-  index_ = ComputeStringIndex(x_grid_, y_grid_, phi_grid_);
+  index_ = ComputeIndex(x_grid_, y_grid_, phi_grid_);
   step_size_ = traversed_x.size();
+
+  traj_cost_ = 0.0;
+  heuristic_cost_ = 0.0;
+  cost_ = 0.0;
+  pre_node_ = nullptr;
+  steering_ = 0.0;
+  direction_ = true;
 }
 
 Box2d Node3d::GetBoundingBox(const common::VehicleParam& vehicle_param_,
@@ -109,9 +122,5 @@ bool Node3d::operator==(const Node3d& right) const {
   return right.GetIndex() == index_;
 }
 
-std::string Node3d::ComputeStringIndex(int x_grid, int y_grid, int phi_grid) {
-  return absl::StrCat(x_grid, "_", y_grid, "_", phi_grid);
-}
-
 }  // namespace planning
 }  // namespace apollo
@@ -20,8 +20,8 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
-#include <string>
 #include <vector>
 
 #include "modules/common/math/box2d.h"
@@ -33,6 +33,7 @@ namespace planning {
 
 class Node3d {
  public:
+  Node3d() = default;
   Node3d(const double x, const double y, const double phi);
   Node3d(const double x, const double y, const double phi,
          const std::vector<double>& XYbounds,
@@ -43,6 +44,15 @@ class Node3d {
          const std::vector<double>& XYbounds,
          const PlannerOpenSpaceConfig& open_space_conf);
   virtual ~Node3d() = default;
+  /**
+   * @brief Reinitialize the node with new traversed states. The state vectors
+   * keep their capacity, so a node reused from a pool doesn't allocate.
+   */
+  void Reset(const std::vector<double>& traversed_x,
+             const std::vector<double>& traversed_y,
+             const std::vector<double>& traversed_phi,
+             const std::vector<double>& XYbounds,
+             const PlannerOpenSpaceConfig& open_space_conf);
   static apollo::common::math::Box2d GetBoundingBox(
       const common::VehicleParam& vehicle_param_, const double x,
       const double y, const double phi);
@@ -56,22 +66,29 @@ class Node3d {
   double GetY() const { return y_; }
   double GetPhi() const { return phi_; }
   bool operator==(const Node3d& right) const;
-  const std::string& GetIndex() const { return index_; }
+  uint64_t GetIndex() const { return index_; }
   size_t GetStepSize() const { return step_size_; }
   bool GetDirec() const { return direction_; }
   double GetSteer() const { return steering_; }
-  std::shared_ptr<Node3d> GetPreNode() const { return pre_node_; }
+  const Node3d* GetPreNode() const { return pre_node_; }
   const std::vector<double>& GetXs() const { return traversed_x_; }
   const std::vector<double>& GetYs() const { return traversed_y_; }
   const std::vector<double>& GetPhis() const { return traversed_phi_; }
-  void SetPre(std::shared_ptr<Node3d> pre_node) { pre_node_ = pre_node; }
+  void SetPre(const Node3d* pre_node) { pre_node_ = pre_node; }
   void SetDirec(bool direction) { direction_ = direction; }
   void SetTrajCost(double cost) { traj_cost_ = cost; }
   void SetHeuCost(double cost) { heuristic_cost_ = cost; }
   void SetSteer(double steering) { steering_ = steering; }
 
  private:
-  static std::string ComputeStringIndex(int x_grid, int y_grid, int phi_grid);
+  // packs the grid coordinates, 24 bits for x and y and 16 bits for phi
+  static uint64_t ComputeIndex(int x_grid, int y_grid, int phi_grid) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x_grid) & 0xFFFFFF)
+            << 40) |
+           (static_cast<uint64_t>(static_cast<uint32_t>(y_grid) & 0xFFFFFF)
+            << 16) |
+           (static_cast<uint32_t>(phi_grid) & 0xFFFF);
+  }
 
  private:
   double x_ = 0.0;
@@ -84,11 +101,11 @@ class Node3d {
   int x_grid_ = 0;
   int y_grid_ = 0;
   int phi_grid_ = 0;
-  std::string index_;
+  uint64_t index_ = 0;
   double traj_cost_ = 0.0;
   double heuristic_cost_ = 0.0;
   double cost_ = 0.0;
-  std::shared_ptr<Node3d> pre_node_ = nullptr;
+  const Node3d* pre_node_ = nullptr;
   double steering_ = 0.0;
   // true for moving forward and false for moving backward
   bool direction_ = true;
@@ -20,9 +20,189 @@
 
 #include "modules/planning/open_space/coarse_trajectory_generator/reeds_shepp_path.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 namespace apollo {
 namespace planning {
 
+namespace {
+
+// the functions computing the lengths of the words of a family
+enum class RSPFamily { SLS, LSL, LSR, LRL, LRLRn, LRLRp, LRSLR };
+
+// the parameter which the length of a segment is taken from
+enum RSPSegment { kT, kU, kV, kHalfPi };
+
+// A word of the movement primitives. The end pose, or the start pose seen
+// from the end for the backward words, is mirrored by x_sign and y_sign
+// before the lengths of the family are computed, and each segment length is
+// the parameter times its sign.
+struct RSPWord {
+  RSPFamily family;
+  bool backward;
+  double x_sign;
+  double y_sign;
+  const char* types;
+  RSPSegment segments[5];
+  double segment_signs[5];
+};
+
+// all the words tried by GenerateRSP, in the order of trial
+const RSPWord kRSPWords[] = {
+    // SCS
+    {RSPFamily::SLS, false, 1.0, 1.0, "SLS",
+     {kT, kU, kV},
+     {1.0, 1.0, 1.0}},
+    {RSPFamily::SLS, false, 1.0, -1.0, "SRS",
+     {kT, kU, kV},
+     {1.0, 1.0, 1.0}},
+    // CSC
+    {RSPFamily::LSL, false, 1.0, 1.0, "LSL",
+     {kT, kU, kV},
+     {1.0, 1.0, 1.0}},
+    {RSPFamily::LSL, false, -1.0, 1.0, "LSL",
+     {kT, kU, kV},
+     {-1.0, -1.0, -1.0}},
+    {RSPFamily::LSL, false, 1.0, -1.0, "RSR",
+     {kT, kU, kV},
+     {1.0, 1.0, 1.0}},
+    {RSPFamily::LSL, false, -1.0, -1.0, "RSR",
+     {kT, kU, kV},
+     {-1.0, -1.0, -1.0}},
+    {RSPFamily::LSR, false, 1.0, 1.0, "LSR",
+     {kT, kU, kV},
+     {1.0, 1.0, 1.0}},
+    {RSPFamily::LSR, false, -1.0, 1.0, "LSR",
+     {kT, kU, kV},
+     {-1.0, -1.0, -1.0}},
+    {RSPFamily::LSR, false, 1.0, -1.0, "RSL",
+     {kT, kU, kV},
+     {1.0, 1.0, 1.0}},
+    {RSPFamily::LSR, false, -1.0, -1.0, "RSL",
+     {kT, kU, kV},
+     {-1.0, -1.0, -1.0}},
+    // CCC
+    {RSPFamily::LRL, false, 1.0, 1.0, "LRL",
+     {kT, kU, kV},
+     {1.0, 1.0, 1.0}},
+    {RSPFamily::LRL, false, -1.0, 1.0, "LRL",
+     {kT, kU, kV},
+     {-1.0, -1.0, -1.0}},
+    {RSPFamily::LRL, false, 1.0, -1.0, "RLR",
+     {kT, kU, kV},
+     {1.0, 1.0, 1.0}},
+    {RSPFamily::LRL, false, -1.0, -1.0, "RLR",
+     {kT, kU, kV},
+     {-1.0, -1.0, -1.0}},
+    // CCC, backward
+    {RSPFamily::LRL, true, 1.0, 1.0, "LRL",
+     {kV, kU, kT},
+     {1.0, 1.0, 1.0}},
+    {RSPFamily::LRL, true, -1.0, 1.0, "LRL",
+     {kV, kU, kT},
+     {-1.0, -1.0, -1.0}},
+    {RSPFamily::LRL, true, 1.0, -1.0, "RLR",
+     {kV, kU, kT},
+     {1.0, 1.0, 1.0}},
+    {RSPFamily::LRL, true, -1.0, -1.0, "RLR",
+     {kV, kU, kT},
+     {-1.0, -1.0, -1.0}},
+    // CCCC
+    {RSPFamily::LRLRn, false, 1.0, 1.0, "LRLR",
+     {kT, kU, kU, kV},
+     {1.0, 1.0, -1.0, 1.0}},
+    {RSPFamily::LRLRn, false, -1.0, 1.0, "LRLR",
+     {kT, kU, kU, kV},
+     {-1.0, -1.0, 1.0, -1.0}},
+    {RSPFamily::LRLRn, false, 1.0, -1.0, "RLRL",
+     {kT, kU, kU, kV},
+     {1.0, 1.0, -1.0, 1.0}},
+    {RSPFamily::LRLRn, false, -1.0, -1.0, "RLRL",
+     {kT, kU, kU, kV},
+     {-1.0, -1.0, 1.0, -1.0}},
+    {RSPFamily::LRLRp, false, 1.0, 1.0, "LRLR",
+     {kT, kU, kU, kV},
+     {1.0, 1.0, 1.0, 1.0}},
+    {RSPFamily::LRLRp, false, -1.0, 1.0, "LRLR",
+     {kT, kU, kU, kV},
+     {-1.0, -1.0, -1.0, -1.0}},
+    {RSPFamily::LRLRp, false, 1.0, -1.0, "RLRL",
+     {kT, kU, kU, kV},
+     {1.0, 1.0, 1.0, 1.0}},
+    {RSPFamily::LRLRp, false, -1.0, -1.0, "RLRL",
+     {kT, kU, kU, kV},
+     {-1.0, -1.0, -1.0, -1.0}},
+    // CCSC
+    {RSPFamily::LRLRn, false, 1.0, 1.0, "LRSL",
+     {kT, kHalfPi, kU, kV},
+     {1.0, -1.0, -1.0, 1.0}},
+    {RSPFamily::LRLRn, false, -1.0, 1.0, "LRSL",
+     {kT, kHalfPi, kU, kV},
+     {-1.0, 1.0, -1.0, -1.0}},
+    {RSPFamily::LRLRn, false, 1.0, -1.0, "RLSR",
+     {kT, kHalfPi, kU, kV},
+     {1.0, -1.0, 1.0, 1.0}},
+    {RSPFamily::LRLRn, false, -1.0, -1.0, "RLSR",
+     {kT, kHalfPi, kU, kV},
+     {-1.0, -1.0, -1.0, -1.0}},
+    {RSPFamily::LRLRp, false, 1.0, 1.0, "LRSR",
+     {kT, kHalfPi, kU, kV},
+     {1.0, -1.0, 1.0, 1.0}},
+    {RSPFamily::LRLRp, false, -1.0, 1.0, "LRSR",
+     {kT, kHalfPi, kU, kV},
+     {-1.0, 1.0, -1.0, -1.0}},
+    {RSPFamily::LRLRp, false, 1.0, -1.0, "RLSL",
+     {kT, kHalfPi, kU, kV},
+     {1.0, -1.0, 1.0, 1.0}},
+    {RSPFamily::LRLRp, false, -1.0, -1.0, "RLSL",
+     {kT, kHalfPi, kU, kV},
+     {-1.0, 1.0, -1.0, -1.0}},
+    // CCSC, backward
+    {RSPFamily::LRLRn, true, 1.0, 1.0, "LSRL",
+     {kV, kU, kHalfPi, kT},
+     {1.0, 1.0, -1.0, 1.0}},
+    {RSPFamily::LRLRn, true, -1.0, 1.0, "LSRL",
+     {kV, kU, kHalfPi, kT},
+     {-1.0, -1.0, 1.0, -1.0}},
+    {RSPFamily::LRLRn, true, 1.0, -1.0, "RSLR",
+     {kV, kU, kHalfPi, kT},
+     {1.0, 1.0, -1.0, 1.0}},
+    {RSPFamily::LRLRn, true, -1.0, -1.0, "RSLR",
+     {kV, kU, kHalfPi, kT},
+     {-1.0, -1.0, 1.0, -1.0}},
+    {RSPFamily::LRLRp, true, 1.0, 1.0, "RSRL",
+     {kV, kU, kHalfPi, kT},
+     {1.0, 1.0, -1.0, 1.0}},
+    {RSPFamily::LRLRp, true, -1.0, 1.0, "RSRL",
+     {kV, kU, kHalfPi, kT},
+     {-1.0, -1.0, 1.0, -1.0}},
+    {RSPFamily::LRLRp, true, 1.0, -1.0, "LSLR",
+     {kV, kU, kHalfPi, kT},
+     {1.0, 1.0, -1.0, 1.0}},
+    {RSPFamily::LRLRp, true, -1.0, -1.0, "LSLR",
+     {kV, kU, kHalfPi, kT},
+     {-1.0, -1.0, 1.0, -1.0}},
+    // CCSCC
+    {RSPFamily::LRSLR, false, 1.0, 1.0, "LRSLR",
+     {kT, kHalfPi, kU, kHalfPi, kV},
+     {1.0, -1.0, 1.0, -1.0, 1.0}},
+    {RSPFamily::LRSLR, false, -1.0, 1.0, "LRSLR",
+     {kT, kHalfPi, kU, kHalfPi, kV},
+     {-1.0, 1.0, -1.0, 1.0, -1.0}},
+    {RSPFamily::LRSLR, false, 1.0, -1.0, "RLSRL",
+     {kT, kHalfPi, kU, kHalfPi, kV},
+     {1.0, -1.0, 1.0, -1.0, 1.0}},
+    {RSPFamily::LRSLR, false, -1.0, -1.0, "RLSRL",
+     {kT, kHalfPi, kU, kHalfPi, kV},
+     {-1.0, 1.0, -1.0, 1.0, -1.0}},
+};
+
+constexpr size_t kRSPWordNum = sizeof(kRSPWords) / sizeof(kRSPWords[0]);
+
+}  // namespace
+
 ReedShepp::ReedShepp(const common::VehicleParam& vehicle_param,
                      const PlannerOpenSpaceConfig& open_space_conf)
     : vehicle_param_(vehicle_param),
@@ -58,20 +238,27 @@ bool ReedShepp::ShortestRSP(const std::shared_ptr<Node3d> start_node,
                             const std::shared_ptr<Node3d> end_node,
                             std::shared_ptr<ReedSheppPath> optimal_path) {
   std::vector<ReedSheppPath> all_possible_paths;
-  if (!GenerateRSPs(start_node, end_node, &all_possible_paths)) {
-    ADEBUG << "Fail to generate different combination of Reed Shepp "
-              "paths";
-    return false;
-  }
-
-  double optimal_path_length = std::numeric_limits<double>::infinity();
   size_t optimal_path_index = 0;
-  size_t paths_size = all_possible_paths.size();
-  for (size_t i = 0; i < paths_size; ++i) {
-    if (all_possible_paths.at(i).total_length > 0 &&
-        all_possible_paths.at(i).total_length < optimal_path_length) {
-      optimal_path_index = i;
-      optimal_path_length = all_possible_paths.at(i).total_length;
+  if (!FLAGS_enable_parallel_hybrid_a) {
+    if (!GenerateShortestRSP(start_node, end_node, &all_possible_paths)) {
+      ADEBUG << "Fail to generate the shortest Reed Shepp path";
+      return false;
+    }
+  } else {
+    if (!GenerateRSPs(start_node, end_node, &all_possible_paths)) {
+      ADEBUG << "Fail to generate different combination of Reed Shepp "
+                "paths";
+      return false;
+    }
+
+    double optimal_path_length = std::numeric_limits<double>::infinity();
+    size_t paths_size = all_possible_paths.size();
+    for (size_t i = 0; i < paths_size; ++i) {
+      if (all_possible_paths.at(i).total_length > 0 &&
+          all_possible_paths.at(i).total_length < optimal_path_length) {
+        optimal_path_index = i;
+        optimal_path_length = all_possible_paths.at(i).total_length;
+      }
     }
   }
 
@@ -101,16 +288,7 @@ bool ReedShepp::ShortestRSP(const std::shared_ptr<Node3d> start_node,
            << end_node->GetY() << ", " << end_node->GetPhi();
     return false;
   }
-  (*optimal_path).x = all_possible_paths[optimal_path_index].x;
-  (*optimal_path).y = all_possible_paths[optimal_path_index].y;
-  (*optimal_path).phi = all_possible_paths[optimal_path_index].phi;
-  (*optimal_path).gear = all_possible_paths[optimal_path_index].gear;
-  (*optimal_path).total_length =
-      all_possible_paths[optimal_path_index].total_length;
-  (*optimal_path).segs_types =
-      all_possible_paths[optimal_path_index].segs_types;
-  (*optimal_path).segs_lengths =
-      all_possible_paths[optimal_path_index].segs_lengths;
+  *optimal_path = std::move(all_possible_paths[optimal_path_index]);
   return true;
 }
 
@@ -132,560 +310,150 @@ bool ReedShepp::GenerateRSPs(const std::shared_ptr<Node3d> start_node,
   return true;
 }
 
-bool ReedShepp::GenerateRSP(const std::shared_ptr<Node3d> start_node,
-                            const std::shared_ptr<Node3d> end_node,
-                            std::vector<ReedSheppPath>* all_possible_paths) {
+void ReedShepp::NormalizeRSPPose(const std::shared_ptr<Node3d> start_node,
+                                 const std::shared_ptr<Node3d> end_node,
+                                 double* x, double* y, double* phi, double* xb,
+                                 double* yb) const {
   double dx = end_node->GetX() - start_node->GetX();
   double dy = end_node->GetY() - start_node->GetY();
   double dphi = end_node->GetPhi() - start_node->GetPhi();
   double c = std::cos(start_node->GetPhi());
   double s = std::sin(start_node->GetPhi());
   // normalize the initial point to (0,0,0)
-  double x = (c * dx + s * dy) * max_kappa_;
-  double y = (-s * dx + c * dy) * max_kappa_;
-  if (!SCS(x, y, dphi, all_possible_paths)) {
-    ADEBUG << "Fail at SCS";
-  }
-  if (!CSC(x, y, dphi, all_possible_paths)) {
-    ADEBUG << "Fail at CSC";
-  }
-  if (!CCC(x, y, dphi, all_possible_paths)) {
-    ADEBUG << "Fail at CCC";
-  }
-  if (!CCCC(x, y, dphi, all_possible_paths)) {
-    ADEBUG << "Fail at CCCC";
-  }
-  if (!CCSC(x, y, dphi, all_possible_paths)) {
-    ADEBUG << "Fail at CCSC";
-  }
-  if (!CCSCC(x, y, dphi, all_possible_paths)) {
-    ADEBUG << "Fail at CCSCC";
-  }
-  if (all_possible_paths->empty()) {
-    ADEBUG << "No path generated by certain two configurations";
-    return false;
-  }
-  return true;
-}
-
-bool ReedShepp::SCS(const double x, const double y, const double phi,
-                    std::vector<ReedSheppPath>* all_possible_paths) {
-  RSPParam SLS_param;
-  SLS(x, y, phi, &SLS_param);
-  double SLS_lengths[3] = {SLS_param.t, SLS_param.u, SLS_param.v};
-  char SLS_types[] = "SLS";
-  if (SLS_param.flag &&
-      !SetRSP(3, SLS_lengths, SLS_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with SLS_param";
-    return false;
-  }
-
-  RSPParam SRS_param;
-  SLS(x, -y, -phi, &SRS_param);
-  double SRS_lengths[3] = {SRS_param.t, SRS_param.u, SRS_param.v};
-  char SRS_types[] = "SRS";
-  if (SRS_param.flag &&
-      !SetRSP(3, SRS_lengths, SRS_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with SRS_param";
-    return false;
-  }
-  return true;
-}
-
-bool ReedShepp::CSC(const double x, const double y, const double phi,
-                    std::vector<ReedSheppPath>* all_possible_paths) {
-  RSPParam LSL1_param;
-  LSL(x, y, phi, &LSL1_param);
-  double LSL1_lengths[3] = {LSL1_param.t, LSL1_param.u, LSL1_param.v};
-  char LSL1_types[] = "LSL";
-  if (LSL1_param.flag &&
-      !SetRSP(3, LSL1_lengths, LSL1_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LSL_param";
-    return false;
-  }
-
-  RSPParam LSL2_param;
-  LSL(-x, y, -phi, &LSL2_param);
-  double LSL2_lengths[3] = {-LSL2_param.t, -LSL2_param.u, -LSL2_param.v};
-  char LSL2_types[] = "LSL";
-  if (LSL2_param.flag &&
-      !SetRSP(3, LSL2_lengths, LSL2_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LSL2_param";
-    return false;
-  }
-
-  RSPParam LSL3_param;
-  LSL(x, -y, -phi, &LSL3_param);
-  double LSL3_lengths[3] = {LSL3_param.t, LSL3_param.u, LSL3_param.v};
-  char LSL3_types[] = "RSR";
-  if (LSL3_param.flag &&
-      !SetRSP(3, LSL3_lengths, LSL3_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LSL3_param";
-    return false;
-  }
-
-  RSPParam LSL4_param;
-  LSL(-x, -y, phi, &LSL4_param);
-  double LSL4_lengths[3] = {-LSL4_param.t, -LSL4_param.u, -LSL4_param.v};
-  char LSL4_types[] = "RSR";
-  if (LSL4_param.flag &&
-      !SetRSP(3, LSL4_lengths, LSL4_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LSL4_param";
-    return false;
-  }
-
-  RSPParam LSR1_param;
-  LSR(x, y, phi, &LSR1_param);
-  double LSR1_lengths[3] = {LSR1_param.t, LSR1_param.u, LSR1_param.v};
-  char LSR1_types[] = "LSR";
-  if (LSR1_param.flag &&
-      !SetRSP(3, LSR1_lengths, LSR1_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LSR1_param";
-    return false;
-  }
-
-  RSPParam LSR2_param;
-  LSR(-x, y, -phi, &LSR2_param);
-  double LSR2_lengths[3] = {-LSR2_param.t, -LSR2_param.u, -LSR2_param.v};
-  char LSR2_types[] = "LSR";
-  if (LSR2_param.flag &&
-      !SetRSP(3, LSR2_lengths, LSR2_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LSR2_param";
-    return false;
-  }
-
-  RSPParam LSR3_param;
-  LSR(x, -y, -phi, &LSR3_param);
-  double LSR3_lengths[3] = {LSR3_param.t, LSR3_param.u, LSR3_param.v};
-  char LSR3_types[] = "RSL";
-  if (LSR3_param.flag &&
-      !SetRSP(3, LSR3_lengths, LSR3_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LSR3_param";
-    return false;
-  }
-
-  RSPParam LSR4_param;
-  LSR(-x, -y, phi, &LSR4_param);
-  double LSR4_lengths[3] = {-LSR4_param.t, -LSR4_param.u, -LSR4_param.v};
-  char LSR4_types[] = "RSL";
-  if (LSR4_param.flag &&
-      !SetRSP(3, LSR4_lengths, LSR4_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LSR4_param";
-    return false;
-  }
-  return true;
-}
-
-bool ReedShepp::CCC(const double x, const double y, const double phi,
-                    std::vector<ReedSheppPath>* all_possible_paths) {
-  RSPParam LRL1_param;
-  LRL(x, y, phi, &LRL1_param);
-  double LRL1_lengths[3] = {LRL1_param.t, LRL1_param.u, LRL1_param.v};
-  char LRL1_types[] = "LRL";
-  if (LRL1_param.flag &&
-      !SetRSP(3, LRL1_lengths, LRL1_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRL_param";
-    return false;
-  }
-
-  RSPParam LRL2_param;
-  LRL(-x, y, -phi, &LRL2_param);
-  double LRL2_lengths[3] = {-LRL2_param.t, -LRL2_param.u, -LRL2_param.v};
-  char LRL2_types[] = "LRL";
-  if (LRL2_param.flag &&
-      !SetRSP(3, LRL2_lengths, LRL2_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRL2_param";
-    return false;
-  }
-
-  RSPParam LRL3_param;
-  LRL(x, -y, -phi, &LRL3_param);
-  double LRL3_lengths[3] = {LRL3_param.t, LRL3_param.u, LRL3_param.v};
-  char LRL3_types[] = "RLR";
-  if (LRL3_param.flag &&
-      !SetRSP(3, LRL3_lengths, LRL3_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRL3_param";
-    return false;
-  }
-
-  RSPParam LRL4_param;
-  LRL(-x, -y, phi, &LRL4_param);
-  double LRL4_lengths[3] = {-LRL4_param.t, -LRL4_param.u, -LRL4_param.v};
-  char LRL4_types[] = "RLR";
-  if (LRL4_param.flag &&
-      !SetRSP(3, LRL4_lengths, LRL4_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRL4_param";
-    return false;
-  }
-
+  *x = (c * dx + s * dy) * max_kappa_;
+  *y = (-s * dx + c * dy) * max_kappa_;
+  *phi = dphi;
   // backward
-  double xb = x * std::cos(phi) + y * std::sin(phi);
-  double yb = x * std::sin(phi) - y * std::cos(phi);
-
-  RSPParam LRL5_param;
-  LRL(xb, yb, phi, &LRL5_param);
-  double LRL5_lengths[3] = {LRL5_param.v, LRL5_param.u, LRL5_param.t};
-  char LRL5_types[] = "LRL";
-  if (LRL5_param.flag &&
-      !SetRSP(3, LRL5_lengths, LRL5_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRL5_param";
-    return false;
-  }
-
-  RSPParam LRL6_param;
-  LRL(-xb, yb, -phi, &LRL6_param);
-  double LRL6_lengths[3] = {-LRL6_param.v, -LRL6_param.u, -LRL6_param.t};
-  char LRL6_types[] = "LRL";
-  if (LRL6_param.flag &&
-      !SetRSP(3, LRL6_lengths, LRL6_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRL6_param";
-    return false;
-  }
-
-  RSPParam LRL7_param;
-  LRL(xb, -yb, -phi, &LRL7_param);
-  double LRL7_lengths[3] = {LRL7_param.v, LRL7_param.u, LRL7_param.t};
-  char LRL7_types[] = "RLR";
-  if (LRL7_param.flag &&
-      !SetRSP(3, LRL7_lengths, LRL7_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRL7_param";
-    return false;
-  }
-
-  RSPParam LRL8_param;
-  LRL(-xb, -yb, phi, &LRL8_param);
-  double LRL8_lengths[3] = {-LRL8_param.v, -LRL8_param.u, -LRL8_param.t};
-  char LRL8_types[] = "RLR";
-  if (LRL8_param.flag &&
-      !SetRSP(3, LRL8_lengths, LRL8_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRL8_param";
-    return false;
-  }
-  return true;
+  *xb = *x * std::cos(dphi) + *y * std::sin(dphi);
+  *yb = *x * std::sin(dphi) - *y * std::cos(dphi);
 }
 
-bool ReedShepp::CCCC(const double x, const double y, const double phi,
-                     std::vector<ReedSheppPath>* all_possible_paths) {
-  RSPParam LRLRn1_param;
-  LRLRn(x, y, phi, &LRLRn1_param);
-  double LRLRn1_lengths[4] = {LRLRn1_param.t, LRLRn1_param.u, -LRLRn1_param.u,
-                              LRLRn1_param.v};
-  char LRLRn1_types[] = "LRLR";
-  if (LRLRn1_param.flag &&
-      !SetRSP(4, LRLRn1_lengths, LRLRn1_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRLRn_param";
-    return false;
-  }
-
-  RSPParam LRLRn2_param;
-  LRLRn(-x, y, -phi, &LRLRn2_param);
-  double LRLRn2_lengths[4] = {-LRLRn2_param.t, -LRLRn2_param.u, LRLRn2_param.u,
-                              -LRLRn2_param.v};
-  char LRLRn2_types[] = "LRLR";
-  if (LRLRn2_param.flag &&
-      !SetRSP(4, LRLRn2_lengths, LRLRn2_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRLRn2_param";
-    return false;
-  }
-
-  RSPParam LRLRn3_param;
-  LRLRn(x, -y, -phi, &LRLRn3_param);
-  double LRLRn3_lengths[4] = {LRLRn3_param.t, LRLRn3_param.u, -LRLRn3_param.u,
-                              LRLRn3_param.v};
-  char LRLRn3_types[] = "RLRL";
-  if (LRLRn3_param.flag &&
-      !SetRSP(4, LRLRn3_lengths, LRLRn3_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRLRn3_param";
-    return false;
-  }
-
-  RSPParam LRLRn4_param;
-  LRLRn(-x, -y, phi, &LRLRn4_param);
-  double LRLRn4_lengths[4] = {-LRLRn4_param.t, -LRLRn4_param.u, LRLRn4_param.u,
-                              -LRLRn4_param.v};
-  char LRLRn4_types[] = "RLRL";
-  if (LRLRn4_param.flag &&
-      !SetRSP(4, LRLRn4_lengths, LRLRn4_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRLRn4_param";
-    return false;
-  }
-
-  RSPParam LRLRp1_param;
-  LRLRp(x, y, phi, &LRLRp1_param);
-  double LRLRp1_lengths[4] = {LRLRp1_param.t, LRLRp1_param.u, LRLRp1_param.u,
-                              LRLRp1_param.v};
-  char LRLRp1_types[] = "LRLR";
-  if (LRLRp1_param.flag &&
-      !SetRSP(4, LRLRp1_lengths, LRLRp1_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRLRp1_param";
-    return false;
-  }
-
-  RSPParam LRLRp2_param;
-  LRLRp(-x, y, -phi, &LRLRp2_param);
-  double LRLRp2_lengths[4] = {-LRLRp2_param.t, -LRLRp2_param.u, -LRLRp2_param.u,
-                              -LRLRp2_param.v};
-  char LRLRp2_types[] = "LRLR";
-  if (LRLRp2_param.flag &&
-      !SetRSP(4, LRLRp2_lengths, LRLRp2_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRLRp2_param";
-    return false;
-  }
-
-  RSPParam LRLRp3_param;
-  LRLRp(x, -y, -phi, &LRLRp3_param);
-  double LRLRp3_lengths[4] = {LRLRp3_param.t, LRLRp3_param.u, LRLRp3_param.u,
-                              LRLRp3_param.v};
-  char LRLRp3_types[] = "RLRL";
-  if (LRLRp3_param.flag &&
-      !SetRSP(4, LRLRp3_lengths, LRLRp3_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRLRp3_param";
-    return false;
+bool ReedShepp::GenerateRSP(const std::shared_ptr<Node3d> start_node,
+                            const std::shared_ptr<Node3d> end_node,
+                            std::vector<ReedSheppPath>* all_possible_paths) {
+  double x = 0.0;
+  double y = 0.0;
+  double dphi = 0.0;
+  double xb = 0.0;
+  double yb = 0.0;
+  NormalizeRSPPose(start_node, end_node, &x, &y, &dphi, &xb, &yb);
+
+  for (size_t word = 0; word < kRSPWordNum; ++word) {
+    if (!GenerateRSPWord(word, x, y, dphi, xb, yb, all_possible_paths)) {
+      ADEBUG << "Fail at word " << kRSPWords[word].types;
+    }
   }
-
-  RSPParam LRLRp4_param;
-  LRLRp(-x, -y, phi, &LRLRp4_param);
-  double LRLRp4_lengths[4] = {-LRLRp4_param.t, -LRLRp4_param.u, -LRLRp4_param.u,
-                              -LRLRp4_param.v};
-  char LRLRp4_types[] = "RLRL";
-  if (LRLRp4_param.flag &&
-      !SetRSP(4, LRLRp4_lengths, LRLRp4_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRLRp4_param";
+  if (all_possible_paths->empty()) {
+    ADEBUG << "No path generated by certain two configurations";
     return false;
   }
   return true;
 }
 
-bool ReedShepp::CCSC(const double x, const double y, const double phi,
-                     std::vector<ReedSheppPath>* all_possible_paths) {
-  RSPParam LRSL1_param;
-  LRLRn(x, y, phi, &LRSL1_param);
-  double LRSL1_lengths[4] = {LRSL1_param.t, -0.5 * M_PI, -LRSL1_param.u,
-                             LRSL1_param.v};
-  char LRSL1_types[] = "LRSL";
-  if (LRSL1_param.flag &&
-      !SetRSP(4, LRSL1_lengths, LRSL1_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSL1_param";
-    return false;
-  }
-
-  RSPParam LRSL2_param;
-  LRLRn(-x, y, -phi, &LRSL2_param);
-  double LRSL2_lengths[4] = {-LRSL2_param.t, 0.5 * M_PI, -LRSL2_param.u,
-                             -LRSL2_param.v};
-  char LRSL2_types[] = "LRSL";
-  if (LRSL2_param.flag &&
-      !SetRSP(4, LRSL2_lengths, LRSL2_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSL2_param";
-    return false;
-  }
-
-  RSPParam LRSL3_param;
-  LRLRn(x, -y, -phi, &LRSL3_param);
-  double LRSL3_lengths[4] = {LRSL3_param.t, -0.5 * M_PI, LRSL3_param.u,
-                             LRSL3_param.v};
-  char LRSL3_types[] = "RLSR";
-  if (LRSL3_param.flag &&
-      !SetRSP(4, LRSL3_lengths, LRSL3_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSL3_param";
-    return false;
-  }
-
-  RSPParam LRSL4_param;
-  LRLRn(-x, -y, phi, &LRSL4_param);
-  double LRSL4_lengths[4] = {-LRSL4_param.t, -0.5 * M_PI, -LRSL4_param.u,
-                             -LRSL4_param.v};
-  char LRSL4_types[] = "RLSR";
-  if (LRSL4_param.flag &&
-      !SetRSP(4, LRSL4_lengths, LRSL4_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSL4_param";
-    return false;
-  }
-
-  RSPParam LRSR1_param;
-  LRLRp(x, y, phi, &LRSR1_param);
-  double LRSR1_lengths[4] = {LRSR1_param.t, -0.5 * M_PI, LRSR1_param.u,
-                             LRSR1_param.v};
-  char LRSR1_types[] = "LRSR";
-  if (LRSR1_param.flag &&
-      !SetRSP(4, LRSR1_lengths, LRSR1_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSR1_param";
-    return false;
-  }
-
-  RSPParam LRSR2_param;
-  LRLRp(-x, y, -phi, &LRSR2_param);
-  double LRSR2_lengths[4] = {-LRSR2_param.t, 0.5 * M_PI, -LRSR2_param.u,
-                             -LRSR2_param.v};
-  char LRSR2_types[] = "LRSR";
-  if (LRSR2_param.flag &&
-      !SetRSP(4, LRSR2_lengths, LRSR2_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSR2_param";
-    return false;
-  }
-
-  RSPParam LRSR3_param;
-  LRLRp(x, -y, -phi, &LRSR3_param);
-  double LRSR3_lengths[4] = {LRSR3_param.t, -0.5 * M_PI, LRSR3_param.u,
-                             LRSR3_param.v};
-  char LRSR3_types[] = "RLSL";
-  if (LRSR3_param.flag &&
-      !SetRSP(4, LRSR3_lengths, LRSR3_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSR3_param";
-    return false;
-  }
-
-  RSPParam LRSR4_param;
-  LRLRp(-x, -y, phi, &LRSR4_param);
-  double LRSR4_lengths[4] = {-LRSR4_param.t, 0.5 * M_PI, -LRSR4_param.u,
-                             -LRSR4_param.v};
-  char LRSR4_types[] = "RLSL";
-  if (LRSR4_param.flag &&
-      !SetRSP(4, LRSR4_lengths, LRSR4_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSR4_param";
-    return false;
-  }
-
-  // backward
-  double xb = x * std::cos(phi) + y * std::sin(phi);
-  double yb = x * std::sin(phi) - y * std::cos(phi);
-
-  RSPParam LRSL5_param;
-  LRLRn(xb, yb, phi, &LRSL5_param);
-  double LRSL5_lengths[4] = {LRSL5_param.v, LRSL5_param.u, -0.5 * M_PI,
-                             LRSL5_param.t};
-  char LRSL5_types[] = "LSRL";
-  if (LRSL5_param.flag &&
-      !SetRSP(4, LRSL5_lengths, LRSL5_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRLRn_param";
-    return false;
-  }
-
-  RSPParam LRSL6_param;
-  LRLRn(-xb, yb, -phi, &LRSL6_param);
-  double LRSL6_lengths[4] = {-LRSL6_param.v, -LRSL6_param.u, 0.5 * M_PI,
-                             -LRSL6_param.t};
-  char LRSL6_types[] = "LSRL";
-  if (LRSL6_param.flag &&
-      !SetRSP(4, LRSL6_lengths, LRSL6_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSL6_param";
-    return false;
-  }
-
-  RSPParam LRSL7_param;
-  LRLRn(xb, -yb, -phi, &LRSL7_param);
-  double LRSL7_lengths[4] = {LRSL7_param.v, LRSL7_param.u, -0.5 * M_PI,
-                             LRSL7_param.t};
-  char LRSL7_types[] = "RSLR";
-  if (LRSL7_param.flag &&
-      !SetRSP(4, LRSL7_lengths, LRSL7_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSL7_param";
-    return false;
-  }
-
-  RSPParam LRSL8_param;
-  LRLRn(-xb, -yb, phi, &LRSL8_param);
-  double LRSL8_lengths[4] = {-LRSL8_param.v, -LRSL8_param.u, 0.5 * M_PI,
-                             -LRSL8_param.t};
-  char LRSL8_types[] = "RSLR";
-  if (LRSL8_param.flag &&
-      !SetRSP(4, LRSL8_lengths, LRSL8_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSL8_param";
-    return false;
-  }
-
-  RSPParam LRSR5_param;
-  LRLRp(xb, yb, phi, &LRSR5_param);
-  double LRSR5_lengths[4] = {LRSR5_param.v, LRSR5_param.u, -0.5 * M_PI,
-                             LRSR5_param.t};
-  char LRSR5_types[] = "RSRL";
-  if (LRSR5_param.flag &&
-      !SetRSP(4, LRSR5_lengths, LRSR5_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSR5_param";
-    return false;
-  }
-
-  RSPParam LRSR6_param;
-  LRLRp(-xb, yb, -phi, &LRSR6_param);
-  double LRSR6_lengths[4] = {-LRSR6_param.v, -LRSR6_param.u, 0.5 * M_PI,
-                             -LRSR6_param.t};
-  char LRSR6_types[] = "RSRL";
-  if (LRSR6_param.flag &&
-      !SetRSP(4, LRSR6_lengths, LRSR6_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSR6_param";
-    return false;
+bool ReedShepp::GenerateShortestRSP(
+    const std::shared_ptr<Node3d> start_node,
+    const std::shared_ptr<Node3d> end_node,
+    std::vector<ReedSheppPath>* all_possible_paths) {
+  double x = 0.0;
+  double y = 0.0;
+  double dphi = 0.0;
+  double xb = 0.0;
+  double yb = 0.0;
+  NormalizeRSPPose(start_node, end_node, &x, &y, &dphi, &xb, &yb);
+
+  // the first of the shortest words in the order of GenerateRSP, whose total
+  // length is summed as in SetRSP
+  size_t shortest_word = kRSPWordNum;
+  int shortest_size = 0;
+  double shortest_lengths[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+  double shortest_length = std::numeric_limits<double>::infinity();
+  for (size_t word = 0; word < kRSPWordNum; ++word) {
+    double lengths[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    const int size = RSPWordLengths(word, x, y, dphi, xb, yb, lengths);
+    double total_length = 0.0;
+    for (int i = 0; i < size; ++i) {
+      total_length += std::abs(lengths[i]);
+    }
+    if (total_length > 0.0 && total_length < shortest_length) {
+      shortest_word = word;
+      shortest_size = size;
+      std::copy(lengths, lengths + size, shortest_lengths);
+      shortest_length = total_length;
+    }
   }
-
-  RSPParam LRSR7_param;
-  LRLRp(xb, -yb, -phi, &LRSR7_param);
-  double LRSR7_lengths[4] = {LRSR7_param.v, LRSR7_param.u, -0.5 * M_PI,
-                             LRSR7_param.t};
-  char LRSR7_types[] = "LSLR";
-  if (LRSR7_param.flag &&
-      !SetRSP(4, LRSR7_lengths, LRSR7_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSR7_param";
+  if (shortest_word == kRSPWordNum) {
+    ADEBUG << "No path generated by certain two configurations";
     return false;
   }
+  return SetRSP(shortest_size, shortest_lengths, kRSPWords[shortest_word].types,
+                all_possible_paths);
+}
 
-  RSPParam LRSR8_param;
-  LRLRp(-xb, -yb, phi, &LRSR8_param);
-  double LRSR8_lengths[4] = {-LRSR8_param.v, -LRSR8_param.u, 0.5 * M_PI,
-                             -LRSR8_param.t};
-  char LRSR8_types[] = "LSLR";
-  if (LRSR8_param.flag &&
-      !SetRSP(4, LRSR8_lengths, LRSR8_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSR8_param";
+bool ReedShepp::GenerateRSPWord(
+    const size_t word, const double x, const double y, const double phi,
+    const double xb, const double yb,
+    std::vector<ReedSheppPath>* all_possible_paths) {
+  double lengths[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+  const int size = RSPWordLengths(word, x, y, phi, xb, yb, lengths);
+  if (size == 0) {
+    return true;
+  }
+  if (!SetRSP(size, lengths, kRSPWords[word].types, all_possible_paths)) {
+    ADEBUG << "Fail at SetRSP with " << kRSPWords[word].types;
     return false;
   }
   return true;
 }
 
-bool ReedShepp::CCSCC(const double x, const double y, const double phi,
-                      std::vector<ReedSheppPath>* all_possible_paths) {
-  RSPParam LRSLR1_param;
-  LRSLR(x, y, phi, &LRSLR1_param);
-  double LRSLR1_lengths[5] = {LRSLR1_param.t, -0.5 * M_PI, LRSLR1_param.u,
-                              -0.5 * M_PI, LRSLR1_param.v};
-  char LRSLR1_types[] = "LRSLR";
-  if (LRSLR1_param.flag &&
-      !SetRSP(5, LRSLR1_lengths, LRSLR1_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSLR1_param";
-    return false;
-  }
-
-  RSPParam LRSLR2_param;
-  LRSLR(-x, y, -phi, &LRSLR2_param);
-  double LRSLR2_lengths[5] = {-LRSLR2_param.t, 0.5 * M_PI, -LRSLR2_param.u,
-                              0.5 * M_PI, -LRSLR2_param.v};
-  char LRSLR2_types[] = "LRSLR";
-  if (LRSLR2_param.flag &&
-      !SetRSP(5, LRSLR2_lengths, LRSLR2_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSLR2_param";
-    return false;
-  }
-
-  RSPParam LRSLR3_param;
-  LRSLR(x, -y, -phi, &LRSLR3_param);
-  double LRSLR3_lengths[5] = {LRSLR3_param.t, -0.5 * M_PI, LRSLR3_param.u,
-                              -0.5 * M_PI, LRSLR3_param.v};
-  char LRSLR3_types[] = "RLSRL";
-  if (LRSLR3_param.flag &&
-      !SetRSP(5, LRSLR3_lengths, LRSLR3_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSLR3_param";
-    return false;
-  }
-
-  RSPParam LRSLR4_param;
-  LRSLR(-x, -y, phi, &LRSLR4_param);
-  double LRSLR4_lengths[5] = {-LRSLR4_param.t, 0.5 * M_PI, -LRSLR4_param.u,
-                              0.5 * M_PI, -LRSLR4_param.v};
-  char LRSLR4_types[] = "RLSRL";
-  if (LRSLR4_param.flag &&
-      !SetRSP(5, LRSLR4_lengths, LRSLR4_types, all_possible_paths)) {
-    ADEBUG << "Fail at SetRSP with LRSLR4_param";
-    return false;
+int ReedShepp::RSPWordLengths(const size_t word, const double x,
+                              const double y, const double phi,
+                              const double xb, const double yb,
+                              double* lengths) {
+  const RSPWord& rsp_word = kRSPWords[word];
+  const double word_x = rsp_word.x_sign * (rsp_word.backward ? xb : x);
+  const double word_y = rsp_word.y_sign * (rsp_word.backward ? yb : y);
+  const double word_phi = rsp_word.x_sign * rsp_word.y_sign * phi;
+  RSPParam param;
+  switch (rsp_word.family) {
+    case RSPFamily::SLS:
+      SLS(word_x, word_y, word_phi, &param);
+      break;
+    case RSPFamily::LSL:
+      LSL(word_x, word_y, word_phi, &param);
+      break;
+    case RSPFamily::LSR:
+      LSR(word_x, word_y, word_phi, &param);
+      break;
+    case RSPFamily::LRL:
+      LRL(word_x, word_y, word_phi, &param);
+      break;
+    case RSPFamily::LRLRn:
+      LRLRn(word_x, word_y, word_phi, &param);
+      break;
+    case RSPFamily::LRLRp:
+      LRLRp(word_x, word_y, word_phi, &param);
+      break;
+    case RSPFamily::LRSLR:
+      LRSLR(word_x, word_y, word_phi, &param);
+      break;
+  }
+  if (!param.flag) {
+    return 0;
+  }
+
+  const int size = static_cast<int>(std::strlen(rsp_word.types));
+  for (int i = 0; i < size; ++i) {
+    double length = 0.5 * M_PI;
+    if (rsp_word.segments[i] == kT) {
+      length = param.t;
+    } else if (rsp_word.segments[i] == kU) {
+      length = param.u;
+    } else if (rsp_word.segments[i] == kV) {
+      length = param.v;
+    }
+    lengths[i] = rsp_word.segment_signs[i] * length;
   }
-  return true;
+  return size;
 }
 
 void ReedShepp::LSL(const double x, const double y, const double phi,
@@ -979,12 +747,15 @@ bool ReedShepp::GenerateLocalConfigurations(
     pphi.pop_back();
     pgear.pop_back();
   }
+  const double cos_phi = std::cos(-start_node->GetPhi());
+  const double sin_phi = std::sin(-start_node->GetPhi());
+  shortest_path->x.reserve(px.size());
+  shortest_path->y.reserve(px.size());
+  shortest_path->phi.reserve(px.size());
   for (size_t i = 0; i < px.size(); ++i) {
-    shortest_path->x.push_back(std::cos(-start_node->GetPhi()) * px.at(i) +
-                               std::sin(-start_node->GetPhi()) * py.at(i) +
+    shortest_path->x.push_back(cos_phi * px.at(i) + sin_phi * py.at(i) +
                                start_node->GetX());
-    shortest_path->y.push_back(-std::sin(-start_node->GetPhi()) * px.at(i) +
-                               std::cos(-start_node->GetPhi()) * py.at(i) +
+    shortest_path->y.push_back(-sin_phi * px.at(i) + cos_phi * py.at(i) +
                                start_node->GetY());
     shortest_path->phi.push_back(
         common::math::NormalizeAngle(pphi.at(i) + start_node->GetPhi()));
@@ -78,6 +78,16 @@ class ReedShepp {
   bool GenerateRSP(const std::shared_ptr<Node3d> start_node,
                    const std::shared_ptr<Node3d> end_node,
                    std::vector<ReedSheppPath>* all_possible_paths);
+  // Set the general profile of only the shortest one of the paths of
+  // GenerateRSP, comparing the lengths of all the words before setting it
+  bool GenerateShortestRSP(const std::shared_ptr<Node3d> start_node,
+                           const std::shared_ptr<Node3d> end_node,
+                           std::vector<ReedSheppPath>* all_possible_paths);
+  // The end pose seen from the start (x, y, phi) and the start pose seen
+  // from the end (xb, yb), normalized by the turning radius
+  void NormalizeRSPPose(const std::shared_ptr<Node3d> start_node,
+                        const std::shared_ptr<Node3d> end_node, double* x,
+                        double* y, double* phi, double* xb, double* yb) const;
   // Set the general profile of the movement primitives, parallel implementation
   bool GenerateRSPPar(const std::shared_ptr<Node3d> start_node,
                       const std::shared_ptr<Node3d> end_node,
@@ -98,20 +108,16 @@ class ReedShepp {
   bool SetRSPPar(const int size, const double* lengths,
                  const std::string& types,
                  std::vector<ReedSheppPath>* all_possible_paths, const int idx);
-  // Six different combination of motion primitive in Reed Shepp path used in
-  // GenerateRSP()
-  bool SCS(const double x, const double y, const double phi,
-           std::vector<ReedSheppPath>* all_possible_paths);
-  bool CSC(const double x, const double y, const double phi,
-           std::vector<ReedSheppPath>* all_possible_paths);
-  bool CCC(const double x, const double y, const double phi,
-           std::vector<ReedSheppPath>* all_possible_paths);
-  bool CCCC(const double x, const double y, const double phi,
-            std::vector<ReedSheppPath>* all_possible_paths);
-  bool CCSC(const double x, const double y, const double phi,
-            std::vector<ReedSheppPath>* all_possible_paths);
-  bool CCSCC(const double x, const double y, const double phi,
-             std::vector<ReedSheppPath>* all_possible_paths);
+  // One of the words of the six different combination of motion primitive
+  // used in GenerateRSP(), with (xb, yb) the start seen from the end
+  bool GenerateRSPWord(const size_t word, const double x, const double y,
+                       const double phi, const double xb, const double yb,
+                       std::vector<ReedSheppPath>* all_possible_paths);
+  // The signed segment lengths of the word, returns the number of the
+  // segments or 0 if the word does not reach the pose
+  int RSPWordLengths(const size_t word, const double x, const double y,
+                     const double phi, const double xb, const double yb,
+                     double* lengths);
   // different options for different combination of motion primitives
   void LSL(const double x, const double y, const double phi, RSPParam* param);
   void LSR(const double x, const double y, const double phi, RSPParam* param);
@@ -137,5 +137,62 @@ TEST_F(reeds_shepp, test_set_5) {
   }
   check(start_node, end_node, optimal_path);
 }
+
+TEST_F(reeds_shepp, shortest_of_all_paths) {
+  // exposes all the paths ShortestRSP chooses from
+  class AllPathsReedShepp : public ReedShepp {
+   public:
+    using ReedShepp::GenerateRSP;
+    using ReedShepp::ReedShepp;
+  };
+  AllPathsReedShepp all_paths_reedshepp(vehicle_param_,
+                                        planner_open_space_config_);
+
+  const double max_kappa = std::tan(vehicle_param_.max_steer_angle() /
+                                    vehicle_param_.steer_ratio()) /
+                           vehicle_param_.wheel_base();
+  const double turning_radius = 1.0 / max_kappa;
+  std::shared_ptr<Node3d> start_node = std::shared_ptr<Node3d>(new Node3d(
+      0.0, 10.0, -10.0 * M_PI / 180.0, XYbounds_, planner_open_space_config_));
+  for (double x = -2.0; x <= 2.0; x += 0.5) {
+    for (double y = -2.0; y <= 2.0; y += 0.5) {
+      for (double phi = -170.0; phi <= 180.0; phi += 40.0) {
+        std::shared_ptr<Node3d> end_node = std::shared_ptr<Node3d>(
+            new Node3d(x * turning_radius, 10.0 + y * turning_radius,
+                       phi * M_PI / 180.0, XYbounds_,
+                       planner_open_space_config_));
+        std::vector<ReedSheppPath> all_paths;
+        if (!all_paths_reedshepp.GenerateRSP(start_node, end_node,
+                                             &all_paths)) {
+          continue;
+        }
+        const ReedSheppPath* all_paths_shortest = &all_paths.front();
+        for (const auto& path : all_paths) {
+          if (path.total_length < all_paths_shortest->total_length) {
+            all_paths_shortest = &path;
+          }
+        }
+
+        // the interpolated shortest path may miss the end pose
+        std::shared_ptr<ReedSheppPath> optimal_path =
+            std::shared_ptr<ReedSheppPath>(new ReedSheppPath());
+        if (!reedshepp_test->ShortestRSP(start_node, end_node, optimal_path)) {
+          continue;
+        }
+        check(start_node, end_node, optimal_path);
+        // the lengths of the interpolated path are scaled to meters
+        EXPECT_EQ(all_paths_shortest->total_length / max_kappa,
+                  optimal_path->total_length);
+        EXPECT_EQ(all_paths_shortest->segs_types, optimal_path->segs_types);
+        ASSERT_EQ(all_paths_shortest->segs_lengths.size(),
+                  optimal_path->segs_lengths.size());
+        for (size_t i = 0; i < optimal_path->segs_lengths.size(); ++i) {
+          EXPECT_EQ(all_paths_shortest->segs_lengths[i] / max_kappa,
+                    optimal_path->segs_lengths[i]);
+        }
+      }
+    }
+  }
+}
 }  // namespace planning
 }  // namespace apollo
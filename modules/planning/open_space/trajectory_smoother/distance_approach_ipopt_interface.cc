@@ -56,6 +56,11 @@ DistanceApproachIPOPTInterface::DistanceApproachIPOPTInterface(
   g_ = {l_ev_ / 2, w_ev_ / 2, l_ev_ / 2, w_ev_ / 2};
   offset_ = (ego_(0, 0) + ego_(2, 0)) / 2 - ego_(2, 0);
   obstacles_edges_sum_ = obstacles_edges_num_.sum();
+  int edges_counter = 0;
+  for (int j = 0; j < obstacles_num_; ++j) {
+    obstacles_edges_start_.push_back(edges_counter);
+    edges_counter += obstacles_edges_num_(j, 0);
+  }
   state_result_ = Eigen::MatrixXd::Zero(4, horizon_ + 1);
   dual_l_result_ = Eigen::MatrixXd::Zero(obstacles_edges_sum_, horizon_ + 1);
   dual_n_result_ = Eigen::MatrixXd::Zero(4 * obstacles_num_, horizon_ + 1);
@@ -103,6 +108,9 @@ DistanceApproachIPOPTInterface::DistanceApproachIPOPTInterface(
   enable_constraint_check_ =
       distance_approach_config_.enable_constraint_check();
   enable_jacobian_ad_ = distance_approach_config_.enable_jacobian_ad();
+  enable_parallel_evaluation_ =
+      distance_approach_config_.distance_approach_mode() ==
+      DISTANCE_APPROACH_IPOPT_PARALLEL;
 }
 
 bool DistanceApproachIPOPTInterface::get_nlp_info(int& n, int& m,
@@ -1118,131 +1126,14 @@ bool DistanceApproachIPOPTInterface::eval_jac_g_ser(int n, const double* x,
 
     // 4. Three obstacles related equal constraints, one equality constraints,
     // [0, horizon_] * [0, obstacles_num_-1] * 4
-
-    state_index = state_start_index_;
-    int l_index = l_start_index_;
-    int n_index = n_start_index_;
-
-    for (int i = 0; i < horizon_ + 1; ++i) {
-      int edges_counter = 0;
-      for (int j = 0; j < obstacles_num_; ++j) {
-        int current_edges_num = obstacles_edges_num_(j, 0);
-        Eigen::MatrixXd Aj =
-            obstacles_A_.block(edges_counter, 0, current_edges_num, 2);
-        Eigen::MatrixXd bj =
-            obstacles_b_.block(edges_counter, 0, current_edges_num, 1);
-
-        // TODO(QiL) : Remove redundant calculation
-        double tmp1 = 0;
-        double tmp2 = 0;
-        for (int k = 0; k < current_edges_num; ++k) {
-          // TODO(QiL) : replace this one directly with x
-          tmp1 += Aj(k, 0) * x[l_index + k];
-          tmp2 += Aj(k, 1) * x[l_index + k];
-        }
-
-        // 1. norm(A* lambda == 1)
-        for (int k = 0; k < current_edges_num; ++k) {
-          // with respect to l
-          values[nz_index] =
-              2 * tmp1 * Aj(k, 0) + 2 * tmp2 * Aj(k, 1);  // t0~tk
-          ++nz_index;
-        }
-
-        // 2. G' * mu + R' * lambda == 0, part 1
-        // With respect to x
-        values[nz_index] = -std::sin(x[state_index + 2]) * tmp1 +
-                           std::cos(x[state_index + 2]) * tmp2;  // u
-        ++nz_index;
-
-        // with respect to l
-        for (int k = 0; k < current_edges_num; ++k) {
-          values[nz_index] = std::cos(x[state_index + 2]) * Aj(k, 0) +
-                             std::sin(x[state_index + 2]) * Aj(k, 1);  // v0~vn
-          ++nz_index;
-        }
-
-        // With respect to n
-        values[nz_index] = 1.0;  // w0
-        ++nz_index;
-
-        values[nz_index] = -1.0;  // w2
-        ++nz_index;
-
-        // 3. G' * mu + R' * lambda == 0, part 2
-        // With respect to x
-        values[nz_index] = -std::cos(x[state_index + 2]) * tmp1 -
-                           std::sin(x[state_index + 2]) * tmp2;  // x
-        ++nz_index;
-
-        // with respect to l
-        for (int k = 0; k < current_edges_num; ++k) {
-          values[nz_index] = -std::sin(x[state_index + 2]) * Aj(k, 0) +
-                             std::cos(x[state_index + 2]) * Aj(k, 1);  // y0~yn
-          ++nz_index;
-        }
-
-        // With respect to n
-        values[nz_index] = 1.0;  // z1
-        ++nz_index;
-
-        values[nz_index] = -1.0;  // z3
-        ++nz_index;
-
-        //  3. -g'*mu + (A*t - b)*lambda > 0
-        double tmp3 = 0.0;
-        double tmp4 = 0.0;
-        for (int k = 0; k < 4; ++k) {
-          tmp3 += -g_[k] * x[n_index + k];
-        }
-
-        for (int k = 0; k < current_edges_num; ++k) {
-          tmp4 += bj(k, 0) * x[l_index + k];
-        }
-
-        // With respect to x
-        values[nz_index] = tmp1;  // aa1
-        ++nz_index;
-
-        values[nz_index] = tmp2;  // bb1
-        ++nz_index;
-
-        values[nz_index] =
-            -std::sin(x[state_index + 2]) * offset_ * tmp1 +
-            std::cos(x[state_index + 2]) * offset_ * tmp2;  // cc1
-        ++nz_index;
-
-        // with respect to l
-        for (int k = 0; k < current_edges_num; ++k) {
-          values[nz_index] =
-              (x[state_index] + std::cos(x[state_index + 2]) * offset_) *
-                  Aj(k, 0) +
-              (x[state_index + 1] + std::sin(x[state_index + 2]) * offset_) *
-                  Aj(k, 1) -
-              bj(k, 0);  // ddk
-          ++nz_index;
-        }
-
-        // with respect to n
-        for (int k = 0; k < 4; ++k) {
-          values[nz_index] = -g_[k];  // eek
-          ++nz_index;
-        }
-
-        // Update index
-        edges_counter += current_edges_num;
-        l_index += current_edges_num;
-        n_index += 4;
-      }
-      state_index += 4;
-    }
+    eval_obstacle_jac_g(x, nz_index, values);
+    nz_index +=
+        (horizon_ + 1) * (4 * obstacles_edges_sum_ + 13 * obstacles_num_);
 
     // 5. load variable bounds as constraints
     state_index = state_start_index_;
     control_index = control_start_index_;
     time_index = time_start_index_;
-    l_index = l_start_index_;
-    n_index = n_start_index_;
 
     // start configuration
     values[nz_index] = 1.0;
@@ -1303,6 +1194,114 @@ bool DistanceApproachIPOPTInterface::eval_jac_g_ser(int n, const double* x,
   return true;
 }  // NOLINT
 
+void DistanceApproachIPOPTInterface::eval_obstacle_jac_g(const double* x,
+                                                         int nz_index,
+                                                         double* values) {
+  const int num_blocks = (horizon_ + 1) * obstacles_num_;
+#pragma omp parallel for schedule(static) num_threads(4) if ( \
+    enable_parallel_evaluation_)
+  for (int block_index = 0; block_index < num_blocks; ++block_index) {
+    eval_obstacle_jac_g_block(x, nz_index, block_index, values);
+  }
+}
+
+void DistanceApproachIPOPTInterface::eval_obstacle_jac_g_block(
+    const double* x, int nz_index, int block_index, double* values) {
+  const int i = block_index / obstacles_num_;
+  const int j = block_index % obstacles_num_;
+  const int current_edges_num = obstacles_edges_num_(j, 0);
+  const int edges_start = obstacles_edges_start_[j];
+  const int state_index = state_start_index_ + 4 * i;
+  const int l_index = l_start_index_ + i * obstacles_edges_sum_ + edges_start;
+  // each obstacle at each step has 4 * current_edges_num + 13 nonzeros
+  nz_index += i * (4 * obstacles_edges_sum_ + 13 * obstacles_num_) +
+              4 * edges_start + 13 * j;
+
+  double tmp1 = 0;
+  double tmp2 = 0;
+  for (int k = 0; k < current_edges_num; ++k) {
+    tmp1 += obstacles_A_(edges_start + k, 0) * x[l_index + k];
+    tmp2 += obstacles_A_(edges_start + k, 1) * x[l_index + k];
+  }
+  const double sin_phi = std::sin(x[state_index + 2]);
+  const double cos_phi = std::cos(x[state_index + 2]);
+
+  // 1. norm(A* lambda == 1)
+  for (int k = 0; k < current_edges_num; ++k) {
+    // with respect to l
+    values[nz_index] = 2 * tmp1 * obstacles_A_(edges_start + k, 0) +
+                       2 * tmp2 * obstacles_A_(edges_start + k, 1);  // t0~tk
+    ++nz_index;
+  }
+
+  // 2. G' * mu + R' * lambda == 0, part 1
+  // With respect to x
+  values[nz_index] = -sin_phi * tmp1 + cos_phi * tmp2;  // u
+  ++nz_index;
+
+  // with respect to l
+  for (int k = 0; k < current_edges_num; ++k) {
+    values[nz_index] = cos_phi * obstacles_A_(edges_start + k, 0) +
+                       sin_phi * obstacles_A_(edges_start + k, 1);  // v0~vn
+    ++nz_index;
+  }
+
+  // With respect to n
+  values[nz_index] = 1.0;  // w0
+  ++nz_index;
+
+  values[nz_index] = -1.0;  // w2
+  ++nz_index;
+
+  // 3. G' * mu + R' * lambda == 0, part 2
+  // With respect to x
+  values[nz_index] = -cos_phi * tmp1 - sin_phi * tmp2;  // x
+  ++nz_index;
+
+  // with respect to l
+  for (int k = 0; k < current_edges_num; ++k) {
+    values[nz_index] = -sin_phi * obstacles_A_(edges_start + k, 0) +
+                       cos_phi * obstacles_A_(edges_start + k, 1);  // y0~yn
+    ++nz_index;
+  }
+
+  // With respect to n
+  values[nz_index] = 1.0;  // z1
+  ++nz_index;
+
+  values[nz_index] = -1.0;  // z3
+  ++nz_index;
+
+  //  3. -g'*mu + (A*t - b)*lambda > 0
+  // With respect to x
+  values[nz_index] = tmp1;  // aa1
+  ++nz_index;
+
+  values[nz_index] = tmp2;  // bb1
+  ++nz_index;
+
+  values[nz_index] =
+      -sin_phi * offset_ * tmp1 + cos_phi * offset_ * tmp2;  // cc1
+  ++nz_index;
+
+  // with respect to l
+  for (int k = 0; k < current_edges_num; ++k) {
+    values[nz_index] =
+        (x[state_index] + cos_phi * offset_) *
+            obstacles_A_(edges_start + k, 0) +
+        (x[state_index + 1] + sin_phi * offset_) *
+            obstacles_A_(edges_start + k, 1) -
+        obstacles_b_(edges_start + k, 0);  // ddk
+    ++nz_index;
+  }
+
+  // with respect to n
+  for (int k = 0; k < 4; ++k) {
+    values[nz_index] = -g_[k];  // eek
+    ++nz_index;
+  }
+}
+
 bool DistanceApproachIPOPTInterface::eval_h(int n, const double* x, bool new_x,
                                             double obj_factor, int m,
                                             const double* lambda,
@@ -1686,62 +1685,8 @@ void DistanceApproachIPOPTInterface::eval_constraints(int n, const T* x, int m,
 
   // 4. Three obstacles related equal constraints, one equality constraints,
   // [0, horizon_] * [0, obstacles_num_-1] * 4
-  state_index = state_start_index_;
-  int l_index = l_start_index_;
-  int n_index = n_start_index_;
-
-  for (int i = 0; i < horizon_ + 1; ++i) {
-    int edges_counter = 0;
-    for (int j = 0; j < obstacles_num_; ++j) {
-      int current_edges_num = obstacles_edges_num_(j, 0);
-      Eigen::MatrixXd Aj =
-          obstacles_A_.block(edges_counter, 0, current_edges_num, 2);
-      Eigen::MatrixXd bj =
-          obstacles_b_.block(edges_counter, 0, current_edges_num, 1);
-
-      // norm(A* lambda) <= 1
-      T tmp1 = 0.0;
-      T tmp2 = 0.0;
-      for (int k = 0; k < current_edges_num; ++k) {
-        // TODO(QiL) : replace this one directly with x
-        tmp1 += Aj(k, 0) * x[l_index + k];
-        tmp2 += Aj(k, 1) * x[l_index + k];
-      }
-      g[constraint_index] = tmp1 * tmp1 + tmp2 * tmp2;
-
-      // G' * mu + R' * lambda == 0
-      g[constraint_index + 1] = x[n_index] - x[n_index + 2] +
-                                cos(x[state_index + 2]) * tmp1 +
-                                sin(x[state_index + 2]) * tmp2;
-
-      g[constraint_index + 2] = x[n_index + 1] - x[n_index + 3] -
-                                sin(x[state_index + 2]) * tmp1 +
-                                cos(x[state_index + 2]) * tmp2;
-
-      //  -g'*mu + (A*t - b)*lambda > 0
-      T tmp3 = 0.0;
-      for (int k = 0; k < 4; ++k) {
-        tmp3 += -g_[k] * x[n_index + k];
-      }
-
-      T tmp4 = 0.0;
-      for (int k = 0; k < current_edges_num; ++k) {
-        tmp4 += bj(k, 0) * x[l_index + k];
-      }
-
-      g[constraint_index + 3] =
-          tmp3 + (x[state_index] + cos(x[state_index + 2]) * offset_) * tmp1 +
-          (x[state_index + 1] + sin(x[state_index + 2]) * offset_) * tmp2 -
-          tmp4;
-
-      // Update index
-      edges_counter += current_edges_num;
-      l_index += current_edges_num;
-      n_index += 4;
-      constraint_index += 4;
-    }
-    state_index += 4;
-  }
+  eval_obstacle_constraints(x, constraint_index, g);
+  constraint_index += (horizon_ + 1) * obstacles_num_ * 4;
   ADEBUG << "constraint_index after obstacles avoidance constraints "
             "updated: "
          << constraint_index;
@@ -1750,8 +1695,8 @@ void DistanceApproachIPOPTInterface::eval_constraints(int n, const T* x, int m,
   state_index = state_start_index_;
   control_index = control_start_index_;
   time_index = time_start_index_;
-  l_index = l_start_index_;
-  n_index = n_start_index_;
+  int l_index = l_start_index_;
+  int n_index = n_start_index_;
 
   // start configuration
   g[constraint_index] = x[state_index];
@@ -1804,6 +1749,71 @@ void DistanceApproachIPOPTInterface::eval_constraints(int n, const T* x, int m,
   }
 }
 
+template <class T>
+void DistanceApproachIPOPTInterface::eval_obstacle_constraints(
+    const T* x, int constraint_index, T* g) {
+  const int num_blocks = (horizon_ + 1) * obstacles_num_;
+  for (int block_index = 0; block_index < num_blocks; ++block_index) {
+    eval_obstacle_constraint_block(x, constraint_index, block_index, g);
+  }
+}
+
+void DistanceApproachIPOPTInterface::eval_obstacle_constraints(
+    const double* x, int constraint_index, double* g) {
+  const int num_blocks = (horizon_ + 1) * obstacles_num_;
+#pragma omp parallel for schedule(static) num_threads(4) if ( \
+    enable_parallel_evaluation_)
+  for (int block_index = 0; block_index < num_blocks; ++block_index) {
+    eval_obstacle_constraint_block(x, constraint_index, block_index, g);
+  }
+}
+
+template <class T>
+void DistanceApproachIPOPTInterface::eval_obstacle_constraint_block(
+    const T* x, int constraint_index, int block_index, T* g) {
+  const int i = block_index / obstacles_num_;
+  const int j = block_index % obstacles_num_;
+  const int current_edges_num = obstacles_edges_num_(j, 0);
+  const int edges_start = obstacles_edges_start_[j];
+  const int state_index = state_start_index_ + 4 * i;
+  const int l_index = l_start_index_ + i * obstacles_edges_sum_ + edges_start;
+  const int n_index = n_start_index_ + 4 * block_index;
+  constraint_index += 4 * block_index;
+
+  // norm(A* lambda) <= 1
+  T tmp1 = 0.0;
+  T tmp2 = 0.0;
+  for (int k = 0; k < current_edges_num; ++k) {
+    tmp1 += obstacles_A_(edges_start + k, 0) * x[l_index + k];
+    tmp2 += obstacles_A_(edges_start + k, 1) * x[l_index + k];
+  }
+  g[constraint_index] = tmp1 * tmp1 + tmp2 * tmp2;
+
+  // G' * mu + R' * lambda == 0
+  g[constraint_index + 1] = x[n_index] - x[n_index + 2] +
+                            cos(x[state_index + 2]) * tmp1 +
+                            sin(x[state_index + 2]) * tmp2;
+
+  g[constraint_index + 2] = x[n_index + 1] - x[n_index + 3] -
+                            sin(x[state_index + 2]) * tmp1 +
+                            cos(x[state_index + 2]) * tmp2;
+
+  //  -g'*mu + (A*t - b)*lambda > 0
+  T tmp3 = 0.0;
+  for (int k = 0; k < 4; ++k) {
+    tmp3 += -g_[k] * x[n_index + k];
+  }
+
+  T tmp4 = 0.0;
+  for (int k = 0; k < current_edges_num; ++k) {
+    tmp4 += obstacles_b_(edges_start + k, 0) * x[l_index + k];
+  }
+
+  g[constraint_index + 3] =
+      tmp3 + (x[state_index] + cos(x[state_index + 2]) * offset_) * tmp1 +
+      (x[state_index + 1] + sin(x[state_index + 2]) * offset_) * tmp2 - tmp4;
+}
+
 bool DistanceApproachIPOPTInterface::check_g(int n, const double* x, int m,
                                              const double* g) {
   int kN = n;
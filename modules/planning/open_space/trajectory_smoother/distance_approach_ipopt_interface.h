@@ -104,6 +104,15 @@ class DistanceApproachIPOPTInterface : public DistanceApproachInterface {
   bool eval_jac_g_ser(int n, const double* x, bool new_x, int m, int nele_jac,
                       int* iRow, int* jCol, double* values) override;
 
+  // the jacobian values of the obstacle constraints from nz_index, in parallel
+  // if enabled
+  void eval_obstacle_jac_g(const double* x, int nz_index, double* values);
+
+  // the jacobian values of the obstacle constraints of an obstacle at a
+  // horizon step
+  void eval_obstacle_jac_g_block(const double* x, int nz_index,
+                                 int block_index, double* values);
+
   /** Method to return:
    *   1) The structure of the hessian of the lagrangian (if "values" is
    * nullptr) 2) The values of the hessian of the lagrangian (if "values" is not
@@ -137,6 +146,20 @@ class DistanceApproachIPOPTInterface : public DistanceApproachInterface {
   template <class T>
   void eval_constraints(int n, const T* x, int m, T* g);
 
+  /** Template to compute the obstacle constraints from constraint_index */
+  template <class T>
+  void eval_obstacle_constraints(const T* x, int constraint_index, T* g);
+
+  /** Method to compute the obstacle constraints, in parallel if enabled */
+  void eval_obstacle_constraints(const double* x, int constraint_index,
+                                 double* g);
+
+  /** Template to compute the four obstacle constraints of an obstacle at a
+   * horizon step, with block_index = step * obstacles_num + obstacle */
+  template <class T>
+  void eval_obstacle_constraint_block(const T* x, int constraint_index,
+                                      int block_index, T* g);
+
   /** Method to generate the required tapes by ADOL-C*/
   void generate_tapes(int n, int m, int* nnz_jac_g, int* nnz_h_lag);
   //***************    end   ADOL-C part ***********************************
@@ -240,6 +263,13 @@ class DistanceApproachIPOPTInterface : public DistanceApproachInterface {
 
   bool enable_jacobian_ad_ = false;
 
+  // evaluate the obstacle constraints and their jacobian in parallel, by
+  // DISTANCE_APPROACH_IPOPT_PARALLEL
+  bool enable_parallel_evaluation_ = false;
+
+  // the first row of each obstacle in obstacles_A_ and obstacles_b_
+  std::vector<int> obstacles_edges_start_;
+
  private:
   DistanceApproachConfig distance_approach_config_;
   const common::VehicleParam vehicle_param_ =
@@ -19,6 +19,10 @@
  **/
 #include "modules/planning/open_space/trajectory_smoother/distance_approach_ipopt_interface.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "cyber/common/file.h"
 #include "gtest/gtest.h"
 
@@ -121,5 +125,48 @@ TEST_F(DistanceApproachIPOPTInterfaceTest, eval_f) {
   EXPECT_TRUE(res);
 }
 
+TEST_F(DistanceApproachIPOPTInterfaceTest, parallel_evaluation) {
+  planner_open_space_config_.mutable_distance_approach_config()
+      ->set_enable_jacobian_ad(false);
+  ProblemSetup();
+  std::unique_ptr<DistanceApproachIPOPTInterface> serial_ptop =
+      std::move(ptop_);
+  planner_open_space_config_.mutable_distance_approach_config()
+      ->set_distance_approach_mode(DISTANCE_APPROACH_IPOPT_PARALLEL);
+  ProblemSetup();
+
+  int n = 0;
+  int m = 0;
+  int nnz_jac_g = 0;
+  int nnz_h_lag = 0;
+  Ipopt::TNLP::IndexStyleEnum index_style;
+  ASSERT_TRUE(
+      serial_ptop->get_nlp_info(n, m, nnz_jac_g, nnz_h_lag, index_style));
+  ASSERT_TRUE(ptop_->get_nlp_info(n, m, nnz_jac_g, nnz_h_lag, index_style));
+
+  std::vector<double> x(n);
+  for (int i = 0; i < n; ++i) {
+    x[i] = 0.1 * (i % 17) - 0.5;
+  }
+
+  std::vector<double> g(m);
+  std::vector<double> parallel_g(m);
+  EXPECT_TRUE(serial_ptop->eval_g(n, x.data(), true, m, g.data()));
+  EXPECT_TRUE(ptop_->eval_g(n, x.data(), true, m, parallel_g.data()));
+  for (int i = 0; i < m; ++i) {
+    EXPECT_DOUBLE_EQ(g[i], parallel_g[i]) << "constraint " << i;
+  }
+
+  std::vector<double> values(nnz_jac_g);
+  std::vector<double> parallel_values(nnz_jac_g);
+  EXPECT_TRUE(serial_ptop->eval_jac_g_ser(n, x.data(), true, m, nnz_jac_g,
+                                          nullptr, nullptr, values.data()));
+  EXPECT_TRUE(ptop_->eval_jac_g_ser(n, x.data(), true, m, nnz_jac_g, nullptr,
+                                    nullptr, parallel_values.data()));
+  for (int i = 0; i < nnz_jac_g; ++i) {
+    EXPECT_DOUBLE_EQ(values[i], parallel_values[i]) << "nonzero " << i;
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -51,7 +51,9 @@ bool DistanceApproachProblem::Solve(
   DistanceApproachInterface* ptop = nullptr;
 
   if (planner_open_space_config_.distance_approach_config()
-          .distance_approach_mode() == DISTANCE_APPROACH_IPOPT) {
+              .distance_approach_mode() == DISTANCE_APPROACH_IPOPT ||
+      planner_open_space_config_.distance_approach_config()
+              .distance_approach_mode() == DISTANCE_APPROACH_IPOPT_PARALLEL) {
     ptop = new DistanceApproachIPOPTInterface(
         horizon, ts, ego, xWS, uWS, l_warm_up, n_warm_up, x0, xF, last_time_u,
         XYbounds, obstacles_edges_num, obstacles_num, obstacles_A, obstacles_b,
@@ -36,6 +36,7 @@ namespace planning {
 
 using apollo::common::PathPoint;
 using apollo::common::TrajectoryPoint;
+using apollo::common::math::AABoxKDTreeParams;
 using apollo::common::math::Box2d;
 using apollo::common::math::LineSegment2d;
 using apollo::common::math::NormalizeAngle;
@@ -80,6 +81,7 @@ bool IterativeAnchoringSmoother::Smooth(
     obstacles_linesegments_vec.emplace_back(obstacle_linesegments);
   }
   obstacles_linesegments_vec_ = std::move(obstacles_linesegments_vec);
+  BuildObstacleSegmentKDTree();
 
   // Interpolate the traj
   DiscretizedPath warm_start_path;
@@ -297,26 +299,8 @@ bool IterativeAnchoringSmoother::ReAnchoring(
       // Get ego box for collision check on collision point index
       bool is_colliding = false;
       for (size_t j = index - 1; j < index + 2; ++j) {
-        const double heading =
-            gear_ ? path_points->at(j).theta()
-                  : NormalizeAngle(path_points->at(j).theta() + M_PI);
-        Box2d ego_box({path_points->at(j).x() +
-                           center_shift_distance_ * std::cos(heading),
-                       path_points->at(j).y() +
-                           center_shift_distance_ * std::sin(heading)},
-                      heading, ego_length_, ego_width_);
-        for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
-          for (const LineSegment2d& linesegment : obstacle_linesegments) {
-            if (ego_box.HasOverlap(linesegment)) {
-              is_colliding = true;
-              break;
-            }
-          }
-          if (is_colliding) {
-            break;
-          }
-        }
-        if (is_colliding) {
+        if (IsEgoBoxColliding(GetEgoBox(path_points->at(j)), nullptr)) {
+          is_colliding = true;
           break;
         }
       }
@@ -402,15 +386,13 @@ bool IterativeAnchoringSmoother::GenerateInitialBounds(
     return true;
   }
 
-  // TODO(Jinyun): refine obstacle formulation and speed it up
+  // TODO(Jinyun): refine obstacle formulation
   for (const auto& path_point : path_points) {
     double min_bound = std::numeric_limits<double>::infinity();
-    for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
-      for (const LineSegment2d& linesegment : obstacle_linesegments) {
-        min_bound =
-            std::min(min_bound,
-                     linesegment.DistanceTo({path_point.x(), path_point.y()}));
-      }
+    if (obstacle_segments_kdtree_ != nullptr) {
+      const Vec2d point(path_point.x(), path_point.y());
+      min_bound =
+          obstacle_segments_kdtree_->GetNearestObject(point)->DistanceTo(point);
     }
     min_bound -= vehicle_shortest_dimension;
     min_bound = min_bound < kEpislon ? 0.0 : min_bound;
@@ -439,6 +421,8 @@ bool IterativeAnchoringSmoother::SmoothPath(
   bool is_collision_free = false;
   std::vector<size_t> colliding_point_index;
   std::vector<std::pair<double, double>> smoothed_point2d;
+  DiscretizedPath previous_path_points;
+  std::vector<double> clearances;
   size_t counter = 0;
 
   while (!is_collision_free) {
@@ -447,6 +431,8 @@ bool IterativeAnchoringSmoother::SmoothPath(
       return true;
     }
 
+    const auto smooth_start_timestamp = std::chrono::system_clock::now();
+
     AdjustPathBounds(colliding_point_index, &flexible_bounds);
 
     std::vector<double> opt_x;
@@ -474,10 +460,22 @@ bool IterativeAnchoringSmoother::SmoothPath(
       return false;
     }
 
-    is_collision_free =
-        CheckCollisionAvoidance(*smoothed_path_points, &colliding_point_index);
+    const auto check_start_timestamp = std::chrono::system_clock::now();
 
-    ADEBUG << "loop iteration number is " << counter;
+    is_collision_free =
+        CheckCollisionAvoidance(*smoothed_path_points, previous_path_points,
+                                &clearances, &colliding_point_index);
+    previous_path_points = *smoothed_path_points;
+
+    const auto check_end_timestamp = std::chrono::system_clock::now();
+    std::chrono::duration<double> smooth_diff =
+        check_start_timestamp - smooth_start_timestamp;
+    std::chrono::duration<double> check_diff =
+        check_end_timestamp - check_start_timestamp;
+    ADEBUG << "loop iteration number is " << counter
+           << ", smoothing time: " << smooth_diff.count() * 1000.0
+           << " ms, collision check time: " << check_diff.count() * 1000.0
+           << " ms.";
     ++counter;
   }
   return true;
@@ -486,10 +484,29 @@ bool IterativeAnchoringSmoother::SmoothPath(
 bool IterativeAnchoringSmoother::CheckCollisionAvoidance(
     const DiscretizedPath& path_points,
     std::vector<size_t>* colliding_point_index) {
+  std::vector<double> clearances;
+  return CheckCollisionAvoidance(path_points, DiscretizedPath(), &clearances,
+                                 colliding_point_index);
+}
+
+bool IterativeAnchoringSmoother::CheckCollisionAvoidance(
+    const DiscretizedPath& path_points,
+    const DiscretizedPath& previous_path_points,
+    std::vector<double>* clearances,
+    std::vector<size_t>* colliding_point_index) {
+  CHECK_NOTNULL(clearances);
   CHECK_NOTNULL(colliding_point_index);
 
   colliding_point_index->clear();
   size_t path_points_size = path_points.size();
+  if (previous_path_points.size() != path_points_size ||
+      clearances->size() != path_points_size) {
+    clearances->assign(path_points_size, 0.0);
+  }
+  // the farthest point of the ego box from the path point
+  const double ego_box_radius = std::abs(center_shift_distance_) +
+                                0.5 * std::hypot(ego_length_, ego_width_);
+  size_t checked_points_num = 0;
   for (size_t i = 0; i < path_points_size; ++i) {
     // Skip checking collision for thoese points colliding originally
     bool skip_checking = false;
@@ -503,30 +520,31 @@ bool IterativeAnchoringSmoother::CheckCollisionAvoidance(
       continue;
     }
 
-    const double heading = gear_
-                               ? path_points[i].theta()
-                               : NormalizeAngle(path_points[i].theta() + M_PI);
-    Box2d ego_box(
-        {path_points[i].x() + center_shift_distance_ * std::cos(heading),
-         path_points[i].y() + center_shift_distance_ * std::sin(heading)},
-        heading, ego_length_, ego_width_);
-
-    bool is_colliding = false;
-    for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
-      for (const LineSegment2d& linesegment : obstacle_linesegments) {
-        if (ego_box.HasOverlap(linesegment)) {
-          colliding_point_index->push_back(i);
-          ADEBUG << "point at " << i << "collied with LineSegment "
-                 << linesegment.DebugString();
-          is_colliding = true;
-          break;
-        }
-      }
-      if (is_colliding) {
-        break;
+    // No point of the ego box moves farther than moved_distance, so the box
+    // stays collision free within the clearance
+    double& clearance = (*clearances)[i];
+    if (clearance > 0.0) {
+      const auto& previous_point = previous_path_points[i];
+      const double moved_distance =
+          std::hypot(path_points[i].x() - previous_point.x(),
+                     path_points[i].y() - previous_point.y()) +
+          std::abs(NormalizeAngle(path_points[i].theta() -
+                                  previous_point.theta())) *
+              ego_box_radius;
+      if (moved_distance + common::math::kMathEpsilon < clearance) {
+        clearance -= moved_distance;
+        continue;
       }
     }
+
+    ++checked_points_num;
+    if (IsEgoBoxColliding(GetEgoBox(path_points[i]), &clearance)) {
+      colliding_point_index->push_back(i);
+      ADEBUG << "point at " << i << " collided";
+    }
   }
+  ADEBUG << "collision checked points: " << checked_points_num << " of "
+         << path_points_size;
 
   if (!colliding_point_index->empty()) {
     return false;
@@ -534,6 +552,63 @@ bool IterativeAnchoringSmoother::CheckCollisionAvoidance(
   return true;
 }
 
+void IterativeAnchoringSmoother::BuildObstacleSegmentKDTree() {
+  obstacle_segments_kdtree_.reset();
+  obstacle_segment_boxes_.clear();
+  for (const auto& obstacle_linesegments : obstacles_linesegments_vec_) {
+    for (const LineSegment2d& linesegment : obstacle_linesegments) {
+      obstacle_segment_boxes_.emplace_back(linesegment);
+    }
+  }
+  if (obstacle_segment_boxes_.empty()) {
+    return;
+  }
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;  // meters.
+  params.max_leaf_size = 16;
+  obstacle_segments_kdtree_.reset(
+      new ObstacleSegmentKDTree(obstacle_segment_boxes_, params));
+}
+
+bool IterativeAnchoringSmoother::IsEgoBoxColliding(const Box2d& ego_box,
+                                                   double* clearance) const {
+  if (clearance != nullptr) {
+    *clearance = kMaxClearance;
+  }
+  if (obstacle_segments_kdtree_ == nullptr) {
+    return false;
+  }
+  // the edges overlapping the box or within kMaxClearance of it are all
+  // within this distance of its center
+  const double search_distance = 0.5 * ego_box.diagonal() + kMaxClearance;
+  for (const auto* segment_box :
+       obstacle_segments_kdtree_->GetObjects(ego_box.center(),
+                                             search_distance)) {
+    const LineSegment2d& linesegment = segment_box->segment();
+    if (ego_box.HasOverlap(linesegment)) {
+      ADEBUG << "ego box collided with LineSegment "
+             << linesegment.DebugString();
+      if (clearance != nullptr) {
+        *clearance = 0.0;
+      }
+      return true;
+    }
+    if (clearance != nullptr) {
+      *clearance = std::min(*clearance, ego_box.DistanceTo(linesegment));
+    }
+  }
+  return false;
+}
+
+Box2d IterativeAnchoringSmoother::GetEgoBox(const PathPoint& path_point) const {
+  const double heading = gear_ ? path_point.theta()
+                               : NormalizeAngle(path_point.theta() + M_PI);
+  return Box2d(
+      {path_point.x() + center_shift_distance_ * std::cos(heading),
+       path_point.y() + center_shift_distance_ * std::sin(heading)},
+      heading, ego_length_, ego_width_);
+}
+
 void IterativeAnchoringSmoother::AdjustPathBounds(
     const std::vector<size_t>& colliding_point_index,
     std::vector<double>* bounds) {
@@ -20,10 +20,14 @@
 
 #pragma once
 
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "Eigen/Eigen"
+#include "gtest/gtest_prod.h"
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
 #include "modules/common/math/box2d.h"
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/vec2d.h"
@@ -58,6 +62,7 @@ class IterativeAnchoringSmoother {
 
   bool GenerateInitialBounds(const DiscretizedPath& path_points,
                              std::vector<double>* initial_bounds);
+  FRIEND_TEST(IterativeAnchoringSmootherTest, generate_initial_bounds);
 
   bool SmoothPath(const DiscretizedPath& raw_path_points,
                   const std::vector<double>& bounds,
@@ -66,6 +71,23 @@ class IterativeAnchoringSmoother {
   bool CheckCollisionAvoidance(const DiscretizedPath& path_points,
                                std::vector<size_t>* colliding_point_index);
 
+  // Only checks the points moved since previous_path_points by more than
+  // their clearances to the obstacles, which are updated by the check
+  bool CheckCollisionAvoidance(const DiscretizedPath& path_points,
+                               const DiscretizedPath& previous_path_points,
+                               std::vector<double>* clearances,
+                               std::vector<size_t>* colliding_point_index);
+  FRIEND_TEST(IterativeAnchoringSmootherTest, incremental_collision_check);
+
+  void BuildObstacleSegmentKDTree();
+
+  // @brief: whether the ego box overlaps an obstacle edge. If not, clearance
+  // is its distance to the obstacles, up to kMaxClearance
+  bool IsEgoBoxColliding(const common::math::Box2d& ego_box,
+                         double* clearance) const;
+
+  common::math::Box2d GetEgoBox(const common::PathPoint& path_point) const;
+
   void AdjustPathBounds(const std::vector<size_t>& colliding_point_index,
                         std::vector<double>* bounds);
 
@@ -94,6 +116,31 @@ class IterativeAnchoringSmoother {
   double CalcHeadings(const DiscretizedPath& path_points, const size_t index);
 
  private:
+  // an obstacle edge indexed by the kd-tree
+  class ObstacleSegmentBox {
+   public:
+    explicit ObstacleSegmentBox(const common::math::LineSegment2d& segment)
+        : segment_(segment), aabox_(segment.start(), segment.end()) {}
+    const common::math::AABox2d& aabox() const { return aabox_; }
+    double DistanceTo(const common::math::Vec2d& point) const {
+      return segment_.DistanceTo(point);
+    }
+    double DistanceSquareTo(const common::math::Vec2d& point) const {
+      return segment_.DistanceSquareTo(point);
+    }
+    const common::math::LineSegment2d& segment() const { return segment_; }
+
+   private:
+    common::math::LineSegment2d segment_;
+    common::math::AABox2d aabox_;
+  };
+  using ObstacleSegmentKDTree =
+      common::math::AABoxKDTree2d<ObstacleSegmentBox>;
+
+  // the largest clearance to the obstacles kept for a path point across the
+  // smoothing iterations
+  static constexpr double kMaxClearance = 0.5;
+
   // vehicle_param
   double ego_length_ = 0.0;
   double ego_width_ = 0.0;
@@ -102,6 +149,9 @@ class IterativeAnchoringSmoother {
   std::vector<std::vector<common::math::LineSegment2d>>
       obstacles_linesegments_vec_;
 
+  std::vector<ObstacleSegmentBox> obstacle_segment_boxes_;
+  std::unique_ptr<ObstacleSegmentKDTree> obstacle_segments_kdtree_;
+
   std::vector<size_t> input_colliding_point_index_;
 
   bool enforce_initial_kappa_ = true;
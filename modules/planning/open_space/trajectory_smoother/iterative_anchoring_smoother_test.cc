@@ -0,0 +1,214 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/open_space/trajectory_smoother/iterative_anchoring_smoother.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/common/configs/vehicle_config_helper.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::PathPoint;
+using apollo::common::math::Box2d;
+using apollo::common::math::LineSegment2d;
+using apollo::common::math::Vec2d;
+
+namespace {
+
+// whether the box overlaps any of the segments, and the distance to the
+// nearest one, by checking all of them
+bool IsCollidingWithAnySegment(
+    const std::vector<std::vector<LineSegment2d>>& obstacles_linesegments_vec,
+    const Box2d& box, double* min_distance) {
+  bool colliding = false;
+  *min_distance = std::numeric_limits<double>::infinity();
+  for (const auto& obstacle_linesegments : obstacles_linesegments_vec) {
+    for (const auto& linesegment : obstacle_linesegments) {
+      colliding = colliding || box.HasOverlap(linesegment);
+      *min_distance = std::min(*min_distance, box.DistanceTo(linesegment));
+    }
+  }
+  return colliding;
+}
+
+}  // namespace
+
+class IterativeAnchoringSmootherTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    common::VehicleConfig vehicle_config;
+    auto* vehicle_param = vehicle_config.mutable_vehicle_param();
+    vehicle_param->set_length(4.933);
+    vehicle_param->set_width(2.11);
+    vehicle_param->set_back_edge_to_center(1.043);
+    common::VehicleConfigHelper::Init(vehicle_config);
+
+    PlannerOpenSpaceConfig config;
+    auto* smoother_config =
+        config.mutable_iterative_anchoring_smoother_config();
+    smoother_config->set_estimate_bound(true);
+    smoother_config->set_vehicle_shortest_dimension(1.04);
+    smoother_.reset(new IterativeAnchoringSmoother(config));
+  }
+
+  // a parking lot crowded with small obstacles of random size and heading
+  std::vector<std::vector<LineSegment2d>> MakeCrowdedObstacles() {
+    std::uniform_real_distribution<double> x_dist(0.0, 40.0);
+    std::uniform_real_distribution<double> y_dist(-8.0, 8.0);
+    std::uniform_real_distribution<double> size_dist(0.2, 1.5);
+    std::uniform_real_distribution<double> heading_dist(-M_PI, M_PI);
+    std::vector<std::vector<LineSegment2d>> obstacles_linesegments_vec;
+    for (int i = 0; i < 80; ++i) {
+      const Box2d box({x_dist(random_engine_), y_dist(random_engine_)},
+                      heading_dist(random_engine_), size_dist(random_engine_),
+                      size_dist(random_engine_));
+      const auto corners = box.GetAllCorners();
+      std::vector<LineSegment2d> obstacle_linesegments;
+      for (size_t j = 0; j < corners.size(); ++j) {
+        obstacle_linesegments.emplace_back(corners[j],
+                                           corners[(j + 1) % corners.size()]);
+      }
+      obstacles_linesegments_vec.push_back(std::move(obstacle_linesegments));
+    }
+    return obstacles_linesegments_vec;
+  }
+
+ protected:
+  std::unique_ptr<IterativeAnchoringSmoother> smoother_;
+  std::mt19937 random_engine_{20200101};
+};
+
+TEST_F(IterativeAnchoringSmootherTest, incremental_collision_check) {
+  const auto obstacles_linesegments_vec = MakeCrowdedObstacles();
+  smoother_->obstacles_linesegments_vec_ = obstacles_linesegments_vec;
+  smoother_->BuildObstacleSegmentKDTree();
+  smoother_->gear_ = true;
+
+  DiscretizedPath path_points;
+  for (int i = 0; i < 200; ++i) {
+    PathPoint path_point;
+    path_point.set_x(static_cast<double>(i) * 0.2);
+    path_point.set_y(0.0);
+    path_point.set_theta(0.0);
+    path_points.push_back(path_point);
+  }
+
+  // some points stay, the others move about as much as in a smoothing
+  // iteration
+  std::bernoulli_distribution move_dist(0.5);
+  std::uniform_real_distribution<double> shift_dist(-0.2, 0.2);
+  std::uniform_real_distribution<double> rotation_dist(-0.05, 0.05);
+  DiscretizedPath previous_path_points;
+  std::vector<double> clearances;
+  size_t num_colliding = 0;
+  size_t num_clear = 0;
+  for (int iteration = 0; iteration < 20; ++iteration) {
+    if (iteration > 0) {
+      for (auto& path_point : path_points) {
+        if (move_dist(random_engine_)) {
+          path_point.set_x(path_point.x() + shift_dist(random_engine_));
+          path_point.set_y(path_point.y() + shift_dist(random_engine_));
+          path_point.set_theta(path_point.theta() +
+                               rotation_dist(random_engine_));
+        }
+      }
+    }
+
+    std::vector<size_t> expected_colliding_point_index;
+    for (size_t i = 0; i < path_points.size(); ++i) {
+      const Box2d ego_box = smoother_->GetEgoBox(path_points[i]);
+      double min_distance = 0.0;
+      const bool expected_colliding = IsCollidingWithAnySegment(
+          obstacles_linesegments_vec, ego_box, &min_distance);
+      if (expected_colliding) {
+        expected_colliding_point_index.push_back(i);
+      }
+
+      double clearance = 0.0;
+      EXPECT_EQ(expected_colliding,
+                smoother_->IsEgoBoxColliding(ego_box, &clearance));
+      if (expected_colliding) {
+        EXPECT_DOUBLE_EQ(0.0, clearance);
+      } else {
+        const double max_clearance = IterativeAnchoringSmoother::kMaxClearance;
+        EXPECT_NEAR(std::min(min_distance, max_clearance), clearance, 1e-9);
+      }
+    }
+    num_colliding += expected_colliding_point_index.size();
+    num_clear += path_points.size() - expected_colliding_point_index.size();
+
+    std::vector<size_t> colliding_point_index;
+    EXPECT_EQ(expected_colliding_point_index.empty(),
+              smoother_->CheckCollisionAvoidance(
+                  path_points, previous_path_points, &clearances,
+                  &colliding_point_index));
+    EXPECT_EQ(expected_colliding_point_index, colliding_point_index);
+    previous_path_points = path_points;
+
+    std::vector<size_t> full_colliding_point_index;
+    smoother_->CheckCollisionAvoidance(path_points,
+                                       &full_colliding_point_index);
+    EXPECT_EQ(expected_colliding_point_index, full_colliding_point_index);
+  }
+  // the obstacles are crowded, but not everywhere
+  EXPECT_GT(num_colliding, 0);
+  EXPECT_GT(num_clear, 0);
+}
+
+TEST_F(IterativeAnchoringSmootherTest, generate_initial_bounds) {
+  const auto obstacles_linesegments_vec = MakeCrowdedObstacles();
+  smoother_->obstacles_linesegments_vec_ = obstacles_linesegments_vec;
+  smoother_->BuildObstacleSegmentKDTree();
+
+  std::uniform_real_distribution<double> x_dist(-5.0, 45.0);
+  std::uniform_real_distribution<double> y_dist(-10.0, 10.0);
+  DiscretizedPath path_points;
+  for (int i = 0; i < 500; ++i) {
+    PathPoint path_point;
+    path_point.set_x(x_dist(random_engine_));
+    path_point.set_y(y_dist(random_engine_));
+    path_points.push_back(path_point);
+  }
+
+  std::vector<double> bounds;
+  EXPECT_TRUE(smoother_->GenerateInitialBounds(path_points, &bounds));
+  ASSERT_EQ(path_points.size(), bounds.size());
+  for (size_t i = 0; i < path_points.size(); ++i) {
+    const Vec2d point(path_points[i].x(), path_points[i].y());
+    double min_distance = std::numeric_limits<double>::infinity();
+    for (const auto& obstacle_linesegments : obstacles_linesegments_vec) {
+      for (const auto& linesegment : obstacle_linesegments) {
+        min_distance = std::min(min_distance, linesegment.DistanceTo(point));
+      }
+    }
+    const double expected_bound = min_distance - 1.04;
+    EXPECT_NEAR(expected_bound < 1e-8 ? 0.0 : expected_bound, bounds[i], 1e-9);
+  }
+}
+
+}  // namespace planning
+}  // namespace apollo
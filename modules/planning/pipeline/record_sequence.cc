@@ -0,0 +1,182 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/pipeline/record_sequence.h"
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "modules/planning/proto/learning_data.pb.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// the name of the sequence of a record file
+std::string SequenceName(const std::string& record_file) {
+  static const std::string kRecordSuffix = ".record.";
+  const size_t file_name_begin = record_file.find_last_of('/') + 1;
+  const size_t suffix_begin = record_file.rfind(kRecordSuffix);
+  if (suffix_begin == std::string::npos || suffix_begin < file_name_begin) {
+    return record_file;
+  }
+  const std::string index =
+      record_file.substr(suffix_begin + kRecordSuffix.size());
+  if (index.empty() ||
+      !std::all_of(index.begin(), index.end(),
+                   [](const char c) { return c >= '0' && c <= '9'; })) {
+    return record_file;
+  }
+  return record_file.substr(0, suffix_begin);
+}
+
+// the index of a learning data file <record file>.<index>.bin, or -1
+int LearningDataFileIndex(const std::string& file_name,
+                          std::string* record_file_name) {
+  static const std::string kBinSuffix = ".bin";
+  if (file_name.size() <= kBinSuffix.size() ||
+      file_name.compare(file_name.size() - kBinSuffix.size(),
+                        kBinSuffix.size(), kBinSuffix) != 0) {
+    return -1;
+  }
+  const std::string stem =
+      file_name.substr(0, file_name.size() - kBinSuffix.size());
+  const size_t index_dot = stem.find_last_of('.');
+  if (index_dot == std::string::npos || index_dot + 1 == stem.size()) {
+    return -1;
+  }
+  const std::string index = stem.substr(index_dot + 1);
+  if (!std::all_of(index.begin(), index.end(),
+                   [](const char c) { return c >= '0' && c <= '9'; })) {
+    return -1;
+  }
+  *record_file_name = stem.substr(0, index_dot);
+  return std::stoi(index);
+}
+
+}  // namespace
+
+std::vector<RecordSequence> GroupRecordSequences(
+    const std::vector<std::string>& record_files) {
+  std::map<std::string, std::vector<std::string>> sequence_records;
+  for (const auto& record_file : record_files) {
+    sequence_records[SequenceName(record_file)].push_back(record_file);
+  }
+
+  std::vector<RecordSequence> sequences;
+  for (auto& sequence_record : sequence_records) {
+    RecordSequence sequence;
+    sequence.name = sequence_record.first;
+    sequence.record_files = std::move(sequence_record.second);
+    // the indices are zero padded
+    std::sort(sequence.record_files.begin(), sequence.record_files.end());
+    sequences.push_back(std::move(sequence));
+  }
+  return sequences;
+}
+
+std::vector<std::vector<size_t>> AssignRecordSequences(
+    const std::vector<double>& sequence_costs, const int num_workers) {
+  const size_t workers_size = std::min(
+      sequence_costs.size(), static_cast<size_t>(std::max(num_workers, 1)));
+  std::vector<std::vector<size_t>> assignments(workers_size);
+  if (workers_size == 0) {
+    return assignments;
+  }
+
+  std::vector<size_t> sequence_indices(sequence_costs.size());
+  std::iota(sequence_indices.begin(), sequence_indices.end(), 0);
+  std::stable_sort(sequence_indices.begin(), sequence_indices.end(),
+                   [&sequence_costs](const size_t lhs, const size_t rhs) {
+                     return sequence_costs[lhs] > sequence_costs[rhs];
+                   });
+
+  std::vector<double> worker_costs(workers_size, 0.0);
+  for (const size_t sequence_index : sequence_indices) {
+    const size_t worker_index = static_cast<size_t>(
+        std::min_element(worker_costs.begin(), worker_costs.end()) -
+        worker_costs.begin());
+    assignments[worker_index].push_back(sequence_index);
+    worker_costs[worker_index] += sequence_costs[sequence_index];
+  }
+  for (auto& assignment : assignments) {
+    std::sort(assignment.begin(), assignment.end());
+  }
+  return assignments;
+}
+
+int MergeSequenceLearningData(const std::string& sequence_dir,
+                              const int frame_num_offset,
+                              const std::string& output_dir, int* file_index) {
+  struct SequenceFile {
+    int index = 0;
+    std::string file_name;
+    std::string record_file_name;
+  };
+  std::vector<SequenceFile> sequence_files;
+  for (const auto& file_name :
+       cyber::common::ListSubPaths(sequence_dir, DT_REG)) {
+    SequenceFile sequence_file;
+    sequence_file.index =
+        LearningDataFileIndex(file_name, &sequence_file.record_file_name);
+    if (sequence_file.index >= 0) {
+      sequence_file.file_name = file_name;
+      sequence_files.push_back(std::move(sequence_file));
+    }
+  }
+  // in the order they were written
+  std::sort(sequence_files.begin(), sequence_files.end(),
+            [](const SequenceFile& lhs, const SequenceFile& rhs) {
+              return lhs.index < rhs.index;
+            });
+
+  for (const auto& sequence_file : sequence_files) {
+    const std::string source_file =
+        sequence_dir + "/" + sequence_file.file_name;
+    LearningData learning_data;
+    if (!cyber::common::GetProtoFromBinaryFile(source_file, &learning_data)) {
+      AERROR << "Fail to read " << source_file;
+      return -1;
+    }
+    for (auto& learning_data_frame :
+         *learning_data.mutable_learning_data_frame()) {
+      learning_data_frame.set_frame_num(learning_data_frame.frame_num() +
+                                        frame_num_offset);
+    }
+    const std::string dest_file =
+        absl::StrCat(output_dir, "/", sequence_file.record_file_name, ".",
+                     (*file_index)++, ".bin");
+    if (!cyber::common::SetProtoToBinaryFile(learning_data, dest_file)) {
+      AERROR << "Fail to write " << dest_file;
+      return -1;
+    }
+    cyber::common::DeleteFile(source_file);
+  }
+  return static_cast<int>(sequence_files.size());
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Split the offline records into the sequences recorded in one run,
+ * assign the sequences to the workers generating the learning data, and merge
+ * the learning data the workers generated.
+ **/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @brief The record files split from one recording, e.g.
+ * 20200101120000.record.00000, 20200101120000.record.00001, ... The messages
+ * of a frame may come from the previous records of its sequence, e.g. the
+ * routing response or the localization history, so a sequence is processed
+ * in order by one MessageProcess.
+ */
+struct RecordSequence {
+  // the path of the record files without the ".record.<index>" suffix
+  std::string name;
+  // sorted by their index
+  std::vector<std::string> record_files;
+};
+
+/**
+ * @brief Group the record files into their sequences, sorted by name. A file
+ * not named as a split record is a sequence on its own.
+ */
+std::vector<RecordSequence> GroupRecordSequences(
+    const std::vector<std::string>& record_files);
+
+/**
+ * @brief Assign the sequences to the workers, balancing the total cost, e.g.
+ * the size of the records, of each worker. The most costly sequences are
+ * assigned first, each to the least loaded worker.
+ * @return The indices of the sequences of each worker, in order. There are no
+ * more workers than sequences.
+ */
+std::vector<std::vector<size_t>> AssignRecordSequences(
+    const std::vector<double>& sequence_costs, const int num_workers);
+
+/**
+ * @brief Move the learning data files <record file>.<index>.bin generated from
+ * a sequence into sequence_dir to output_dir, as if the sequences were
+ * processed in order by one MessageProcess: the file indices continue from
+ * file_index, so records of the same name in different sequences do not
+ * overwrite each other, and the frame numbers are shifted by
+ * frame_num_offset, the number of frames of the previous sequences.
+ * @return The number of files moved, or -1 on failure.
+ */
+int MergeSequenceLearningData(const std::string& sequence_dir,
+                              const int frame_num_offset,
+                              const std::string& output_dir, int* file_index);
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/pipeline/record_sequence.h"
+
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+#include "cyber/common/file.h"
+#include "modules/planning/proto/learning_data.pb.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(RecordSequenceTest, group_record_sequences) {
+  const std::vector<std::string> record_files = {
+      "/data/b/20200101120000.record.00001",
+      "/data/a/20200101120000.record.00001",
+      "/data/a/20200101120000.record.00000",
+      "/data/a/20200101130000.record.00000",
+      "/data/b/20200101120000.record.00000",
+      "/data/a.record.00000/demo.record",
+      "/data/a/demo.record.tmp",
+  };
+  const auto sequences = GroupRecordSequences(record_files);
+  ASSERT_EQ(5, sequences.size());
+
+  EXPECT_EQ("/data/a.record.00000/demo.record", sequences[0].name);
+  ASSERT_EQ(1, sequences[0].record_files.size());
+
+  EXPECT_EQ("/data/a/20200101120000", sequences[1].name);
+  ASSERT_EQ(2, sequences[1].record_files.size());
+  EXPECT_EQ("/data/a/20200101120000.record.00000",
+            sequences[1].record_files[0]);
+  EXPECT_EQ("/data/a/20200101120000.record.00001",
+            sequences[1].record_files[1]);
+
+  EXPECT_EQ("/data/a/20200101130000", sequences[2].name);
+  ASSERT_EQ(1, sequences[2].record_files.size());
+
+  EXPECT_EQ("/data/a/demo.record.tmp", sequences[3].name);
+  ASSERT_EQ(1, sequences[3].record_files.size());
+
+  EXPECT_EQ("/data/b/20200101120000", sequences[4].name);
+  ASSERT_EQ(2, sequences[4].record_files.size());
+  EXPECT_EQ("/data/b/20200101120000.record.00000",
+            sequences[4].record_files[0]);
+}
+
+TEST(RecordSequenceTest, assign_record_sequences) {
+  const std::vector<double> sequence_costs = {1.0, 5.0, 2.0, 4.0, 3.0, 3.0};
+  const auto assignments = AssignRecordSequences(sequence_costs, 3);
+  ASSERT_EQ(3, assignments.size());
+  // 5 + 1, 4 + 2, 3 + 3
+  EXPECT_EQ(std::vector<size_t>({0, 1}), assignments[0]);
+  EXPECT_EQ(std::vector<size_t>({2, 3}), assignments[1]);
+  EXPECT_EQ(std::vector<size_t>({4, 5}), assignments[2]);
+
+  // no more workers than sequences
+  EXPECT_EQ(2, AssignRecordSequences({1.0, 2.0}, 8).size());
+  EXPECT_EQ(1, AssignRecordSequences({1.0, 2.0}, 0).size());
+  EXPECT_TRUE(AssignRecordSequences({}, 4).empty());
+}
+
+namespace {
+
+void WriteLearningData(const std::string& file,
+                       const std::vector<uint32_t>& frame_nums) {
+  LearningData learning_data;
+  for (const uint32_t frame_num : frame_nums) {
+    learning_data.add_learning_data_frame()->set_frame_num(frame_num);
+  }
+  ASSERT_TRUE(cyber::common::SetProtoToBinaryFile(learning_data, file));
+}
+
+std::vector<uint32_t> ReadFrameNums(const std::string& file) {
+  LearningData learning_data;
+  std::vector<uint32_t> frame_nums;
+  if (cyber::common::GetProtoFromBinaryFile(file, &learning_data)) {
+    for (const auto& learning_data_frame :
+         learning_data.learning_data_frame()) {
+      frame_nums.push_back(learning_data_frame.frame_num());
+    }
+  }
+  return frame_nums;
+}
+
+}  // namespace
+
+TEST(RecordSequenceTest, merge_sequences_of_same_record_name) {
+  const std::string test_dir =
+      "/tmp/record_sequence_test_" + std::to_string(getpid());
+  const std::string output_dir = test_dir + "/output";
+  const std::string sequence_dir_0 = test_dir + "/sequence_0";
+  const std::string sequence_dir_1 = test_dir + "/sequence_1";
+  ASSERT_TRUE(cyber::common::EnsureDirectory(output_dir));
+  ASSERT_TRUE(cyber::common::EnsureDirectory(sequence_dir_0));
+  ASSERT_TRUE(cyber::common::EnsureDirectory(sequence_dir_1));
+
+  // e.g. /data/a/demo.record and /data/b/demo.record, each numbered from 0
+  for (int i = 0; i <= 10; ++i) {
+    WriteLearningData(
+        sequence_dir_0 + "/demo.record." + std::to_string(i) + ".bin",
+        {static_cast<uint32_t>(i)});
+  }
+  WriteLearningData(sequence_dir_1 + "/demo.record.0.bin", {0, 1});
+  WriteLearningData(sequence_dir_1 + "/demo.record.1.bin", {2});
+
+  int file_index = 0;
+  EXPECT_EQ(11, MergeSequenceLearningData(sequence_dir_0, 0, output_dir,
+                                          &file_index));
+  EXPECT_EQ(11, file_index);
+  EXPECT_EQ(2, MergeSequenceLearningData(sequence_dir_1, 11, output_dir,
+                                         &file_index));
+  EXPECT_EQ(13, file_index);
+
+  // numbered as one sequence, none overwritten
+  for (int i = 0; i <= 10; ++i) {
+    EXPECT_EQ(std::vector<uint32_t>({static_cast<uint32_t>(i)}),
+              ReadFrameNums(output_dir + "/demo.record." + std::to_string(i) +
+                            ".bin"));
+  }
+  EXPECT_EQ(std::vector<uint32_t>({11, 12}),
+            ReadFrameNums(output_dir + "/demo.record.11.bin"));
+  EXPECT_EQ(std::vector<uint32_t>({13}),
+            ReadFrameNums(output_dir + "/demo.record.12.bin"));
+  EXPECT_TRUE(cyber::common::ListSubPaths(sequence_dir_0, DT_REG).empty());
+  EXPECT_TRUE(cyber::common::ListSubPaths(sequence_dir_1, DT_REG).empty());
+
+  cyber::common::DeleteFile(test_dir);
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -14,6 +14,16 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <boost/filesystem.hpp>
 
 #include "absl/strings/str_split.h"
@@ -23,12 +33,243 @@
 #include "modules/planning/common/message_process.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/util/util.h"
+#include "modules/planning/pipeline/record_sequence.h"
 #include "modules/planning/proto/planning_config.pb.h"
 #include "modules/prediction/util/data_extraction.h"
 
 namespace apollo {
 namespace planning {
 
+namespace {
+
+// what a worker generated, for the throughput report and the merge of the
+// learning data
+struct WorkerResult {
+  int num_sequences = 0;
+  int num_records = 0;
+  int num_learning_data_frames = 0;
+  double time_sec = 0.0;
+  // the number of frames of each sequence of the worker, in order
+  std::vector<int> sequence_frame_nums;
+};
+
+// generate the learning data of the sequences, each with its own
+// MessageProcess, into the directory sequence_dir_prefix + the sequence index
+WorkerResult ProcessRecordSequences(
+    const PlanningConfig& planning_config,
+    const std::vector<RecordSequence>& sequences,
+    const std::vector<size_t>& sequence_indices,
+    const std::string& sequence_dir_prefix) {
+  const auto start_time = std::chrono::system_clock::now();
+  const std::string data_dir = FLAGS_planning_data_dir;
+  WorkerResult result;
+  for (const size_t sequence_index : sequence_indices) {
+    const auto& sequence = sequences[sequence_index];
+    result.sequence_frame_nums.push_back(0);
+    FLAGS_planning_data_dir =
+        sequence_dir_prefix + std::to_string(sequence_index);
+    MessageProcess message_process;
+    if (!cyber::common::EnsureDirectory(FLAGS_planning_data_dir) ||
+        !message_process.Init(planning_config)) {
+      AERROR << "Fail to process sequence " << sequence.name;
+      continue;
+    }
+    for (const auto& record_file : sequence.record_files) {
+      AINFO << "\tProcessing: " << record_file;
+      message_process.ProcessOfflineData(record_file);
+      FeatureOutput::WriteRemainderiLearningData(record_file);
+      ++result.num_records;
+    }
+    result.sequence_frame_nums.back() =
+        message_process.total_learning_data_frame_num();
+    result.num_learning_data_frames += result.sequence_frame_nums.back();
+    ++result.num_sequences;
+    message_process.Close();
+  }
+  FLAGS_planning_data_dir = data_dir;
+  const std::chrono::duration<double> time_diff =
+      std::chrono::system_clock::now() - start_time;
+  result.time_sec = time_diff.count();
+  return result;
+}
+
+// fork a worker process generating the learning data of the sequences, which
+// writes its result to result_file
+pid_t SpawnWorker(const PlanningConfig& planning_config,
+                  const std::vector<RecordSequence>& sequences,
+                  const std::vector<size_t>& sequence_indices,
+                  const std::string& sequence_dir_prefix,
+                  const std::string& result_file) {
+  const pid_t pid = fork();
+  if (pid != 0) {
+    return pid;
+  }
+  const WorkerResult result = ProcessRecordSequences(
+      planning_config, sequences, sequence_indices, sequence_dir_prefix);
+  {
+    std::ofstream fout(result_file);
+    fout << result.num_sequences << " " << result.num_records << " "
+         << result.num_learning_data_frames << " " << result.time_sec;
+    for (const int sequence_frame_num : result.sequence_frame_nums) {
+      fout << " " << sequence_frame_num;
+    }
+    fout << std::endl;
+  }
+  google::FlushLogFiles(google::INFO);
+  _exit(0);
+}
+
+bool ReadWorkerResult(const std::string& result_file,
+                      const size_t num_worker_sequences,
+                      WorkerResult* result) {
+  std::ifstream fin(result_file);
+  if (!(fin >> result->num_sequences >> result->num_records >>
+        result->num_learning_data_frames >> result->time_sec)) {
+    return false;
+  }
+  result->sequence_frame_nums.resize(num_worker_sequences, 0);
+  for (auto& sequence_frame_num : result->sequence_frame_nums) {
+    if (!(fin >> sequence_frame_num)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// merge the learning data of the sequences into FLAGS_planning_data_dir in
+// the order of the sequences, numbering the files and the frames as the
+// sequential generation does
+void MergeLearningData(const std::string& sequence_dir_prefix,
+                       const std::vector<int>& sequence_frame_nums) {
+  const std::string log_file = FLAGS_planning_data_dir + "/learning_data.log";
+  int file_index = 0;
+  int frame_num_offset = 0;
+  for (size_t i = 0; i < sequence_frame_nums.size(); ++i) {
+    const std::string sequence_dir = sequence_dir_prefix + std::to_string(i);
+    if (!cyber::common::DirectoryExists(sequence_dir)) {
+      continue;
+    }
+    if (MergeSequenceLearningData(sequence_dir, frame_num_offset,
+                                  FLAGS_planning_data_dir, &file_index) < 0) {
+      AERROR << "Fail to merge the learning data of " << sequence_dir;
+      continue;
+    }
+    frame_num_offset += sequence_frame_nums[i];
+
+    const std::string sequence_log_file = sequence_dir + "/learning_data.log";
+    if (cyber::common::PathExists(sequence_log_file)) {
+      std::ifstream fin(sequence_log_file);
+      std::ofstream fout(log_file, std::ios_base::out | std::ios_base::app);
+      fout << fin.rdbuf();
+    }
+    cyber::common::DeleteFile(sequence_dir);
+  }
+}
+
+// The records are split into their sequences, which are assigned to
+// FLAGS_planning_offline_num_workers worker processes. Each worker has its
+// own MessageProcess, FeatureOutput and map, and writes the learning data of
+// each sequence into a directory of its own, merged when all the workers are
+// done.
+void GenerateLearningDataInParallel(const PlanningConfig& planning_config,
+                                    const std::vector<std::string>& inputs) {
+  // the sequences in the order of the inputs, as processed sequentially
+  std::vector<std::string> offline_bags;
+  std::vector<RecordSequence> sequences;
+  for (const auto& input : inputs) {
+    std::vector<std::string> input_bags;
+    util::GetFilesByPath(boost::filesystem::path(input), &input_bags);
+    for (auto& sequence : GroupRecordSequences(input_bags)) {
+      sequences.push_back(std::move(sequence));
+    }
+    offline_bags.insert(offline_bags.end(), input_bags.begin(),
+                        input_bags.end());
+  }
+
+  double total_size_mb = 0.0;
+  std::vector<double> sequence_sizes;
+  for (const auto& sequence : sequences) {
+    double sequence_size = 0.0;
+    for (const auto& record_file : sequence.record_files) {
+      boost::system::error_code error_code;
+      const auto file_size = boost::filesystem::file_size(
+          boost::filesystem::path(record_file), error_code);
+      if (!error_code) {
+        sequence_size += static_cast<double>(file_size);
+      }
+    }
+    sequence_sizes.push_back(sequence_size);
+    total_size_mb += sequence_size / (1024.0 * 1024.0);
+  }
+  const auto assignments =
+      AssignRecordSequences(sequence_sizes, FLAGS_planning_offline_num_workers);
+  AINFO << "Found " << offline_bags.size() << " rosbags of "
+        << sequences.size() << " sequences to process with "
+        << assignments.size() << " workers";
+
+  const auto start_time = std::chrono::system_clock::now();
+  const std::string result_file_prefix =
+      "/tmp/record_to_learning_data_" + std::to_string(getpid()) + "_worker_";
+  // merged into FLAGS_planning_data_dir when all the workers are done
+  const std::string sequence_dir_prefix = FLAGS_planning_data_dir +
+                                          "/record_to_learning_data_" +
+                                          std::to_string(getpid()) +
+                                          "_sequence_";
+  std::vector<pid_t> pids;
+  for (size_t i = 0; i < assignments.size(); ++i) {
+    pids.push_back(SpawnWorker(planning_config, sequences, assignments[i],
+                               sequence_dir_prefix,
+                               result_file_prefix + std::to_string(i)));
+  }
+
+  WorkerResult total_result;
+  std::vector<int> sequence_frame_nums(sequences.size(), 0);
+  double total_worker_time_sec = 0.0;
+  for (size_t i = 0; i < pids.size(); ++i) {
+    WorkerResult result;
+    if (pids[i] < 0) {
+      AERROR << "Fail to fork worker " << i << ", process its sequences here";
+      result = ProcessRecordSequences(planning_config, sequences,
+                                      assignments[i], sequence_dir_prefix);
+    } else {
+      int status = 0;
+      waitpid(pids[i], &status, 0);
+      const std::string result_file = result_file_prefix + std::to_string(i);
+      if (!ReadWorkerResult(result_file, assignments[i].size(), &result)) {
+        AERROR << "Worker " << i << " reported nothing, status: " << status;
+      }
+      unlink(result_file.c_str());
+    }
+    AINFO << "Worker " << i << ": " << result.num_sequences << " sequences, "
+          << result.num_records << " records, "
+          << result.num_learning_data_frames << " learning_data_frames in "
+          << result.time_sec << " sec";
+    total_result.num_sequences += result.num_sequences;
+    total_result.num_records += result.num_records;
+    total_result.num_learning_data_frames += result.num_learning_data_frames;
+    total_worker_time_sec += result.time_sec;
+    for (size_t j = 0; j < result.sequence_frame_nums.size(); ++j) {
+      sequence_frame_nums[assignments[i][j]] = result.sequence_frame_nums[j];
+    }
+  }
+  MergeLearningData(sequence_dir_prefix, sequence_frame_nums);
+
+  const std::chrono::duration<double> time_diff =
+      std::chrono::system_clock::now() - start_time;
+  const double time_sec = std::max(time_diff.count(), 1e-6);
+  const double num_workers =
+      static_cast<double>(std::max<size_t>(pids.size(), 1));
+  AINFO << "Generated " << total_result.num_learning_data_frames
+        << " learning_data_frames from " << total_result.num_records
+        << " records (" << total_size_mb << " MB) in " << time_sec
+        << " sec: " << total_result.num_learning_data_frames / time_sec
+        << " frames/sec, " << total_size_mb / time_sec << " MB/sec, "
+        << "worker utilization "
+        << 100.0 * total_worker_time_sec / (time_sec * num_workers) << "%";
+}
+
+}  // namespace
+
 void GenerateLearningData() {
   AINFO << "map_dir: " << FLAGS_map_dir;
   if (FLAGS_planning_offline_bags.empty()) {
@@ -47,13 +288,17 @@ void GenerateLearningData() {
       cyber::common::GetProtoFromFile(planning_config_file, &planning_config))
       << "failed to load planning config file " << planning_config_file;
 
+  const std::vector<std::string> inputs =
+      absl::StrSplit(FLAGS_planning_offline_bags, ':');
+  if (FLAGS_planning_offline_num_workers > 1) {
+    GenerateLearningDataInParallel(planning_config, inputs);
+    return;
+  }
+
   MessageProcess message_process;
   if (!message_process.Init(planning_config)) {
     return;
   }
-
-  const std::vector<std::string> inputs =
-      absl::StrSplit(FLAGS_planning_offline_bags, ':');
   for (const auto& input : inputs) {
     std::vector<std::string> offline_bags;
     util::GetFilesByPath(boost::filesystem::path(input), &offline_bags);
@@ -20,6 +20,7 @@
 
 #include "modules/planning/planner/lattice/lattice_planner.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -31,6 +32,7 @@
 #include "modules/common/math/cartesian_frenet_conversion.h"
 #include "modules/common/math/path_matcher.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/constraint_checker/collision_checker.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
 #include "modules/planning/lattice/behavior/path_time_graph.h"
@@ -40,6 +42,7 @@
 #include "modules/planning/lattice/trajectory_generation/trajectory1d_generator.h"
 #include "modules/planning/lattice/trajectory_generation/trajectory_combiner.h"
 #include "modules/planning/lattice/trajectory_generation/trajectory_evaluator.h"
+#include "modules/planning/lattice/trajectory_generation/trajectory_pair_selector.h"
 
 namespace apollo {
 namespace planning {
@@ -54,6 +57,28 @@ using apollo::cyber::Clock;
 
 namespace {
 
+void CheckTrajectoryPair(const std::vector<PathPoint>& reference_line,
+                         const double init_relative_time,
+                         const CollisionChecker& collision_checker,
+                         CheckedTrajectoryPair* checked_pair) {
+  // combine two 1d trajectories to one 2d trajectory
+  checked_pair->combined_trajectory = TrajectoryCombiner::Combine(
+      reference_line, *checked_pair->trajectory_pair.first,
+      *checked_pair->trajectory_pair.second, init_relative_time);
+
+  // check longitudinal and lateral acceleration
+  // considering trajectory curvatures
+  checked_pair->result =
+      ConstraintChecker::ValidTrajectory(checked_pair->combined_trajectory);
+  if (checked_pair->result != ConstraintChecker::Result::VALID) {
+    return;
+  }
+
+  // check collision with other obstacles
+  checked_pair->in_collision =
+      collision_checker.InCollision(checked_pair->combined_trajectory);
+}
+
 std::vector<PathPoint> ToDiscretizedReferenceLine(
     const std::vector<ReferencePoint>& ref_points) {
   double s = 0.0;
@@ -201,16 +226,20 @@ Status LatticePlanner::PlanOnReferenceLine(
   // dynamic constraints.
   //   second, evaluate the feasible longitudinal and lateral trajectory pairs
   //   and sort them according to the cost.
-  TrajectoryEvaluator trajectory_evaluator(
-      init_s, planning_target, lon_trajectory1d_bundle, lat_trajectory1d_bundle,
-      ptr_path_time_graph, ptr_reference_line);
+  std::unique_ptr<TrajectoryEvaluator> trajectory_evaluator;
+  {
+    PLANNING_PROFILE_SPAN("EvaluateTrajectoryPairs");
+    trajectory_evaluator = std::make_unique<TrajectoryEvaluator>(
+        init_s, planning_target, lon_trajectory1d_bundle,
+        lat_trajectory1d_bundle, ptr_path_time_graph, ptr_reference_line);
+  }
 
   ADEBUG << "Trajectory_Evaluator_Construction_Time = "
          << (Clock::NowInSeconds() - current_time) * 1000;
   current_time = Clock::NowInSeconds();
 
   ADEBUG << "number of trajectory pairs = "
-         << trajectory_evaluator.num_of_trajectory_pairs()
+         << trajectory_evaluator->num_of_trajectory_pairs()
          << "  number_lon_traj = " << lon_trajectory1d_bundle.size()
          << "  number_lat_traj = " << lat_trajectory1d_bundle.size();
 
@@ -222,66 +251,30 @@ Status LatticePlanner::PlanOnReferenceLine(
   // 7. always get the best pair of trajectories to combine; return the first
   // collision-free trajectory.
   size_t constraint_failure_count = 0;
-  size_t collision_failure_count = 0;
-  size_t combined_constraint_failure_count = 0;
-
-  size_t lon_vel_failure_count = 0;
-  size_t lon_acc_failure_count = 0;
-  size_t lon_jerk_failure_count = 0;
-  size_t curvature_failure_count = 0;
-  size_t lat_acc_failure_count = 0;
-  size_t lat_jerk_failure_count = 0;
-
   size_t num_lattice_traj = 0;
 
-  while (trajectory_evaluator.has_more_trajectory_pairs()) {
-    double trajectory_pair_cost =
-        trajectory_evaluator.top_trajectory_pair_cost();
-    auto trajectory_pair = trajectory_evaluator.next_top_trajectory_pair();
-
-    // combine two 1d trajectories to one 2d trajectory
-    auto combined_trajectory = TrajectoryCombiner::Combine(
-        *ptr_reference_line, *trajectory_pair.first, *trajectory_pair.second,
-        planning_init_point.relative_time());
-
-    // check longitudinal and lateral acceleration
-    // considering trajectory curvatures
-    auto result = ConstraintChecker::ValidTrajectory(combined_trajectory);
-    if (result != ConstraintChecker::Result::VALID) {
-      ++combined_constraint_failure_count;
-
-      switch (result) {
-        case ConstraintChecker::Result::LON_VELOCITY_OUT_OF_BOUND:
-          lon_vel_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::LON_ACCELERATION_OUT_OF_BOUND:
-          lon_acc_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::LON_JERK_OUT_OF_BOUND:
-          lon_jerk_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::CURVATURE_OUT_OF_BOUND:
-          curvature_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::LAT_ACCELERATION_OUT_OF_BOUND:
-          lat_acc_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::LAT_JERK_OUT_OF_BOUND:
-          lat_jerk_failure_count += 1;
-          break;
-        case ConstraintChecker::Result::VALID:
-        default:
-          // Intentional empty
-          break;
-      }
-      continue;
-    }
-
-    // check collision with other obstacles
-    if (collision_checker.InCollision(combined_trajectory)) {
-      ++collision_failure_count;
-      continue;
-    }
+  // the pairs after the first valid one are checked for nothing, but
+  // concurrently with it
+  const size_t num_checked_pairs =
+      FLAGS_enable_parallel_lattice_evaluation
+          ? static_cast<size_t>(
+                std::max(1, FLAGS_lattice_num_speculative_candidates))
+          : 1;
+  const double init_relative_time = planning_init_point.relative_time();
+  // the collision checker is only read by the checks
+  TrajectoryPairSelector trajectory_pair_selector(
+      num_checked_pairs,
+      [&ptr_reference_line, init_relative_time,
+       &collision_checker](CheckedTrajectoryPair* checked_pair) {
+        CheckTrajectoryPair(*ptr_reference_line, init_relative_time,
+                            collision_checker, checked_pair);
+      });
+  CheckedTrajectoryPair checked_pair;
+  if (trajectory_pair_selector.Select(trajectory_evaluator.get(),
+                                      &checked_pair)) {
+    double trajectory_pair_cost = checked_pair.cost;
+    const auto& trajectory_pair = checked_pair.trajectory_pair;
+    const auto& combined_trajectory = checked_pair.combined_trajectory;
 
     // put combine trajectory into debug data
     const auto& combined_trajectory_points = combined_trajectory;
@@ -322,7 +315,6 @@ Status LatticePlanner::PlanOnReferenceLine(
       ADEBUG << combined_trajectory_points[i].ShortDebugString();
     }
 
-    break;
     /*
     auto combined_trajectory_path =
         ptr_debug->mutable_planning_data()->add_trajectory_path();
@@ -342,9 +334,10 @@ Status LatticePlanner::PlanOnReferenceLine(
   ADEBUG << "1d trajectory not valid for constraint ["
          << constraint_failure_count << "] times";
   ADEBUG << "Combined trajectory not valid for ["
-         << combined_constraint_failure_count << "] times";
-  ADEBUG << "Trajectory not valid for collision [" << collision_failure_count
+         << trajectory_pair_selector.combined_constraint_failure_count()
          << "] times";
+  ADEBUG << "Trajectory not valid for collision ["
+         << trajectory_pair_selector.collision_failure_count() << "] times";
   ADEBUG << "Total_Lattice_Planning_Frame_Time = "
          << (Clock::NowInSeconds() - start_time) * 1000;
 
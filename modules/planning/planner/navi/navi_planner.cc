@@ -288,32 +288,29 @@ std::vector<SpeedPoint> NaviPlanner::GenerateInitSpeedProfile(
     AWARN << "last frame is empty";
     return speed_profile;
   }
-  const ReferenceLineInfo* last_reference_line_info =
-      last_frame->DriveReferenceLineInfo();
-  if (!last_reference_line_info) {
+  if (!last_frame->has_drive_reference_line()) {
     ADEBUG << "last reference line info is empty";
     return speed_profile;
   }
-  if (!reference_line_info->IsStartFrom(*last_reference_line_info)) {
+  const auto& last_reference_line = last_frame->drive_reference_line();
+  if (!reference_line_info->IsStartFrom(last_reference_line)) {
     ADEBUG << "Current reference line is not started previous drived line";
     return speed_profile;
   }
-  const auto& last_speed_data = last_reference_line_info->speed_data();
+  const auto& last_speed_data = last_frame->drive_speed_data();
 
   if (!last_speed_data.empty()) {
     const auto& last_init_point = last_frame->PlanningStartPoint().path_point();
     Vec2d last_xy_point(last_init_point.x(), last_init_point.y());
     SLPoint last_sl_point;
-    if (!last_reference_line_info->reference_line().XYToSL(last_xy_point,
-                                                           &last_sl_point)) {
+    if (!last_reference_line.XYToSL(last_xy_point, &last_sl_point)) {
       AERROR << "Fail to transfer xy to sl when init speed profile";
     }
 
     Vec2d xy_point(planning_init_point.path_point().x(),
                    planning_init_point.path_point().y());
     SLPoint sl_point;
-    if (!last_reference_line_info->reference_line().XYToSL(xy_point,
-                                                           &sl_point)) {
+    if (!last_reference_line.XYToSL(xy_point, &sl_point)) {
       AERROR << "Fail to transfer xy to sl when init speed profile";
     }
 
@@ -24,6 +24,7 @@
 #include "modules/map/pnc_map/pnc_map.h"
 #include "modules/planning/common/history.h"
 #include "modules/planning/common/planning_context.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/navi_planning.h"
 #include "modules/planning/on_lane_planning.h"
 
@@ -112,6 +113,11 @@ bool PlanningComponent::Init() {
   planning_learning_data_writer_ = node_->CreateWriter<PlanningLearningData>(
       config_.topic_config().planning_learning_data_topic());
 
+  if (FLAGS_enable_planning_profiler) {
+    planning_profile_writer_ = node_->CreateWriter<PlanningProfile>(
+        config_.topic_config().planning_profile_topic());
+  }
+
   return true;
 }
 
@@ -186,7 +192,11 @@ bool PlanningComponent::Proc(
   }
 
   ADCTrajectory adc_trajectory_pb;
+  auto* profiler = PlanningProfiler::Instance();
+  profiler->BeginCycle(++num_planning_cycles_);
   planning_base_->RunOnce(local_view_, &adc_trajectory_pb);
+  profiler->EndCycle();
+  PublishPlanningProfile();
   common::util::FillHeader(node_->Name(), &adc_trajectory_pb);
 
   // modify trajectory relative time due to the timestamp change in header
@@ -204,6 +214,22 @@ bool PlanningComponent::Proc(
   return true;
 }
 
+void PlanningComponent::PublishPlanningProfile() {
+  if (!FLAGS_enable_planning_profiler ||
+      FLAGS_planning_profiler_report_interval <= 0 ||
+      num_planning_cycles_ % FLAGS_planning_profiler_report_interval != 0) {
+    return;
+  }
+  auto* profiler = PlanningProfiler::Instance();
+  PlanningProfile planning_profile;
+  profiler->GetProfile(&planning_profile);
+  common::util::FillHeader(node_->Name(), &planning_profile);
+  planning_profile_writer_->Write(planning_profile);
+  if (!FLAGS_planning_profiler_trace_file.empty()) {
+    profiler->DumpSlowestCycles(FLAGS_planning_profiler_trace_file);
+  }
+}
+
 void PlanningComponent::CheckRerouting() {
   auto* rerouting = injector_->planning_context()
                         ->mutable_planning_status()
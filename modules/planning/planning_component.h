@@ -31,6 +31,7 @@
 #include "modules/planning/proto/pad_msg.pb.h"
 #include "modules/planning/proto/planning.pb.h"
 #include "modules/planning/proto/planning_config.pb.h"
+#include "modules/planning/proto/planning_stats.pb.h"
 #include "modules/prediction/proto/prediction_obstacle.pb.h"
 #include "modules/routing/proto/routing.pb.h"
 #include "modules/storytelling/proto/story.pb.h"
@@ -59,6 +60,8 @@ class PlanningComponent final
   void CheckRerouting();
   bool CheckInput();
 
+  void PublishPlanningProfile();
+
  private:
   std::shared_ptr<cyber::Reader<perception::TrafficLightDetection>>
       traffic_light_reader_;
@@ -71,6 +74,7 @@ class PlanningComponent final
   std::shared_ptr<cyber::Writer<routing::RoutingRequest>> rerouting_writer_;
   std::shared_ptr<cyber::Writer<PlanningLearningData>>
       planning_learning_data_writer_;
+  std::shared_ptr<cyber::Writer<PlanningProfile>> planning_profile_writer_;
 
   std::mutex mutex_;
   perception::TrafficLightDetection traffic_light_;
@@ -86,6 +90,7 @@ class PlanningComponent final
 
   PlanningConfig config_;
   MessageProcess message_process_;
+  uint32_t num_planning_cycles_ = 0;
 };
 
 CYBER_REGISTER_COMPONENT(PlanningComponent)
@@ -36,6 +36,7 @@
 #include "modules/map/pnc_map/path.h"
 #include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/routing/common/routing_gflags.h"
 
 /**
@@ -56,6 +57,8 @@ using apollo::hdmap::MapPathPoint;
 using apollo::hdmap::PncMap;
 using apollo::hdmap::RouteSegments;
 
+constexpr size_t ReferenceLineProvider::kMaxSmoothingCacheSize;
+
 ReferenceLineProvider::~ReferenceLineProvider() {}
 
 ReferenceLineProvider::ReferenceLineProvider(
@@ -188,6 +191,8 @@ void ReferenceLineProvider::UpdateReferenceLine(
 }
 
 void ReferenceLineProvider::GenerateThread() {
+  // runs alongside the planning cycles, which its spans are not part of
+  PlanningProfiler::ScopedThreadRoot profiler_root("ReferenceLineProvider");
   while (!is_stop_) {
     static constexpr int32_t kSleepTime = 50;  // milliseconds
     cyber::SleepFor(std::chrono::milliseconds(kSleepTime));
@@ -207,6 +212,7 @@ void ReferenceLineProvider::GenerateThread() {
     const double end_time = Clock::NowInSeconds();
     std::lock_guard<std::mutex> lock(reference_lines_mutex_);
     last_calculation_time_ = end_time - start_time;
+    UpdateSmoothingStatistics();
   }
 }
 
@@ -220,6 +226,25 @@ double ReferenceLineProvider::LastTimeDelay() {
   }
 }
 
+double ReferenceLineProvider::LastSmoothingTime() {
+  std::lock_guard<std::mutex> lock(reference_lines_mutex_);
+  return last_smoothing_time_;
+}
+
+double ReferenceLineProvider::SmoothingCacheHitRate() {
+  std::lock_guard<std::mutex> lock(reference_lines_mutex_);
+  return smoothing_cache_hit_rate_;
+}
+
+void ReferenceLineProvider::UpdateSmoothingStatistics() {
+  last_smoothing_time_ = smoothing_time_;
+  smoothing_cache_hit_rate_ =
+      num_smoothing_requests_ == 0
+          ? 0.0
+          : static_cast<double>(num_smoothing_cache_hits_) /
+                static_cast<double>(num_smoothing_requests_);
+}
+
 bool ReferenceLineProvider::GetReferenceLines(
     std::list<ReferenceLine> *reference_lines,
     std::list<hdmap::RouteSegments> *segments) {
@@ -249,7 +274,9 @@ bool ReferenceLineProvider::GetReferenceLines(
     if (CreateReferenceLine(reference_lines, segments)) {
       UpdateReferenceLine(*reference_lines, *segments);
       double end_time = Clock::NowInSeconds();
+      std::lock_guard<std::mutex> lock(reference_lines_mutex_);
       last_calculation_time_ = end_time - start_time;
+      UpdateSmoothingStatistics();
       return true;
     }
   }
@@ -551,6 +578,8 @@ bool ReferenceLineProvider::CreateReferenceLine(
     std::list<hdmap::RouteSegments> *segments) {
   CHECK_NOTNULL(reference_lines);
   CHECK_NOTNULL(segments);
+  PLANNING_PROFILE_SPAN("CreateReferenceLine");
+  smoothing_time_ = 0.0;
 
   common::VehicleState vehicle_state;
   {
@@ -575,6 +604,9 @@ bool ReferenceLineProvider::CreateReferenceLine(
       }
     }
   }
+  if (is_new_routing) {
+    smoothing_cache_.clear();
+  }
 
   if (!CreateRouteSegments(vehicle_state, segments)) {
     AERROR << "Failed to create reference line from routing";
@@ -870,8 +902,149 @@ void ReferenceLineProvider::GetAnchorPoints(
 
 bool ReferenceLineProvider::SmoothRouteSegment(const RouteSegments &segments,
                                                ReferenceLine *reference_line) {
+  if (!FLAGS_enable_reference_line_smoothing_cache ||
+      !FLAGS_enable_smooth_reference_line) {
+    hdmap::Path path(segments);
+    return SmoothReferenceLine(ReferenceLine(path), reference_line);
+  }
+  ++num_smoothing_requests_;
+  if (SmoothRouteSegmentFromCache(segments, reference_line)) {
+    ++num_smoothing_cache_hits_;
+    return true;
+  }
   hdmap::Path path(segments);
-  return SmoothReferenceLine(ReferenceLine(path), reference_line);
+  if (!SmoothReferenceLine(ReferenceLine(path), reference_line)) {
+    return false;
+  }
+  AddToSmoothingCache(segments, *reference_line);
+  return true;
+}
+
+bool ReferenceLineProvider::SmoothRouteSegmentFromCache(
+    const RouteSegments &segments, ReferenceLine *reference_line) {
+  static constexpr double kLaneSegmentEpsilon = 1e-3;
+  if (segments.empty()) {
+    return false;
+  }
+  const auto &first_segment = segments.front();
+  for (auto cached = smoothing_cache_.begin(); cached != smoothing_cache_.end();
+       ++cached) {
+    // find the cached lane segment the new segments start from
+    const auto &cached_segments = cached->segments;
+    size_t j = 0;
+    while (j < cached_segments.size() &&
+           (cached_segments[j].lane->id().id() !=
+                first_segment.lane->id().id() ||
+            first_segment.start_s <
+                cached_segments[j].start_s - kLaneSegmentEpsilon ||
+            first_segment.start_s >
+                cached_segments[j].end_s - kLaneSegmentEpsilon)) {
+      ++j;
+    }
+    if (j == cached_segments.size()) {
+      continue;
+    }
+    // the following lane segments have to be the same, except that either
+    // the new or the cached segments may end earlier on their last lane
+    size_t i = 0;
+    bool is_matched = true;
+    for (; i < segments.size() && j < cached_segments.size(); ++i, ++j) {
+      const auto &segment = segments[i];
+      const auto &cached_segment = cached_segments[j];
+      if (segment.lane->id().id() != cached_segment.lane->id().id() ||
+          (i > 0 && std::fabs(segment.start_s - cached_segment.start_s) >
+                        kLaneSegmentEpsilon)) {
+        is_matched = false;
+        break;
+      }
+      const bool is_last = i + 1 == segments.size();
+      const bool is_cached_last = j + 1 == cached_segments.size();
+      if ((!is_last || segment.end_s > cached_segment.end_s) &&
+          !is_cached_last &&
+          std::fabs(segment.end_s - cached_segment.end_s) >
+              kLaneSegmentEpsilon) {
+        is_matched = false;
+        break;
+      }
+    }
+    if (!is_matched) {
+      continue;
+    }
+    const auto &cached_ref = cached->reference_line;
+    common::SLPoint start_sl;
+    if (!cached_ref.XYToSL(
+            first_segment.lane->GetSmoothPoint(first_segment.start_s),
+            &start_sl)) {
+      continue;
+    }
+    const auto &last_segment = segments.back();
+    const bool is_covered =
+        i == segments.size() &&
+        (j < cached_segments.size() ||
+         last_segment.end_s <=
+             cached_segments.back().end_s + kLaneSegmentEpsilon);
+    if (is_covered) {
+      common::SLPoint end_sl;
+      if (!cached_ref.XYToSL(
+              last_segment.lane->GetSmoothPoint(last_segment.end_s),
+              &end_sl)) {
+        continue;
+      }
+      *reference_line = cached_ref;
+      if (!reference_line->Segment(start_sl.s(), 0.0,
+                                   end_sl.s() - start_sl.s())) {
+        continue;
+      }
+      smoothing_cache_.splice(smoothing_cache_.begin(), smoothing_cache_,
+                              cached);
+      ADEBUG << "Reuse cached smoothed reference line from s " << start_sl.s()
+             << " to " << end_sl.s();
+      return true;
+    }
+    // reuse the cached reference line up to the stitch overlap, and smooth the
+    // rest of the new segments anchored to it
+    const double stitch_s =
+        cached_ref.Length() - FLAGS_reference_line_stitch_overlap_distance;
+    if (stitch_s <= start_sl.s()) {
+      continue;
+    }
+    const auto stitch_point = cached_ref.GetReferencePoint(stitch_s);
+    hdmap::Path path(segments);
+    ReferenceLine raw_ref(path);
+    common::SLPoint stitch_sl;
+    if (!raw_ref.XYToSL(stitch_point, &stitch_sl) ||
+        !raw_ref.Segment(stitch_sl.s(), 0.0, raw_ref.Length())) {
+      continue;
+    }
+    if (!SmoothPrefixedReferenceLine(cached_ref, raw_ref, reference_line) ||
+        !reference_line->Stitch(cached_ref)) {
+      continue;
+    }
+    common::SLPoint new_start_sl;
+    if (!reference_line->XYToSL(
+            first_segment.lane->GetSmoothPoint(first_segment.start_s),
+            &new_start_sl) ||
+        !reference_line->Segment(new_start_sl.s(), 0.0,
+                                 reference_line->Length())) {
+      continue;
+    }
+    ADEBUG << "Reuse cached smoothed reference line up to s " << stitch_s
+           << " and smooth the remaining " << raw_ref.Length() << " meters";
+    smoothing_cache_.erase(cached);
+    AddToSmoothingCache(segments, *reference_line);
+    return true;
+  }
+  return false;
+}
+
+void ReferenceLineProvider::AddToSmoothingCache(
+    const RouteSegments &segments, const ReferenceLine &reference_line) {
+  smoothing_cache_.emplace_front();
+  smoothing_cache_.front().segments = segments;
+  smoothing_cache_.front().reference_line = reference_line;
+  if (smoothing_cache_.size() > kMaxSmoothingCacheSize) {
+    smoothing_cache_.pop_back();
+  }
 }
 
 bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
@@ -904,16 +1077,7 @@ bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
     break;
   }
 
-  smoother_->SetAnchorPoints(anchor_points);
-  if (!smoother_->Smooth(raw_ref, reference_line)) {
-    AERROR << "Failed to smooth prefixed reference line with anchor points";
-    return false;
-  }
-  if (!IsReferenceLineSmoothValid(raw_ref, *reference_line)) {
-    AERROR << "The smoothed reference line error is too large";
-    return false;
-  }
-  return true;
+  return SmoothWithAnchorPoints(anchor_points, raw_ref, reference_line);
 }
 
 bool ReferenceLineProvider::SmoothReferenceLine(
@@ -925,8 +1089,20 @@ bool ReferenceLineProvider::SmoothReferenceLine(
   // generate anchor points:
   std::vector<AnchorPoint> anchor_points;
   GetAnchorPoints(raw_reference_line, &anchor_points);
+  return SmoothWithAnchorPoints(anchor_points, raw_reference_line,
+                                reference_line);
+}
+
+bool ReferenceLineProvider::SmoothWithAnchorPoints(
+    const std::vector<AnchorPoint> &anchor_points,
+    const ReferenceLine &raw_reference_line, ReferenceLine *reference_line) {
+  PLANNING_PROFILE_SPAN("SmoothReferenceLine");
   smoother_->SetAnchorPoints(anchor_points);
-  if (!smoother_->Smooth(raw_reference_line, reference_line)) {
+  const double start_time = Clock::NowInSeconds();
+  const bool is_smoothed =
+      smoother_->Smooth(raw_reference_line, reference_line);
+  smoothing_time_ += Clock::NowInSeconds() - start_time;
+  if (!is_smoothed) {
     AERROR << "Failed to smooth reference line with anchor points";
     return false;
   }
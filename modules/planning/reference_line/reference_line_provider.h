@@ -30,6 +30,7 @@
 #include <vector>
 
 #include "cyber/cyber.h"
+#include "gtest/gtest_prod.h"
 #include "modules/common/util/factory.h"
 #include "modules/common/util/util.h"
 #include "modules/common/vehicle_state/proto/vehicle_state.pb.h"
@@ -86,6 +87,18 @@ class ReferenceLineProvider {
 
   bool UpdatedReferenceLine() { return is_reference_line_updated_.load(); }
 
+  /**
+   * @brief The time spent in the smoother by the last reference line
+   * generation, in seconds.
+   */
+  double LastSmoothingTime();
+
+  /**
+   * @brief The ratio of the route segments smoothed with the smoothing cache
+   * to all route segments smoothed.
+   */
+  double SmoothingCacheHitRate();
+
  private:
   /**
    * @brief Use PncMap to create reference line and the corresponding segments
@@ -127,6 +140,25 @@ class ReferenceLineProvider {
   bool SmoothRouteSegment(const hdmap::RouteSegments& segments,
                           ReferenceLine* reference_line);
 
+  /**
+   * @brief Smooth the route segments from a cached smoothed reference line of
+   * the same lane segments. The cached reference line is reused up to the
+   * stitch overlap distance before its end, and only the rest is smoothed
+   * anchored to it.
+   * @return false if no cached reference line covers the start of segments
+   */
+  bool SmoothRouteSegmentFromCache(const hdmap::RouteSegments& segments,
+                                   ReferenceLine* reference_line);
+
+  void AddToSmoothingCache(const hdmap::RouteSegments& segments,
+                           const ReferenceLine& reference_line);
+
+  bool SmoothWithAnchorPoints(const std::vector<AnchorPoint>& anchor_points,
+                              const ReferenceLine& raw_reference_line,
+                              ReferenceLine* reference_line);
+
+  void UpdateSmoothingStatistics();
+
   /**
    * @brief This function creates a smoothed forward reference line
    * based on the given segments.
@@ -154,6 +186,12 @@ class ReferenceLineProvider {
   bool Shrink(const common::SLPoint& sl, ReferenceLine* ref,
               hdmap::RouteSegments* segments);
 
+ private:
+  FRIEND_TEST(ReferenceLineProviderTest, SmoothCoveredRouteSegmentFromCache);
+  FRIEND_TEST(ReferenceLineProviderTest, SmoothRouteSegmentTailFromCache);
+  FRIEND_TEST(ReferenceLineProviderTest, EvictLeastRecentlyUsedFromCache);
+  FRIEND_TEST(ReferenceLineProviderTest, MissSmoothingCacheAfterNewRouting);
+
  private:
   bool is_initialized_ = false;
   std::atomic<bool> is_stop_{false};
@@ -186,6 +224,22 @@ class ReferenceLineProvider {
 
   std::atomic<bool> is_reference_line_updated_{true};
 
+  // smoothed route segments, the most recently used first, only accessed by
+  // the reference line generation and cleared on a new routing
+  struct SmoothedRouteSegments {
+    hdmap::RouteSegments segments;
+    ReferenceLine reference_line;
+  };
+  static constexpr size_t kMaxSmoothingCacheSize = 8;
+  std::list<SmoothedRouteSegments> smoothing_cache_;
+  uint64_t num_smoothing_requests_ = 0;
+  uint64_t num_smoothing_cache_hits_ = 0;
+  double smoothing_time_ = 0.0;
+
+  // published with reference_lines_mutex_
+  double last_smoothing_time_ = 0.0;
+  double smoothing_cache_hit_rate_ = 0.0;
+
   const common::VehicleStateProvider* vehicle_state_provider_ = nullptr;
 };
 
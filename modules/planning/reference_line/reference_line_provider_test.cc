@@ -0,0 +1,215 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/reference_line/reference_line_provider.h"
+
+#include "cyber/common/file.h"
+#include "gtest/gtest.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// returns the raw reference line, and counts the length it smoothed
+class CountingSmoother : public ReferenceLineSmoother {
+ public:
+  CountingSmoother() : ReferenceLineSmoother(ReferenceLineSmootherConfig()) {}
+
+  void SetAnchorPoints(const std::vector<AnchorPoint>&) override {}
+
+  bool Smooth(const ReferenceLine& raw_reference_line,
+              ReferenceLine* const smoothed_reference_line) override {
+    ++num_calls;
+    smoothed_length += raw_reference_line.Length();
+    *smoothed_reference_line = raw_reference_line;
+    return true;
+  }
+
+  int num_calls = 0;
+  double smoothed_length = 0.0;
+};
+
+}  // namespace
+
+class ReferenceLineProviderTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    FLAGS_map_dir = "/apollo/modules/planning/testdata/garage_map";
+    FLAGS_base_map_filename = "base_map.txt";
+    FLAGS_smoother_config_filename =
+        "/apollo/modules/planning/conf/discrete_points_smoother_config.pb.txt";
+    FLAGS_enable_reference_line_smoothing_cache = true;
+    FLAGS_enable_smooth_reference_line = true;
+    FLAGS_reference_line_stitch_overlap_distance = 20.0;
+
+    const auto* base_map = hdmap::HDMapUtil::BaseMapPtr();
+    ASSERT_NE(nullptr, base_map);
+    lane_ = base_map->GetLaneById(hdmap::MakeMapId("1_-1"));
+    ASSERT_NE(nullptr, lane_);
+    provider_.reset(new ReferenceLineProvider(nullptr, base_map));
+    smoother_ = new CountingSmoother();
+  }
+
+  hdmap::RouteSegments MakeSegments(const double start_s,
+                                    const double end_s) const {
+    hdmap::RouteSegments segments;
+    segments.emplace_back(lane_, start_s, end_s);
+    return segments;
+  }
+
+ protected:
+  hdmap::LaneInfoConstPtr lane_ = nullptr;
+  std::unique_ptr<ReferenceLineProvider> provider_;
+  // owned by provider_ once set as its smoother
+  CountingSmoother* smoother_ = nullptr;
+};
+
+TEST_F(ReferenceLineProviderTest, SmoothCoveredRouteSegmentFromCache) {
+  provider_->smoother_.reset(smoother_);
+  ReferenceLine cached;
+  EXPECT_TRUE(provider_->SmoothRouteSegment(MakeSegments(0.0, 100.0), &cached));
+  EXPECT_EQ(1, smoother_->num_calls);
+  EXPECT_EQ(0, provider_->num_smoothing_cache_hits_);
+
+  ReferenceLine reference_line;
+  EXPECT_TRUE(
+      provider_->SmoothRouteSegment(MakeSegments(10.0, 90.0), &reference_line));
+  EXPECT_EQ(1, smoother_->num_calls);
+  EXPECT_EQ(1, provider_->num_smoothing_cache_hits_);
+  EXPECT_EQ(2, provider_->num_smoothing_requests_);
+  EXPECT_NEAR(80.0, reference_line.Length(), 0.1);
+
+  // the cut of the cached reference line
+  const auto start_point = lane_->GetSmoothPoint(10.0);
+  common::SLPoint start_sl;
+  EXPECT_TRUE(cached.XYToSL(start_point, &start_sl));
+  EXPECT_NEAR(10.0, start_sl.s(), 0.1);
+  for (double s = 0.0; s < reference_line.Length(); s += 10.0) {
+    const auto point = reference_line.GetReferencePoint(s);
+    const auto cached_point = cached.GetReferencePoint(start_sl.s() + s);
+    EXPECT_NEAR(cached_point.x(), point.x(), 1e-3);
+    EXPECT_NEAR(cached_point.y(), point.y(), 1e-3);
+  }
+  EXPECT_EQ(1, provider_->smoothing_cache_.size());
+}
+
+TEST_F(ReferenceLineProviderTest, SmoothRouteSegmentTailFromCache) {
+  provider_->smoother_.reset(smoother_);
+  ReferenceLine cached;
+  EXPECT_TRUE(provider_->SmoothRouteSegment(MakeSegments(0.0, 80.0), &cached));
+  EXPECT_EQ(1, smoother_->num_calls);
+
+  // only the segments after the stitch overlap before the cached end at 60
+  // are smoothed
+  smoother_->smoothed_length = 0.0;
+  ReferenceLine reference_line;
+  EXPECT_TRUE(provider_->SmoothRouteSegment(MakeSegments(10.0, 150.0),
+                                            &reference_line));
+  EXPECT_EQ(2, smoother_->num_calls);
+  EXPECT_NEAR(90.0, smoother_->smoothed_length, 1.0);
+  EXPECT_EQ(1, provider_->num_smoothing_cache_hits_);
+  EXPECT_NEAR(140.0, reference_line.Length(), 1.0);
+
+  // the stitched reference line replaces the cached one
+  ASSERT_EQ(1, provider_->smoothing_cache_.size());
+  EXPECT_NEAR(150.0,
+              provider_->smoothing_cache_.front().segments.back().end_s, 1e-6);
+  EXPECT_TRUE(provider_->SmoothRouteSegment(MakeSegments(20.0, 140.0),
+                                            &reference_line));
+  EXPECT_EQ(2, smoother_->num_calls);
+  EXPECT_EQ(2, provider_->num_smoothing_cache_hits_);
+  EXPECT_NEAR(120.0, reference_line.Length(), 1.0);
+}
+
+TEST_F(ReferenceLineProviderTest, EvictLeastRecentlyUsedFromCache) {
+  provider_->smoother_.reset(smoother_);
+  const size_t max_size = ReferenceLineProvider::kMaxSmoothingCacheSize;
+  // segments none of which covers the start of another
+  auto segments = [this](const size_t index) {
+    return MakeSegments(static_cast<double>(index) * 15.0,
+                        static_cast<double>(index) * 15.0 + 10.0);
+  };
+  ReferenceLine reference_line;
+  for (size_t i = 0; i < max_size; ++i) {
+    EXPECT_TRUE(provider_->SmoothRouteSegment(segments(i), &reference_line));
+  }
+  EXPECT_EQ(max_size, provider_->smoothing_cache_.size());
+  EXPECT_EQ(static_cast<int>(max_size), smoother_->num_calls);
+
+  // using the first one makes the second the least recently used
+  EXPECT_TRUE(provider_->SmoothRouteSegment(segments(0), &reference_line));
+  EXPECT_EQ(static_cast<int>(max_size), smoother_->num_calls);
+  EXPECT_TRUE(
+      provider_->SmoothRouteSegment(segments(max_size), &reference_line));
+  EXPECT_EQ(static_cast<int>(max_size) + 1, smoother_->num_calls);
+  EXPECT_EQ(max_size, provider_->smoothing_cache_.size());
+
+  EXPECT_TRUE(provider_->SmoothRouteSegment(segments(0), &reference_line));
+  EXPECT_EQ(static_cast<int>(max_size) + 1, smoother_->num_calls);
+  EXPECT_TRUE(provider_->SmoothRouteSegment(segments(1), &reference_line));
+  EXPECT_EQ(static_cast<int>(max_size) + 2, smoother_->num_calls);
+  EXPECT_EQ(max_size, provider_->smoothing_cache_.size());
+}
+
+TEST_F(ReferenceLineProviderTest, MissSmoothingCacheAfterNewRouting) {
+  provider_->smoother_.reset(smoother_);
+  routing::RoutingResponse routing;
+  ASSERT_TRUE(cyber::common::GetProtoFromFile(
+      "/apollo/modules/planning/testdata/garage_test/garage_routing.pb.txt",
+      &routing));
+  common::VehicleState vehicle_state;
+  const auto start_point = lane_->GetSmoothPoint(10.0);
+  vehicle_state.set_x(start_point.x());
+  vehicle_state.set_y(start_point.y());
+  vehicle_state.set_heading(lane_->Heading(10.0));
+  provider_->UpdateVehicleState(vehicle_state);
+  provider_->UpdateRoutingResponse(routing);
+
+  std::list<ReferenceLine> reference_lines;
+  std::list<hdmap::RouteSegments> segments;
+  EXPECT_TRUE(provider_->CreateReferenceLine(&reference_lines, &segments));
+  EXPECT_EQ(1, smoother_->num_calls);
+  EXPECT_EQ(0, provider_->num_smoothing_cache_hits_);
+
+  // the same routing
+  reference_lines.clear();
+  segments.clear();
+  EXPECT_TRUE(provider_->CreateReferenceLine(&reference_lines, &segments));
+  EXPECT_EQ(1, smoother_->num_calls);
+  EXPECT_EQ(1, provider_->num_smoothing_cache_hits_);
+
+  // a new routing of the same lanes
+  routing.mutable_header()->set_sequence_num(routing.header().sequence_num() +
+                                             1);
+  provider_->UpdateRoutingResponse(routing);
+  reference_lines.clear();
+  segments.clear();
+  EXPECT_TRUE(provider_->CreateReferenceLine(&reference_lines, &segments));
+  EXPECT_EQ(2, smoother_->num_calls);
+  EXPECT_EQ(1, provider_->num_smoothing_cache_hits_);
+  EXPECT_EQ(3, provider_->num_smoothing_requests_);
+  EXPECT_EQ(1, provider_->smoothing_cache_.size());
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -20,9 +20,12 @@
 
 #include "modules/planning/scenarios/lane_follow/lane_follow_stage.h"
 
+#include <future>
+#include <unordered_map>
 #include <utility>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "cyber/time/clock.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/util/point_factory.h"
@@ -32,12 +35,15 @@
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/planning/common/ego_info.h"
 #include "modules/planning/common/frame.h"
+#include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
 #include "modules/planning/tasks/deciders/lane_change_decider/lane_change_decider.h"
 #include "modules/planning/tasks/deciders/path_decider/path_decider.h"
 #include "modules/planning/tasks/deciders/speed_decider/speed_decider.h"
 #include "modules/planning/tasks/optimizers/path_time_heuristic/path_time_heuristic_optimizer.h"
+#include "modules/planning/tasks/task_factory.h"
 
 namespace apollo {
 namespace planning {
@@ -92,6 +98,18 @@ void LaneFollowStage::RecordObstacleDebugInfo(
 
 Stage::StageStatus LaneFollowStage::Process(
     const TrajectoryPoint& planning_start_point, Frame* frame) {
+  // the urgency checking of rule based stop decider reads the other
+  // reference lines while they are planned
+  if (FLAGS_enable_parallel_reference_line_planning &&
+      !FLAGS_enable_lane_change_urgency_checking &&
+      frame->reference_line_info().size() > 1) {
+    return ProcessInParallel(planning_start_point, frame);
+  }
+  return ProcessInSequence(planning_start_point, frame);
+}
+
+Stage::StageStatus LaneFollowStage::ProcessInSequence(
+    const TrajectoryPoint& planning_start_point, Frame* frame) {
   bool has_drivable_reference_line = false;
 
   ADEBUG << "Number of reference lines:\t"
@@ -115,44 +133,175 @@ Stage::StageStatus LaneFollowStage::Process(
     auto cur_status =
         PlanOnReferenceLine(planning_start_point, frame, &reference_line_info);
 
-    if (cur_status.ok()) {
-      if (reference_line_info.IsChangeLanePath()) {
-        ADEBUG << "reference line is lane change ref.";
-        ADEBUG << "FLAGS_enable_smarter_lane_change: "
-               << FLAGS_enable_smarter_lane_change;
-        if (reference_line_info.Cost() < kStraightForwardLineCost &&
-            (LaneChangeDecider::IsClearToChangeLane(&reference_line_info) ||
-             FLAGS_enable_smarter_lane_change)) {
-          // If the path and speed optimization succeed on target lane while
-          // under smart lane-change or IsClearToChangeLane under older version
-          has_drivable_reference_line = true;
-          reference_line_info.SetDrivable(true);
-          LaneChangeDecider::UpdatePreparationDistance(
-              true, frame, &reference_line_info, injector_->planning_context());
-          ADEBUG << "\tclear for lane change";
-        } else {
-          LaneChangeDecider::UpdatePreparationDistance(
-              false, frame, &reference_line_info,
-              injector_->planning_context());
-          reference_line_info.SetDrivable(false);
-          ADEBUG << "\tlane change failed";
-        }
-      } else {
-        ADEBUG << "reference line is NOT lane change ref.";
-        has_drivable_reference_line = true;
-      }
-    } else {
-      reference_line_info.SetDrivable(false);
+    has_drivable_reference_line =
+        CheckPlannedReferenceLine(cur_status, frame, &reference_line_info);
+  }
+
+  return has_drivable_reference_line ? StageStatus::RUNNING
+                                     : StageStatus::ERROR;
+}
+
+Stage::StageStatus LaneFollowStage::ProcessInParallel(
+    const TrajectoryPoint& planning_start_point, Frame* frame) {
+  auto* reference_line_infos = frame->mutable_reference_line_info();
+  auto* planning_context = injector_->planning_context();
+
+  // frame level tasks run once on the front line, as Process does
+  size_t first_task_index = 0;
+  while (first_task_index < task_list_.size() &&
+         IsFrameLevelTask(task_list_[first_task_index])) {
+    auto* task = task_list_[first_task_index++];
+    auto& front_line = reference_line_infos->front();
+    PLANNING_PROFILE_SPAN(task->Name());
+    const double start_timestamp = Clock::NowInSeconds();
+    const auto ret = task->Execute(frame, &front_line);
+    const double end_timestamp = Clock::NowInSeconds();
+    RecordDebugInfo(&front_line, task->Name(),
+                    (end_timestamp - start_timestamp) * 1000);
+    if (!ret.ok()) {
+      AERROR << "Failed to run tasks[" << task->Name()
+             << "], plan the reference lines in sequence.";
+      return ProcessInSequence(planning_start_point, frame);
+    }
+  }
+
+  ADEBUG << "Number of reference lines planned in parallel:\t"
+         << reference_line_infos->size();
+
+  std::vector<ReferenceLineInfo*> lines;
+  for (auto& reference_line_info : *reference_line_infos) {
+    lines.push_back(&reference_line_info);
+  }
+  CreateLineTasks(lines.size(), first_task_index);
+
+  // every line starts from the status left by the frame level tasks
+  std::vector<PlanningStatus> line_status(lines.size(),
+                                          planning_context->planning_status());
+  std::vector<Status> line_ret(lines.size());
+  auto plan_on_line = [&](size_t index) {
+    PlanningContext::ScopedStatus scoped_status(planning_context,
+                                                &line_status[index]);
+    line_ret[index] = PlanOnReferenceLine(planning_start_point, frame,
+                                          lines[index],
+                                          line_task_lists_[index]);
+  };
+
+  // the front line is planned on this thread, only the other lines take
+  // workers from the task pool
+  std::vector<std::future<void>> results;
+  for (size_t i = 1; i < lines.size(); ++i) {
+    results.emplace_back(cyber::Async(plan_on_line, i));
+  }
+  plan_on_line(0);
+  for (auto& result : results) {
+    result.get();
+  }
+
+  // pick in order, the status of the last line Process would have planned is
+  // kept, which makes the result independent of the thread timing
+  bool has_drivable_reference_line = false;
+  for (size_t i = 0; i < lines.size(); ++i) {
+    if (has_drivable_reference_line) {
+      lines[i]->SetDrivable(false);
+      break;
     }
+    *planning_context->mutable_planning_status() = std::move(line_status[i]);
+    has_drivable_reference_line =
+        CheckPlannedReferenceLine(line_ret[i], frame, lines[i]);
   }
 
   return has_drivable_reference_line ? StageStatus::RUNNING
                                      : StageStatus::ERROR;
 }
 
+bool LaneFollowStage::CheckPlannedReferenceLine(
+    const Status& plan_status, Frame* frame,
+    ReferenceLineInfo* reference_line_info) {
+  if (!plan_status.ok()) {
+    reference_line_info->SetDrivable(false);
+    return false;
+  }
+
+  if (!reference_line_info->IsChangeLanePath()) {
+    ADEBUG << "reference line is NOT lane change ref.";
+    return true;
+  }
+
+  ADEBUG << "reference line is lane change ref.";
+  ADEBUG << "FLAGS_enable_smarter_lane_change: "
+         << FLAGS_enable_smarter_lane_change;
+  if (reference_line_info->Cost() < kStraightForwardLineCost &&
+      (LaneChangeDecider::IsClearToChangeLane(reference_line_info) ||
+       FLAGS_enable_smarter_lane_change)) {
+    // If the path and speed optimization succeed on target lane while
+    // under smart lane-change or IsClearToChangeLane under older version
+    reference_line_info->SetDrivable(true);
+    LaneChangeDecider::UpdatePreparationDistance(
+        true, frame, reference_line_info, injector_->planning_context());
+    ADEBUG << "\tclear for lane change";
+    return true;
+  }
+
+  LaneChangeDecider::UpdatePreparationDistance(
+      false, frame, reference_line_info, injector_->planning_context());
+  reference_line_info->SetDrivable(false);
+  ADEBUG << "\tlane change failed";
+  return false;
+}
+
+bool LaneFollowStage::IsFrameLevelTask(const Task* task) {
+  // lane change decider reorders the reference lines of the frame
+  return task->Config().task_type() == TaskConfig::LANE_CHANGE_DECIDER;
+}
+
+void LaneFollowStage::CreateLineTasks(size_t line_num,
+                                      size_t first_task_index) {
+  if (line_num <= line_task_lists_.size()) {
+    return;
+  }
+  if (line_task_lists_.empty()) {
+    line_tasks_.emplace_back();
+    line_task_lists_.emplace_back(task_list_.begin() + first_task_index,
+                                  task_list_.end());
+  }
+
+  const auto& stage_config = Stage::config_;
+  std::unordered_map<TaskConfig::TaskType, const TaskConfig*, std::hash<int>>
+      config_map;
+  for (const auto& task_config : stage_config.task_config()) {
+    config_map[task_config.task_type()] = &task_config;
+  }
+  while (line_task_lists_.size() < line_num) {
+    line_tasks_.emplace_back();
+    line_task_lists_.emplace_back();
+    auto& tasks = line_tasks_.back();
+    for (int i = static_cast<int>(first_task_index);
+         i < stage_config.task_type_size(); ++i) {
+      auto task_type = stage_config.task_type(i);
+      auto iter = tasks.find(task_type);
+      if (iter == tasks.end()) {
+        auto ptr = TaskFactory::CreateTask(*config_map[task_type], injector_);
+        line_task_lists_.back().push_back(ptr.get());
+        tasks[task_type] = std::move(ptr);
+      } else {
+        line_task_lists_.back().push_back(iter->second.get());
+      }
+    }
+  }
+}
+
 Status LaneFollowStage::PlanOnReferenceLine(
     const TrajectoryPoint& planning_start_point, Frame* frame,
     ReferenceLineInfo* reference_line_info) {
+  return PlanOnReferenceLine(planning_start_point, frame, reference_line_info,
+                             task_list_);
+}
+
+Status LaneFollowStage::PlanOnReferenceLine(
+    const TrajectoryPoint& planning_start_point, Frame* frame,
+    ReferenceLineInfo* reference_line_info,
+    const std::vector<Task*>& task_list) {
+  PLANNING_PROFILE_SPAN("PlanOnReferenceLine");
   if (!reference_line_info->IsChangeLanePath()) {
     reference_line_info->AddCost(kStraightForwardLineCost);
   }
@@ -161,7 +310,8 @@ Status LaneFollowStage::PlanOnReferenceLine(
          << reference_line_info->IsChangeLanePath();
 
   auto ret = Status::OK();
-  for (auto* task : task_list_) {
+  for (auto* task : task_list) {
+    PLANNING_PROFILE_SPAN(task->Name());
     const double start_timestamp = Clock::NowInSeconds();
 
     ret = task->Execute(frame, reference_line_info);
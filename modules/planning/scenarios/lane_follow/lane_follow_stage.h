@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -53,6 +54,17 @@ class LaneFollowStage : public Stage {
       const common::TrajectoryPoint& planning_start_point, Frame* frame,
       ReferenceLineInfo* reference_line_info);
 
+  StageStatus ProcessInSequence(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame);
+
+  /**
+   * @brief Plan all the reference lines concurrently, then pick the result in
+   * the same order as Process does. Tasks working on the whole frame, which
+   * may reorder the reference lines, run once before the lines fan out.
+   */
+  StageStatus ProcessInParallel(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame);
+
   void PlanFallbackTrajectory(
       const common::TrajectoryPoint& planning_start_point, Frame* frame,
       ReferenceLineInfo* reference_line_info);
@@ -69,9 +81,35 @@ class LaneFollowStage : public Stage {
 
   void RecordObstacleDebugInfo(ReferenceLineInfo* reference_line_info);
 
+ private:
+  common::Status PlanOnReferenceLine(
+      const common::TrajectoryPoint& planning_start_point, Frame* frame,
+      ReferenceLineInfo* reference_line_info,
+      const std::vector<Task*>& task_list);
+
+  /**
+   * @brief Decide whether a planned reference line can be driven on
+   */
+  bool CheckPlannedReferenceLine(const common::Status& plan_status,
+                                 Frame* frame,
+                                 ReferenceLineInfo* reference_line_info);
+
+  static bool IsFrameLevelTask(const Task* task);
+
+  /**
+   * @brief Make sure there are task lists for line_num reference lines. The
+   * first line uses the tasks of the stage, the others own a copy so that no
+   * task is executed concurrently.
+   */
+  void CreateLineTasks(size_t line_num, size_t first_task_index);
+
  private:
   ScenarioConfig config_;
   std::unique_ptr<Stage> stage_;
+
+  std::vector<std::map<TaskConfig::TaskType, std::unique_ptr<Task>>>
+      line_tasks_;
+  std::vector<std::vector<Task*>> line_task_lists_;
 };
 
 }  // namespace lane_follow
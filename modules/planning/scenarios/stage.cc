@@ -25,6 +25,7 @@
 
 #include "cyber/time/clock.h"
 #include "modules/planning/common/planning_context.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/common/speed_profile_generator.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
 #include "modules/planning/tasks/task_factory.h"
@@ -93,6 +94,7 @@ bool Stage::ExecuteTaskOnReferenceLine(
     }
 
     for (auto* task : task_list_) {
+      PLANNING_PROFILE_SPAN(task->Name());
       const double start_timestamp = Clock::NowInSeconds();
 
       const auto ret = task->Execute(frame, &reference_line_info);
@@ -145,6 +147,7 @@ bool Stage::ExecuteTaskOnReferenceLineForOnlineLearning(
   auto& picked_reference_line_info =
       frame->mutable_reference_line_info()->front();
   for (auto* task : task_list_) {
+    PLANNING_PROFILE_SPAN(task->Name());
     const double start_timestamp = Clock::NowInSeconds();
 
     const auto ret = task->Execute(frame, &picked_reference_line_info);
@@ -178,6 +181,7 @@ bool Stage::ExecuteTaskOnReferenceLineForOnlineLearning(
 bool Stage::ExecuteTaskOnOpenSpace(Frame* frame) {
   auto ret = common::Status::OK();
   for (auto* task : task_list_) {
+    PLANNING_PROFILE_SPAN(task->Name());
     ret = task->Execute(frame);
     if (!ret.ok()) {
       AERROR << "Failed to run tasks[" << task->Name()
@@ -30,6 +30,7 @@
 #include "modules/planning/common/path_boundary.h"
 #include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/tasks/deciders/utils/path_decider_obstacle_utils.h"
 
 namespace apollo {
@@ -48,6 +49,31 @@ using PathBoundPoint = std::tuple<double, double, double>;
 using PathBound = std::vector<PathBoundPoint>;
 // ObstacleEdge contains: (is_start_s, s, l_min, l_max, obstacle_id).
 using ObstacleEdge = std::tuple<int, double, double, double, std::string>;
+
+bool IsSameReferencePoint(const ReferencePoint& lhs,
+                          const ReferencePoint& rhs) {
+  if (lhs.x() != rhs.x() || lhs.y() != rhs.y() ||
+      lhs.heading() != rhs.heading() || lhs.kappa() != rhs.kappa() ||
+      lhs.dkappa() != rhs.dkappa() ||
+      lhs.lane_waypoints().size() != rhs.lane_waypoints().size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.lane_waypoints().size(); ++i) {
+    const auto& lhs_waypoint = lhs.lane_waypoints()[i];
+    const auto& rhs_waypoint = rhs.lane_waypoints()[i];
+    if (lhs_waypoint.lane != rhs_waypoint.lane ||
+        lhs_waypoint.s != rhs_waypoint.s || lhs_waypoint.l != rhs_waypoint.l) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsSameLaneSegment(const hdmap::LaneSegment& lhs,
+                       const hdmap::LaneSegment& rhs) {
+  return lhs.lane == rhs.lane && lhs.start_s == rhs.start_s &&
+         lhs.end_s == rhs.end_s;
+}
 }  // namespace
 
 PathBoundsDecider::PathBoundsDecider(
@@ -302,6 +328,10 @@ void PathBoundsDecider::InitPathBoundsDecider(
   } else {
     adc_lane_width_ = lane_left_width + lane_right_width;
   }
+
+  UpdateLaneSamples(reference_line);
+  has_sorted_obstacles_ = false;
+  sorted_obstacles_.clear();
 }
 
 common::TrajectoryPoint PathBoundsDecider::InferFrontAxeCenterFromRearAxeCenter(
@@ -323,6 +353,7 @@ Status PathBoundsDecider::GenerateRegularPathBound(
     const LaneBorrowInfo& lane_borrow_info, PathBound* const path_bound,
     std::string* const blocking_obstacle_id,
     std::string* const borrow_lane_type) {
+  PLANNING_PROFILE_SPAN("RegularPathBound");
   // 1. Initialize the path boundaries to be an indefinitely large area.
   if (!InitPathBoundary(reference_line_info, path_bound)) {
     const std::string msg = "Failed to initialize path boundaries.";
@@ -375,6 +406,7 @@ Status PathBoundsDecider::GenerateRegularPathBound(
 Status PathBoundsDecider::GenerateLaneChangePathBound(
     const ReferenceLineInfo& reference_line_info,
     std::vector<std::tuple<double, double, double>>* const path_bound) {
+  PLANNING_PROFILE_SPAN("LaneChangePathBound");
   // 1. Initialize the path boundaries to be an indefinitely large area.
   if (!InitPathBoundary(reference_line_info, path_bound)) {
     const std::string msg = "Failed to initialize path boundaries.";
@@ -425,6 +457,7 @@ Status PathBoundsDecider::GenerateLaneChangePathBound(
 Status PathBoundsDecider::GeneratePullOverPathBound(
     const Frame& frame, const ReferenceLineInfo& reference_line_info,
     PathBound* const path_bound) {
+  PLANNING_PROFILE_SPAN("PullOverPathBound");
   // 1. Initialize the path boundaries to be an indefinitely large area.
   if (!InitPathBoundary(reference_line_info, path_bound)) {
     const std::string msg = "Failed to initialize path boundaries.";
@@ -530,6 +563,7 @@ Status PathBoundsDecider::GeneratePullOverPathBound(
 
 Status PathBoundsDecider::GenerateFallbackPathBound(
     const ReferenceLineInfo& reference_line_info, PathBound* const path_bound) {
+  PLANNING_PROFILE_SPAN("FallbackPathBound");
   // 1. Initialize the path boundaries to be an indefinitely large area.
   if (!InitPathBoundary(reference_line_info, path_bound)) {
     const std::string msg = "Failed to initialize fallback path boundaries.";
@@ -930,7 +964,6 @@ bool PathBoundsDecider::GetBoundaryFromRoads(
   // Sanity checks.
   CHECK_NOTNULL(path_bound);
   ACHECK(!path_bound->empty());
-  const ReferenceLine& reference_line = reference_line_info.reference_line();
 
   // Go through every point, update the boudnary based on the road boundary.
   double past_road_left_width = adc_lane_width_ / 2.0;
@@ -939,16 +972,18 @@ bool PathBoundsDecider::GetBoundaryFromRoads(
   for (size_t i = 0; i < path_bound->size(); ++i) {
     // 1. Get road boundary.
     double curr_s = std::get<0>((*path_bound)[i]);
+    const LaneSample& lane_sample =
+        GetLaneSample(reference_line_info, i, curr_s);
     double curr_road_left_width = 0.0;
     double curr_road_right_width = 0.0;
-    double refline_offset_to_lane_center = 0.0;
-    reference_line.GetOffsetToMap(curr_s, &refline_offset_to_lane_center);
-    if (!reference_line.GetRoadWidth(curr_s, &curr_road_left_width,
-                                     &curr_road_right_width)) {
+    const double refline_offset_to_lane_center = lane_sample.offset_to_map;
+    if (!lane_sample.has_road_width) {
       AWARN << "Failed to get lane width at s = " << curr_s;
       curr_road_left_width = past_road_left_width;
       curr_road_right_width = past_road_right_width;
     } else {
+      curr_road_left_width = lane_sample.road_left_width;
+      curr_road_right_width = lane_sample.road_right_width;
       curr_road_left_width += refline_offset_to_lane_center;
       curr_road_right_width -= refline_offset_to_lane_center;
       past_road_left_width = curr_road_left_width;
@@ -1117,7 +1152,6 @@ bool PathBoundsDecider::GetBoundaryFromLanesAndADC(
   // Sanity checks.
   CHECK_NOTNULL(path_bound);
   ACHECK(!path_bound->empty());
-  const ReferenceLine& reference_line = reference_line_info.reference_line();
   bool is_left_lane_boundary = true;
   bool is_right_lane_boundary = true;
   const double boundary_buffer = 0.05;  // meter
@@ -1130,29 +1164,29 @@ bool PathBoundsDecider::GetBoundaryFromLanesAndADC(
   bool borrowing_reverse_lane = false;
   for (size_t i = 0; i < path_bound->size(); ++i) {
     double curr_s = std::get<0>((*path_bound)[i]);
+    const LaneSample& lane_sample = GetLaneSampleWithNeighborLane(
+        reference_line_info, i, curr_s, lane_borrow_info);
     // 1. Get the current lane width at current point.
     double curr_lane_left_width = 0.0;
     double curr_lane_right_width = 0.0;
     double offset_to_lane_center = 0.0;
-    if (!reference_line.GetLaneWidth(curr_s, &curr_lane_left_width,
-                                     &curr_lane_right_width)) {
+    if (!lane_sample.has_lane_width) {
       AWARN << "Failed to get lane width at s = " << curr_s;
       curr_lane_left_width = past_lane_left_width;
       curr_lane_right_width = past_lane_right_width;
     } else {
+      curr_lane_left_width = lane_sample.lane_left_width;
+      curr_lane_right_width = lane_sample.lane_right_width;
       // check if lane boundary is also road boundary
-      double curr_road_left_width = 0.0;
-      double curr_road_right_width = 0.0;
-      if (reference_line.GetRoadWidth(curr_s, &curr_road_left_width,
-                                      &curr_road_right_width)) {
+      if (lane_sample.has_road_width) {
         is_left_lane_boundary =
-            (std::abs(curr_road_left_width - curr_lane_left_width) >
+            (std::abs(lane_sample.road_left_width - curr_lane_left_width) >
              boundary_buffer);
         is_right_lane_boundary =
-            (std::abs(curr_road_right_width - curr_lane_right_width) >
+            (std::abs(lane_sample.road_right_width - curr_lane_right_width) >
              boundary_buffer);
       }
-      reference_line.GetOffsetToMap(curr_s, &offset_to_lane_center);
+      offset_to_lane_center = lane_sample.offset_to_map;
       curr_lane_left_width += offset_to_lane_center;
       curr_lane_right_width -= offset_to_lane_center;
       past_lane_left_width = curr_lane_left_width;
@@ -1161,44 +1195,18 @@ bool PathBoundsDecider::GetBoundaryFromLanesAndADC(
 
     // 2. Get the neighbor lane widths at the current point.
     double curr_neighbor_lane_width = 0.0;
-    if (CheckLaneBoundaryType(reference_line_info, curr_s, lane_borrow_info)) {
-      hdmap::Id neighbor_lane_id;
-      if (lane_borrow_info == LaneBorrowInfo::LEFT_BORROW) {
-        // Borrowing left neighbor lane.
-        if (reference_line_info.GetNeighborLaneInfo(
-                ReferenceLineInfo::LaneType::LeftForward, curr_s,
-                &neighbor_lane_id, &curr_neighbor_lane_width)) {
-          ADEBUG << "Borrow left forward neighbor lane.";
-        } else if (reference_line_info.GetNeighborLaneInfo(
-                       ReferenceLineInfo::LaneType::LeftReverse, curr_s,
-                       &neighbor_lane_id, &curr_neighbor_lane_width)) {
-          borrowing_reverse_lane = true;
-          ADEBUG << "Borrow left reverse neighbor lane.";
-        } else {
-          ADEBUG << "There is no left neighbor lane.";
-        }
-      } else if (lane_borrow_info == LaneBorrowInfo::RIGHT_BORROW) {
-        // Borrowing right neighbor lane.
-        if (reference_line_info.GetNeighborLaneInfo(
-                ReferenceLineInfo::LaneType::RightForward, curr_s,
-                &neighbor_lane_id, &curr_neighbor_lane_width)) {
-          ADEBUG << "Borrow right forward neighbor lane.";
-        } else if (reference_line_info.GetNeighborLaneInfo(
-                       ReferenceLineInfo::LaneType::RightReverse, curr_s,
-                       &neighbor_lane_id, &curr_neighbor_lane_width)) {
-          borrowing_reverse_lane = true;
-          ADEBUG << "Borrow right reverse neighbor lane.";
-        } else {
-          ADEBUG << "There is no right neighbor lane.";
-        }
+    if (lane_borrow_info != LaneBorrowInfo::NO_BORROW) {
+      const int side = lane_borrow_info == LaneBorrowInfo::LEFT_BORROW ? 0 : 1;
+      curr_neighbor_lane_width = lane_sample.neighbor_lane_width[side];
+      if (lane_sample.is_neighbor_lane_reverse[side]) {
+        borrowing_reverse_lane = true;
       }
     }
 
     // 3. Calculate the proper boundary based on lane-width, ADC's position,
     //    and ADC's velocity.
     static constexpr double kMaxLateralAccelerations = 1.5;
-    double offset_to_map = 0.0;
-    reference_line.GetOffsetToMap(curr_s, &offset_to_map);
+    const double offset_to_map = lane_sample.offset_to_map;
 
     double ADC_speed_buffer = (adc_frenet_ld_ > 0 ? 1.0 : -1.0) *
                               adc_frenet_ld_ * adc_frenet_ld_ /
@@ -1275,7 +1283,6 @@ bool PathBoundsDecider::GetBoundaryFromLanesAndADC(
 //     (pull over at closer road side) lane boundary for EMERGENCY_PULL_OVER
 void PathBoundsDecider::UpdatePullOverBoundaryByLaneBoundary(
     const ReferenceLineInfo& reference_line_info, PathBound* const path_bound) {
-  const ReferenceLine& reference_line = reference_line_info.reference_line();
   const auto& pull_over_status =
       injector_->planning_context()->planning_status().pull_over();
   const auto pull_over_type = pull_over_status.pull_over_type();
@@ -1286,16 +1293,14 @@ void PathBoundsDecider::UpdatePullOverBoundaryByLaneBoundary(
 
   for (size_t i = 0; i < path_bound->size(); ++i) {
     const double curr_s = std::get<0>((*path_bound)[i]);
+    const LaneSample& lane_sample =
+        GetLaneSample(reference_line_info, i, curr_s);
     double left_bound = 3.0;
     double right_bound = 3.0;
-    double curr_lane_left_width = 0.0;
-    double curr_lane_right_width = 0.0;
-    if (reference_line.GetLaneWidth(curr_s, &curr_lane_left_width,
-                                    &curr_lane_right_width)) {
-      double offset_to_lane_center = 0.0;
-      reference_line.GetOffsetToMap(curr_s, &offset_to_lane_center);
-      left_bound = curr_lane_left_width + offset_to_lane_center;
-      right_bound = curr_lane_right_width + offset_to_lane_center;
+    if (lane_sample.has_lane_width) {
+      const double offset_to_lane_center = lane_sample.offset_to_map;
+      left_bound = lane_sample.lane_left_width + offset_to_lane_center;
+      right_bound = lane_sample.lane_right_width + offset_to_lane_center;
     }
     ADEBUG << "left_bound[" << left_bound << "] right_bound[" << right_bound
            << "]";
@@ -1310,12 +1315,11 @@ void PathBoundsDecider::UpdatePullOverBoundaryByLaneBoundary(
 
 void PathBoundsDecider::ConvertBoundarySAxisFromLaneCenterToRefLine(
     const ReferenceLineInfo& reference_line_info, PathBound* const path_bound) {
-  const ReferenceLine& reference_line = reference_line_info.reference_line();
   for (size_t i = 0; i < path_bound->size(); ++i) {
     // 1. Get road boundary.
     double curr_s = std::get<0>((*path_bound)[i]);
-    double refline_offset_to_lane_center = 0.0;
-    reference_line.GetOffsetToMap(curr_s, &refline_offset_to_lane_center);
+    const double refline_offset_to_lane_center =
+        GetLaneSample(reference_line_info, i, curr_s).offset_to_map;
     std::get<1>((*path_bound)[i]) -= refline_offset_to_lane_center;
     std::get<2>((*path_bound)[i]) -= refline_offset_to_lane_center;
   }
@@ -1408,8 +1412,7 @@ bool PathBoundsDecider::GetBoundaryFromStaticObstacles(
     const PathDecision& path_decision, PathBound* const path_boundaries,
     std::string* const blocking_obstacle_id) {
   // Preprocessing.
-  auto indexed_obstacles = path_decision.obstacles();
-  auto sorted_obstacles = SortObstaclesForSweepLine(indexed_obstacles);
+  const auto& sorted_obstacles = GetSortedObstacles(path_decision);
   ADEBUG << "There are " << sorted_obstacles.size() << " obstacles.";
   double center_line = adc_frenet_l_;
   size_t obs_idx = 0;
@@ -1908,6 +1911,109 @@ bool PathBoundsDecider::CheckLaneBoundaryType(
   return true;
 }
 
+void PathBoundsDecider::UpdateLaneSamples(const ReferenceLine& reference_line) {
+  const auto& reference_points = reference_line.reference_points();
+  const auto& lane_segments = reference_line.map_path().lane_segments();
+  if (reference_points.size() == lane_samples_reference_points_.size() &&
+      lane_segments.size() == lane_samples_lane_segments_.size() &&
+      std::equal(reference_points.begin(), reference_points.end(),
+                 lane_samples_reference_points_.begin(),
+                 IsSameReferencePoint) &&
+      std::equal(lane_segments.begin(), lane_segments.end(),
+                 lane_samples_lane_segments_.begin(), IsSameLaneSegment)) {
+    return;
+  }
+  lane_samples_.clear();
+  lane_samples_reference_points_ = reference_points;
+  lane_samples_lane_segments_ = lane_segments;
+}
+
+const PathBoundsDecider::LaneSample& PathBoundsDecider::GetLaneSample(
+    const ReferenceLineInfo& reference_line_info, const size_t idx,
+    const double s) {
+  if (idx >= lane_samples_.size()) {
+    lane_samples_.resize(idx + 1);
+  }
+  LaneSample& lane_sample = lane_samples_[idx];
+  if (lane_sample.is_taken && lane_sample.s == s) {
+    return lane_sample;
+  }
+
+  lane_sample = LaneSample();
+  lane_sample.is_taken = true;
+  lane_sample.s = s;
+  const ReferenceLine& reference_line = reference_line_info.reference_line();
+  lane_sample.has_lane_width = reference_line.GetLaneWidth(
+      s, &lane_sample.lane_left_width, &lane_sample.lane_right_width);
+  lane_sample.has_road_width = reference_line.GetRoadWidth(
+      s, &lane_sample.road_left_width, &lane_sample.road_right_width);
+  reference_line.GetOffsetToMap(s, &lane_sample.offset_to_map);
+  return lane_sample;
+}
+
+const PathBoundsDecider::LaneSample&
+PathBoundsDecider::GetLaneSampleWithNeighborLane(
+    const ReferenceLineInfo& reference_line_info, const size_t idx,
+    const double s, const LaneBorrowInfo& lane_borrow_info) {
+  const LaneSample& lane_sample = GetLaneSample(reference_line_info, idx, s);
+  if (lane_borrow_info == LaneBorrowInfo::NO_BORROW) {
+    return lane_sample;
+  }
+  const int side = lane_borrow_info == LaneBorrowInfo::LEFT_BORROW ? 0 : 1;
+  if (lane_sample.is_neighbor_lane_taken[side]) {
+    return lane_sample;
+  }
+
+  LaneSample& neighbor_lane_sample = lane_samples_[idx];
+  double curr_neighbor_lane_width = 0.0;
+  bool is_reverse_lane = false;
+  if (CheckLaneBoundaryType(reference_line_info, s, lane_borrow_info)) {
+    hdmap::Id neighbor_lane_id;
+    if (lane_borrow_info == LaneBorrowInfo::LEFT_BORROW) {
+      // Borrowing left neighbor lane.
+      if (reference_line_info.GetNeighborLaneInfo(
+              ReferenceLineInfo::LaneType::LeftForward, s, &neighbor_lane_id,
+              &curr_neighbor_lane_width)) {
+        ADEBUG << "Borrow left forward neighbor lane.";
+      } else if (reference_line_info.GetNeighborLaneInfo(
+                     ReferenceLineInfo::LaneType::LeftReverse, s,
+                     &neighbor_lane_id, &curr_neighbor_lane_width)) {
+        is_reverse_lane = true;
+        ADEBUG << "Borrow left reverse neighbor lane.";
+      } else {
+        ADEBUG << "There is no left neighbor lane.";
+      }
+    } else {
+      // Borrowing right neighbor lane.
+      if (reference_line_info.GetNeighborLaneInfo(
+              ReferenceLineInfo::LaneType::RightForward, s, &neighbor_lane_id,
+              &curr_neighbor_lane_width)) {
+        ADEBUG << "Borrow right forward neighbor lane.";
+      } else if (reference_line_info.GetNeighborLaneInfo(
+                     ReferenceLineInfo::LaneType::RightReverse, s,
+                     &neighbor_lane_id, &curr_neighbor_lane_width)) {
+        is_reverse_lane = true;
+        ADEBUG << "Borrow right reverse neighbor lane.";
+      } else {
+        ADEBUG << "There is no right neighbor lane.";
+      }
+    }
+  }
+  neighbor_lane_sample.is_neighbor_lane_taken[side] = true;
+  neighbor_lane_sample.neighbor_lane_width[side] = curr_neighbor_lane_width;
+  neighbor_lane_sample.is_neighbor_lane_reverse[side] = is_reverse_lane;
+  return neighbor_lane_sample;
+}
+
+const std::vector<ObstacleEdge>& PathBoundsDecider::GetSortedObstacles(
+    const PathDecision& path_decision) {
+  if (!has_sorted_obstacles_) {
+    sorted_obstacles_ = SortObstaclesForSweepLine(path_decision.obstacles());
+    has_sorted_obstacles_ = true;
+  }
+  return sorted_obstacles_;
+}
+
 void PathBoundsDecider::RecordDebugInfo(
     const PathBound& path_boundaries, const std::string& debug_name,
     ReferenceLineInfo* const reference_line_info) {
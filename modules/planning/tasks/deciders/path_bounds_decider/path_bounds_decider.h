@@ -29,6 +29,7 @@
 
 #include "gtest/gtest.h"
 
+#include "modules/map/pnc_map/path.h"
 #include "modules/planning/proto/planning_config.pb.h"
 
 #include "modules/planning/tasks/deciders/decider.h"
@@ -304,6 +305,51 @@ class PathBoundsDecider : public Decider {
                              const double check_s,
                              const LaneBorrowInfo& lane_borrow_info);
 
+  /////////////////////////////////////////////////////////////////////////////
+  // Below are the map queries shared by the path bounds generation.
+
+  /** @brief The map queries at a point of the path bounds. They only depend
+   *   on the reference line and the s of the point, so they are shared by
+   *   all path bounds generated in a frame, and kept for the next frame as
+   *   long as the reference line and the s are unchanged.
+   */
+  struct LaneSample {
+    bool is_taken = false;
+    double s = 0.0;
+    bool has_lane_width = false;
+    double lane_left_width = 0.0;
+    double lane_right_width = 0.0;
+    bool has_road_width = false;
+    double road_left_width = 0.0;
+    double road_right_width = 0.0;
+    double offset_to_map = 0.0;
+    // The neighbor lane to borrow, indexed by left and right borrow.
+    bool is_neighbor_lane_taken[2] = {false, false};
+    double neighbor_lane_width[2] = {0.0, 0.0};
+    bool is_neighbor_lane_reverse[2] = {false, false};
+  };
+
+  /** @brief Keep the lane samples of the previous frame only if they were
+   *   taken on the same reference line.
+   */
+  void UpdateLaneSamples(const ReferenceLine& reference_line);
+
+  /** @brief Get the lane sample of the path bound point at "idx", and take
+   *   it if it's not taken at "s" yet.
+   */
+  const LaneSample& GetLaneSample(const ReferenceLineInfo& reference_line_info,
+                                  const size_t idx, const double s);
+
+  /** @brief Get the lane sample of the path bound point at "idx" with the
+   *   neighbor lane to borrow.
+   */
+  const LaneSample& GetLaneSampleWithNeighborLane(
+      const ReferenceLineInfo& reference_line_info, const size_t idx,
+      const double s, const LaneBorrowInfo& lane_borrow_info);
+
+  const std::vector<std::tuple<int, double, double, double, std::string>>&
+  GetSortedObstacles(const PathDecision& path_decision);
+
   void RecordDebugInfo(
       const std::vector<std::tuple<double, double, double>>& path_boundaries,
       const std::string& debug_name,
@@ -317,8 +363,19 @@ class PathBoundsDecider : public Decider {
   double adc_l_to_lane_center_ = 0.0;
   double adc_lane_width_ = 0.0;
 
+  std::vector<LaneSample> lane_samples_;
+  // The reference line where the lane samples are taken.
+  std::vector<ReferencePoint> lane_samples_reference_points_;
+  std::vector<hdmap::LaneSegment> lane_samples_lane_segments_;
+
+  // The static obstacle edges of the current frame.
+  bool has_sorted_obstacles_ = false;
+  std::vector<std::tuple<int, double, double, double, std::string>>
+      sorted_obstacles_;
+
   FRIEND_TEST(PathBoundsDeciderTest, InitPathBoundary);
   FRIEND_TEST(PathBoundsDeciderTest, GetBoundaryFromLanesAndADC);
+  FRIEND_TEST(PathBoundsDeciderTest, ReuseLaneSamples);
 };
 
 }  // namespace planning
@@ -21,6 +21,8 @@
 #include "modules/planning/tasks/deciders/path_bounds_decider/path_bounds_decider.h"
 
 #include "gtest/gtest.h"
+#include "modules/common/configs/config_gflags.h"
+#include "modules/map/hdmap/hdmap_util.h"
 #include "modules/planning/proto/planning_config.pb.h"
 
 namespace apollo {
@@ -72,5 +74,63 @@ TEST_F(PathBoundsDeciderTest, GetBoundaryFromStaticObstacles) {
   PathDecision path_decision;
 }
 
+TEST_F(PathBoundsDeciderTest, ReuseLaneSamples) {
+  FLAGS_map_dir = "modules/planning/testdata/garage_map";
+  FLAGS_base_map_filename = "base_map.txt";
+  const auto* hdmap = hdmap::HDMapUtil::BaseMapPtr();
+  ASSERT_NE(nullptr, hdmap);
+  const auto lane_info = hdmap->GetLaneById(hdmap::MakeMapId("1_-1"));
+  ASSERT_NE(nullptr, lane_info);
+  std::vector<ReferencePoint> ref_points;
+  for (size_t i = 0; i < lane_info->points().size(); ++i) {
+    std::vector<hdmap::LaneWaypoint> waypoint;
+    waypoint.emplace_back(lane_info, lane_info->accumulate_s()[i]);
+    hdmap::MapPathPoint map_path_point(lane_info->points()[i],
+                                       lane_info->headings()[i], waypoint);
+    ref_points.emplace_back(map_path_point, 0.0, 0.0);
+  }
+  ReferenceLine reference_line(ref_points);
+  ReferenceLineInfo reference_line_info(common::VehicleState(),
+                                        common::TrajectoryPoint(),
+                                        reference_line, hdmap::RouteSegments());
+
+  // The path bounds from the lane samples kept across frames are the same as
+  // the ones rebuilt from scratch, also after the ADC moves.
+  PathBoundsDecider path_bounds_decider(config_, injector_);
+  for (const double adc_frenet_s : {10.0, 10.0, 12.3, 12.3}) {
+    path_bounds_decider.adc_frenet_s_ = adc_frenet_s;
+    path_bounds_decider.adc_lane_width_ = kDefaultLaneWidth;
+    path_bounds_decider.UpdateLaneSamples(reference_line);
+    for (const auto lane_borrow_info :
+         {PathBoundsDecider::LaneBorrowInfo::NO_BORROW,
+          PathBoundsDecider::LaneBorrowInfo::LEFT_BORROW,
+          PathBoundsDecider::LaneBorrowInfo::RIGHT_BORROW}) {
+      for (const double adc_buffer : {0.1, 0.5}) {
+        std::vector<std::tuple<double, double, double>> path_bound;
+        std::string borrow_lane_type;
+        ASSERT_TRUE(path_bounds_decider.InitPathBoundary(reference_line_info,
+                                                         &path_bound));
+        ASSERT_TRUE(path_bounds_decider.GetBoundaryFromLanesAndADC(
+            reference_line_info, lane_borrow_info, adc_buffer, &path_bound,
+            &borrow_lane_type));
+
+        PathBoundsDecider rebuilt_path_bounds_decider(config_, injector_);
+        rebuilt_path_bounds_decider.adc_frenet_s_ = adc_frenet_s;
+        rebuilt_path_bounds_decider.adc_lane_width_ = kDefaultLaneWidth;
+        std::vector<std::tuple<double, double, double>> rebuilt_path_bound;
+        std::string rebuilt_borrow_lane_type;
+        ASSERT_TRUE(rebuilt_path_bounds_decider.InitPathBoundary(
+            reference_line_info, &rebuilt_path_bound));
+        ASSERT_TRUE(rebuilt_path_bounds_decider.GetBoundaryFromLanesAndADC(
+            reference_line_info, lane_borrow_info, adc_buffer,
+            &rebuilt_path_bound, &rebuilt_borrow_lane_type));
+
+        EXPECT_EQ(rebuilt_path_bound, path_bound);
+        EXPECT_EQ(rebuilt_borrow_lane_type, borrow_lane_type);
+      }
+    }
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
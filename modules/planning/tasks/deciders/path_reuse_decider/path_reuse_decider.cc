@@ -34,9 +34,8 @@ using apollo::common::Status;
 using apollo::common::math::Polygon2d;
 using apollo::common::math::Vec2d;
 
-int PathReuseDecider::reusable_path_counter_ = 0;
-int PathReuseDecider::total_path_counter_ = 0;
-bool PathReuseDecider::path_reusable_ = false;
+std::atomic<int> PathReuseDecider::reusable_path_counter_(0);
+std::atomic<int> PathReuseDecider::total_path_counter_(0);
 
 PathReuseDecider::PathReuseDecider(
     const TaskConfig& config,
@@ -112,8 +111,7 @@ Status PathReuseDecider::Process(Frame* const frame,
   bool speed_optimization_successful = false;
   const auto& history_frame = injector_->frame_history()->Latest();
   if (history_frame) {
-    const auto history_trajectory_type =
-        history_frame->reference_line_info().front().trajectory_type();
+    const auto history_trajectory_type = history_frame->trajectory_type();
     speed_optimization_successful =
         (history_trajectory_type != ADCTrajectory::SPEED_FALLBACK);
   }
@@ -123,7 +121,13 @@ Status PathReuseDecider::Process(Frame* const frame,
   //                                          ->reference_line_info()
   //                                          .front()
   //                                          .trajectory_type();
-  if (path_reusable_) {
+  // kept in planning context, so that reference lines planned in parallel
+  // each see the value of the last cycle
+  auto* mutable_path_decider_status = injector_->planning_context()
+                                          ->mutable_planning_status()
+                                          ->mutable_path_decider();
+  bool path_reusable = mutable_path_decider_status->is_path_reusable();
+  if (path_reusable) {
     if (!frame->current_frame_planned_trajectory().is_replan() &&
         speed_optimization_successful && IsCollisionFree(reference_line_info) &&
         TrimHistoryPath(frame, reference_line_info)) {
@@ -132,13 +136,10 @@ Status PathReuseDecider::Process(Frame* const frame,
     } else {
       // stop reuse path
       ADEBUG << "stop reuse path";
-      path_reusable_ = false;
+      path_reusable = false;
     }
   } else {
     // F -> T
-    auto* mutable_path_decider_status = injector_->planning_context()
-                                            ->mutable_planning_status()
-                                            ->mutable_path_decider();
     static constexpr int kWaitCycle = -2;  // wait 2 cycle
 
     const int front_static_obstacle_cycle_counter =
@@ -157,12 +158,13 @@ Status PathReuseDecider::Process(Frame* const frame,
         TrimHistoryPath(frame, reference_line_info)) {
       // enable reuse path
       ADEBUG << "reuse path: front_blocking_obstacle ignorable";
-      path_reusable_ = true;
+      path_reusable = true;
       ++reusable_path_counter_;
     }
   }
 
-  reference_line_info->set_path_reusable(path_reusable_);
+  mutable_path_decider_status->set_is_path_reusable(path_reusable);
+  reference_line_info->set_path_reusable(path_reusable);
   ADEBUG << "reusable_path_counter[" << reusable_path_counter_
          << "] total_path_counter[" << total_path_counter_ << "]";
   return Status::OK();
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -73,9 +74,8 @@ class PathReuseDecider : public Decider {
                        ReferenceLineInfo* const reference_line_info);
 
  private:
-  static int reusable_path_counter_;  // count reused path
-  static int total_path_counter_;     // count total path
-  static bool path_reusable_;
+  static std::atomic<int> reusable_path_counter_;  // count reused path
+  static std::atomic<int> total_path_counter_;     // count total path
 };
 
 }  // namespace planning
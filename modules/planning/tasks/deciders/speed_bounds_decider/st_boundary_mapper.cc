@@ -26,6 +26,7 @@
 #include <utility>
 
 #include "cyber/common/log.h"
+#include "cyber/task/task.h"
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/vec2d.h"
@@ -44,9 +45,29 @@ namespace planning {
 using apollo::common::ErrorCode;
 using apollo::common::PathPoint;
 using apollo::common::Status;
+using apollo::common::math::AABox2d;
+using apollo::common::math::AABoxKDTreeParams;
 using apollo::common::math::Box2d;
+using apollo::common::math::LineSegment2d;
 using apollo::common::math::Vec2d;
 
+namespace {
+// the number of the path points sampled for the moving obstacles
+constexpr int kDefaultNumPoint = 50;
+// margin of the path segment search against the rounding of the path points
+constexpr double kPathSearchMargin = 0.01;
+
+bool IsInSRanges(const std::vector<std::pair<double, double>>& s_ranges,
+                 const double s) {
+  auto it = std::upper_bound(
+      s_ranges.begin(), s_ranges.end(), s,
+      [](const double s, const std::pair<double, double>& s_range) {
+        return s < s_range.first;
+      });
+  return it != s_ranges.begin() && s <= std::prev(it)->second;
+}
+}  // namespace
+
 STBoundaryMapper::STBoundaryMapper(
     const SpeedBoundsDeciderConfig& config, const ReferenceLine& reference_line,
     const PathData& path_data, const double planning_distance,
@@ -58,7 +79,55 @@ STBoundaryMapper::STBoundaryMapper(
       vehicle_param_(common::VehicleConfigHelper::GetConfig().vehicle_param()),
       planning_max_distance_(planning_distance),
       planning_max_time_(planning_time),
-      injector_(injector) {}
+      injector_(injector) {
+  InitSampledPath();
+}
+
+void STBoundaryMapper::InitSampledPath() {
+  const auto& path_points = path_data_.discretized_path();
+  if (path_points.empty()) {
+    return;
+  }
+  // Subsample to reduce computation time.
+  if (path_points.size() > 2 * kDefaultNumPoint) {
+    const auto ratio = path_points.size() / kDefaultNumPoint;
+    std::vector<PathPoint> sampled_path_points;
+    for (size_t i = 0; i < path_points.size(); ++i) {
+      if (i % ratio == 0) {
+        sampled_path_points.push_back(path_points[i]);
+      }
+    }
+    sampled_path_ = DiscretizedPath(std::move(sampled_path_points));
+  } else {
+    sampled_path_ = DiscretizedPath(path_points);
+  }
+
+  for (size_t i = 0; i < sampled_path_.size(); ++i) {
+    const size_t next = std::min(i + 1, sampled_path_.size() - 1);
+    if (next == i && i > 0) {
+      break;
+    }
+    sampled_path_segments_.emplace_back(
+        Vec2d(sampled_path_[i].x(), sampled_path_[i].y()),
+        Vec2d(sampled_path_[next].x(), sampled_path_[next].y()));
+  }
+  for (size_t i = 0; i < sampled_path_segments_.size(); ++i) {
+    const auto& segment = sampled_path_segments_[i];
+    AABox2d aabox(segment.start(), segment.end());
+    if (i == 0) {
+      sampled_path_aabox_ = aabox;
+    } else {
+      sampled_path_aabox_.MergeFrom(aabox);
+    }
+    sampled_path_segment_boxes_.emplace_back(aabox, &sampled_path_[i], &segment,
+                                             static_cast<int>(i));
+  }
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;  // meters.
+  params.max_leaf_size = 16;
+  sampled_path_kdtree_.reset(
+      new PathSegmentKDTree(sampled_path_segment_boxes_, params));
+}
 
 Status STBoundaryMapper::ComputeSTBoundary(PathDecision* path_decision) const {
   // Sanity checks.
@@ -71,17 +140,28 @@ Status STBoundaryMapper::ComputeSTBoundary(PathDecision* path_decision) const {
                   "Fail to get params because of too few path points");
   }
 
+  // The lateral buffer is read here, as the planning status may be local to
+  // the calling thread.
+  const auto* planning_status = injector_->planning_context()
+                                    ->mutable_planning_status()
+                                    ->mutable_change_lane();
+  const double l_buffer =
+      planning_status->status() == ChangeLaneStatus::IN_CHANGE_LANE
+          ? FLAGS_lane_change_obstacle_nudge_l_buffer
+          : FLAGS_nonstatic_obstacle_nudge_l_buffer;
+
   // Go through every obstacle.
   Obstacle* stop_obstacle = nullptr;
   ObjectDecisionType stop_decision;
   double min_stop_s = std::numeric_limits<double>::max();
+  std::vector<Obstacle*> obstacles_to_map;
   for (const auto* ptr_obstacle_item : path_decision->obstacles().Items()) {
     Obstacle* ptr_obstacle = path_decision->Find(ptr_obstacle_item->Id());
     ACHECK(ptr_obstacle != nullptr);
 
     // If no longitudinal decision has been made, then plot it onto ST-graph.
     if (!ptr_obstacle->HasLongitudinalDecision()) {
-      ComputeSTBoundary(ptr_obstacle);
+      obstacles_to_map.push_back(ptr_obstacle);
       continue;
     }
 
@@ -103,12 +183,28 @@ Status STBoundaryMapper::ComputeSTBoundary(PathDecision* path_decision) const {
                decision.has_yield()) {
       // 2. Depending on the longitudinal overtake/yield decision,
       //    fine-tune the upper/lower st-boundary of related obstacles.
-      ComputeSTBoundaryWithDecision(ptr_obstacle, decision);
+      obstacles_to_map.push_back(ptr_obstacle);
     } else if (!decision.has_ignore()) {
       // 3. Ignore those unrelated obstacles.
       AWARN << "No mapping for decision: " << decision.DebugString();
     }
   }
+
+  if (FLAGS_enable_multi_thread_in_st_boundary_mapper) {
+    std::vector<std::future<void>> results;
+    for (auto* obstacle : obstacles_to_map) {
+      results.push_back(cyber::Async(&STBoundaryMapper::MapObstacle, this,
+                                     obstacle, l_buffer));
+    }
+    for (auto& result : results) {
+      result.get();
+    }
+  } else {
+    for (auto* obstacle : obstacles_to_map) {
+      MapObstacle(obstacle, l_buffer);
+    }
+  }
+
   if (stop_obstacle) {
     bool success = MapStopDecision(stop_obstacle, stop_decision);
     if (!success) {
@@ -160,15 +256,26 @@ bool STBoundaryMapper::MapStopDecision(
   return true;
 }
 
-void STBoundaryMapper::ComputeSTBoundary(Obstacle* obstacle) const {
+void STBoundaryMapper::MapObstacle(Obstacle* obstacle,
+                                   const double l_buffer) const {
+  if (!obstacle->HasLongitudinalDecision()) {
+    ComputeSTBoundary(obstacle, l_buffer);
+  } else {
+    ComputeSTBoundaryWithDecision(obstacle, obstacle->LongitudinalDecision(),
+                                  l_buffer);
+  }
+}
+
+void STBoundaryMapper::ComputeSTBoundary(Obstacle* obstacle,
+                                         const double l_buffer) const {
   if (FLAGS_use_st_drivable_boundary) {
     return;
   }
   std::vector<STPoint> lower_points;
   std::vector<STPoint> upper_points;
 
-  if (!GetOverlapBoundaryPoints(path_data_.discretized_path(), *obstacle,
-                                &upper_points, &lower_points)) {
+  if (!GetOverlapBoundaryPoints(*obstacle, l_buffer, &upper_points,
+                                &lower_points)) {
     return;
   }
 
@@ -188,26 +295,22 @@ void STBoundaryMapper::ComputeSTBoundary(Obstacle* obstacle) const {
 }
 
 bool STBoundaryMapper::GetOverlapBoundaryPoints(
-    const std::vector<PathPoint>& path_points, const Obstacle& obstacle,
+    const Obstacle& obstacle, const double l_buffer,
     std::vector<STPoint>* upper_points,
     std::vector<STPoint>* lower_points) const {
   // Sanity checks.
   DCHECK(upper_points->empty());
   DCHECK(lower_points->empty());
+  const auto& path_points = path_data_.discretized_path();
   DCHECK_GT(path_points.size(), 0);
   if (path_points.empty()) {
     AERROR << "No points in path_data_.discretized_path().";
     return false;
   }
 
-  const auto* planning_status = injector_->planning_context()
-                                    ->mutable_planning_status()
-                                    ->mutable_change_lane();
-
-  double l_buffer =
-      planning_status->status() == ChangeLaneStatus::IN_CHANGE_LANE
-          ? FLAGS_lane_change_obstacle_nudge_l_buffer
-          : FLAGS_nonstatic_obstacle_nudge_l_buffer;
+  // The ADC box of a path point farther than this from the center of an
+  // obstacle box does not overlap the obstacle box.
+  const double adc_box_radius = GetADCBoxRadius(l_buffer);
 
   // Draw the given obstacle on the ST-graph.
   const auto& trajectory = obstacle.Trajectory();
@@ -219,12 +322,19 @@ bool STBoundaryMapper::GetOverlapBoundaryPoints(
             << "] has NO prediction trajectory."
             << obstacle.Perception().ShortDebugString();
     }
+    const Box2d& obs_box = obstacle.PerceptionBoundingBox();
+    const double max_distance =
+        adc_box_radius + obs_box.diagonal() * 0.5 + kPathSearchMargin;
     for (const auto& curr_point_on_path : path_points) {
       if (curr_point_on_path.s() > planning_max_distance_) {
         break;
       }
+      if (obs_box.center().DistanceTo(Vec2d(curr_point_on_path.x(),
+                                            curr_point_on_path.y())) >
+          max_distance) {
+        continue;
+      }
 
-      const Box2d& obs_box = obstacle.PerceptionBoundingBox();
       if (CheckOverlap(curr_point_on_path, obs_box, l_buffer)) {
         // If there is overlapping, then plot it on ST-graph.
         const double backward_distance = -vehicle_param_.front_edge_to_center();
@@ -245,37 +355,69 @@ bool STBoundaryMapper::GetOverlapBoundaryPoints(
     }
   } else {
     // For those with predicted trajectories (moving obstacles):
-    // 1. Subsample to reduce computation time.
-    const int default_num_point = 50;
-    DiscretizedPath discretized_path;
-    if (path_points.size() > 2 * default_num_point) {
-      const auto ratio = path_points.size() / default_num_point;
-      std::vector<PathPoint> sampled_path_points;
-      for (size_t i = 0; i < path_points.size(); ++i) {
-        if (i % ratio == 0) {
-          sampled_path_points.push_back(path_points[i]);
-        }
+    // 1. Use the path subsampled to reduce computation time.
+    const DiscretizedPath& discretized_path = sampled_path_;
+    static constexpr double kNegtiveTimeThreshold = -1.0;
+
+    // Reject the obstacle early if its whole trajectory stays away from the
+    // path.
+    std::vector<Vec2d> trajectory_xy;
+    for (const auto& trajectory_point : trajectory.trajectory_point()) {
+      if (trajectory_point.relative_time() >= kNegtiveTimeThreshold) {
+        trajectory_xy.emplace_back(trajectory_point.path_point().x(),
+                                   trajectory_point.path_point().y());
       }
-      discretized_path = DiscretizedPath(std::move(sampled_path_points));
-    } else {
-      discretized_path = DiscretizedPath(path_points);
     }
+    if (trajectory_xy.empty()) {
+      return false;
+    }
+    const AABox2d trajectory_aabox(trajectory_xy);
+    const double trajectory_margin =
+        adc_box_radius +
+        std::hypot(obstacle.Perception().length(),
+                   obstacle.Perception().width()) *
+            0.5 +
+        kPathSearchMargin;
+    if (!sampled_path_aabox_.HasOverlap(
+            AABox2d(trajectory_aabox.center(),
+                    trajectory_aabox.length() + 2.0 * trajectory_margin,
+                    trajectory_aabox.width() + 2.0 * trajectory_margin))) {
+      return false;
+    }
+
+    // Query s clamped onto the path, since Evaluate clamps it likewise.
+    const double path_front_s = discretized_path.front().s();
+    const double path_back_s = discretized_path.back().s();
+    std::vector<std::pair<double, double>> s_ranges;
+    auto may_overlap = [&](const double query_s) {
+      return IsInSRanges(
+          s_ranges, std::fmin(std::fmax(query_s, path_front_s), path_back_s));
+    };
+
     // 2. Go through every point of the predicted obstacle trajectory.
     for (int i = 0; i < trajectory.trajectory_point_size(); ++i) {
       const auto& trajectory_point = trajectory.trajectory_point(i);
       const Box2d obs_box = obstacle.GetBoundingBox(trajectory_point);
 
       double trajectory_point_time = trajectory_point.relative_time();
-      static constexpr double kNegtiveTimeThreshold = -1.0;
       if (trajectory_point_time < kNegtiveTimeThreshold) {
         continue;
       }
 
+      // Only the path near the obstacle box is checked.
+      GetCandidateSRanges(obs_box, adc_box_radius, &s_ranges);
+      if (s_ranges.empty()) {
+        continue;
+      }
+
       const double step_length = vehicle_param_.front_edge_to_center();
       auto path_len =
           std::min(FLAGS_max_trajectory_len, discretized_path.Length());
       // Go through every point of the ADC's path.
       for (double path_s = 0.0; path_s < path_len; path_s += step_length) {
+        if (!may_overlap(path_s + discretized_path.front().s())) {
+          continue;
+        }
         const auto curr_adc_path_point =
             discretized_path.Evaluate(path_s + discretized_path.front().s());
         if (CheckOverlap(curr_adc_path_point, obs_box, l_buffer)) {
@@ -286,7 +428,7 @@ bool STBoundaryMapper::GetOverlapBoundaryPoints(
                                           obs_box.length() + obs_box.width();
           const double default_min_step = 0.1;  // in meters
           const double fine_tuning_step_length = std::fmin(
-              default_min_step, discretized_path.Length() / default_num_point);
+              default_min_step, discretized_path.Length() / kDefaultNumPoint);
 
           bool find_low = false;
           bool find_high = false;
@@ -301,18 +443,20 @@ bool STBoundaryMapper::GetOverlapBoundaryPoints(
               break;
             }
             if (!find_low) {
-              const auto& point_low = discretized_path.Evaluate(
-                  low_s + discretized_path.front().s());
-              if (!CheckOverlap(point_low, obs_box, l_buffer)) {
+              const double query_s = low_s + discretized_path.front().s();
+              if (!may_overlap(query_s) ||
+                  !CheckOverlap(discretized_path.Evaluate(query_s), obs_box,
+                                l_buffer)) {
                 low_s += fine_tuning_step_length;
               } else {
                 find_low = true;
               }
             }
             if (!find_high) {
-              const auto& point_high = discretized_path.Evaluate(
-                  high_s + discretized_path.front().s());
-              if (!CheckOverlap(point_high, obs_box, l_buffer)) {
+              const double query_s = high_s + discretized_path.front().s();
+              if (!may_overlap(query_s) ||
+                  !CheckOverlap(discretized_path.Evaluate(query_s), obs_box,
+                                l_buffer)) {
                 high_s -= fine_tuning_step_length;
               } else {
                 find_high = true;
@@ -339,7 +483,8 @@ bool STBoundaryMapper::GetOverlapBoundaryPoints(
 }
 
 void STBoundaryMapper::ComputeSTBoundaryWithDecision(
-    Obstacle* obstacle, const ObjectDecisionType& decision) const {
+    Obstacle* obstacle, const ObjectDecisionType& decision,
+    const double l_buffer) const {
   DCHECK(decision.has_follow() || decision.has_yield() ||
          decision.has_overtake())
       << "decision is " << decision.DebugString()
@@ -354,8 +499,8 @@ void STBoundaryMapper::ComputeSTBoundaryWithDecision(
     lower_points = path_st_boundary.lower_points();
     upper_points = path_st_boundary.upper_points();
   } else {
-    if (!GetOverlapBoundaryPoints(path_data_.discretized_path(), *obstacle,
-                                  &upper_points, &lower_points)) {
+    if (!GetOverlapBoundaryPoints(*obstacle, l_buffer, &upper_points,
+                                  &lower_points)) {
       return;
     }
   }
@@ -386,6 +531,47 @@ void STBoundaryMapper::ComputeSTBoundaryWithDecision(
   obstacle->set_path_st_boundary(boundary);
 }
 
+double STBoundaryMapper::GetADCBoxRadius(const double l_buffer) const {
+  const double center_offset = std::hypot(
+      (vehicle_param_.front_edge_to_center() -
+       vehicle_param_.back_edge_to_center()) *
+          0.5,
+      (vehicle_param_.left_edge_to_center() -
+       vehicle_param_.right_edge_to_center()) *
+          0.5);
+  return center_offset + std::hypot(vehicle_param_.length() * 0.5,
+                                    vehicle_param_.width() * 0.5 + l_buffer);
+}
+
+void STBoundaryMapper::GetCandidateSRanges(
+    const Box2d& obs_box, const double adc_box_radius,
+    std::vector<std::pair<double, double>>* s_ranges) const {
+  s_ranges->clear();
+  if (sampled_path_kdtree_ == nullptr) {
+    return;
+  }
+  const auto segment_boxes = sampled_path_kdtree_->GetObjects(
+      obs_box.center(),
+      adc_box_radius + obs_box.diagonal() * 0.5 + kPathSearchMargin);
+  std::vector<int> segment_ids;
+  segment_ids.reserve(segment_boxes.size());
+  for (const auto* segment_box : segment_boxes) {
+    segment_ids.push_back(segment_box->id());
+  }
+  std::sort(segment_ids.begin(), segment_ids.end());
+  for (const int id : segment_ids) {
+    const size_t next = std::min(static_cast<size_t>(id) + 1,
+                                 sampled_path_.size() - 1);
+    const double start_s = sampled_path_[id].s();
+    const double end_s = sampled_path_[next].s();
+    if (!s_ranges->empty() && s_ranges->back().second >= start_s) {
+      s_ranges->back().second = std::fmax(s_ranges->back().second, end_s);
+    } else {
+      s_ranges->emplace_back(start_s, end_s);
+    }
+  }
+}
+
 bool STBoundaryMapper::CheckOverlap(const PathPoint& path_point,
                                     const Box2d& obs_box,
                                     const double l_buffer) const {
@@ -22,12 +22,18 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/line_segment2d.h"
 #include "modules/common/status/status.h"
+#include "modules/map/hdmap/hdmap_common.h"
 #include "modules/planning/common/dependency_injector.h"
 #include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/path/discretized_path.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/st_boundary.h"
@@ -52,21 +58,50 @@ class STBoundaryMapper {
 
  private:
   FRIEND_TEST(StBoundaryMapperTest, check_overlap_test);
+  FRIEND_TEST(StBoundaryMapperTest, candidate_s_ranges_test);
+
+  using PathSegmentBox =
+      hdmap::ObjectWithAABox<common::PathPoint, common::math::LineSegment2d>;
+  using PathSegmentKDTree = common::math::AABoxKDTree2d<PathSegmentBox>;
+
+  /** @brief Subsample the path for the moving obstacles and index its
+   * segments by a KD-tree, once for all the obstacles.
+   */
+  void InitSampledPath();
+
+  /** @brief Maps an obstacle without a longitudinal decision, or fine-tunes
+   * the boundary of one with a follow, overtake or yield decision. It only
+   * modifies the given obstacle, so obstacles can be mapped concurrently.
+   */
+  void MapObstacle(Obstacle* obstacle, const double l_buffer) const;
 
   /** @brief Calls GetOverlapBoundaryPoints to get upper and lower points
    * for a given obstacle, and then formulate STBoundary based on that.
    * It also labels boundary type based on previously documented decisions.
    */
-  void ComputeSTBoundary(Obstacle* obstacle) const;
+  void ComputeSTBoundary(Obstacle* obstacle, const double l_buffer) const;
 
   /** @brief Map the given obstacle onto the ST-Graph. The boundary is
    * represented as upper and lower points for every s of interests.
    * Note that upper_points.size() = lower_points.size()
    */
-  bool GetOverlapBoundaryPoints(
-      const std::vector<common::PathPoint>& path_points,
-      const Obstacle& obstacle, std::vector<STPoint>* upper_points,
-      std::vector<STPoint>* lower_points) const;
+  bool GetOverlapBoundaryPoints(const Obstacle& obstacle,
+                                const double l_buffer,
+                                std::vector<STPoint>* upper_points,
+                                std::vector<STPoint>* lower_points) const;
+
+  /** @brief The radius around the path point within which the ADC bounding
+   * box of CheckOverlap lies.
+   */
+  double GetADCBoxRadius(const double l_buffer) const;
+
+  /** @brief Get the sorted ranges of the sampled path s, outside of which the
+   * ADC does not overlap the obstacle box. The ranges are looked up from the
+   * path segments near the box.
+   */
+  void GetCandidateSRanges(
+      const common::math::Box2d& obs_box, const double adc_box_radius,
+      std::vector<std::pair<double, double>>* s_ranges) const;
 
   /** @brief Given a path-point and an obstacle bounding box, check if the
    *        ADC, when at that path-point, will collide with the obstacle.
@@ -90,7 +125,8 @@ class STBoundaryMapper {
    * when necessary.
    */
   void ComputeSTBoundaryWithDecision(Obstacle* obstacle,
-                                     const ObjectDecisionType& decision) const;
+                                     const ObjectDecisionType& decision,
+                                     const double l_buffer) const;
 
  private:
   const SpeedBoundsDeciderConfig& speed_bounds_config_;
@@ -100,6 +136,13 @@ class STBoundaryMapper {
   const double planning_max_distance_;
   const double planning_max_time_;
   std::shared_ptr<DependencyInjector> injector_;
+
+  // the path subsampled for the moving obstacles, and its segments
+  DiscretizedPath sampled_path_;
+  std::vector<common::math::LineSegment2d> sampled_path_segments_;
+  std::vector<PathSegmentBox> sampled_path_segment_boxes_;
+  std::unique_ptr<PathSegmentKDTree> sampled_path_kdtree_;
+  common::math::AABox2d sampled_path_aabox_;
 };
 
 }  // namespace planning
@@ -91,5 +91,42 @@ TEST_F(StBoundaryMapperTest, check_overlap_test) {
   EXPECT_TRUE(mapper.CheckOverlap(path_point, box, 0.0));
 }
 
+TEST_F(StBoundaryMapperTest, candidate_s_ranges_test) {
+  SpeedBoundsDeciderConfig config;
+  double planning_distance = 70.0;
+  double planning_time = 10.0;
+  STBoundaryMapper mapper(config, *reference_line_, path_data_,
+                          planning_distance, planning_time, injector_);
+  const auto& path_points = path_data_.discretized_path();
+  ASSERT_FALSE(path_points.empty());
+  const double adc_box_radius = mapper.GetADCBoxRadius(0.0);
+
+  // Every path point overlapping the box is covered by the candidates.
+  const auto& path_point = path_points[path_points.size() / 2];
+  common::math::Box2d box(
+      common::math::Vec2d(path_point.x() + 2.0, path_point.y() + 1.0),
+      path_point.theta(), 4.0, 2.0);
+  std::vector<std::pair<double, double>> s_ranges;
+  mapper.GetCandidateSRanges(box, adc_box_radius, &s_ranges);
+  ASSERT_FALSE(s_ranges.empty());
+  for (const auto& point : path_points) {
+    if (!mapper.CheckOverlap(point, box, 0.0)) {
+      continue;
+    }
+    bool covered = false;
+    for (const auto& s_range : s_ranges) {
+      covered |= s_range.first <= point.s() && point.s() <= s_range.second;
+    }
+    EXPECT_TRUE(covered) << "path point at s = " << point.s();
+  }
+
+  // The path far away from the box is not a candidate.
+  common::math::Box2d far_box(
+      common::math::Vec2d(path_point.x() + 1000.0, path_point.y()), 0.0, 4.0,
+      2.0);
+  mapper.GetCandidateSRanges(far_box, adc_box_radius, &s_ranges);
+  EXPECT_TRUE(s_ranges.empty());
+}
+
 }  // namespace planning
 }  // namespace apollo
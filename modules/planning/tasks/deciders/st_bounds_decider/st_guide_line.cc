@@ -47,6 +47,7 @@ void STGuideLine::Init(
         trajectory_point.path_point().s(), trajectory_point.relative_time(),
         trajectory_point.v(), trajectory_point.a(), trajectory_point.da());
   }
+  guideline_speed_data_.BuildLookupIndex();
 }
 
 double STGuideLine::GetGuideSFromT(double t) {
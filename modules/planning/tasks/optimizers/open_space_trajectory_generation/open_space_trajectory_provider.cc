@@ -27,6 +27,7 @@
 #include "modules/common/vehicle_state/proto/vehicle_state.pb.h"
 #include "modules/planning/common/planning_context.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
 #include "modules/planning/common/trajectory_stitcher.h"
 
@@ -254,6 +255,9 @@ Status OpenSpaceTrajectoryProvider::Process() {
 }
 
 void OpenSpaceTrajectoryProvider::GenerateTrajectoryThread() {
+  // runs alongside the planning cycles, which its spans are not part of
+  PlanningProfiler::ScopedThreadRoot profiler_root(
+      "OpenSpaceTrajectoryProvider");
   while (!is_generation_thread_stop_) {
     if (!trajectory_updated_ && data_ready_) {
       OpenSpaceTrajectoryThreadData thread_data;
@@ -414,13 +418,15 @@ void OpenSpaceTrajectoryProvider::LoadResult(
 }
 
 void OpenSpaceTrajectoryProvider::ReuseLastFrameResult(
-    const Frame* last_frame, DiscretizedTrajectory* const trajectory_data) {
+    const FrameSnapshot* last_frame,
+    DiscretizedTrajectory* const trajectory_data) {
   *(trajectory_data) =
       last_frame->open_space_info().stitched_trajectory_result();
   frame_->mutable_open_space_info()->set_open_space_provider_success(true);
 }
 
-void OpenSpaceTrajectoryProvider::ReuseLastFrameDebug(const Frame* last_frame) {
+void OpenSpaceTrajectoryProvider::ReuseLastFrameDebug(
+    const FrameSnapshot* last_frame) {
   // reuse last frame's instance
   auto* ptr_debug = frame_->mutable_open_space_info()->mutable_debug_instance();
   ptr_debug->mutable_planning_data()->mutable_open_space()->MergeFrom(
@@ -74,10 +74,10 @@ class OpenSpaceTrajectoryProvider : public TrajectoryOptimizer {
 
   void LoadResult(DiscretizedTrajectory* const trajectory_data);
 
-  void ReuseLastFrameResult(const Frame* last_frame,
+  void ReuseLastFrameResult(const FrameSnapshot* last_frame,
                             DiscretizedTrajectory* const trajectory_data);
 
-  void ReuseLastFrameDebug(const Frame* last_frame);
+  void ReuseLastFrameDebug(const FrameSnapshot* last_frame);
 
  private:
   bool thread_init_flag_ = false;
@@ -31,7 +31,12 @@ namespace apollo {
 namespace planning {
 namespace {
 constexpr double kInf = std::numeric_limits<double>::infinity();
-}
+// resolution and offset of the keys of the cached accel and jerk costs
+constexpr double kAccelEpsilon = 0.1;
+constexpr size_t kAccelShift = 100;
+constexpr double kJerkEpsilon = 0.1;
+constexpr size_t kJerkShift = 200;
+}  // namespace
 
 DpStCost::DpStCost(const DpStSpeedOptimizerConfig& config, const double total_t,
                    const double total_s,
@@ -44,22 +49,17 @@ DpStCost::DpStCost(const DpStSpeedOptimizerConfig& config, const double total_t,
       init_point_(init_point),
       unit_t_(config.unit_t()),
       total_s_(total_s) {
-  int index = 0;
-  for (const auto& obstacle : obstacles) {
-    boundary_map_[obstacle->path_st_boundary().id()] = index++;
-  }
-
   AddToKeepClearRange(obstacles);
 
   const auto dimension_t =
       static_cast<uint32_t>(std::ceil(total_t / static_cast<double>(unit_t_))) +
       1;
-  boundary_cost_.resize(obstacles_.size());
-  for (auto& vec : boundary_cost_) {
-    vec.resize(dimension_t, std::make_pair(-1.0, -1.0));
-  }
-  accel_cost_.fill(-1.0);
-  jerk_cost_.fill(-1.0);
+  boundary_slices_.reserve(dimension_t);
+
+  // The costs are filled up front rather than on the first query, so that
+  // they are read only and do not depend on the order of the queries.
+  InitAccelCost();
+  InitJerkCost();
 }
 
 void DpStCost::AddToKeepClearRange(
@@ -110,23 +110,19 @@ bool DpStCost::InKeepClearRange(double s) const {
   return false;
 }
 
-double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
-  const double s = st_graph_point.point().s();
-  const double t = st_graph_point.point().t();
-
-  double cost = 0.0;
+void DpStCost::RasterizeBoundaries(const std::vector<double>& column_t) {
+  column_t_ = column_t;
+  boundary_slices_.assign(column_t.size(), std::vector<BoundarySlice>());
 
+  drivable_s_range_.clear();
   if (FLAGS_use_st_drivable_boundary) {
     // TODO(Jiancheng): move to configs
     static constexpr double boundary_resolution = 0.1;
-    int index = static_cast<int>(t / boundary_resolution);
-    const double lower_bound =
-        st_drivable_boundary_.st_boundary(index).s_lower();
-    const double upper_bound =
-        st_drivable_boundary_.st_boundary(index).s_upper();
-
-    if (s > upper_bound || s < lower_bound) {
-      return kInf;
+    for (const double t : column_t) {
+      int index = static_cast<int>(t / boundary_resolution);
+      drivable_s_range_.emplace_back(
+          st_drivable_boundary_.st_boundary(index).s_lower(),
+          st_drivable_boundary_.st_boundary(index).s_upper());
     }
   }
 
@@ -144,54 +140,114 @@ double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
       continue;
     }
 
-    auto boundary = obstacle->path_st_boundary();
-
-    if (boundary.min_s() > FLAGS_speed_lon_decision_horizon) {
-      continue;
-    }
-    if (t < boundary.min_t() || t > boundary.max_t()) {
+    const auto& boundary = obstacle->path_st_boundary();
+    if (boundary.IsEmpty() ||
+        boundary.min_s() > FLAGS_speed_lon_decision_horizon) {
       continue;
     }
-    if (boundary.IsPointInBoundary(st_graph_point.point())) {
-      return kInf;
+
+    const auto upper_points = boundary.upper_points();
+    const auto lower_points = boundary.lower_points();
+    for (size_t i = 0; i < column_t.size(); ++i) {
+      const double t = column_t[i];
+      if (t < boundary.min_t() || t > boundary.max_t()) {
+        continue;
+      }
+      BoundarySlice slice;
+      boundary.GetBoundarySRange(t, &slice.s_upper, &slice.s_lower);
+
+      // the same edges as STBoundary::IsPointInBoundary tests against
+      if (t > boundary.min_t() && t < boundary.max_t() &&
+          t >= lower_points.front().t() && t <= lower_points.back().t()) {
+        const auto first_ge = std::lower_bound(
+            lower_points.begin(), lower_points.end(), t,
+            [](const STPoint& p, const double time) { return p.t() < time; });
+        const size_t index = std::distance(lower_points.begin(), first_ge);
+        size_t left = 0;
+        size_t right = 0;
+        if (first_ge == lower_points.end()) {
+          left = right = lower_points.size() - 1;
+        } else if (index > 0) {
+          left = index - 1;
+          right = index;
+        }
+        slice.has_interior = true;
+        slice.upper_left_t = upper_points[left].t();
+        slice.upper_left_s = upper_points[left].s();
+        slice.upper_right_t = upper_points[right].t();
+        slice.upper_right_s = upper_points[right].s();
+        slice.lower_left_t = lower_points[left].t();
+        slice.lower_left_s = lower_points[left].s();
+        slice.lower_right_t = lower_points[right].t();
+        slice.lower_right_s = lower_points[right].s();
+      }
+      boundary_slices_[i].push_back(slice);
     }
-    double s_upper = 0.0;
-    double s_lower = 0.0;
-
-    int boundary_index = boundary_map_[boundary.id()];
-    if (boundary_cost_[boundary_index][st_graph_point.index_t()].first < 0.0) {
-      boundary.GetBoundarySRange(t, &s_upper, &s_lower);
-      boundary_cost_[boundary_index][st_graph_point.index_t()] =
-          std::make_pair(s_upper, s_lower);
-    } else {
-      s_upper = boundary_cost_[boundary_index][st_graph_point.index_t()].first;
-      s_lower = boundary_cost_[boundary_index][st_graph_point.index_t()].second;
+  }
+}
+
+void DpStCost::GetObstacleCosts(const uint32_t index_t,
+                                const std::vector<double>& row_s,
+                                const size_t row_begin, const size_t row_end,
+                                double* const costs) const {
+  CHECK_LT(index_t, boundary_slices_.size());
+  const double t = column_t_[index_t];
+  std::fill(costs + row_begin, costs + row_end, 0.0);
+
+  if (FLAGS_use_st_drivable_boundary) {
+    const double lower_bound = drivable_s_range_[index_t].first;
+    const double upper_bound = drivable_s_range_[index_t].second;
+    for (size_t r = row_begin; r < row_end; ++r) {
+      if (row_s[r] > upper_bound || row_s[r] < lower_bound) {
+        costs[r] = kInf;
+      }
     }
-    if (s < s_lower) {
-      const double follow_distance_s = config_.safe_distance();
-      if (s + follow_distance_s < s_lower) {
-        continue;
-      } else {
-        auto s_diff = follow_distance_s - s_lower + s;
-        cost += config_.obstacle_weight() * config_.default_obstacle_cost() *
-                s_diff * s_diff;
+  }
+
+  const double weight =
+      config_.obstacle_weight() * config_.default_obstacle_cost();
+  const double follow_distance_s = config_.safe_distance();
+  const double overtake_distance_s =
+      StGapEstimator::EstimateSafeOvertakingGap();
+  // Obstacles are the outer loop, so the rows of a column are plain
+  // arithmetic over contiguous arrays.
+  for (const auto& slice : boundary_slices_[index_t]) {
+    for (size_t r = row_begin; r < row_end; ++r) {
+      const double s = row_s[r];
+      double cost = 0.0;
+      if (s < slice.s_lower) {
+        if (s + follow_distance_s >= slice.s_lower) {
+          const double s_diff = follow_distance_s - slice.s_lower + s;
+          cost = weight * s_diff * s_diff;
+        }
+      } else if (s > slice.s_upper) {
+        // or calculated from velocity
+        if (s <= slice.s_upper + overtake_distance_s) {
+          const double s_diff = overtake_distance_s + slice.s_upper - s;
+          cost = weight * s_diff * s_diff;
+        }
       }
-    } else if (s > s_upper) {
-      const double overtake_distance_s =
-          StGapEstimator::EstimateSafeOvertakingGap();
-      if (s > s_upper + overtake_distance_s) {  // or calculated from velocity
-        continue;
-      } else {
-        auto s_diff = overtake_distance_s + s_upper - s;
-        cost += config_.obstacle_weight() * config_.default_obstacle_cost() *
-                s_diff * s_diff;
+      if (slice.has_interior) {
+        const double check_upper =
+            (slice.upper_left_t - t) * (slice.upper_right_s - s) -
+            (slice.upper_left_s - s) * (slice.upper_right_t - t);
+        const double check_lower =
+            (slice.lower_left_t - t) * (slice.lower_right_s - s) -
+            (slice.lower_left_s - s) * (slice.lower_right_t - t);
+        if (check_upper * check_lower < 0) {
+          cost = kInf;
+        }
       }
+      costs[r] += cost;
     }
   }
-  return cost * unit_t_;
+
+  for (size_t r = row_begin; r < row_end; ++r) {
+    costs[r] *= unit_t_;
+  }
 }
 
-double DpStCost::GetSpatialPotentialCost(const StGraphPoint& point) {
+double DpStCost::GetSpatialPotentialCost(const StGraphPoint& point) const {
   return (total_s_ - point.point().s()) * config_.spatial_potential_penalty();
 }
 
@@ -238,23 +294,17 @@ double DpStCost::GetSpeedCost(const STPoint& first, const STPoint& second,
   return cost;
 }
 
-double DpStCost::GetAccelCost(const double accel) {
-  double cost = 0.0;
-  static constexpr double kEpsilon = 0.1;
-  static constexpr size_t kShift = 100;
-  const size_t accel_key = static_cast<size_t>(accel / kEpsilon + 0.5 + kShift);
-  DCHECK_LT(accel_key, accel_cost_.size());
-  if (accel_key >= accel_cost_.size()) {
-    return kInf;
-  }
-
-  if (accel_cost_.at(accel_key) < 0.0) {
+void DpStCost::InitAccelCost() {
+  const double max_acc = config_.max_acceleration();
+  const double max_dec = config_.max_deceleration();
+  const double accel_penalty = config_.accel_penalty();
+  const double decel_penalty = config_.decel_penalty();
+  for (size_t i = 0; i < accel_cost_.size(); ++i) {
+    const double accel =
+        (static_cast<double>(i) - static_cast<double>(kAccelShift)) *
+        kAccelEpsilon;
     const double accel_sq = accel * accel;
-    double max_acc = config_.max_acceleration();
-    double max_dec = config_.max_deceleration();
-    double accel_penalty = config_.accel_penalty();
-    double decel_penalty = config_.decel_penalty();
-
+    double cost = 0.0;
     if (accel > 0.0) {
       cost = accel_penalty * accel_sq;
     } else {
@@ -264,57 +314,63 @@ double DpStCost::GetAccelCost(const double accel) {
                 (1 + std::exp(1.0 * (accel - max_dec))) +
             accel_sq * accel_penalty * accel_penalty /
                 (1 + std::exp(-1.0 * (accel - max_acc)));
-    accel_cost_.at(accel_key) = cost;
-  } else {
-    cost = accel_cost_.at(accel_key);
+    accel_cost_[i] = cost;
   }
-  return cost * unit_t_;
+}
+
+double DpStCost::GetAccelCost(const double accel) const {
+  const size_t accel_key =
+      static_cast<size_t>(accel / kAccelEpsilon + 0.5 + kAccelShift);
+  DCHECK_LT(accel_key, accel_cost_.size());
+  if (accel_key >= accel_cost_.size()) {
+    return kInf;
+  }
+  return accel_cost_[accel_key] * unit_t_;
 }
 
 double DpStCost::GetAccelCostByThreePoints(const STPoint& first,
                                            const STPoint& second,
-                                           const STPoint& third) {
+                                           const STPoint& third) const {
   double accel = (first.s() + third.s() - 2 * second.s()) / (unit_t_ * unit_t_);
   return GetAccelCost(accel);
 }
 
 double DpStCost::GetAccelCostByTwoPoints(const double pre_speed,
                                          const STPoint& pre_point,
-                                         const STPoint& curr_point) {
+                                         const STPoint& curr_point) const {
   double current_speed = (curr_point.s() - pre_point.s()) / unit_t_;
   double accel = (current_speed - pre_speed) / unit_t_;
   return GetAccelCost(accel);
 }
 
-double DpStCost::JerkCost(const double jerk) {
-  double cost = 0.0;
-  static constexpr double kEpsilon = 0.1;
-  static constexpr size_t kShift = 200;
-  const size_t jerk_key = static_cast<size_t>(jerk / kEpsilon + 0.5 + kShift);
-  if (jerk_key >= jerk_cost_.size()) {
-    return kInf;
-  }
-
-  if (jerk_cost_.at(jerk_key) < 0.0) {
-    double jerk_sq = jerk * jerk;
+void DpStCost::InitJerkCost() {
+  for (size_t i = 0; i < jerk_cost_.size(); ++i) {
+    const double jerk =
+        (static_cast<double>(i) - static_cast<double>(kJerkShift)) *
+        kJerkEpsilon;
+    const double jerk_sq = jerk * jerk;
     if (jerk > 0) {
-      cost = config_.positive_jerk_coeff() * jerk_sq * unit_t_;
+      jerk_cost_[i] = config_.positive_jerk_coeff() * jerk_sq * unit_t_;
     } else {
-      cost = config_.negative_jerk_coeff() * jerk_sq * unit_t_;
+      jerk_cost_[i] = config_.negative_jerk_coeff() * jerk_sq * unit_t_;
     }
-    jerk_cost_.at(jerk_key) = cost;
-  } else {
-    cost = jerk_cost_.at(jerk_key);
   }
+}
 
+double DpStCost::JerkCost(const double jerk) const {
+  const size_t jerk_key =
+      static_cast<size_t>(jerk / kJerkEpsilon + 0.5 + kJerkShift);
+  if (jerk_key >= jerk_cost_.size()) {
+    return kInf;
+  }
   // TODO(All): normalize to unit_t_
-  return cost;
+  return jerk_cost_[jerk_key];
 }
 
 double DpStCost::GetJerkCostByFourPoints(const STPoint& first,
                                          const STPoint& second,
                                          const STPoint& third,
-                                         const STPoint& fourth) {
+                                         const STPoint& fourth) const {
   double jerk = (fourth.s() - 3 * third.s() + 3 * second.s() - first.s()) /
                 (unit_t_ * unit_t_ * unit_t_);
   return JerkCost(jerk);
@@ -323,7 +379,7 @@ double DpStCost::GetJerkCostByFourPoints(const STPoint& first,
 double DpStCost::GetJerkCostByTwoPoints(const double pre_speed,
                                         const double pre_acc,
                                         const STPoint& pre_point,
-                                        const STPoint& curr_point) {
+                                        const STPoint& curr_point) const {
   const double curr_speed = (curr_point.s() - pre_point.s()) / unit_t_;
   const double curr_accel = (curr_speed - pre_speed) / unit_t_;
   const double jerk = (curr_accel - pre_acc) / unit_t_;
@@ -333,7 +389,7 @@ double DpStCost::GetJerkCostByTwoPoints(const double pre_speed,
 double DpStCost::GetJerkCostByThreePoints(const double first_speed,
                                           const STPoint& first,
                                           const STPoint& second,
-                                          const STPoint& third) {
+                                          const STPoint& third) const {
   const double pre_speed = (second.s() - first.s()) / unit_t_;
   const double pre_acc = (pre_speed - first_speed) / unit_t_;
   const double curr_speed = (third.s() - second.s()) / unit_t_;
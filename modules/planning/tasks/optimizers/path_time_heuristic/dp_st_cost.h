@@ -20,8 +20,7 @@
 
 #pragma once
 
-#include <string>
-#include <unordered_map>
+#include <array>
 #include <utility>
 #include <vector>
 
@@ -43,9 +42,27 @@ class DpStCost {
            const STDrivableBoundary& st_drivable_boundary,
            const common::TrajectoryPoint& init_point);
 
-  double GetObstacleCost(const StGraphPoint& point);
-
-  double GetSpatialPotentialCost(const StGraphPoint& point);
+  /**
+   * @brief Cut the st boundaries of the obstacles at the time of each column
+   * of the graph into s ranges, so the obstacle costs of a column are
+   * evaluated without visiting the boundaries again.
+   * @param column_t the time of each column
+   */
+  void RasterizeBoundaries(const std::vector<double>& column_t);
+
+  /**
+   * @brief Obstacle costs of the rows [row_begin, row_end) of a column. It
+   * only reads the rasterized boundaries, so disjoint row ranges of a column
+   * can be evaluated concurrently.
+   * @param row_s the s of each row
+   * @param costs the costs written by row index
+   */
+  void GetObstacleCosts(const uint32_t index_t,
+                        const std::vector<double>& row_s,
+                        const size_t row_begin, const size_t row_end,
+                        double* const costs) const;
+
+  double GetSpatialPotentialCost(const StGraphPoint& point) const;
 
   double GetReferenceCost(const STPoint& point,
                           const STPoint& reference_point) const;
@@ -55,24 +72,44 @@ class DpStCost {
                       const double cruise_speed) const;
 
   double GetAccelCostByTwoPoints(const double pre_speed, const STPoint& first,
-                                 const STPoint& second);
+                                 const STPoint& second) const;
   double GetAccelCostByThreePoints(const STPoint& first, const STPoint& second,
-                                   const STPoint& third);
+                                   const STPoint& third) const;
 
   double GetJerkCostByTwoPoints(const double pre_speed, const double pre_acc,
                                 const STPoint& pre_point,
-                                const STPoint& curr_point);
+                                const STPoint& curr_point) const;
   double GetJerkCostByThreePoints(const double first_speed,
                                   const STPoint& first_point,
                                   const STPoint& second_point,
-                                  const STPoint& third_point);
+                                  const STPoint& third_point) const;
 
   double GetJerkCostByFourPoints(const STPoint& first, const STPoint& second,
-                                 const STPoint& third, const STPoint& fourth);
+                                 const STPoint& third,
+                                 const STPoint& fourth) const;
 
  private:
-  double GetAccelCost(const double accel);
-  double JerkCost(const double jerk);
+  // An obstacle st boundary cut at the time of a column
+  struct BoundarySlice {
+    double s_lower = 0.0;
+    double s_upper = 0.0;
+    // whether the column time is strictly inside the boundary, and the upper
+    // and lower edges of the boundary crossing the column
+    bool has_interior = false;
+    double upper_left_t = 0.0;
+    double upper_left_s = 0.0;
+    double upper_right_t = 0.0;
+    double upper_right_s = 0.0;
+    double lower_left_t = 0.0;
+    double lower_left_s = 0.0;
+    double lower_right_t = 0.0;
+    double lower_right_s = 0.0;
+  };
+
+  void InitAccelCost();
+  void InitJerkCost();
+  double GetAccelCost(const double accel) const;
+  double JerkCost(const double jerk) const;
 
   void AddToKeepClearRange(const std::vector<const Obstacle*>& obstacles);
   static void SortAndMergeRange(
@@ -89,8 +126,11 @@ class DpStCost {
   double unit_t_ = 0.0;
   double total_s_ = 0.0;
 
-  std::unordered_map<std::string, int> boundary_map_;
-  std::vector<std::vector<std::pair<double, double>>> boundary_cost_;
+  std::vector<double> column_t_;
+  // boundary_slices_[t] holds the obstacles which apply at column t
+  std::vector<std::vector<BoundarySlice>> boundary_slices_;
+  // s_lower and s_upper of the st drivable boundary at each column
+  std::vector<std::pair<double, double>> drivable_s_range_;
 
   std::vector<std::pair<double, double>> keep_clear_range_;
 
@@ -50,8 +50,13 @@ bool CheckOverlapOnDpStGraph(const std::vector<const STBoundary*>& boundaries,
   if (FLAGS_use_st_drivable_boundary) {
     return false;
   }
+  const double s1 = p1.point().s();
+  const double s2 = p2.point().s();
   for (const auto* boundary : boundaries) {
-    if (boundary->boundary_type() == STBoundary::BoundaryType::KEEP_CLEAR) {
+    // The same bounding box test as Polygon2d::HasOverlap, before the line
+    // segment is built
+    if ((s1 < boundary->min_y() && s2 < boundary->min_y()) ||
+        (s1 > boundary->max_y() && s2 > boundary->max_y())) {
       continue;
     }
     // Check collision between a polygon and a line segment
@@ -229,6 +234,13 @@ Status GriddedPathTimeGraph::CalculateTotalCost() {
   size_t next_highest_row = 0;
   size_t next_lowest_row = 0;
 
+  std::vector<double> column_t(cost_table_.size());
+  for (size_t c = 0; c < cost_table_.size(); ++c) {
+    column_t[c] = cost_table_[c][0].point().t();
+  }
+  dp_st_cost_.RasterizeBoundaries(column_t);
+  obstacle_cost_by_index_.assign(dimension_s_, 0.0);
+
   for (size_t c = 0; c < cost_table_.size(); ++c) {
     size_t highest_row = 0;
     size_t lowest_row = cost_table_.back().size() - 1;
@@ -236,20 +248,24 @@ Status GriddedPathTimeGraph::CalculateTotalCost() {
     int count = static_cast<int>(next_highest_row) -
                 static_cast<int>(next_lowest_row) + 1;
     if (count > 0) {
-      std::vector<std::future<void>> results;
-      for (size_t r = next_lowest_row; r <= next_highest_row; ++r) {
-        auto msg = std::make_shared<StGraphMessage>(c, r);
-        if (FLAGS_enable_multi_thread_in_dp_st_graph) {
+      UpdateColumnBoundaries(c);
+      // The rows of a column only depend on the previous columns, so they are
+      // split into tasks of consecutive rows.
+      const size_t row_end = next_highest_row + 1;
+      if (FLAGS_enable_multi_thread_in_dp_st_graph) {
+        const size_t rows_per_task =
+            static_cast<size_t>(std::max(1, FLAGS_dp_st_graph_rows_per_task));
+        std::vector<std::future<void>> results;
+        for (size_t r = next_lowest_row; r < row_end; r += rows_per_task) {
           results.push_back(
-              cyber::Async(&GriddedPathTimeGraph::CalculateCostAt, this, msg));
-        } else {
-          CalculateCostAt(msg);
+              cyber::Async(&GriddedPathTimeGraph::CalculateCostsOfRows, this, c,
+                           r, std::min(r + rows_per_task, row_end)));
         }
-      }
-      if (FLAGS_enable_multi_thread_in_dp_st_graph) {
         for (auto& result : results) {
           result.get();
         }
+      } else {
+        CalculateCostsOfRows(c, next_lowest_row, row_end);
       }
     }
 
@@ -270,6 +286,36 @@ Status GriddedPathTimeGraph::CalculateTotalCost() {
   return Status::OK();
 }
 
+void GriddedPathTimeGraph::UpdateColumnBoundaries(const size_t c) {
+  column_boundaries_.clear();
+  if (c == 0) {
+    return;
+  }
+  const double pre_t = cost_table_[c - 1][0].point().t();
+  const double curr_t = cost_table_[c][0].point().t();
+  for (const auto* boundary : st_graph_data_.st_boundaries()) {
+    if (boundary->boundary_type() == STBoundary::BoundaryType::KEEP_CLEAR) {
+      continue;
+    }
+    // x of the st boundary polygon is t
+    if (curr_t < boundary->min_x() || pre_t > boundary->max_x()) {
+      continue;
+    }
+    column_boundaries_.push_back(boundary);
+  }
+}
+
+void GriddedPathTimeGraph::CalculateCostsOfRows(const size_t c,
+                                                const size_t row_begin,
+                                                const size_t row_end) {
+  dp_st_cost_.GetObstacleCosts(static_cast<uint32_t>(c),
+                               spatial_distance_by_index_, row_begin, row_end,
+                               obstacle_cost_by_index_.data());
+  for (size_t r = row_begin; r < row_end; ++r) {
+    CalculateCostAt(static_cast<uint32_t>(c), static_cast<uint32_t>(r));
+  }
+}
+
 void GriddedPathTimeGraph::GetRowRange(const StGraphPoint& point,
                                        size_t* next_highest_row,
                                        size_t* next_lowest_row) {
@@ -314,13 +360,11 @@ void GriddedPathTimeGraph::GetRowRange(const StGraphPoint& point,
   }
 }
 
-void GriddedPathTimeGraph::CalculateCostAt(
-    const std::shared_ptr<StGraphMessage>& msg) {
-  const uint32_t c = msg->c;
-  const uint32_t r = msg->r;
+void GriddedPathTimeGraph::CalculateCostAt(const uint32_t c,
+                                           const uint32_t r) {
   auto& cost_cr = cost_table_[c][r];
 
-  cost_cr.SetObstacleCost(dp_st_cost_.GetObstacleCost(cost_cr));
+  cost_cr.SetObstacleCost(obstacle_cost_by_index_[r]);
   if (cost_cr.obstacle_cost() > std::numeric_limits<double>::max()) {
     return;
   }
@@ -353,8 +397,7 @@ void GriddedPathTimeGraph::CalculateCostAt(
       return;
     }
 
-    if (CheckOverlapOnDpStGraph(st_graph_data_.st_boundaries(), cost_cr,
-                                cost_init)) {
+    if (CheckOverlapOnDpStGraph(column_boundaries_, cost_cr, cost_init)) {
       return;
     }
     cost_cr.SetTotalCost(
@@ -414,7 +457,7 @@ void GriddedPathTimeGraph::CalculateCostAt(
 
       // Filter out continuous-time node connection which is in collision with
       // obstacle
-      if (CheckOverlapOnDpStGraph(st_graph_data_.st_boundaries(), cost_cr,
+      if (CheckOverlapOnDpStGraph(column_boundaries_, cost_cr,
                                   pre_col[r_pre])) {
         continue;
       }
@@ -460,7 +503,7 @@ void GriddedPathTimeGraph::CalculateCostAt(
       continue;
     }
 
-    if (CheckOverlapOnDpStGraph(st_graph_data_.st_boundaries(), cost_cr,
+    if (CheckOverlapOnDpStGraph(column_boundaries_, cost_cr,
                                 pre_col[r_pre])) {
       continue;
     }
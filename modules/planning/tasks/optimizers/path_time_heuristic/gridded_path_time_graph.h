@@ -20,7 +20,6 @@
 
 #pragma once
 
-#include <memory>
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
@@ -58,13 +57,15 @@ class GriddedPathTimeGraph {
 
   common::Status CalculateTotalCost();
 
-  // defined for cyber task
-  struct StGraphMessage {
-    StGraphMessage(const uint32_t c_, const int32_t r_) : c(c_), r(r_) {}
-    uint32_t c;
-    uint32_t r;
-  };
-  void CalculateCostAt(const std::shared_ptr<StGraphMessage>& msg);
+  // collect the st boundaries which the edges into column c may overlap
+  void UpdateColumnBoundaries(const size_t c);
+
+  // calculate the rows [row_begin, row_end) of column c, defined for cyber
+  // task
+  void CalculateCostsOfRows(const size_t c, const size_t row_begin,
+                            const size_t row_end);
+
+  void CalculateCostAt(const uint32_t c, const uint32_t r);
 
   double CalculateEdgeCost(const STPoint& first, const STPoint& second,
                            const STPoint& third, const STPoint& forth,
@@ -121,6 +122,13 @@ class GriddedPathTimeGraph {
   // cost_table_[t][s]
   // row: s, col: t --- NOTICE: Please do NOT change.
   std::vector<std::vector<StGraphPoint>> cost_table_;
+
+  // obstacle costs of the column being calculated by row
+  std::vector<double> obstacle_cost_by_index_;
+
+  // non keep clear st boundaries overlapping the time span of the edges into
+  // the column being calculated
+  std::vector<const STBoundary*> column_boundaries_;
 };
 
 }  // namespace planning
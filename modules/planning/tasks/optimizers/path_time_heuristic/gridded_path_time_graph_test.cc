@@ -134,5 +134,53 @@ TEST_F(DpStGraphTest, simple) {
   EXPECT_TRUE(ret.ok());
 }
 
+TEST_F(DpStGraphTest, multi_thread) {
+  // an obstacle cutting in ahead and slower than the adc
+  Obstacle o1;
+  o1.SetId("o1");
+  std::vector<std::pair<STPoint, STPoint>> point_pairs;
+  for (double t = 1.0; t <= 7.0; t += 0.5) {
+    point_pairs.emplace_back(STPoint(20.0 + 5.0 * t, t),
+                             STPoint(25.0 + 5.0 * t, t));
+  }
+  o1.set_path_st_boundary(STBoundary(point_pairs));
+  obstacle_list_.push_back(o1);
+
+  std::vector<const Obstacle*> obstacles;
+  obstacles.emplace_back(&(obstacle_list_.back()));
+  std::vector<const STBoundary*> boundaries;
+  boundaries.push_back(&(obstacles.back()->path_st_boundary()));
+
+  init_point_.set_v(10.0);
+  init_point_.set_a(0.0);
+
+  planning_internal::STGraphDebug st_graph_debug;
+  st_graph_data_ = StGraphData();
+  st_graph_data_.LoadData(boundaries, 30.0, init_point_, speed_limit_, 5.0,
+                          120.0, 7.0, &st_graph_debug);
+
+  SpeedData single_thread_speed_data;
+  GriddedPathTimeGraph single_thread_graph(st_graph_data_, dp_config_,
+                                           obstacles, init_point_);
+  ASSERT_TRUE(single_thread_graph.Search(&single_thread_speed_data).ok());
+
+  FLAGS_enable_multi_thread_in_dp_st_graph = true;
+  FLAGS_dp_st_graph_rows_per_task = 3;
+  SpeedData multi_thread_speed_data;
+  GriddedPathTimeGraph multi_thread_graph(st_graph_data_, dp_config_,
+                                          obstacles, init_point_);
+  ASSERT_TRUE(multi_thread_graph.Search(&multi_thread_speed_data).ok());
+  FLAGS_enable_multi_thread_in_dp_st_graph = false;
+
+  ASSERT_EQ(single_thread_speed_data.size(), multi_thread_speed_data.size());
+  for (size_t i = 0; i < single_thread_speed_data.size(); ++i) {
+    const auto& point = single_thread_speed_data[i];
+    EXPECT_DOUBLE_EQ(point.s(), multi_thread_speed_data[i].s());
+    EXPECT_DOUBLE_EQ(point.t(), multi_thread_speed_data[i].t());
+    EXPECT_FALSE(boundaries.front()->IsPointInBoundary(
+        STPoint(point.s(), point.t())));
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
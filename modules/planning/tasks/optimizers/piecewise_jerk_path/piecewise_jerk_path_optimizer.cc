@@ -29,7 +29,6 @@
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/speed/speed_data.h"
 #include "modules/planning/common/trajectory1d/piecewise_jerk_trajectory1d.h"
-#include "modules/planning/math/piecewise_jerk/piecewise_jerk_path_problem.h"
 
 namespace apollo {
 namespace planning {
@@ -165,11 +164,18 @@ common::Status PiecewiseJerkPathOptimizer::Process(
       ddl_bounds.emplace_back(-lat_acc_bound - kappa, lat_acc_bound - kappa);
     }
 
+    PiecewiseJerkOsqpWorkspace* osqp_workspace = nullptr;
+    if (FLAGS_enable_piecewise_jerk_osqp_warm_start) {
+      osqp_workspace = osqp_workspaces_.Get(
+          reference_line_info_->Lanes().Id() + "/" + path_boundary.label(),
+          frame_->SequenceNum());
+    }
+
     bool res_opt = OptimizePath(
         init_frenet_state.second, end_state, std::move(path_reference_l),
         path_reference_size, path_boundary.delta_s(), is_valid_path_reference,
-        path_boundary.boundary(), ddl_bounds, w, max_iter, &opt_l, &opt_dl,
-        &opt_ddl);
+        path_boundary.boundary(), ddl_bounds, w, max_iter,
+        path_boundary.start_s(), osqp_workspace, &opt_l, &opt_dl, &opt_ddl);
 
     if (res_opt) {
       for (size_t i = 0; i < path_boundary_size; i += 4) {
@@ -239,7 +245,8 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
     const double delta_s, const bool is_valid_path_reference,
     const std::vector<std::pair<double, double>>& lat_boundaries,
     const std::vector<std::pair<double, double>>& ddl_bounds,
-    const std::array<double, 5>& w, const int max_iter, std::vector<double>* x,
+    const std::array<double, 5>& w, const int max_iter, const double start_s,
+    PiecewiseJerkOsqpWorkspace* osqp_workspace, std::vector<double>* x,
     std::vector<double>* dx, std::vector<double>* ddx) {
   // num of knots
   const size_t kNumKnots = lat_boundaries.size();
@@ -307,7 +314,10 @@ bool PiecewiseJerkPathOptimizer::OptimizePath(
                                                  axis_distance, max_yaw_rate);
   piecewise_jerk_problem.set_dddx_bound(jerk_bound);
 
-  bool success = piecewise_jerk_problem.Optimize(max_iter);
+  bool success =
+      osqp_workspace == nullptr
+          ? piecewise_jerk_problem.Optimize(max_iter)
+          : piecewise_jerk_problem.Optimize(max_iter, start_s, osqp_workspace);
 
   auto end_time = std::chrono::system_clock::now();
   std::chrono::duration<double> diff = end_time - start_time;
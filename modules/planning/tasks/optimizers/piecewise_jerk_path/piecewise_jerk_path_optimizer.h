@@ -24,6 +24,7 @@
 #include <utility>
 #include <vector>
 
+#include "modules/planning/math/piecewise_jerk/piecewise_jerk_path_problem.h"
 #include "modules/planning/tasks/optimizers/path_optimizer.h"
 
 namespace apollo {
@@ -63,6 +64,8 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
    * @param ddl_bounds: constains
    * @param w: weighting scales
    * @param max_iter: optimization max interations
+   * @param start_s: s of the first knot
+   * @param osqp_workspace: workspace kept across cycles, or nullptr
    * @param ptr_x: optimization result of x
    * @param ptr_dx: optimization result of dx
    * @param ptr_ddx: optimization result of ddx
@@ -78,6 +81,7 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
       const std::vector<std::pair<double, double>>& lat_boundaries,
       const std::vector<std::pair<double, double>>& ddl_bounds,
       const std::array<double, 5>& w, const int max_iter,
+      const double start_s, PiecewiseJerkOsqpWorkspace* osqp_workspace,
       std::vector<double>* ptr_x, std::vector<double>* ptr_dx,
       std::vector<double>* ptr_ddx);
 
@@ -93,6 +97,10 @@ class PiecewiseJerkPathOptimizer : public PathOptimizer {
 
   double GaussianWeighting(const double x, const double peak_weighting,
                            const double peak_weighting_x) const;
+
+ private:
+  // by the reference line and the path boundary label
+  PiecewiseJerkOsqpWorkspacePool osqp_workspaces_;
 };
 
 }  // namespace planning
@@ -29,7 +29,6 @@
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/speed_profile_generator.h"
 #include "modules/planning/common/st_graph_data.h"
-#include "modules/planning/math/piecewise_jerk/piecewise_jerk_speed_problem.h"
 
 namespace apollo {
 namespace planning {
@@ -158,7 +157,19 @@ Status PiecewiseJerkSpeedOptimizer::Process(const PathData& path_data,
   piecewise_jerk_problem.set_dx_bounds(std::move(s_dot_bounds));
 
   // Solve the problem
-  if (!piecewise_jerk_problem.Optimize()) {
+  bool success = false;
+  if (FLAGS_enable_piecewise_jerk_osqp_warm_start) {
+    // the knots are shifted by the absolute time of the init point
+    const double start_t =
+        frame_->vehicle_state().timestamp() + init_point.relative_time();
+    success = piecewise_jerk_problem.Optimize(
+        4000, start_t,
+        osqp_workspaces_.Get(reference_line_info_->Lanes().Id(),
+                             frame_->SequenceNum()));
+  } else {
+    success = piecewise_jerk_problem.Optimize();
+  }
+  if (!success) {
     const std::string msg = "Piecewise jerk speed optimizer failed!";
     AERROR << msg;
     speed_data->clear();
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include "modules/planning/math/piecewise_jerk/piecewise_jerk_speed_problem.h"
 #include "modules/planning/tasks/optimizers/speed_optimizer.h"
 
 namespace apollo {
@@ -35,6 +36,9 @@ class PiecewiseJerkSpeedOptimizer : public SpeedOptimizer {
   common::Status Process(const PathData& path_data,
                          const common::TrajectoryPoint& init_point,
                          SpeedData* const speed_data) override;
+
+  // by the reference line
+  PiecewiseJerkOsqpWorkspacePool osqp_workspaces_;
 };
 
 }  // namespace planning
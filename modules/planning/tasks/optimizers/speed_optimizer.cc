@@ -38,6 +38,8 @@ Status SpeedOptimizer::Execute(Frame* frame,
   auto ret =
       Process(reference_line_info->path_data(), frame->PlanningStartPoint(),
               reference_line_info->mutable_speed_data());
+  // for the speed queries of the following tasks
+  reference_line_info->mutable_speed_data()->BuildLookupIndex();
 
   RecordDebugInfo(reference_line_info->speed_data());
   return ret;
@@ -0,0 +1,411 @@
+/******************************************************************************
+ * Copyright 2020 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Replays the planning inputs of records through OnLanePlanning as fast
+ * as possible on the mock clock. Reports the latency distributions of the
+ * cycles and of the profiled spans, and the allocations of each cycle, and
+ * checks that every run plans the same trajectories. Run it with -c opt:
+ *
+ *   planning_replay_benchmark --replay_record_file=<record>[:<record>...]
+ *       --map_dir=/apollo/modules/map/data/<map>
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_split.h"
+#include "cyber/common/file.h"
+#include "cyber/common/log.h"
+#include "cyber/record/record_reader.h"
+#include "cyber/time/clock.h"
+#include "modules/common/util/message_util.h"
+#include "modules/planning/common/dependency_injector.h"
+#include "modules/planning/common/history.h"
+#include "modules/planning/common/local_view.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_profiler.h"
+#include "modules/planning/on_lane_planning.h"
+#include "modules/planning/proto/planning_config.pb.h"
+
+DEFINE_string(replay_record_file, "",
+              "the records of the planning inputs to replay, separated by "
+              "colon ':'");
+DEFINE_string(replay_planning_config_file,
+              "/apollo/modules/planning/conf/planning_config.pb.txt",
+              "the planning config of the replay");
+DEFINE_int32(replay_num_runs, 2,
+             "number of times the records are replayed. The trajectories of "
+             "each run are compared with the ones of the first run.");
+DEFINE_int32(replay_max_cycles, 0,
+             "the maximum number of planning cycles of a run, 0 for all the "
+             "cycles of the records");
+DEFINE_string(replay_profile_file, "",
+              "the file to write the PlanningProfile of the last run to, in "
+              "text format");
+
+namespace {
+
+// the allocations of the whole process, counted by the operator new below
+std::atomic<uint64_t> num_allocations{0};
+std::atomic<uint64_t> allocated_bytes{0};
+
+void* CountedAllocate(const std::size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  void* ptr = CountedAllocate(size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return CountedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+namespace apollo {
+namespace planning {
+
+using apollo::cyber::Clock;
+using apollo::cyber::record::RecordMessage;
+using apollo::cyber::record::RecordReader;
+using apollo::perception::TrafficLightDetection;
+using apollo::relative_map::MapMsg;
+using apollo::routing::RoutingResponse;
+using apollo::storytelling::Stories;
+
+namespace {
+
+// the inputs of a planning cycle, which is triggered by a prediction message
+// as in PlanningComponent
+struct ReplayFrame {
+  double timestamp_sec = 0.0;
+  LocalView local_view;
+};
+
+struct CycleStats {
+  double time_ms = 0.0;
+  double num_allocations = 0.0;
+  double allocated_kb = 0.0;
+};
+
+template <typename T>
+bool ParseMessage(const RecordMessage& message, std::shared_ptr<T>* proto) {
+  auto parsed_proto = std::make_shared<T>();
+  if (!parsed_proto->ParseFromString(message.content)) {
+    AERROR << "Fail to parse the message of " << message.channel_name;
+    return false;
+  }
+  *proto = std::move(parsed_proto);
+  return true;
+}
+
+// read the frames of the records before the replay, so that the cycles are
+// run back to back without reading the records
+bool LoadReplayFrames(const PlanningConfig& config,
+                      std::vector<ReplayFrame>* frames) {
+  const auto& topic_config = config.topic_config();
+  LocalView local_view;
+  local_view.routing = std::make_shared<RoutingResponse>();
+  local_view.traffic_light = std::make_shared<TrafficLightDetection>();
+  local_view.relative_map = std::make_shared<MapMsg>();
+  local_view.pad_msg = std::make_shared<PadMessage>();
+  local_view.stories = std::make_shared<Stories>();
+
+  const std::vector<std::string> record_files =
+      absl::StrSplit(FLAGS_replay_record_file, ':', absl::SkipEmpty());
+  for (const auto& record_file : record_files) {
+    RecordReader reader(record_file);
+    if (!reader.IsValid()) {
+      AERROR << "Fail to open " << record_file;
+      return false;
+    }
+    RecordMessage message;
+    while (reader.ReadMessage(&message)) {
+      if (message.channel_name == topic_config.chassis_topic()) {
+        ParseMessage(message, &local_view.chassis);
+      } else if (message.channel_name == topic_config.localization_topic()) {
+        ParseMessage(message, &local_view.localization_estimate);
+      } else if (message.channel_name ==
+                 topic_config.routing_response_topic()) {
+        ParseMessage(message, &local_view.routing);
+      } else if (message.channel_name ==
+                 topic_config.traffic_light_detection_topic()) {
+        ParseMessage(message, &local_view.traffic_light);
+      } else if (message.channel_name ==
+                 topic_config.story_telling_topic()) {
+        ParseMessage(message, &local_view.stories);
+      } else if (message.channel_name == topic_config.prediction_topic()) {
+        // the inputs checked by PlanningComponent::CheckInput
+        if (!ParseMessage(message, &local_view.prediction_obstacles) ||
+            local_view.chassis == nullptr ||
+            local_view.localization_estimate == nullptr ||
+            !local_view.routing->has_header()) {
+          continue;
+        }
+        ReplayFrame frame;
+        frame.timestamp_sec = static_cast<double>(message.time) * 1e-9;
+        frame.local_view = local_view;
+        frames->push_back(std::move(frame));
+        if (FLAGS_replay_max_cycles > 0 &&
+            static_cast<int>(frames->size()) >= FLAGS_replay_max_cycles) {
+          return true;
+        }
+      }
+    }
+  }
+  return !frames->empty();
+}
+
+// replay the frames with a new OnLanePlanning, and keep the stats and a hash
+// of the trajectory of each cycle
+bool ReplayFrames(const PlanningConfig& config,
+                  const std::vector<ReplayFrame>& frames,
+                  std::vector<CycleStats>* cycle_stats,
+                  std::vector<size_t>* trajectory_hashes) {
+  auto injector = std::make_shared<DependencyInjector>();
+  OnLanePlanning planning(injector);
+  if (!planning.Init(config).ok()) {
+    AERROR << "Fail to init planning";
+    return false;
+  }
+
+  auto* profiler = PlanningProfiler::Instance();
+  profiler->Clear();
+  uint32_t sequence_num = 0;
+  for (const auto& frame : frames) {
+    Clock::SetNowInSeconds(frame.timestamp_sec);
+    ADCTrajectory trajectory;
+
+    const uint64_t start_num_allocations = num_allocations.load();
+    const uint64_t start_allocated_bytes = allocated_bytes.load();
+    const auto start_time = std::chrono::steady_clock::now();
+    profiler->BeginCycle(++sequence_num);
+    planning.RunOnce(frame.local_view, &trajectory);
+    profiler->EndCycle();
+    const auto end_time = std::chrono::steady_clock::now();
+
+    CycleStats stats;
+    stats.time_ms =
+        std::chrono::duration<double, std::milli>(end_time - start_time)
+            .count();
+    stats.num_allocations =
+        static_cast<double>(num_allocations.load() - start_num_allocations);
+    stats.allocated_kb =
+        static_cast<double>(allocated_bytes.load() - start_allocated_bytes) /
+        1024.0;
+    cycle_stats->push_back(stats);
+
+    common::util::FillHeader(planning.Name(), &trajectory);
+    injector->history()->Add(trajectory);
+
+    // the header and the latency stats differ from run to run
+    trajectory.clear_header();
+    trajectory.clear_latency_stats();
+    trajectory.clear_debug();
+    trajectory_hashes->push_back(
+        std::hash<std::string>()(trajectory.SerializeAsString()));
+  }
+  return true;
+}
+
+// nearest rank percentile of the sorted values
+double Percentile(const std::vector<double>& sorted_values,
+                  const double percent) {
+  const size_t rank = static_cast<size_t>(
+      std::ceil(percent / 100.0 * static_cast<double>(sorted_values.size())));
+  return sorted_values[std::max<size_t>(rank, 1) - 1];
+}
+
+void ReportDistribution(const std::string& name, std::vector<double> values) {
+  if (values.empty()) {
+    return;
+  }
+  std::sort(values.begin(), values.end());
+  double sum = 0.0;
+  for (const double value : values) {
+    sum += value;
+  }
+  std::cout << std::setw(24) << name << std::fixed << std::setprecision(3)
+            << std::setw(12) << sum / static_cast<double>(values.size())
+            << std::setw(12) << Percentile(values, 50.0) << std::setw(12)
+            << Percentile(values, 90.0) << std::setw(12)
+            << Percentile(values, 99.0) << std::setw(12) << values.back()
+            << std::endl;
+}
+
+void ReportRun(const int run_index, const std::vector<CycleStats>& stats) {
+  std::vector<double> times_ms;
+  std::vector<double> allocations;
+  std::vector<double> allocated_kb;
+  for (const auto& cycle_stats : stats) {
+    times_ms.push_back(cycle_stats.time_ms);
+    allocations.push_back(cycle_stats.num_allocations);
+    allocated_kb.push_back(cycle_stats.allocated_kb);
+  }
+  std::cout << "run " << run_index << ", " << stats.size() << " cycles"
+            << std::endl;
+  std::cout << std::setw(24) << "per cycle" << std::setw(12) << "avg"
+            << std::setw(12) << "p50" << std::setw(12) << "p90"
+            << std::setw(12) << "p99" << std::setw(12) << "max" << std::endl;
+  ReportDistribution("time_ms", times_ms);
+  ReportDistribution("allocations", allocations);
+  ReportDistribution("allocated_kb", allocated_kb);
+}
+
+void ReportProfile(const PlanningProfile& profile) {
+  std::cout << "spans of the last run, " << profile.num_dropped_spans()
+            << " dropped" << std::endl;
+  std::cout << std::setw(10) << "num" << std::setw(12) << "avg_ms"
+            << std::setw(12) << "p50_ms" << std::setw(12) << "p90_ms"
+            << std::setw(12) << "p99_ms" << std::setw(12) << "max_ms"
+            << "  path" << std::endl;
+  for (const auto& span_stats : profile.span_stats()) {
+    std::cout << std::setw(10) << span_stats.num() << std::fixed
+              << std::setprecision(3) << std::setw(12) << span_stats.avg_ms()
+              << std::setw(12) << span_stats.p50_ms() << std::setw(12)
+              << span_stats.p90_ms() << std::setw(12) << span_stats.p99_ms()
+              << std::setw(12) << span_stats.max_ms() << "  "
+              << span_stats.path() << std::endl;
+  }
+}
+
+}  // namespace
+
+int RunReplayBenchmark() {
+  PlanningConfig config;
+  if (!cyber::common::GetProtoFromFile(FLAGS_replay_planning_config_file,
+                                       &config)) {
+    AERROR << "Fail to load planning config file "
+           << FLAGS_replay_planning_config_file;
+    return -1;
+  }
+
+  std::vector<ReplayFrame> frames;
+  if (!LoadReplayFrames(config, &frames)) {
+    AERROR << "No planning cycle to replay in " << FLAGS_replay_record_file;
+    return -1;
+  }
+
+  // the reference lines are created in the planning cycles rather than in a
+  // thread racing with them, so that the runs are the same
+  FLAGS_enable_reference_line_provider_thread = false;
+  FLAGS_enable_planning_profiler = true;
+  FLAGS_planning_profiler_window_size = std::max(
+      FLAGS_planning_profiler_window_size, static_cast<int>(frames.size()));
+  Clock::SetMode(cyber::proto::MODE_MOCK);
+
+  std::vector<size_t> first_trajectory_hashes;
+  int num_nondeterministic_runs = 0;
+  for (int run_index = 0; run_index < std::max(FLAGS_replay_num_runs, 1);
+       ++run_index) {
+    std::vector<CycleStats> cycle_stats;
+    std::vector<size_t> trajectory_hashes;
+    if (!ReplayFrames(config, frames, &cycle_stats, &trajectory_hashes)) {
+      return -1;
+    }
+    ReportRun(run_index, cycle_stats);
+
+    if (run_index == 0) {
+      first_trajectory_hashes = std::move(trajectory_hashes);
+      continue;
+    }
+    size_t num_different_cycles = 0;
+    size_t first_different_cycle = 0;
+    for (size_t i = 0; i < trajectory_hashes.size(); ++i) {
+      if (trajectory_hashes[i] != first_trajectory_hashes[i]) {
+        if (num_different_cycles == 0) {
+          first_different_cycle = i;
+        }
+        ++num_different_cycles;
+      }
+    }
+    if (num_different_cycles > 0) {
+      ++num_nondeterministic_runs;
+      std::cout << "run " << run_index << " differs from run 0 in "
+                << num_different_cycles << " cycles, from cycle "
+                << first_different_cycle << std::endl;
+    }
+  }
+
+  auto* profiler = PlanningProfiler::Instance();
+  PlanningProfile profile;
+  profiler->GetProfile(&profile);
+  ReportProfile(profile);
+  if (!FLAGS_replay_profile_file.empty()) {
+    cyber::common::SetProtoToASCIIFile(profile, FLAGS_replay_profile_file);
+  }
+  if (!FLAGS_planning_profiler_trace_file.empty()) {
+    profiler->DumpSlowestCycles(FLAGS_planning_profiler_trace_file);
+  }
+
+  if (num_nondeterministic_runs > 0) {
+    std::cout << "NOT deterministic: " << num_nondeterministic_runs
+              << " runs differ from the first one" << std::endl;
+    return 1;
+  }
+  std::cout << "deterministic over " << std::max(FLAGS_replay_num_runs, 1)
+            << " runs" << std::endl;
+  return 0;
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char* argv[]) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::planning::RunReplayBenchmark();
+}